@@ -6,7 +6,24 @@
  *  SPDX-License-Identifier: MIT
 */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE     /* dlinfo, for cglLoadGLFromLibrary */
+#endif
+
 #include <cgl/cgl.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#if defined(__linux__)
+#include <link.h>
+#define CGL_ELF_LOOKUP
+#endif
+#endif
 
 
 /* something about glClearDepthf, glDepthRangef.. */
@@ -16,70 +33,2514 @@
 #endif
 
 
-PFNGLACTIVETEXTUREPROC glad_glActiveTexture = nullptr;
-PFNGLATTACHSHADERPROC glad_glAttachShader = nullptr;
-PFNGLBINDATTRIBLOCATIONPROC glad_glBindAttribLocation = nullptr;
-PFNGLBINDBUFFERPROC glad_glBindBuffer = nullptr;
-PFNGLBINDTEXTUREPROC glad_glBindTexture = nullptr;
-PFNGLBLENDCOLORPROC glad_glBlendColor = nullptr;
-PFNGLBUFFERDATAPROC glad_glBufferData = nullptr;
-PFNGLBUFFERSUBDATAPROC glad_glBufferSubData = nullptr;
-PFNGLBLENDEQUATIONPROC glad_glBlendEquation = nullptr;
-PFNGLBLENDEQUATIONSEPARATEPROC glad_glBlendEquationSeparate = nullptr;
-PFNGLBLENDFUNCPROC glad_glBlendFunc = nullptr;
-PFNGLBLENDFUNCSEPARATEPROC glad_glBlendFuncSeparate = nullptr;
-PFNGLCLEARPROC glad_glClear = nullptr;
-PFNGLCLEARCOLORPROC glad_glClearColor = nullptr;
-PFNGLCLEARDEPTHPROC glad_glClearDepth = nullptr;
-PFNGLCLEARSTENCILPROC glad_glClearStencil = nullptr;
-PFNGLCOLORMASKPROC glad_glColorMask = nullptr;
-PFNGLCOMPILESHADERPROC glad_glCompileShader = nullptr;
-PFNGLCOPYTEXIMAGE2DPROC glad_glCopyTexImage2D = nullptr;
-PFNGLCOPYTEXSUBIMAGE2DPROC glad_glCopyTexSubImage2D = nullptr;
-PFNGLCREATEPROGRAMPROC glad_glCreateProgram = nullptr;
-PFNGLCREATESHADERPROC glad_glCreateShader = nullptr;
-PFNGLCULLFACEPROC glad_glCullFace = nullptr;
-PFNGLDELETEBUFFERSPROC glad_glDeleteBuffers = nullptr;
-PFNGLDELETEPROGRAMPROC glad_glDeleteProgram = nullptr;
-PFNGLDELETESHADERPROC glad_glDeleteShader = nullptr;
-PFNGLDELETETEXTURESPROC glad_glDeleteTextures = nullptr;
-PFNGLDEPTHFUNCPROC glad_glDepthFunc = nullptr;
-PFNGLDEPTHMASKPROC glad_glDepthMask = nullptr;
-PFNGLDEPTHRANGEPROC glad_glDepthRange = nullptr;
-PFNGLDETACHSHADERPROC glad_glDetachShader = nullptr;
-PFNGLDISABLEPROC glad_glDisable = nullptr;
-PFNGLDISABLEVERTEXATTRIBARRAYPROC glad_glDisableVertexAttribArray = nullptr;
-PFNGLDRAWARRAYSPROC glad_glDrawArrays = nullptr;
-PFNGLDRAWELEMENTSPROC glad_glDrawElements = nullptr;
-PFNGLENABLEPROC glad_glEnable = nullptr;
-PFNGLENABLEVERTEXATTRIBARRAYPROC glad_glEnableVertexAttribArray = nullptr;
-PFNGLFINISHPROC glad_glFinish = nullptr;
-PFNGLFLUSHPROC glad_glFlush = nullptr;
-PFNGLFRONTFACEPROC glad_glFrontFace = nullptr;
-PFNGLGENBUFFERSPROC glad_glGenBuffers = nullptr;
-PFNGLGENTEXTURESPROC glad_glGenTextures = nullptr;
-PFNGLGETACTIVEATTRIBPROC glad_glGetActiveAttrib = nullptr;
-PFNGLGETBOOLEANVPROC glad_glGetBooleanv = nullptr;
-PFNGLGETFLOATVPROC glad_glGetFloatv = nullptr;
-PFNGLGETINTEGERVPROC glad_glGetIntegerv = nullptr;
+CGLDispatch cgl_dispatch;
+CGLLimits cgl_limits;
+
+
+
+/* enum names and values, looked up by perfect hashes generated by cglgen.py.
+ * cgl_enum_entries is ordered by the hash of the names, and cgl_enum_value_slots,
+ * ordered by the hash of the values, refers into it. The hash functions are the same
+ * as hash_string and hash_value in cglgen.py.
+ */
+typedef struct CGLEnumEntry {
+    unsigned short name;    /* offset into cgl_enum_pool */
+    GLenum value;
+} CGLEnumEntry;
+
+/* cglgen:begin enums */
+#define CGL_ENUM_COUNT 221
+#define CGL_ENUM_VALUE_COUNT 216
+
+static const char cgl_enum_pool[] =
+    "GL_FALSE\0"
+    "GL_TRUE\0"
+    "GL_NO_ERROR\0"
+    "GL_INVALID_ENUM\0"
+    "GL_INVALID_VALUE\0"
+    "GL_INVALID_OPERATION\0"
+    "GL_OUT_OF_MEMORY\0"
+    "GL_TEXTURE0\0"
+    "GL_TEXTURE1\0"
+    "GL_TEXTURE2\0"
+    "GL_TEXTURE3\0"
+    "GL_TEXTURE4\0"
+    "GL_TEXTURE5\0"
+    "GL_TEXTURE6\0"
+    "GL_TEXTURE7\0"
+    "GL_TEXTURE8\0"
+    "GL_TEXTURE9\0"
+    "GL_TEXTURE10\0"
+    "GL_TEXTURE11\0"
+    "GL_TEXTURE12\0"
+    "GL_TEXTURE13\0"
+    "GL_TEXTURE14\0"
+    "GL_TEXTURE15\0"
+    "GL_TEXTURE16\0"
+    "GL_TEXTURE17\0"
+    "GL_TEXTURE18\0"
+    "GL_TEXTURE19\0"
+    "GL_TEXTURE20\0"
+    "GL_TEXTURE21\0"
+    "GL_TEXTURE22\0"
+    "GL_TEXTURE23\0"
+    "GL_TEXTURE24\0"
+    "GL_TEXTURE25\0"
+    "GL_TEXTURE26\0"
+    "GL_TEXTURE27\0"
+    "GL_TEXTURE28\0"
+    "GL_TEXTURE29\0"
+    "GL_TEXTURE30\0"
+    "GL_TEXTURE31\0"
+    "GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS\0"
+    "GL_MAX_VERTEX_ATTRIBS\0"
+    "GL_ARRAY_BUFFER\0"
+    "GL_ELEMENT_ARRAY_BUFFER\0"
+    "GL_TEXTURE_2D\0"
+    "GL_TEXTURE_CUBE_MAP\0"
+    "GL_FUNC_ADD\0"
+    "GL_FUNC_REVERSE_SUBTRACT\0"
+    "GL_FUNC_SUBTRACT\0"
+    "GL_ZERO\0"
+    "GL_ONE\0"
+    "GL_SRC_COLOR\0"
+    "GL_ONE_MINUS_SRC_COLOR\0"
+    "GL_SRC_ALPHA\0"
+    "GL_ONE_MINUS_SRC_ALPHA\0"
+    "GL_DST_ALPHA\0"
+    "GL_ONE_MINUS_DST_ALPHA\0"
+    "GL_DST_COLOR\0"
+    "GL_ONE_MINUS_DST_COLOR\0"
+    "GL_SRC_ALPHA_SATURATE\0"
+    "GL_CONSTANT_COLOR\0"
+    "GL_ONE_MINUS_CONSTANT_COLOR\0"
+    "GL_CONSTANT_ALPHA\0"
+    "GL_ONE_MINUS_CONSTANT_ALPHA\0"
+    "GL_STREAM_DRAW\0"
+    "GL_STATIC_DRAW\0"
+    "GL_DYNAMIC_DRAW\0"
+    "GL_DEPTH_BUFFER_BIT\0"
+    "GL_STENCIL_BUFFER_BIT\0"
+    "GL_COLOR_BUFFER_BIT\0"
+    "GL_TEXTURE_CUBE_MAP_POSITIVE_X\0"
+    "GL_TEXTURE_CUBE_MAP_NEGATIVE_X\0"
+    "GL_TEXTURE_CUBE_MAP_POSITIVE_Y\0"
+    "GL_TEXTURE_CUBE_MAP_NEGATIVE_Y\0"
+    "GL_TEXTURE_CUBE_MAP_POSITIVE_Z\0"
+    "GL_TEXTURE_CUBE_MAP_NEGATIVE_Z\0"
+    "GL_ALPHA\0"
+    "GL_RGB\0"
+    "GL_RGBA\0"
+    "GL_LUMINANCE\0"
+    "GL_LUMINANCE_ALPHA\0"
+    "GL_NEAREST\0"
+    "GL_LINEAR\0"
+    "GL_TEXTURE_MAG_FILTER\0"
+    "GL_TEXTURE_MIN_FILTER\0"
+    "GL_TEXTURE_WRAP_S\0"
+    "GL_TEXTURE_WRAP_T\0"
+    "GL_REPEAT\0"
+    "GL_CLAMP_TO_EDGE\0"
+    "GL_FRAGMENT_SHADER\0"
+    "GL_VERTEX_SHADER\0"
+    "GL_FRONT\0"
+    "GL_BACK\0"
+    "GL_FRONT_AND_BACK\0"
+    "GL_NEVER\0"
+    "GL_LESS\0"
+    "GL_EQUAL\0"
+    "GL_LEQUAL\0"
+    "GL_GREATER\0"
+    "GL_NOTEQUAL\0"
+    "GL_GEQUAL\0"
+    "GL_ALWAYS\0"
+    "GL_KEEP\0"
+    "GL_REPLACE\0"
+    "GL_INCR\0"
+    "GL_DECR\0"
+    "GL_INVERT\0"
+    "GL_INCR_WRAP\0"
+    "GL_DECR_WRAP\0"
+    "GL_BLEND\0"
+    "GL_CULL_FACE\0"
+    "GL_DEPTH_TEST\0"
+    "GL_DITHER\0"
+    "GL_POLYGON_OFFSET_FILL\0"
+    "GL_SAMPLE_ALPHA_TO_COVERAGE\0"
+    "GL_SAMPLE_COVERAGE\0"
+    "GL_SCISSOR_TEST\0"
+    "GL_STENCIL_TEST\0"
+    "GL_POINTS\0"
+    "GL_LINES\0"
+    "GL_LINE_LOOP\0"
+    "GL_LINE_STRIP\0"
+    "GL_TRIANGLES\0"
+    "GL_TRIANGLE_STRIP\0"
+    "GL_TRIANGLE_FAN\0"
+    "GL_BYTE\0"
+    "GL_UNSIGNED_BYTE\0"
+    "GL_SHORT\0"
+    "GL_UNSIGNED_SHORT\0"
+    "GL_CW\0"
+    "GL_CCW\0"
+    "GL_ACTIVE_TEXTURE\0"
+    "GL_ALIASED_LINE_WIDTH_RANGE\0"
+    "GL_ARRAY_BUFFER_BINDING\0"
+    "GL_BLEND_COLOR\0"
+    "GL_BLEND_DST_RGB\0"
+    "GL_BLEND_SRC_RGB\0"
+    "GL_BLEND_DST_ALPHA\0"
+    "GL_BLEND_SRC_ALPHA\0"
+    "GL_BLEND_EQUATION_RGB\0"
+    "GL_BLEND_EQUATION_ALPHA\0"
+    "GL_COLOR_CLEAR_VALUE\0"
+    "GL_COLOR_WRITEMASK\0"
+    "GL_COMPRESSED_TEXTURE_FORMATS\0"
+    "GL_CULL_FACE_MODE\0"
+    "GL_CURRENT_PROGRAM\0"
+    "GL_DEPTH_CLEAR_VALUE\0"
+    "GL_DEPTH_FUNC\0"
+    "GL_DEPTH_RANGE\0"
+    "GL_DEPTH_WRITEMASK\0"
+    "GL_ELEMENT_ARRAY_BUFFER_BINDING\0"
+    "GL_LINE_WIDTH\0"
+    "GL_MAX_CUBE_MAP_TEXTURE_SIZE\0"
+    "GL_MAX_TEXTURE_IMAGE_UNITS\0"
+    "GL_MAX_TEXTURE_SIZE\0"
+    "GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS\0"
+    "GL_MAX_VIEWPORT_DIMS\0"
+    "GL_NUM_COMPRESSED_TEXTURE_FORMATS\0"
+    "GL_PACK_ALIGNMENT\0"
+    "GL_POLYGON_OFFSET_FACTOR\0"
+    "GL_POLYGON_OFFSET_UNITS\0"
+    "GL_SAMPLE_BUFFERS\0"
+    "GL_SAMPLE_COVERAGE_INVERT\0"
+    "GL_SAMPLE_COVERAGE_VALUE\0"
+    "GL_SAMPLES\0"
+    "GL_SCISSOR_BOX\0"
+    "GL_STENCIL_BACK_FAIL\0"
+    "GL_STENCIL_BACK_FUNC\0"
+    "GL_STENCIL_BACK_PASS_DEPTH_FAIL\0"
+    "GL_STENCIL_BACK_PASS_DEPTH_PASS\0"
+    "GL_STENCIL_BACK_REF\0"
+    "GL_STENCIL_BACK_VALUE_MASK\0"
+    "GL_STENCIL_BACK_WRITEMASK\0"
+    "GL_STENCIL_CLEAR_VALUE\0"
+    "GL_STENCIL_FAIL\0"
+    "GL_STENCIL_FUNC\0"
+    "GL_STENCIL_PASS_DEPTH_FAIL\0"
+    "GL_STENCIL_PASS_DEPTH_PASS\0"
+    "GL_STENCIL_REF\0"
+    "GL_STENCIL_VALUE_MASK\0"
+    "GL_STENCIL_WRITEMASK\0"
+    "GL_SUBPIXEL_BITS\0"
+    "GL_TEXTURE_BINDING_2D\0"
+    "GL_TEXTURE_BINDING_CUBE_MAP\0"
+    "GL_UNPACK_ALIGNMENT\0"
+    "GL_VIEWPORT\0"
+    "GL_FLOAT\0"
+    "GL_FLOAT_VEC2\0"
+    "GL_FLOAT_VEC3\0"
+    "GL_FLOAT_VEC4\0"
+    "GL_FLOAT_MAT2\0"
+    "GL_FLOAT_MAT3\0"
+    "GL_FLOAT_MAT4\0"
+    "GL_INT\0"
+    "GL_INT_VEC2\0"
+    "GL_INT_VEC3\0"
+    "GL_INT_VEC4\0"
+    "GL_BOOL\0"
+    "GL_BOOL_VEC2\0"
+    "GL_BOOL_VEC3\0"
+    "GL_BOOL_VEC4\0"
+    "GL_SAMPLER_2D\0"
+    "GL_SAMPLER_CUBE\0"
+    "GL_DELETE_STATUS\0"
+    "GL_LINK_STATUS\0"
+    "GL_VALIDATE_STATUS\0"
+    "GL_INFO_LOG_LENGTH\0"
+    "GL_ATTACHED_SHADERS\0"
+    "GL_ACTIVE_UNIFORMS\0"
+    "GL_ACTIVE_UNIFORM_MAX_LENGTH\0"
+    "GL_ACTIVE_ATTRIBUTES\0"
+    "GL_ACTIVE_ATTRIBUTE_MAX_LENGTH\0"
+    "GL_MAX_FRAGMENT_UNIFORM_COMPONENTS\0"
+    "GL_MAX_VERTEX_UNIFORM_COMPONENTS\0"
+    "GL_MAX_VERTEX_UNIFORM_VECTORS\0"
+    "GL_MAX_FRAGMENT_UNIFORM_VECTORS\0"
+    "GL_SMOOTH_LINE_WIDTH_RANGE\0"
+    "GL_SMOOTH_LINE_WIDTH_GRANULARITY\0"
+    "GL_STENCIL_BITS\0"
+    "GL_IMPLEMENTATION_COLOR_READ_TYPE\0"
+    "GL_IMPLEMENTATION_COLOR_READ_FORMAT\0"
+    "GL_SHADER_COMPILER";
+
+static const CGLEnumEntry cgl_enum_entries[CGL_ENUM_COUNT] = {
+    {3539, 0x8B8A}, {3135, 0x0CF5}, {1462, 0x8B31}, {415, 0x84D9}, {2764, 0x8802}, {2127, 0x8009},
+    {160, 0x84C5}, {3470, 0x8B86}, {3518, 0x8B89}, {1283, 0x1909}, {3605, 0x8B4A}, {3776, 0x8B9A},
+    {1259, 0x1906}, {1939, 0x1403}, {1531, 0x0202}, {1593, 0x1E00}, {3397, 0x8B82}, {1664, 0x0BE2},
+    {2315, 0x0B70}, {1651, 0x8508}, {311, 0x84D1}, {1275, 0x1908}, {828, 0x0307}, {2330, 0x0B72},
+    {3760, 0x0D57}, {376, 0x84D6}, {1540, 0x0203}, {3431, 0x8B84}, {402, 0x84D8}, {2424, 0x8872},
+    {3190, 0x8B51}, {2072, 0x80C9}, {1686, 0x0B71}, {220, 0x84CA}, {2707, 0x0C10}, {2055, 0x80C8},
+    {324, 0x84D2}, {1780, 0x0C11}, {3279, 0x8B54}, {2395, 0x851C}, {1700, 0x0BD0}, {1628, 0x150A},
+    {1858, 0x0004}, {2578, 0x8038}, {196, 0x84C8}, {285, 0x84CF}, {756, 0x0303}, {2560, 0x0D05},
+    {1479, 0x0404}, {9, 0x0001}, {2505, 0x0D3A}, {112, 0x84C1}, {1871, 0x0005}, {1601, 0x1E01},
+    {1733, 0x809E}, {1228, 0x851A}, {2924, 0x0B94}, {1913, 0x1401}, {441, 0x84DB}, {1710, 0x8037},
+    {1620, 0x1E03}, {1104, 0x8516}, {3267, 0x8B53}, {891, 0x8002}, {17, 0x0000}, {1550, 0x0204},
+    {1496, 0x0408}, {792, 0x0305}, {272, 0x84CE}, {83, 0x0505}, {1889, 0x0006}, {1930, 0x1402},
+    {1963, 0x0901}, {208, 0x84C9}, {3380, 0x8B80}, {1970, 0x84E0}, {1573, 0x0206}, {2301, 0x0B74},
+    {1638, 0x8507}, {3489, 0x8B87}, {45, 0x0501}, {1488, 0x0405}, {172, 0x84C6}, {3668, 0x8DFD},
+    {564, 0x8892}, {3047, 0x0B98}, {1166, 0x8518}, {1197, 0x8519}, {638, 0x8006}, {124, 0x84C2},
+    {3068, 0x0D50}, {1135, 0x8517}, {2108, 0x80CB}, {1673, 0x0B44}, {3846, 0x8DFA}, {2040, 0x8005},
+    {506, 0x8B4D}, {1031, 0x0400}, {3176, 0x8B50}, {1831, 0x0002}, {3260, 0x1404}, {3246, 0x8B5C},
+    {480, 0x84DE}, {1612, 0x1E02}, {1957, 0x0900}, {1812, 0x0000}, {1844, 0x0003}, {454, 0x84DC},
+    {3311, 0x8B57}, {246, 0x84CC}, {2956, 0x0B95}, {618, 0x8513}, {965, 0x88E0}, {873, 0x8001},
+    {3638, 0x8DFB}, {1988, 0x846E}, {1905, 0x1400}, {1583, 0x0207}, {389, 0x84D7}, {29, 0x0500},
+    {2451, 0x0D33}, {1398, 0x2803}, {1443, 0x8B30}, {542, 0x8869}, {3324, 0x8B58}, {2349, 0x8895},
+    {337, 0x84D3}, {1380, 0x2802}, {692, 0x0000}, {2194, 0x0C23}, {3450, 0x8B85}, {2016, 0x8894},
+    {2173, 0x0C22}, {2796, 0x8803}, {2381, 0x0B21}, {2627, 0x80A8}, {2213, 0x86A3}, {1326, 0x2601},
+    {493, 0x84DF}, {779, 0x0304}, {3337, 0x8B59}, {2722, 0x8801}, {3727, 0x0B23}, {675, 0x800A},
+    {2645, 0x80AB}, {700, 0x0001}, {467, 0x84DD}, {1514, 0x0200}, {2149, 0x883D}, {428, 0x84DA},
+    {650, 0x800B}, {580, 0x8893}, {3107, 0x8514}, {3085, 0x8069}, {919, 0x8003}, {707, 0x0300},
+    {350, 0x84D4}, {259, 0x84CD}, {851, 0x0308}, {2671, 0x80AA}, {3218, 0x8B5A}, {995, 0x88E8},
+    {363, 0x84D5}, {937, 0x8004}, {720, 0x0301}, {233, 0x84CB}, {2848, 0x8CA4}, {1561, 0x0205},
+    {1296, 0x190A}, {980, 0x88E4}, {3025, 0x0B93}, {3810, 0x8B9B}, {1761, 0x80A0}, {100, 0x84C0},
+    {1358, 0x2801}, {2696, 0x80A9}, {1336, 0x2800}, {3570, 0x8B49}, {815, 0x0306}, {2243, 0x0B45},
+    {2526, 0x86A2}, {1053, 0x4000}, {2743, 0x8800}, {136, 0x84C3}, {3291, 0x8B55}, {3350, 0x8B5E},
+    {1011, 0x0100}, {604, 0x0DE1}, {298, 0x84D0}, {3155, 0x0BA2}, {3204, 0x8B52}, {3303, 0x8B56},
+    {3010, 0x0B97}, {2280, 0x0B73}, {2471, 0x8B4C}, {148, 0x84C4}, {184, 0x84C7}, {1796, 0x0B90},
+    {3232, 0x8B5B}, {3700, 0x0B22}, {1073, 0x8515}, {1315, 0x2600}, {2983, 0x0B96}, {1416, 0x2901},
+    {2261, 0x8B8D}, {1268, 0x1907}, {2940, 0x0B92}, {743, 0x0302}, {1523, 0x0201}, {62, 0x0502},
+    {2901, 0x0B91}, {1822, 0x0001}, {0, 0x0000}, {2828, 0x8CA3}, {2089, 0x80CA}, {2875, 0x8CA5},
+    {3364, 0x8B60}, {3412, 0x8B83}, {2603, 0x2A00}, {1426, 0x812F}, {3167, 0x1406}
+};
+
+static const unsigned short cgl_enum_name_displace[111] = {
+    4, 0, 10, 14, 3, 0, 2, 1, 6, 24, 2, 0, 0, 9, 23, 5,
+    2, 1, 18, 3, 9, 3, 6, 1, 7, 25, 17, 16, 15, 1, 42, 2,
+    2, 6, 9, 0, 2, 2, 12, 25, 10, 6, 3, 15, 26, 0, 30, 2,
+    28, 0, 7, 0, 11, 8, 1, 8, 16, 6, 0, 1, 4, 2, 26, 23,
+    0, 14, 1, 4, 5, 9, 0, 46, 0, 33, 22, 56, 2, 1, 3, 11,
+    1, 11, 2, 19, 120, 3, 6, 1, 9, 12, 3, 4, 11, 0, 1, 11,
+    1, 1, 8, 2, 61, 68, 0, 2, 0, 25, 74, 4, 25, 32, 37
+};
+
+static const unsigned short cgl_enum_value_slots[CGL_ENUM_VALUE_COUNT] = {
+    179, 85, 23, 168, 89, 0, 103, 5, 121, 59, 198, 49, 199, 160, 52, 206,
+    193, 99, 9, 186, 130, 202, 161, 124, 40, 73, 29, 194, 13, 200, 137, 120,
+    15, 102, 171, 173, 54, 78, 109, 51, 149, 175, 201, 47, 116, 60, 155, 17,
+    154, 183, 147, 188, 119, 169, 41, 36, 213, 84, 65, 162, 37, 172, 94, 118,
+    104, 219, 195, 8, 79, 45, 191, 26, 98, 90, 55, 76, 117, 185, 197, 141,
+    153, 87, 163, 6, 100, 24, 12, 215, 72, 190, 158, 142, 50, 70, 182, 220,
+    174, 180, 66, 151, 131, 204, 170, 209, 69, 1, 110, 133, 181, 114, 4, 140,
+    25, 138, 112, 214, 53, 143, 14, 42, 113, 11, 81, 210, 35, 205, 132, 91,
+    108, 134, 38, 157, 111, 146, 126, 176, 82, 83, 177, 44, 122, 32, 96, 129,
+    56, 3, 30, 139, 207, 203, 68, 101, 46, 123, 77, 196, 166, 212, 106, 107,
+    20, 2, 184, 34, 88, 93, 192, 127, 164, 218, 208, 189, 159, 62, 61, 125,
+    144, 178, 95, 57, 216, 75, 10, 165, 31, 150, 167, 74, 187, 135, 7, 217,
+    18, 43, 19, 86, 16, 33, 58, 152, 63, 48, 136, 148, 115, 156, 39, 97,
+    28, 21, 80, 22, 71, 92, 67, 27
+};
+
+static const unsigned short cgl_enum_value_displace[108] = {
+    3, 8, 2, 4, 1, 2, 0, 2, 5, 5, 0, 5, 6, 7, 2, 11,
+    0, 0, 2, 1, 2, 2, 1, 14, 0, 8, 0, 0, 10, 34, 1, 1,
+    3, 1, 6, 12, 3, 5, 15, 2, 4, 4, 1, 3, 5, 8, 5, 1,
+    1, 10, 3, 7, 0, 11, 2, 21, 2, 24, 0, 8, 22, 1, 16, 7,
+    2, 17, 29, 3, 34, 2, 6, 15, 45, 5, 20, 0, 1, 0, 0, 20,
+    5, 7, 0, 9, 1, 2, 2, 5, 2, 29, 18, 6, 8, 0, 33, 12,
+    1, 4, 23, 86, 0, 99, 500, 15, 18, 3, 6, 73
+};
+/* cglgen:end enums */
+
+static unsigned long cgl_hash_string(const char *key, unsigned long seed) {
+    unsigned long h = (2166136261UL ^ seed) & 0xffffffffUL;
+
+    while (*key != '\0')
+        h = ((h ^ (unsigned char) *key++) * 16777619UL) & 0xffffffffUL;
+    return h;
+}
+
+static unsigned long cgl_hash_value(unsigned long key, unsigned long seed) {
+    unsigned long h = (key ^ (seed * 0x9e3779b9UL)) & 0xffffffffUL;
+
+    h = ((h ^ (h >> 16)) * 0x7feb352dUL) & 0xffffffffUL;
+    h = ((h ^ (h >> 15)) * 0x846ca68bUL) & 0xffffffffUL;
+    return h ^ (h >> 16);
+}
+
+GLenum cglGetEnumValue(const char *name) {
+    const unsigned long buckets = sizeof(cgl_enum_name_displace) / sizeof(cgl_enum_name_displace[0]);
+    const CGLEnumEntry *entry;
+
+    if (name == nullptr)
+        return CGL_UNKNOWN_ENUM;
+    entry = &cgl_enum_entries[cgl_hash_string(name, cgl_enum_name_displace[cgl_hash_string(name, 0) % buckets])
+                              % CGL_ENUM_COUNT];
+    return strcmp(cgl_enum_pool + entry->name, name) == 0 ? entry->value : CGL_UNKNOWN_ENUM;
+}
+
+const char *cglGetEnumName(GLenum value) {
+    const unsigned long buckets = sizeof(cgl_enum_value_displace) / sizeof(cgl_enum_value_displace[0]);
+    const CGLEnumEntry *entry;
+
+    entry = &cgl_enum_entries[cgl_enum_value_slots[cgl_hash_value(value, cgl_enum_value_displace[cgl_hash_value(value, 0) % buckets])
+                                                   % CGL_ENUM_VALUE_COUNT]];
+    return entry->value == value ? cgl_enum_pool + entry->name : nullptr;
+}
+
+
+
+void cglLoadLimits(void) {
+    static const struct { GLenum pname; size_t offset; } integer_limits[] = {
+        { GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, offsetof(CGLLimits, max_combined_texture_image_units) },
+        { GL_MAX_TEXTURE_IMAGE_UNITS, offsetof(CGLLimits, max_texture_image_units) },
+        { GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS, offsetof(CGLLimits, max_vertex_texture_image_units) },
+        { GL_MAX_TEXTURE_SIZE, offsetof(CGLLimits, max_texture_size) },
+        { GL_MAX_CUBE_MAP_TEXTURE_SIZE, offsetof(CGLLimits, max_cube_map_texture_size) },
+        { GL_MAX_VIEWPORT_DIMS, offsetof(CGLLimits, max_viewport_dims) },
+        { GL_MAX_VERTEX_ATTRIBS, offsetof(CGLLimits, max_vertex_attribs) },
+        { GL_MAX_VERTEX_UNIFORM_VECTORS, offsetof(CGLLimits, max_vertex_uniform_vectors) },
+        { GL_MAX_FRAGMENT_UNIFORM_VECTORS, offsetof(CGLLimits, max_fragment_uniform_vectors) },
+        { GL_NUM_COMPRESSED_TEXTURE_FORMATS, offsetof(CGLLimits, num_compressed_texture_formats) },
+        { GL_SUBPIXEL_BITS, offsetof(CGLLimits, subpixel_bits) },
+        { GL_SAMPLE_BUFFERS, offsetof(CGLLimits, sample_buffers) },
+        { GL_SAMPLES, offsetof(CGLLimits, samples) },
+        { GL_STENCIL_BITS, offsetof(CGLLimits, stencil_bits) },
+        { GL_IMPLEMENTATION_COLOR_READ_FORMAT, offsetof(CGLLimits, implementation_color_read_format) },
+        { GL_IMPLEMENTATION_COLOR_READ_TYPE, offsetof(CGLLimits, implementation_color_read_type) },
+        { GL_SHADER_COMPILER, offsetof(CGLLimits, shader_compiler) }
+    };
+    static const struct { GLenum pname; size_t offset; } float_limits[] = {
+        { GL_ALIASED_LINE_WIDTH_RANGE, offsetof(CGLLimits, aliased_line_width_range) },
+        { GL_SMOOTH_LINE_WIDTH_RANGE, offsetof(CGLLimits, smooth_line_width_range) },
+        { GL_SMOOTH_LINE_WIDTH_GRANULARITY, offsetof(CGLLimits, smooth_line_width_granularity) }
+    };
+    CGLLimits *limits = CGL_CURRENT_LIMITS;
+    GLint vertex_components = -1, fragment_components = -1;
+    size_t i;
+
+    /* unsupported queries leave their value alone, so everything starts out as -1 */
+    for (i = 0; i < sizeof(integer_limits) / sizeof(integer_limits[0]); ++i)
+        *(GLint *) ((char *) limits + integer_limits[i].offset) = -1;
+    limits->max_viewport_dims[1] = -1;
+    limits->aliased_line_width_range[0] = limits->aliased_line_width_range[1] = -1.0f;
+    limits->smooth_line_width_range[0] = limits->smooth_line_width_range[1] = -1.0f;
+    limits->smooth_line_width_granularity = -1.0f;
+
+    for (i = 0; i < sizeof(integer_limits) / sizeof(integer_limits[0]); ++i)
+        glGetIntegerv(integer_limits[i].pname, (GLint *) ((char *) limits + integer_limits[i].offset));
+    for (i = 0; i < sizeof(float_limits) / sizeof(float_limits[0]); ++i)
+        glGetFloatv(float_limits[i].pname, (GLfloat *) ((char *) limits + float_limits[i].offset));
+
+    /* GL 2.1 counts uniform components, GL ES 2.0 vec4s, GL 4 both */
+    if (limits->max_vertex_uniform_vectors < 0) {
+        glGetIntegerv(GL_MAX_VERTEX_UNIFORM_COMPONENTS, &vertex_components);
+        limits->max_vertex_uniform_vectors = vertex_components < 0 ? -1 : vertex_components / 4;
+    }
+    if (limits->max_fragment_uniform_vectors < 0) {
+        glGetIntegerv(GL_MAX_FRAGMENT_UNIFORM_COMPONENTS, &fragment_components);
+        limits->max_fragment_uniform_vectors = fragment_components < 0 ? -1 : fragment_components / 4;
+    }
+    /* desktop GL has no GL_SHADER_COMPILER before 4.1, but always a compiler */
+    if (limits->shader_compiler < 0 && limits->smooth_line_width_granularity >= 0.0f)
+        limits->shader_compiler = GL_TRUE;
+
+    while (glGetError() != GL_NO_ERROR)
+        ;
+}
+
+
+
+/* pipelines: the description with booleans as GL_TRUE / GL_FALSE and the blend color clamped like GL does,
+ * so that equal state compares equal, and the capabilities as CGL_PIPELINE_* bits.
+ * Every dispatch table remembers the pipeline applied last (as a copy, since it may be destroyed since).
+ */
+#define CGL_PIPELINE_BLEND                  0x01u
+#define CGL_PIPELINE_DEPTH_TEST             0x02u
+#define CGL_PIPELINE_STENCIL_TEST           0x04u
+#define CGL_PIPELINE_CULL_FACE              0x08u
+#define CGL_PIPELINE_POLYGON_OFFSET_FILL    0x10u
+#define CGL_PIPELINE_CAPS                   0x1fu
+
+static const GLenum cgl_pipeline_caps[] = {
+    GL_BLEND, GL_DEPTH_TEST, GL_STENCIL_TEST, GL_CULL_FACE, GL_POLYGON_OFFSET_FILL
+};
+
+#define CGL_DIRTY_BLEND_FUNC            0x0001u
+#define CGL_DIRTY_BLEND_EQUATION        0x0002u
+#define CGL_DIRTY_BLEND_COLOR           0x0004u
+#define CGL_DIRTY_DEPTH_FUNC            0x0008u
+#define CGL_DIRTY_DEPTH_MASK            0x0010u
+#define CGL_DIRTY_STENCIL_FUNC_FRONT    0x0020u
+#define CGL_DIRTY_STENCIL_FUNC_BACK     0x0040u
+#define CGL_DIRTY_STENCIL_OP_FRONT      0x0080u
+#define CGL_DIRTY_STENCIL_OP_BACK       0x0100u
+#define CGL_DIRTY_STENCIL_MASK_FRONT    0x0200u
+#define CGL_DIRTY_STENCIL_MASK_BACK     0x0400u
+#define CGL_DIRTY_CULL_FACE             0x0800u
+#define CGL_DIRTY_FRONT_FACE            0x1000u
+#define CGL_DIRTY_COLOR_MASK            0x2000u
+#define CGL_DIRTY_POLYGON_OFFSET        0x4000u
+#define CGL_DIRTY_ALL                   0x7fffu
+
+struct CGLPipelineState {
+    unsigned int caps;
+    CGLPipelineDesc desc;
+};
+
+typedef struct CGLAppliedPipeline {
+    int valid;
+    CGLPipelineState state;
+} CGLAppliedPipeline;
+
+static CGLAppliedPipeline cgl_applied_pipeline;
+
+/* a vertex format keeps its attributes by index, with a bit in enabled for each one that is used */
+struct CGLVertexFormat {
+    unsigned int enabled;
+    CGLVertexAttrib attribs[CGL_VERTEX_FORMAT_ATTRIBS];
+};
+
+/* the arrays stay specified while disabled, so known tracks the attributes set since the last invalidation */
+typedef struct CGLAppliedVertexFormat {
+    int valid;
+    unsigned int known;
+    CGLVertexFormat format;
+} CGLAppliedVertexFormat;
+
+static CGLAppliedVertexFormat cgl_applied_vertex_format;
+
+
+#ifndef CGL_DIRECT_LINK
+
+/* the names of all entry points, packed back to back in dispatch order,
+ * with cgl_symbol_offset[i] being the start of the name for cgl_dispatch.slot[i].
+ * The section between the cglgen markers is generated by cglgen.py, do not edit it by hand.
+ */
+/* cglgen:begin symbols */
+static const char cgl_symbol_pool[] =
+    "glActiveTexture\0"
+    "glAttachShader\0"
+    "glBindAttribLocation\0"
+    "glBindBuffer\0"
+    "glBindTexture\0"
+    "glBlendColor\0"
+    "glBlendEquation\0"
+    "glBlendEquationSeparate\0"
+    "glBlendFunc\0"
+    "glBlendFuncSeparate\0"
+    "glBufferData\0"
+    "glBufferSubData\0"
+    "glClear\0"
+    "glClearColor\0"
+    "glClearDepth\0"
+    "glClearStencil\0"
+    "glColorMask\0"
+    "glCompileShader\0"
+    "glCopyTexImage2D\0"
+    "glCopyTexSubImage2D\0"
+    "glCreateProgram\0"
+    "glCreateShader\0"
+    "glCullFace\0"
+    "glDeleteBuffers\0"
+    "glDeleteProgram\0"
+    "glDeleteShader\0"
+    "glDeleteTextures\0"
+    "glDepthFunc\0"
+    "glDepthMask\0"
+    "glDepthRange\0"
+    "glDetachShader\0"
+    "glEnable\0"
+    "glDisable\0"
+    "glEnableVertexAttribArray\0"
+    "glDisableVertexAttribArray\0"
+    "glDrawArrays\0"
+    "glDrawElements\0"
+    "glFinish\0"
+    "glFlush\0"
+    "glFrontFace\0"
+    "glGenBuffers\0"
+    "glGenTextures\0"
+    "glGetBooleanv\0"
+    "glGetFloatv\0"
+    "glGetIntegerv\0"
+    "glGetActiveAttrib\0"
+    "glGetActiveUniform\0"
+    "glGetError\0"
+    "glGetProgramiv\0"
+    "glGetUniformLocation\0"
+    "glLinkProgram\0"
+    "glPixelStorei\0"
+    "glPolygonOffset\0"
+    "glStencilFunc\0"
+    "glStencilFuncSeparate\0"
+    "glStencilMask\0"
+    "glStencilMaskSeparate\0"
+    "glStencilOp\0"
+    "glStencilOpSeparate\0"
+    "glTexImage2D\0"
+    "glTexParameteri\0"
+    "glTexSubImage2D\0"
+    "glUniform1f\0"
+    "glUniform2f\0"
+    "glUniform3f\0"
+    "glUniform4f\0"
+    "glUniform1i\0"
+    "glUniform2i\0"
+    "glUniform3i\0"
+    "glUniform4i\0"
+    "glUniform1fv\0"
+    "glUniform2fv\0"
+    "glUniform3fv\0"
+    "glUniform4fv\0"
+    "glUniform1iv\0"
+    "glUniform2iv\0"
+    "glUniform3iv\0"
+    "glUniform4iv\0"
+    "glUniformMatrix2fv\0"
+    "glUniformMatrix3fv\0"
+    "glUniformMatrix4fv\0"
+    "glUseProgram\0"
+    "glVertexAttribPointer";
+
+static const unsigned short cgl_symbol_offset[CGL_DISPATCH_COUNT] = {
+    0, 16, 31, 52, 65, 79, 92, 108, 132, 144, 164, 177, 193, 201, 214, 227, 242, 254, 270, 287, 307,
+    323, 338, 349, 365, 381, 396, 413, 425, 437, 450, 465, 474, 484, 510, 537, 550, 565, 574, 582,
+    594, 607, 621, 635, 647, 661, 679, 698, 709, 724, 745, 759, 773, 789, 803, 825, 839, 861, 873,
+    893, 906, 922, 938, 950, 962, 974, 986, 998, 1010, 1022, 1034, 1047, 1060, 1073, 1086, 1099,
+    1112, 1125, 1138, 1157, 1176, 1195, 1208
+};
+
+#ifdef CGL_ELF_LOOKUP
+static const unsigned long cgl_symbol_hash[CGL_DISPATCH_COUNT] = {
+    0x9357fc85UL, 0x9f5da104UL, 0x4f819e14UL, 0x57ea206fUL, 0x9ac194a6UL, 0xb4a0fd7cUL,
+    0x021bfc03UL, 0xce3c8a98UL, 0x629242a9UL, 0xd44a173eUL, 0x5700cb2cUL, 0x1665d376UL,
+    0xfd54903fUL, 0xf09eb19eUL, 0xf0ab5ff4UL, 0x6ddfbe91UL, 0xba01dd83UL, 0x712f7898UL,
+    0xe8bdd9bdUL, 0xcc4f7087UL, 0x205c8f24UL, 0x835cdd03UL, 0x01bdf1b7UL, 0x79bf9d58UL,
+    0xa9131403UL, 0xdcd6c202UL, 0xa9b36b2fUL, 0x32c64499UL, 0x32c9c6d9UL, 0x8c5d071aUL,
+    0x61c91a58UL, 0xacb2ecbfUL, 0xebb1802cUL, 0x13ae32c2UL, 0x0371adcfUL, 0x2d14fe58UL,
+    0x8bf2f3c3UL, 0xaeb4da79UL, 0xfd8b201aUL, 0xc0f69510UL, 0xd6d8c65fUL, 0xa9f1b516UL,
+    0xb46983eeUL, 0x5935c704UL, 0xe868633cUL, 0xd526c09aUL, 0x6ebf1914UL, 0xf3216d22UL,
+    0x5a6f1c4fUL, 0x4c1fa891UL, 0x2fed8c1eUL, 0x6c1f6590UL, 0x9f2842a7UL, 0x4f9c03f6UL,
+    0x94f2d58bUL, 0x4f9f8636UL, 0x387497cbUL, 0x80e55949UL, 0x1519cddeUL, 0x4dc8e382UL,
+    0xf4dfe433UL, 0x1ed5e02cUL, 0x027101cfUL, 0x027101f0UL, 0x02710211UL, 0x02710232UL,
+    0x027101d2UL, 0x027101f3UL, 0x02710214UL, 0x02710235UL, 0x50913c25UL, 0x50914066UL,
+    0x509144a7UL, 0x509148e8UL, 0x50913c88UL, 0x509140c9UL, 0x5091450aUL, 0x5091494bUL,
+    0x17b2927bUL, 0x17b296bcUL, 0x17b29afdUL, 0x4f3ddefdUL, 0x73e23bddUL
+};
+#endif
+/* cglgen:end symbols */
+
+#define CGL_SLOT(name) (offsetof(CGLDispatch, fn.name) / sizeof(GLADproc))
+
+
+/* the copy of the GL state kept by the shadow-state cache.
+ * known has a CGL_KNOWN_* bit for each value that is valid, the capabilities of glEnable
+ * have one CGL_CAP_* bit each in caps (the value) and known_caps.
+ */
+#define CGL_KNOWN_BLEND_FUNC        0x001u
+#define CGL_KNOWN_BLEND_EQUATION    0x002u
+#define CGL_KNOWN_BLEND_COLOR       0x004u
+#define CGL_KNOWN_DEPTH_FUNC        0x008u
+#define CGL_KNOWN_DEPTH_MASK        0x010u
+#define CGL_KNOWN_COLOR_MASK        0x020u
+#define CGL_KNOWN_CULL_FACE         0x040u
+#define CGL_KNOWN_FRONT_FACE        0x080u
+#define CGL_KNOWN_DEPTH_RANGE       0x100u
+#define CGL_KNOWN_STATE             0x1ffu
+
+#define CGL_CAP_BLEND                   0x001u
+#define CGL_CAP_CULL_FACE               0x002u
+#define CGL_CAP_DEPTH_TEST              0x004u
+#define CGL_CAP_DITHER                  0x008u
+#define CGL_CAP_POLYGON_OFFSET_FILL     0x010u
+#define CGL_CAP_SAMPLE_ALPHA_TO_COVERAGE 0x020u
+#define CGL_CAP_SAMPLE_COVERAGE         0x040u
+#define CGL_CAP_SCISSOR_TEST            0x080u
+#define CGL_CAP_STENCIL_TEST            0x100u
+#define CGL_CAP_ALL                     0x1ffu
+
+typedef struct CGLShadowState {
+    unsigned int known;
+    unsigned int caps;
+    unsigned int known_caps;
+    GLenum blend_func[4];       /* src rgb, dst rgb, src alpha, dst alpha */
+    GLenum blend_equation[2];   /* rgb, alpha */
+    GLfloat blend_color[4];
+    GLenum depth_func;
+    GLboolean depth_mask;
+    GLboolean color_mask[4];
+    GLenum cull_face;
+    GLenum front_face;
+    GLdouble depth_range[2];
+} CGLShadowState;
+
+/* the bindings kept by the binding cache, CGL_UNKNOWN_NAME where the cache doesn't know them */
+#define CGL_UNKNOWN_NAME 0xffffffffu
+#define CGL_CACHED_TEXTURE_UNITS 32
+
+typedef struct CGLBindings {
+    GLuint array_buffer;
+    GLuint element_array_buffer;
+    GLuint program;
+    GLenum active_texture;
+    GLuint textures[CGL_CACHED_TEXTURE_UNITS][2];   /* GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP */
+} CGLBindings;
+
+/* the uniform cache keeps, for each program, the locations queried by name and the value last set
+ * at each location. All three are hash tables with linear probing and a power of two capacity,
+ * at most half full, a program of 0, a name of NULL and a location of -1 marking the free entries.
+ */
+#define CGL_UNIFORM_FLOAT       0x10u
+#define CGL_UNIFORM_INT         0x20u
+#define CGL_UNIFORM_MATRIX      0x30u
+#define CGL_UNIFORM_TRANSPOSED  0x40u   /* a matrix given row major */
+
+typedef struct CGLUniformName {
+    char *name;
+    unsigned long hash;
+    GLint location;
+} CGLUniformName;
+
+typedef struct CGLUniformValue {
+    GLint location;
+    unsigned int kind;          /* CGL_UNIFORM_* | components, 0 if the value is unknown */
+    unsigned char data[64];     /* up to a mat4 */
+} CGLUniformValue;
+
+typedef struct CGLUniformProgram {
+    GLuint program;
+    unsigned int name_count;
+    unsigned int name_capacity;
+    unsigned int value_count;
+    unsigned int value_capacity;
+    CGLUniformName *names;
+    CGLUniformValue *values;
+} CGLUniformProgram;
+
+typedef struct CGLUniforms {
+    GLuint program;             /* the program in use, CGL_UNKNOWN_NAME if not known */
+    CGLUniformProgram *current; /* its entry in programs, NULL if not looked up yet */
+    unsigned int count;
+    unsigned int capacity;
+    CGLUniformProgram *programs;
+} CGLUniforms;
+
+/* the caches sharing functions, see cgl_cache_glUseProgram */
+#define CGL_CACHE_BINDINGS  0x1u
+#define CGL_CACHE_UNIFORMS  0x2u
+
+/* everything the caches keep per dispatch table */
+typedef struct CGLCaches {
+    CGLDispatch next;           /* the functions replaced by the caches */
+    unsigned int enabled;       /* CGL_CACHE_* */
+    CGLShadowState state;
+    CGLBindings bindings;
+    CGLUniforms uniforms;
+    CGLCacheStats stats;
+} CGLCaches;
+
+static CGLCaches cgl_caches;
+
+static void cgl_free_uniforms(CGLUniforms *uniforms);
+
+
+#ifdef CGL_MULTI_CONTEXT
+
+struct CGLContext {
+    CGLDispatch dispatch;
+    CGLLimits limits;
+    CGLCaches caches;
+    CGLAppliedPipeline pipeline;
+    CGLAppliedVertexFormat vertex_format;
+    GLADloadproc loader;    /* for cglLoadGLLazy */
+    void *allocation;       /* the unaligned block returned by calloc */
+};
+
+CGL_THREAD_LOCAL CGLDispatch *cgl_current_dispatch = &cgl_dispatch;
+CGL_THREAD_LOCAL CGLLimits *cgl_current_limits = &cgl_limits;
+static CGL_THREAD_LOCAL CGLContext *cgl_current_context = nullptr;
+
+CGLContext *cglCreateContext(void) {
+    void *allocation = calloc(1, sizeof(CGLContext) + 63);
+    CGLContext *context;
+
+    if (allocation == nullptr)
+        return nullptr;
+    context = (CGLContext *) (((size_t) allocation + 63) & ~(size_t) 63);
+    context->allocation = allocation;
+    return context;
+}
+
+void cglDestroyContext(CGLContext *context) {
+    if (context == nullptr)
+        return;
+    cgl_free_uniforms(&context->caches.uniforms);
+    free(context->allocation);
+}
+
+void cglMakeCurrent(CGLContext *context) {
+    cgl_current_context = context;
+    cgl_current_dispatch = context != nullptr ? &context->dispatch : &cgl_dispatch;
+    cgl_current_limits = context != nullptr ? &context->limits : &cgl_limits;
+}
+
+CGLContext *cglGetCurrentContext(void) {
+    return cgl_current_context;
+}
+
+#endif /* CGL_MULTI_CONTEXT */
+
+
+void cglLoadGL(GLADloadproc loader) {
+    CGLDispatch *dispatch = CGL_CURRENT_DISPATCH;
+    unsigned int i;
+
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i)
+        dispatch->slot[i] = loader(cgl_symbol_pool + cgl_symbol_offset[i]);
+}
+
+
+
+const char *cglSymbolName(unsigned int slot) {
+    return slot < CGL_DISPATCH_COUNT ? cgl_symbol_pool + cgl_symbol_offset[slot] : nullptr;
+}
+
+
+
+/* built-in library loader.
+ * On ELF systems the symbols are looked up directly in the DT_GNU_HASH table of the library,
+ * with the hashes precomputed by cglgen.py, so there is no hashing at load time and no search
+ * through the global scope like dlsym does. Anything not found that way (not a GNU hash library,
+ * symbol provided by a dependency or as an IFUNC, ...) still goes through dlsym.
+ */
+#ifdef CGL_ELF_LOOKUP
+
+typedef struct CGLElfTables {
+    ElfW(Addr) base;
+    const Elf32_Word *gnu_hash;
+    const ElfW(Sym) *symtab;
+    const char *strtab;
+} CGLElfTables;
+
+/* glibc relocates the pointers of the dynamic section in place, others (musl) do not */
+static const void *cgl_elf_pointer(ElfW(Addr) base, ElfW(Addr) ptr) {
+    return (const void *) (ptr < base ? base + ptr : ptr);
+}
+
+static int cgl_elf_tables(void *library, CGLElfTables *tables) {
+    struct link_map *map = nullptr;
+    const ElfW(Dyn) *dyn;
+
+    if (dlinfo(library, RTLD_DI_LINKMAP, &map) != 0 || map == nullptr)
+        return 0;
+    memset(tables, 0, sizeof(*tables));
+    tables->base = map->l_addr;
+    for (dyn = map->l_ld; dyn->d_tag != DT_NULL; ++dyn) {
+        if (dyn->d_tag == DT_GNU_HASH)
+            tables->gnu_hash = (const Elf32_Word *) cgl_elf_pointer(map->l_addr, dyn->d_un.d_ptr);
+        else if (dyn->d_tag == DT_SYMTAB)
+            tables->symtab = (const ElfW(Sym) *) cgl_elf_pointer(map->l_addr, dyn->d_un.d_ptr);
+        else if (dyn->d_tag == DT_STRTAB)
+            tables->strtab = (const char *) cgl_elf_pointer(map->l_addr, dyn->d_un.d_ptr);
+    }
+    return tables->gnu_hash != nullptr && tables->symtab != nullptr && tables->strtab != nullptr;
+}
+
+static GLADproc cgl_elf_lookup(const CGLElfTables *tables, const char *name, Elf32_Word hash) {
+    const unsigned int bits = sizeof(ElfW(Addr)) * 8;
+    Elf32_Word nbuckets = tables->gnu_hash[0];
+    Elf32_Word symoffset = tables->gnu_hash[1];
+    Elf32_Word bloom_size = tables->gnu_hash[2];
+    Elf32_Word bloom_shift = tables->gnu_hash[3];
+    const ElfW(Addr) *bloom = (const ElfW(Addr) *) &tables->gnu_hash[4];
+    const Elf32_Word *buckets = (const Elf32_Word *) &bloom[bloom_size];
+    const Elf32_Word *chain = &buckets[nbuckets];
+    ElfW(Addr) word = bloom[(hash / bits) % bloom_size];
+    ElfW(Addr) mask = ((ElfW(Addr)) 1 << (hash % bits)) | ((ElfW(Addr)) 1 << ((hash >> bloom_shift) % bits));
+    Elf32_Word index;
+
+    if ((word & mask) != mask)
+        return nullptr;
+    index = buckets[hash % nbuckets];
+    if (index < symoffset)
+        return nullptr;
+    for (;;) {
+        const ElfW(Sym) *sym = &tables->symtab[index];
+        Elf32_Word chain_hash = chain[index - symoffset];
+
+        /* ELF64_ST_TYPE is the same as ELF32_ST_TYPE, IFUNCs are left to dlsym */
+        if ((chain_hash | 1) == (hash | 1) && sym->st_shndx != SHN_UNDEF
+                && ELF64_ST_TYPE(sym->st_info) == STT_FUNC && strcmp(tables->strtab + sym->st_name, name) == 0)
+            return (GLADproc) (tables->base + sym->st_value);
+        if (chain_hash & 1)
+            return nullptr;
+        ++index;
+    }
+}
+
+#endif /* CGL_ELF_LOOKUP */
+
+#if defined(_WIN32) || defined(__unix__) || defined(__APPLE__)
+
+static const char *const cgl_library_names[] = {
+#if defined(_WIN32)
+    "opengl32.dll",
+#elif defined(__APPLE__)
+    "/System/Library/Frameworks/OpenGL.framework/OpenGL",
+#else
+    "libGL.so.1", "libOpenGL.so.0", "libGLESv2.so.2", "libGL.so", "libOpenGL.so", "libGLESv2.so",
+#endif
+    nullptr
+};
+
+static GLADproc cgl_library_symbol(void *library, const char *name) {
+#if defined(_WIN32)
+    return (GLADproc) GetProcAddress((HMODULE) library, name);
+#else
+    /* ISO C forbids the cast of dlsym's data pointer to a function pointer, hence the union */
+    union { void *data; GLADproc proc; } symbol;
+
+    symbol.data = dlsym(library, name);
+    return symbol.proc;
+#endif
+}
+
+CGLLoadReport cglLoadGLFromLibrary(const char *path) {
+    CGLDispatch *dispatch = CGL_CURRENT_DISPATCH;
+    CGLLoadReport report;
+    void *library = nullptr;
+    unsigned int i;
+#if defined(_WIN32)
+    GLADproc (APIENTRY *wgl_get_proc_address)(const char *) = nullptr;
+#endif
+#ifdef CGL_ELF_LOOKUP
+    CGLElfTables tables;
+    int have_tables;
+#endif
+
+    memset(&report, 0, sizeof(report));
+    for (i = 0; library == nullptr && (path != nullptr ? i == 0 : cgl_library_names[i] != nullptr); ++i) {
+        const char *name = path != nullptr ? path : cgl_library_names[i];
+#if defined(_WIN32)
+        library = (void *) LoadLibraryA(name);
+#else
+        library = dlopen(name, RTLD_NOW | RTLD_LOCAL);
+#endif
+    }
+
+#if defined(_WIN32)
+    /* everything after GL 1.1 only comes through wglGetProcAddress */
+    if (library != nullptr)
+        *(FARPROC *) &wgl_get_proc_address = GetProcAddress((HMODULE) library, "wglGetProcAddress");
+#endif
+#ifdef CGL_ELF_LOOKUP
+    have_tables = library != nullptr && cgl_elf_tables(library, &tables);
+#endif
+
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i) {
+        const char *name = cgl_symbol_pool + cgl_symbol_offset[i];
+        GLADproc proc = nullptr;
+
+        if (library != nullptr) {
+#ifdef CGL_ELF_LOOKUP
+            if (have_tables)
+                proc = cgl_elf_lookup(&tables, name, (Elf32_Word) cgl_symbol_hash[i]);
+#endif
+            if (proc == nullptr)
+                proc = cgl_library_symbol(library, name);
+#if defined(_WIN32)
+            if (proc == nullptr && wgl_get_proc_address != nullptr)
+                proc = wgl_get_proc_address(name);
+#endif
+        }
+        dispatch->slot[i] = proc;
+        if (proc != nullptr)
+            ++report.loaded;
+        else
+            report.missing_mask[i / 32] |= 1UL << (i % 32);
+    }
+    report.missing = CGL_DISPATCH_COUNT - report.loaded;
+    return report;
+}
+
+#else
+
+CGLLoadReport cglLoadGLFromLibrary(const char *path) {
+    CGLLoadReport report;
+    unsigned int i;
+
+    (void) path;
+    memset(&report, 0, sizeof(report));
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i) {
+        CGL_CURRENT_DISPATCH->slot[i] = nullptr;
+        report.missing_mask[i / 32] |= 1UL << (i % 32);
+    }
+    report.missing = CGL_DISPATCH_COUNT;
+    return report;
+}
+
+#endif
+
+
+
+/* lazy binding: every slot starts out pointing at its stub in cgl_lazy_stubs.
+ * A stub resolves its own entry point on the first call, puts it into the slot
+ * (unless somebody else has replaced the stub in the meantime) and forwards the call.
+ * The loader belongs to the table, i.e. to the current CGLContext if there is one.
+ */
+static GLADloadproc cgl_lazy_loader = nullptr;
+
+static GLADproc cgl_lazy_bind(unsigned int slot, GLADproc stub) {
+    CGLDispatch *dispatch = CGL_CURRENT_DISPATCH;
+    GLADloadproc loader = cgl_lazy_loader;
+    GLADproc proc;
+
+#ifdef CGL_MULTI_CONTEXT
+    if (cgl_current_context != nullptr)
+        loader = cgl_current_context->loader;
+#endif
+    proc = loader(cgl_symbol_pool + cgl_symbol_offset[slot]);
+    if (dispatch->slot[slot] == stub)
+        dispatch->slot[slot] = proc;
+    return proc;
+}
+
+/* cglgen:begin lazy */
+static void APIENTRY cgl_lazy_glActiveTexture(GLenum texture) {
+    ((PFNGLACTIVETEXTUREPROC) cgl_lazy_bind(0, (GLADproc) cgl_lazy_glActiveTexture))(texture);
+}
+static void APIENTRY cgl_lazy_glAttachShader(GLuint program, GLuint shader) {
+    ((PFNGLATTACHSHADERPROC) cgl_lazy_bind(1, (GLADproc) cgl_lazy_glAttachShader))(program, shader);
+}
+static void APIENTRY cgl_lazy_glBindAttribLocation(GLuint program, GLuint index, const GLchar *name) {
+    ((PFNGLBINDATTRIBLOCATIONPROC) cgl_lazy_bind(2, (GLADproc) cgl_lazy_glBindAttribLocation))(program, index, name);
+}
+static void APIENTRY cgl_lazy_glBindBuffer(GLenum target, GLuint buffer) {
+    ((PFNGLBINDBUFFERPROC) cgl_lazy_bind(3, (GLADproc) cgl_lazy_glBindBuffer))(target, buffer);
+}
+static void APIENTRY cgl_lazy_glBindTexture(GLenum target, GLuint texture) {
+    ((PFNGLBINDTEXTUREPROC) cgl_lazy_bind(4, (GLADproc) cgl_lazy_glBindTexture))(target, texture);
+}
+static void APIENTRY cgl_lazy_glBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    ((PFNGLBLENDCOLORPROC) cgl_lazy_bind(5, (GLADproc) cgl_lazy_glBlendColor))(red, green, blue, alpha);
+}
+static void APIENTRY cgl_lazy_glBlendEquation(GLenum mode) {
+    ((PFNGLBLENDEQUATIONPROC) cgl_lazy_bind(6, (GLADproc) cgl_lazy_glBlendEquation))(mode);
+}
+static void APIENTRY cgl_lazy_glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+    ((PFNGLBLENDEQUATIONSEPARATEPROC) cgl_lazy_bind(7, (GLADproc) cgl_lazy_glBlendEquationSeparate))(modeRGB, modeAlpha);
+}
+static void APIENTRY cgl_lazy_glBlendFunc(GLenum sfactor, GLenum dfactor) {
+    ((PFNGLBLENDFUNCPROC) cgl_lazy_bind(8, (GLADproc) cgl_lazy_glBlendFunc))(sfactor, dfactor);
+}
+static void APIENTRY cgl_lazy_glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) {
+    ((PFNGLBLENDFUNCSEPARATEPROC) cgl_lazy_bind(9, (GLADproc) cgl_lazy_glBlendFuncSeparate))(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+}
+static void APIENTRY cgl_lazy_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    ((PFNGLBUFFERDATAPROC) cgl_lazy_bind(10, (GLADproc) cgl_lazy_glBufferData))(target, size, data, usage);
+}
+static void APIENTRY cgl_lazy_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    ((PFNGLBUFFERSUBDATAPROC) cgl_lazy_bind(11, (GLADproc) cgl_lazy_glBufferSubData))(target, offset, size, data);
+}
+static void APIENTRY cgl_lazy_glClear(GLbitfield mask) {
+    ((PFNGLCLEARPROC) cgl_lazy_bind(12, (GLADproc) cgl_lazy_glClear))(mask);
+}
+static void APIENTRY cgl_lazy_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    ((PFNGLCLEARCOLORPROC) cgl_lazy_bind(13, (GLADproc) cgl_lazy_glClearColor))(red, green, blue, alpha);
+}
+static void APIENTRY cgl_lazy_glClearDepth(GLdouble depth) {
+    ((PFNGLCLEARDEPTHPROC) cgl_lazy_bind(14, (GLADproc) cgl_lazy_glClearDepth))(depth);
+}
+static void APIENTRY cgl_lazy_glClearStencil(GLint s) {
+    ((PFNGLCLEARSTENCILPROC) cgl_lazy_bind(15, (GLADproc) cgl_lazy_glClearStencil))(s);
+}
+static void APIENTRY cgl_lazy_glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    ((PFNGLCOLORMASKPROC) cgl_lazy_bind(16, (GLADproc) cgl_lazy_glColorMask))(red, green, blue, alpha);
+}
+static void APIENTRY cgl_lazy_glCompileShader(GLuint shader) {
+    ((PFNGLCOMPILESHADERPROC) cgl_lazy_bind(17, (GLADproc) cgl_lazy_glCompileShader))(shader);
+}
+static void APIENTRY cgl_lazy_glCopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border) {
+    ((PFNGLCOPYTEXIMAGE2DPROC) cgl_lazy_bind(18, (GLADproc) cgl_lazy_glCopyTexImage2D))(target, level, internalformat, x, y, width, height, border);
+}
+static void APIENTRY cgl_lazy_glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height) {
+    ((PFNGLCOPYTEXSUBIMAGE2DPROC) cgl_lazy_bind(19, (GLADproc) cgl_lazy_glCopyTexSubImage2D))(target, level, xoffset, yoffset, x, y, width, height);
+}
+static GLuint APIENTRY cgl_lazy_glCreateProgram(void) {
+    return ((PFNGLCREATEPROGRAMPROC) cgl_lazy_bind(20, (GLADproc) cgl_lazy_glCreateProgram))();
+}
+static GLuint APIENTRY cgl_lazy_glCreateShader(GLenum type) {
+    return ((PFNGLCREATESHADERPROC) cgl_lazy_bind(21, (GLADproc) cgl_lazy_glCreateShader))(type);
+}
+static void APIENTRY cgl_lazy_glCullFace(GLenum mode) {
+    ((PFNGLCULLFACEPROC) cgl_lazy_bind(22, (GLADproc) cgl_lazy_glCullFace))(mode);
+}
+static void APIENTRY cgl_lazy_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
+    ((PFNGLDELETEBUFFERSPROC) cgl_lazy_bind(23, (GLADproc) cgl_lazy_glDeleteBuffers))(n, buffers);
+}
+static void APIENTRY cgl_lazy_glDeleteProgram(GLuint program) {
+    ((PFNGLDELETEPROGRAMPROC) cgl_lazy_bind(24, (GLADproc) cgl_lazy_glDeleteProgram))(program);
+}
+static void APIENTRY cgl_lazy_glDeleteShader(GLuint shader) {
+    ((PFNGLDELETESHADERPROC) cgl_lazy_bind(25, (GLADproc) cgl_lazy_glDeleteShader))(shader);
+}
+static void APIENTRY cgl_lazy_glDeleteTextures(GLsizei n, const GLuint *textures) {
+    ((PFNGLDELETETEXTURESPROC) cgl_lazy_bind(26, (GLADproc) cgl_lazy_glDeleteTextures))(n, textures);
+}
+static void APIENTRY cgl_lazy_glDepthFunc(GLenum func) {
+    ((PFNGLDEPTHFUNCPROC) cgl_lazy_bind(27, (GLADproc) cgl_lazy_glDepthFunc))(func);
+}
+static void APIENTRY cgl_lazy_glDepthMask(GLboolean flag) {
+    ((PFNGLDEPTHMASKPROC) cgl_lazy_bind(28, (GLADproc) cgl_lazy_glDepthMask))(flag);
+}
+static void APIENTRY cgl_lazy_glDepthRange(GLdouble n, GLdouble f) {
+    ((PFNGLDEPTHRANGEPROC) cgl_lazy_bind(29, (GLADproc) cgl_lazy_glDepthRange))(n, f);
+}
+static void APIENTRY cgl_lazy_glDetachShader(GLuint program, GLuint shader) {
+    ((PFNGLDETACHSHADERPROC) cgl_lazy_bind(30, (GLADproc) cgl_lazy_glDetachShader))(program, shader);
+}
+static void APIENTRY cgl_lazy_glEnable(GLenum cap) {
+    ((PFNGLENABLEPROC) cgl_lazy_bind(31, (GLADproc) cgl_lazy_glEnable))(cap);
+}
+static void APIENTRY cgl_lazy_glDisable(GLenum cap) {
+    ((PFNGLDISABLEPROC) cgl_lazy_bind(32, (GLADproc) cgl_lazy_glDisable))(cap);
+}
+static void APIENTRY cgl_lazy_glEnableVertexAttribArray(GLuint index) {
+    ((PFNGLENABLEVERTEXATTRIBARRAYPROC) cgl_lazy_bind(33, (GLADproc) cgl_lazy_glEnableVertexAttribArray))(index);
+}
+static void APIENTRY cgl_lazy_glDisableVertexAttribArray(GLuint index) {
+    ((PFNGLDISABLEVERTEXATTRIBARRAYPROC) cgl_lazy_bind(34, (GLADproc) cgl_lazy_glDisableVertexAttribArray))(index);
+}
+static void APIENTRY cgl_lazy_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    ((PFNGLDRAWARRAYSPROC) cgl_lazy_bind(35, (GLADproc) cgl_lazy_glDrawArrays))(mode, first, count);
+}
+static void APIENTRY cgl_lazy_glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) {
+    ((PFNGLDRAWELEMENTSPROC) cgl_lazy_bind(36, (GLADproc) cgl_lazy_glDrawElements))(mode, count, type, indices);
+}
+static void APIENTRY cgl_lazy_glFinish(void) {
+    ((PFNGLFINISHPROC) cgl_lazy_bind(37, (GLADproc) cgl_lazy_glFinish))();
+}
+static void APIENTRY cgl_lazy_glFlush(void) {
+    ((PFNGLFLUSHPROC) cgl_lazy_bind(38, (GLADproc) cgl_lazy_glFlush))();
+}
+static void APIENTRY cgl_lazy_glFrontFace(GLenum mode) {
+    ((PFNGLFRONTFACEPROC) cgl_lazy_bind(39, (GLADproc) cgl_lazy_glFrontFace))(mode);
+}
+static void APIENTRY cgl_lazy_glGenBuffers(GLsizei n, GLuint *buffers) {
+    ((PFNGLGENBUFFERSPROC) cgl_lazy_bind(40, (GLADproc) cgl_lazy_glGenBuffers))(n, buffers);
+}
+static void APIENTRY cgl_lazy_glGenTextures(GLsizei n, GLuint *textures) {
+    ((PFNGLGENTEXTURESPROC) cgl_lazy_bind(41, (GLADproc) cgl_lazy_glGenTextures))(n, textures);
+}
+static void APIENTRY cgl_lazy_glGetBooleanv(GLenum pname, GLboolean *data) {
+    ((PFNGLGETBOOLEANVPROC) cgl_lazy_bind(42, (GLADproc) cgl_lazy_glGetBooleanv))(pname, data);
+}
+static void APIENTRY cgl_lazy_glGetFloatv(GLenum pname, GLfloat *data) {
+    ((PFNGLGETFLOATVPROC) cgl_lazy_bind(43, (GLADproc) cgl_lazy_glGetFloatv))(pname, data);
+}
+static void APIENTRY cgl_lazy_glGetIntegerv(GLenum pname, GLint *data) {
+    ((PFNGLGETINTEGERVPROC) cgl_lazy_bind(44, (GLADproc) cgl_lazy_glGetIntegerv))(pname, data);
+}
+static void APIENTRY cgl_lazy_glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    ((PFNGLGETACTIVEATTRIBPROC) cgl_lazy_bind(45, (GLADproc) cgl_lazy_glGetActiveAttrib))(program, index, bufSize, length, size, type, name);
+}
+static void APIENTRY cgl_lazy_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    ((PFNGLGETACTIVEUNIFORMPROC) cgl_lazy_bind(46, (GLADproc) cgl_lazy_glGetActiveUniform))(program, index, bufSize, length, size, type, name);
+}
+static GLenum APIENTRY cgl_lazy_glGetError(void) {
+    return ((PFNGLGETERRORPROC) cgl_lazy_bind(47, (GLADproc) cgl_lazy_glGetError))();
+}
+static void APIENTRY cgl_lazy_glGetProgramiv(GLuint program, GLenum pname, GLint *params) {
+    ((PFNGLGETPROGRAMIVPROC) cgl_lazy_bind(48, (GLADproc) cgl_lazy_glGetProgramiv))(program, pname, params);
+}
+static GLint APIENTRY cgl_lazy_glGetUniformLocation(GLuint program, const GLchar *name) {
+    return ((PFNGLGETUNIFORMLOCATIONPROC) cgl_lazy_bind(49, (GLADproc) cgl_lazy_glGetUniformLocation))(program, name);
+}
+static void APIENTRY cgl_lazy_glLinkProgram(GLuint program) {
+    ((PFNGLLINKPROGRAMPROC) cgl_lazy_bind(50, (GLADproc) cgl_lazy_glLinkProgram))(program);
+}
+static void APIENTRY cgl_lazy_glPixelStorei(GLenum pname, GLint param) {
+    ((PFNGLPIXELSTOREIPROC) cgl_lazy_bind(51, (GLADproc) cgl_lazy_glPixelStorei))(pname, param);
+}
+static void APIENTRY cgl_lazy_glPolygonOffset(GLfloat factor, GLfloat units) {
+    ((PFNGLPOLYGONOFFSETPROC) cgl_lazy_bind(52, (GLADproc) cgl_lazy_glPolygonOffset))(factor, units);
+}
+static void APIENTRY cgl_lazy_glStencilFunc(GLenum func, GLint ref, GLuint mask) {
+    ((PFNGLSTENCILFUNCPROC) cgl_lazy_bind(53, (GLADproc) cgl_lazy_glStencilFunc))(func, ref, mask);
+}
+static void APIENTRY cgl_lazy_glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+    ((PFNGLSTENCILFUNCSEPARATEPROC) cgl_lazy_bind(54, (GLADproc) cgl_lazy_glStencilFuncSeparate))(face, func, ref, mask);
+}
+static void APIENTRY cgl_lazy_glStencilMask(GLuint mask) {
+    ((PFNGLSTENCILMASKPROC) cgl_lazy_bind(55, (GLADproc) cgl_lazy_glStencilMask))(mask);
+}
+static void APIENTRY cgl_lazy_glStencilMaskSeparate(GLenum face, GLuint mask) {
+    ((PFNGLSTENCILMASKSEPARATEPROC) cgl_lazy_bind(56, (GLADproc) cgl_lazy_glStencilMaskSeparate))(face, mask);
+}
+static void APIENTRY cgl_lazy_glStencilOp(GLenum sfail, GLenum dpfail, GLenum dppass) {
+    ((PFNGLSTENCILOPPROC) cgl_lazy_bind(57, (GLADproc) cgl_lazy_glStencilOp))(sfail, dpfail, dppass);
+}
+static void APIENTRY cgl_lazy_glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    ((PFNGLSTENCILOPSEPARATEPROC) cgl_lazy_bind(58, (GLADproc) cgl_lazy_glStencilOpSeparate))(face, sfail, dpfail, dppass);
+}
+static void APIENTRY cgl_lazy_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *data) {
+    ((PFNGLTEXIMAGE2DPROC) cgl_lazy_bind(59, (GLADproc) cgl_lazy_glTexImage2D))(target, level, internalformat, width, height, border, format, type, data);
+}
+static void APIENTRY cgl_lazy_glTexParameteri(GLenum target, GLenum pname, GLint param) {
+    ((PFNGLTEXPARAMETERIPROC) cgl_lazy_bind(60, (GLADproc) cgl_lazy_glTexParameteri))(target, pname, param);
+}
+static void APIENTRY cgl_lazy_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *data) {
+    ((PFNGLTEXSUBIMAGE2DPROC) cgl_lazy_bind(61, (GLADproc) cgl_lazy_glTexSubImage2D))(target, level, xoffset, yoffset, width, height, format, type, data);
+}
+static void APIENTRY cgl_lazy_glUniform1f(GLint location, GLfloat v0) {
+    ((PFNGLUNIFORM1FPROC) cgl_lazy_bind(62, (GLADproc) cgl_lazy_glUniform1f))(location, v0);
+}
+static void APIENTRY cgl_lazy_glUniform2f(GLint location, GLfloat v0, GLfloat v1) {
+    ((PFNGLUNIFORM2FPROC) cgl_lazy_bind(63, (GLADproc) cgl_lazy_glUniform2f))(location, v0, v1);
+}
+static void APIENTRY cgl_lazy_glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    ((PFNGLUNIFORM3FPROC) cgl_lazy_bind(64, (GLADproc) cgl_lazy_glUniform3f))(location, v0, v1, v2);
+}
+static void APIENTRY cgl_lazy_glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    ((PFNGLUNIFORM4FPROC) cgl_lazy_bind(65, (GLADproc) cgl_lazy_glUniform4f))(location, v0, v1, v2, v3);
+}
+static void APIENTRY cgl_lazy_glUniform1i(GLint location, GLint v0) {
+    ((PFNGLUNIFORM1IPROC) cgl_lazy_bind(66, (GLADproc) cgl_lazy_glUniform1i))(location, v0);
+}
+static void APIENTRY cgl_lazy_glUniform2i(GLint location, GLint v0, GLint v1) {
+    ((PFNGLUNIFORM2IPROC) cgl_lazy_bind(67, (GLADproc) cgl_lazy_glUniform2i))(location, v0, v1);
+}
+static void APIENTRY cgl_lazy_glUniform3i(GLint location, GLint v0, GLint v1, GLint v2) {
+    ((PFNGLUNIFORM3IPROC) cgl_lazy_bind(68, (GLADproc) cgl_lazy_glUniform3i))(location, v0, v1, v2);
+}
+static void APIENTRY cgl_lazy_glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+    ((PFNGLUNIFORM4IPROC) cgl_lazy_bind(69, (GLADproc) cgl_lazy_glUniform4i))(location, v0, v1, v2, v3);
+}
+static void APIENTRY cgl_lazy_glUniform1fv(GLint location, GLsizei count, const GLfloat *value) {
+    ((PFNGLUNIFORM1FVPROC) cgl_lazy_bind(70, (GLADproc) cgl_lazy_glUniform1fv))(location, count, value);
+}
+static void APIENTRY cgl_lazy_glUniform2fv(GLint location, GLsizei count, const GLfloat *value) {
+    ((PFNGLUNIFORM2FVPROC) cgl_lazy_bind(71, (GLADproc) cgl_lazy_glUniform2fv))(location, count, value);
+}
+static void APIENTRY cgl_lazy_glUniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+    ((PFNGLUNIFORM3FVPROC) cgl_lazy_bind(72, (GLADproc) cgl_lazy_glUniform3fv))(location, count, value);
+}
+static void APIENTRY cgl_lazy_glUniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+    ((PFNGLUNIFORM4FVPROC) cgl_lazy_bind(73, (GLADproc) cgl_lazy_glUniform4fv))(location, count, value);
+}
+static void APIENTRY cgl_lazy_glUniform1iv(GLint location, GLsizei count, const GLint *value) {
+    ((PFNGLUNIFORM1IVPROC) cgl_lazy_bind(74, (GLADproc) cgl_lazy_glUniform1iv))(location, count, value);
+}
+static void APIENTRY cgl_lazy_glUniform2iv(GLint location, GLsizei count, const GLint *value) {
+    ((PFNGLUNIFORM2IVPROC) cgl_lazy_bind(75, (GLADproc) cgl_lazy_glUniform2iv))(location, count, value);
+}
+static void APIENTRY cgl_lazy_glUniform3iv(GLint location, GLsizei count, const GLint *value) {
+    ((PFNGLUNIFORM3IVPROC) cgl_lazy_bind(76, (GLADproc) cgl_lazy_glUniform3iv))(location, count, value);
+}
+static void APIENTRY cgl_lazy_glUniform4iv(GLint location, GLsizei count, const GLint *value) {
+    ((PFNGLUNIFORM4IVPROC) cgl_lazy_bind(77, (GLADproc) cgl_lazy_glUniform4iv))(location, count, value);
+}
+static void APIENTRY cgl_lazy_glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    ((PFNGLUNIFORMMATRIX2FVPROC) cgl_lazy_bind(78, (GLADproc) cgl_lazy_glUniformMatrix2fv))(location, count, transpose, value);
+}
+static void APIENTRY cgl_lazy_glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    ((PFNGLUNIFORMMATRIX3FVPROC) cgl_lazy_bind(79, (GLADproc) cgl_lazy_glUniformMatrix3fv))(location, count, transpose, value);
+}
+static void APIENTRY cgl_lazy_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    ((PFNGLUNIFORMMATRIX4FVPROC) cgl_lazy_bind(80, (GLADproc) cgl_lazy_glUniformMatrix4fv))(location, count, transpose, value);
+}
+static void APIENTRY cgl_lazy_glUseProgram(GLuint program) {
+    ((PFNGLUSEPROGRAMPROC) cgl_lazy_bind(81, (GLADproc) cgl_lazy_glUseProgram))(program);
+}
+static void APIENTRY cgl_lazy_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+    ((PFNGLVERTEXATTRIBPOINTERPROC) cgl_lazy_bind(82, (GLADproc) cgl_lazy_glVertexAttribPointer))(index, size, type, normalized, stride, pointer);
+}
+
+static const CGLDispatch cgl_lazy_stubs = {{
+    cgl_lazy_glActiveTexture,
+    cgl_lazy_glAttachShader,
+    cgl_lazy_glBindAttribLocation,
+    cgl_lazy_glBindBuffer,
+    cgl_lazy_glBindTexture,
+    cgl_lazy_glBlendColor,
+    cgl_lazy_glBlendEquation,
+    cgl_lazy_glBlendEquationSeparate,
+    cgl_lazy_glBlendFunc,
+    cgl_lazy_glBlendFuncSeparate,
+    cgl_lazy_glBufferData,
+    cgl_lazy_glBufferSubData,
+    cgl_lazy_glClear,
+    cgl_lazy_glClearColor,
+    cgl_lazy_glClearDepth,
+    cgl_lazy_glClearStencil,
+    cgl_lazy_glColorMask,
+    cgl_lazy_glCompileShader,
+    cgl_lazy_glCopyTexImage2D,
+    cgl_lazy_glCopyTexSubImage2D,
+    cgl_lazy_glCreateProgram,
+    cgl_lazy_glCreateShader,
+    cgl_lazy_glCullFace,
+    cgl_lazy_glDeleteBuffers,
+    cgl_lazy_glDeleteProgram,
+    cgl_lazy_glDeleteShader,
+    cgl_lazy_glDeleteTextures,
+    cgl_lazy_glDepthFunc,
+    cgl_lazy_glDepthMask,
+    cgl_lazy_glDepthRange,
+    cgl_lazy_glDetachShader,
+    cgl_lazy_glEnable,
+    cgl_lazy_glDisable,
+    cgl_lazy_glEnableVertexAttribArray,
+    cgl_lazy_glDisableVertexAttribArray,
+    cgl_lazy_glDrawArrays,
+    cgl_lazy_glDrawElements,
+    cgl_lazy_glFinish,
+    cgl_lazy_glFlush,
+    cgl_lazy_glFrontFace,
+    cgl_lazy_glGenBuffers,
+    cgl_lazy_glGenTextures,
+    cgl_lazy_glGetBooleanv,
+    cgl_lazy_glGetFloatv,
+    cgl_lazy_glGetIntegerv,
+    cgl_lazy_glGetActiveAttrib,
+    cgl_lazy_glGetActiveUniform,
+    cgl_lazy_glGetError,
+    cgl_lazy_glGetProgramiv,
+    cgl_lazy_glGetUniformLocation,
+    cgl_lazy_glLinkProgram,
+    cgl_lazy_glPixelStorei,
+    cgl_lazy_glPolygonOffset,
+    cgl_lazy_glStencilFunc,
+    cgl_lazy_glStencilFuncSeparate,
+    cgl_lazy_glStencilMask,
+    cgl_lazy_glStencilMaskSeparate,
+    cgl_lazy_glStencilOp,
+    cgl_lazy_glStencilOpSeparate,
+    cgl_lazy_glTexImage2D,
+    cgl_lazy_glTexParameteri,
+    cgl_lazy_glTexSubImage2D,
+    cgl_lazy_glUniform1f,
+    cgl_lazy_glUniform2f,
+    cgl_lazy_glUniform3f,
+    cgl_lazy_glUniform4f,
+    cgl_lazy_glUniform1i,
+    cgl_lazy_glUniform2i,
+    cgl_lazy_glUniform3i,
+    cgl_lazy_glUniform4i,
+    cgl_lazy_glUniform1fv,
+    cgl_lazy_glUniform2fv,
+    cgl_lazy_glUniform3fv,
+    cgl_lazy_glUniform4fv,
+    cgl_lazy_glUniform1iv,
+    cgl_lazy_glUniform2iv,
+    cgl_lazy_glUniform3iv,
+    cgl_lazy_glUniform4iv,
+    cgl_lazy_glUniformMatrix2fv,
+    cgl_lazy_glUniformMatrix3fv,
+    cgl_lazy_glUniformMatrix4fv,
+    cgl_lazy_glUseProgram,
+    cgl_lazy_glVertexAttribPointer
+}};
+/* cglgen:end lazy */
+
+void cglLoadGLLazy(GLADloadproc loader) {
+#ifdef CGL_MULTI_CONTEXT
+    if (cgl_current_context != nullptr)
+        cgl_current_context->loader = loader;
+    else
+#endif
+    cgl_lazy_loader = loader;
+    *CGL_CURRENT_DISPATCH = cgl_lazy_stubs;
+}
+
+void cglResolveLazy(CGLDispatch *table) {
+    GLADloadproc loader = cgl_lazy_loader;
+    unsigned int i;
+
+#ifdef CGL_MULTI_CONTEXT
+    if (cgl_current_context != nullptr)
+        loader = cgl_current_context->loader;
+#endif
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i)
+        if (table->slot[i] == cgl_lazy_stubs.slot[i])
+            table->slot[i] = loader(cgl_symbol_pool + cgl_symbol_offset[i]);
+}
+
+
+
+/* caches: a cache replaces some slots of the dispatch table by its own functions,
+ * which call the previous ones through CGLCaches::next when they don't filter the call.
+ * Lazy stubs are bound before, as they would otherwise be called (and resolve again) each time.
+ */
+typedef struct CGLCacheEntry {
+    unsigned short slot;
+    GLADproc proc;
+} CGLCacheEntry;
+
+static CGLCaches *cgl_current_caches(void) {
+#ifdef CGL_MULTI_CONTEXT
+    if (cgl_current_context != nullptr)
+        return &cgl_current_context->caches;
+#endif
+    return &cgl_caches;
+}
+
+static void cgl_install_cache(const CGLCacheEntry *entries, size_t count) {
+    CGLDispatch *dispatch = CGL_CURRENT_DISPATCH;
+    CGLCaches *caches = cgl_current_caches();
+    size_t i;
+
+    for (i = 0; i < count; ++i) {
+        unsigned int slot = entries[i].slot;
+
+        if (dispatch->slot[slot] == entries[i].proc)
+            continue;
+        if (dispatch->slot[slot] == cgl_lazy_stubs.slot[slot])
+            cgl_lazy_bind(slot, cgl_lazy_stubs.slot[slot]);
+        caches->next.slot[slot] = dispatch->slot[slot];
+        dispatch->slot[slot] = entries[i].proc;
+    }
+}
+
+static void cgl_remove_cache(const CGLCacheEntry *entries, size_t count) {
+    CGLDispatch *dispatch = CGL_CURRENT_DISPATCH;
+    CGLCaches *caches = cgl_current_caches();
+    size_t i;
+
+    for (i = 0; i < count; ++i)
+        if (dispatch->slot[entries[i].slot] == entries[i].proc)
+            dispatch->slot[entries[i].slot] = caches->next.slot[entries[i].slot];
+}
+
+/* counts the call, and either filters it or takes value as the new state */
+static int cgl_filter(CGLCaches *caches, size_t slot, unsigned int known, void *state, const void *value, size_t size) {
+    ++caches->stats.calls[slot];
+    if ((caches->state.known & known) != 0 && memcmp(state, value, size) == 0) {
+        ++caches->stats.filtered[slot];
+        return 1;
+    }
+    memcpy(state, value, size);
+    caches->state.known |= known;
+    return 0;
+}
+
+static unsigned int cgl_cap_bit(GLenum cap) {
+    switch (cap) {
+        case GL_BLEND:                      return CGL_CAP_BLEND;
+        case GL_CULL_FACE:                  return CGL_CAP_CULL_FACE;
+        case GL_DEPTH_TEST:                 return CGL_CAP_DEPTH_TEST;
+        case GL_DITHER:                     return CGL_CAP_DITHER;
+        case GL_POLYGON_OFFSET_FILL:        return CGL_CAP_POLYGON_OFFSET_FILL;
+        case GL_SAMPLE_ALPHA_TO_COVERAGE:   return CGL_CAP_SAMPLE_ALPHA_TO_COVERAGE;
+        case GL_SAMPLE_COVERAGE:            return CGL_CAP_SAMPLE_COVERAGE;
+        case GL_SCISSOR_TEST:               return CGL_CAP_SCISSOR_TEST;
+        case GL_STENCIL_TEST:               return CGL_CAP_STENCIL_TEST;
+        default:                            return 0;
+    }
+}
+
+static int cgl_filter_cap(CGLCaches *caches, size_t slot, GLenum cap, int enable) {
+    unsigned int bit = cgl_cap_bit(cap);
+
+    ++caches->stats.calls[slot];
+    if ((caches->state.known_caps & bit) != 0 && ((caches->state.caps & bit) != 0) == enable) {
+        ++caches->stats.filtered[slot];
+        return 1;
+    }
+    caches->state.known_caps |= bit;
+    caches->state.caps = enable ? caches->state.caps | bit : caches->state.caps & ~bit;
+    return 0;
+}
+
+static GLfloat cgl_clampf(GLfloat value) {
+    return value < 0.0f ? 0.0f : value > 1.0f ? 1.0f : value;
+}
+
+static void APIENTRY cgl_cache_glEnable(GLenum cap) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_cap(caches, CGL_SLOT(Enable), cap, 1))
+        caches->next.fn.Enable(cap);
+}
+
+static void APIENTRY cgl_cache_glDisable(GLenum cap) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_cap(caches, CGL_SLOT(Disable), cap, 0))
+        caches->next.fn.Disable(cap);
+}
+
+static void APIENTRY cgl_cache_glBlendFunc(GLenum sfactor, GLenum dfactor) {
+    CGLCaches *caches = cgl_current_caches();
+    GLenum value[4];
+
+    value[0] = value[2] = sfactor;
+    value[1] = value[3] = dfactor;
+    if (!cgl_filter(caches, CGL_SLOT(BlendFunc), CGL_KNOWN_BLEND_FUNC, caches->state.blend_func, value, sizeof(value)))
+        caches->next.fn.BlendFunc(sfactor, dfactor);
+}
+
+static void APIENTRY cgl_cache_glBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    CGLCaches *caches = cgl_current_caches();
+    GLenum value[4];
+
+    value[0] = srcRGB;
+    value[1] = dstRGB;
+    value[2] = srcAlpha;
+    value[3] = dstAlpha;
+    if (!cgl_filter(caches, CGL_SLOT(BlendFuncSeparate), CGL_KNOWN_BLEND_FUNC, caches->state.blend_func, value, sizeof(value)))
+        caches->next.fn.BlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+}
+
+static void APIENTRY cgl_cache_glBlendEquation(GLenum mode) {
+    CGLCaches *caches = cgl_current_caches();
+    GLenum value[2];
+
+    value[0] = value[1] = mode;
+    if (!cgl_filter(caches, CGL_SLOT(BlendEquation), CGL_KNOWN_BLEND_EQUATION, caches->state.blend_equation, value, sizeof(value)))
+        caches->next.fn.BlendEquation(mode);
+}
+
+static void APIENTRY cgl_cache_glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+    CGLCaches *caches = cgl_current_caches();
+    GLenum value[2];
+
+    value[0] = modeRGB;
+    value[1] = modeAlpha;
+    if (!cgl_filter(caches, CGL_SLOT(BlendEquationSeparate), CGL_KNOWN_BLEND_EQUATION, caches->state.blend_equation, value, sizeof(value)))
+        caches->next.fn.BlendEquationSeparate(modeRGB, modeAlpha);
+}
+
+/* GL stores the blend color and depth range clamped to [0, 1], so values outside of it are compared the same way */
+static void APIENTRY cgl_cache_glBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    CGLCaches *caches = cgl_current_caches();
+    GLfloat value[4];
+
+    value[0] = cgl_clampf(red);
+    value[1] = cgl_clampf(green);
+    value[2] = cgl_clampf(blue);
+    value[3] = cgl_clampf(alpha);
+    if (!cgl_filter(caches, CGL_SLOT(BlendColor), CGL_KNOWN_BLEND_COLOR, caches->state.blend_color, value, sizeof(value)))
+        caches->next.fn.BlendColor(red, green, blue, alpha);
+}
+
+static void APIENTRY cgl_cache_glDepthFunc(GLenum func) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter(caches, CGL_SLOT(DepthFunc), CGL_KNOWN_DEPTH_FUNC, &caches->state.depth_func, &func, sizeof(func)))
+        caches->next.fn.DepthFunc(func);
+}
+
+static void APIENTRY cgl_cache_glDepthMask(GLboolean flag) {
+    CGLCaches *caches = cgl_current_caches();
+    GLboolean value = flag != GL_FALSE;
+
+    if (!cgl_filter(caches, CGL_SLOT(DepthMask), CGL_KNOWN_DEPTH_MASK, &caches->state.depth_mask, &value, sizeof(value)))
+        caches->next.fn.DepthMask(flag);
+}
+
+static void APIENTRY cgl_cache_glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    CGLCaches *caches = cgl_current_caches();
+    GLboolean value[4];
+
+    value[0] = red != GL_FALSE;
+    value[1] = green != GL_FALSE;
+    value[2] = blue != GL_FALSE;
+    value[3] = alpha != GL_FALSE;
+    if (!cgl_filter(caches, CGL_SLOT(ColorMask), CGL_KNOWN_COLOR_MASK, caches->state.color_mask, value, sizeof(value)))
+        caches->next.fn.ColorMask(red, green, blue, alpha);
+}
+
+static void APIENTRY cgl_cache_glCullFace(GLenum mode) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter(caches, CGL_SLOT(CullFace), CGL_KNOWN_CULL_FACE, &caches->state.cull_face, &mode, sizeof(mode)))
+        caches->next.fn.CullFace(mode);
+}
+
+static void APIENTRY cgl_cache_glFrontFace(GLenum mode) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter(caches, CGL_SLOT(FrontFace), CGL_KNOWN_FRONT_FACE, &caches->state.front_face, &mode, sizeof(mode)))
+        caches->next.fn.FrontFace(mode);
+}
+
+static void APIENTRY cgl_cache_glDepthRange(GLdouble n, GLdouble f) {
+    CGLCaches *caches = cgl_current_caches();
+    GLdouble value[2];
+
+    value[0] = n < 0.0 ? 0.0 : n > 1.0 ? 1.0 : n;
+    value[1] = f < 0.0 ? 0.0 : f > 1.0 ? 1.0 : f;
+    if (!cgl_filter(caches, CGL_SLOT(DepthRange), CGL_KNOWN_DEPTH_RANGE, caches->state.depth_range, value, sizeof(value)))
+        caches->next.fn.DepthRange(n, f);
+}
+
+static const CGLCacheEntry cgl_state_cache_entries[] = {
+    { CGL_SLOT(Enable),                 (GLADproc) cgl_cache_glEnable },
+    { CGL_SLOT(Disable),                (GLADproc) cgl_cache_glDisable },
+    { CGL_SLOT(BlendFunc),              (GLADproc) cgl_cache_glBlendFunc },
+    { CGL_SLOT(BlendFuncSeparate),      (GLADproc) cgl_cache_glBlendFuncSeparate },
+    { CGL_SLOT(BlendEquation),          (GLADproc) cgl_cache_glBlendEquation },
+    { CGL_SLOT(BlendEquationSeparate),  (GLADproc) cgl_cache_glBlendEquationSeparate },
+    { CGL_SLOT(BlendColor),             (GLADproc) cgl_cache_glBlendColor },
+    { CGL_SLOT(DepthFunc),              (GLADproc) cgl_cache_glDepthFunc },
+    { CGL_SLOT(DepthMask),              (GLADproc) cgl_cache_glDepthMask },
+    { CGL_SLOT(ColorMask),              (GLADproc) cgl_cache_glColorMask },
+    { CGL_SLOT(CullFace),               (GLADproc) cgl_cache_glCullFace },
+    { CGL_SLOT(FrontFace),              (GLADproc) cgl_cache_glFrontFace },
+    { CGL_SLOT(DepthRange),             (GLADproc) cgl_cache_glDepthRange }
+};
+
+void cglEnableStateCache(void) {
+    CGLShadowState *state = &cgl_current_caches()->state;
+
+    if (CGL_CURRENT_DISPATCH->fn.Enable == cgl_cache_glEnable)
+        return;
+    cgl_install_cache(cgl_state_cache_entries, sizeof(cgl_state_cache_entries) / sizeof(cgl_state_cache_entries[0]));
+
+    /* the initial values, see the reference pages */
+    state->known = CGL_KNOWN_STATE;
+    state->known_caps = CGL_CAP_ALL;
+    state->caps = CGL_CAP_DITHER;
+    state->blend_func[0] = state->blend_func[2] = GL_ONE;
+    state->blend_func[1] = state->blend_func[3] = GL_ZERO;
+    state->blend_equation[0] = state->blend_equation[1] = GL_FUNC_ADD;
+    state->blend_color[0] = state->blend_color[1] = state->blend_color[2] = state->blend_color[3] = 0.0f;
+    state->depth_func = GL_LESS;
+    state->depth_mask = GL_TRUE;
+    state->color_mask[0] = state->color_mask[1] = state->color_mask[2] = state->color_mask[3] = GL_TRUE;
+    state->cull_face = GL_BACK;
+    state->front_face = GL_CCW;
+    state->depth_range[0] = 0.0;
+    state->depth_range[1] = 1.0;
+}
+
+void cglDisableStateCache(void) {
+    cgl_remove_cache(cgl_state_cache_entries, sizeof(cgl_state_cache_entries) / sizeof(cgl_state_cache_entries[0]));
+}
+
+
+static int cgl_filter_name(CGLCaches *caches, size_t slot, GLuint *binding, GLuint name) {
+    ++caches->stats.calls[slot];
+    if (*binding == name) {
+        ++caches->stats.filtered[slot];
+        return 1;
+    }
+    *binding = name;
+    return 0;
+}
+
+static GLuint *cgl_buffer_binding(CGLBindings *bindings, GLenum target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER:           return &bindings->array_buffer;
+        case GL_ELEMENT_ARRAY_BUFFER:   return &bindings->element_array_buffer;
+        default:                        return nullptr;
+    }
+}
+
+/* the binding of target on the active unit, NULL if not cached */
+static GLuint *cgl_texture_binding(CGLBindings *bindings, GLenum target) {
+    unsigned int unit = bindings->active_texture - GL_TEXTURE0;
+
+    if (unit >= CGL_CACHED_TEXTURE_UNITS)
+        return nullptr;
+    switch (target) {
+        case GL_TEXTURE_2D:         return &bindings->textures[unit][0];
+        case GL_TEXTURE_CUBE_MAP:   return &bindings->textures[unit][1];
+        default:                    return nullptr;
+    }
+}
+
+static void APIENTRY cgl_cache_glBindBuffer(GLenum target, GLuint buffer) {
+    CGLCaches *caches = cgl_current_caches();
+    GLuint *binding = cgl_buffer_binding(&caches->bindings, target);
+
+    if (binding == nullptr)
+        ++caches->stats.calls[CGL_SLOT(BindBuffer)];
+    else if (cgl_filter_name(caches, CGL_SLOT(BindBuffer), binding, buffer))
+        return;
+    caches->next.fn.BindBuffer(target, buffer);
+}
+
+static void APIENTRY cgl_cache_glActiveTexture(GLenum texture) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_name(caches, CGL_SLOT(ActiveTexture), &caches->bindings.active_texture, texture))
+        caches->next.fn.ActiveTexture(texture);
+}
+
+static void APIENTRY cgl_cache_glBindTexture(GLenum target, GLuint texture) {
+    CGLCaches *caches = cgl_current_caches();
+    GLuint *binding = cgl_texture_binding(&caches->bindings, target);
+
+    if (binding == nullptr)
+        ++caches->stats.calls[CGL_SLOT(BindTexture)];
+    else if (cgl_filter_name(caches, CGL_SLOT(BindTexture), binding, texture))
+        return;
+    caches->next.fn.BindTexture(target, texture);
+}
+
+/* shared by the binding and the uniform cache, which needs to know the program in use */
+static void APIENTRY cgl_cache_glUseProgram(GLuint program) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (caches->uniforms.program != program) {
+        caches->uniforms.program = program;
+        caches->uniforms.current = nullptr;
+    }
+    if ((caches->enabled & CGL_CACHE_BINDINGS) == 0
+            || !cgl_filter_name(caches, CGL_SLOT(UseProgram), &caches->bindings.program, program))
+        caches->next.fn.UseProgram(program);
+}
+
+/* deleted buffers and textures are unbound from everywhere they were bound, 0 is ignored */
+static void APIENTRY cgl_cache_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
+    CGLCaches *caches = cgl_current_caches();
+    CGLBindings *bindings = &caches->bindings;
+    GLsizei i;
+
+    ++caches->stats.calls[CGL_SLOT(DeleteBuffers)];
+    for (i = 0; i < n; ++i) {
+        if (buffers[i] == 0)
+            continue;
+        if (bindings->array_buffer == buffers[i])
+            bindings->array_buffer = 0;
+        if (bindings->element_array_buffer == buffers[i])
+            bindings->element_array_buffer = 0;
+    }
+    caches->next.fn.DeleteBuffers(n, buffers);
+}
+
+static void APIENTRY cgl_cache_glDeleteTextures(GLsizei n, const GLuint *textures) {
+    CGLCaches *caches = cgl_current_caches();
+    GLuint *binding = &caches->bindings.textures[0][0];
+    GLsizei i;
+    unsigned int j;
+
+    ++caches->stats.calls[CGL_SLOT(DeleteTextures)];
+    for (i = 0; i < n; ++i)
+        if (textures[i] != 0)
+            for (j = 0; j < CGL_CACHED_TEXTURE_UNITS * 2; ++j)
+                if (binding[j] == textures[i])
+                    binding[j] = 0;
+    caches->next.fn.DeleteTextures(n, textures);
+}
+
+static const CGLCacheEntry cgl_binding_cache_entries[] = {
+    { CGL_SLOT(BindBuffer),     (GLADproc) cgl_cache_glBindBuffer },
+    { CGL_SLOT(ActiveTexture),  (GLADproc) cgl_cache_glActiveTexture },
+    { CGL_SLOT(BindTexture),    (GLADproc) cgl_cache_glBindTexture },
+    { CGL_SLOT(UseProgram),     (GLADproc) cgl_cache_glUseProgram },
+    { CGL_SLOT(DeleteBuffers),  (GLADproc) cgl_cache_glDeleteBuffers },
+    { CGL_SLOT(DeleteTextures), (GLADproc) cgl_cache_glDeleteTextures }
+};
+
+void cglEnableBindingCache(void) {
+    CGLCaches *caches = cgl_current_caches();
+    CGLBindings *bindings = &caches->bindings;
+
+    if (CGL_CURRENT_DISPATCH->fn.BindBuffer == cgl_cache_glBindBuffer)
+        return;
+    cgl_install_cache(cgl_binding_cache_entries, sizeof(cgl_binding_cache_entries) / sizeof(cgl_binding_cache_entries[0]));
+    caches->enabled |= CGL_CACHE_BINDINGS;
+
+    /* nothing bound in a new context */
+    memset(bindings, 0, sizeof(CGLBindings));
+    bindings->active_texture = GL_TEXTURE0;
+}
+
+static void cgl_install_uniform_cache(void);
+
+void cglDisableBindingCache(void) {
+    CGLCaches *caches = cgl_current_caches();
+
+    cgl_remove_cache(cgl_binding_cache_entries, sizeof(cgl_binding_cache_entries) / sizeof(cgl_binding_cache_entries[0]));
+    caches->enabled &= ~CGL_CACHE_BINDINGS;
+    if (caches->enabled & CGL_CACHE_UNIFORMS)
+        cgl_install_uniform_cache();    /* glUseProgram is still needed */
+}
+
+
+/* the uniform cache */
+
+static unsigned int cgl_hash_location(GLint location) {
+    return (unsigned int) ((((unsigned long) location * 2654435761UL) & 0xffffffffUL) >> 8);
+}
+
+/* frees the names and values of a program, for when they are no longer valid */
+static void cgl_reset_uniform_program(CGLUniformProgram *entry) {
+    unsigned int i;
+
+    for (i = 0; i < entry->name_capacity; ++i)
+        free(entry->names[i].name);
+    free(entry->names);
+    free(entry->values);
+    entry->names = nullptr;
+    entry->values = nullptr;
+    entry->name_count = entry->name_capacity = 0;
+    entry->value_count = entry->value_capacity = 0;
+}
+
+static void cgl_free_uniforms(CGLUniforms *uniforms) {
+    unsigned int i;
+
+    for (i = 0; i < uniforms->capacity; ++i)
+        cgl_reset_uniform_program(&uniforms->programs[i]);
+    free(uniforms->programs);
+    uniforms->programs = nullptr;
+    uniforms->current = nullptr;
+    uniforms->count = uniforms->capacity = 0;
+}
+
+/* the entry of program, added if create is set and there is none yet; NULL if there is none or no memory */
+static CGLUniformProgram *cgl_uniform_program(CGLUniforms *uniforms, GLuint program, int create) {
+    unsigned int i;
+
+    if (program == 0 || program == CGL_UNKNOWN_NAME)
+        return nullptr;
+    if (create && (uniforms->count + 1) * 2 > uniforms->capacity) {
+        unsigned int capacity = uniforms->capacity > 0 ? uniforms->capacity * 2 : 16;
+        CGLUniformProgram *programs = (CGLUniformProgram *) calloc(capacity, sizeof(CGLUniformProgram));
+
+        if (programs == nullptr)
+            return nullptr;
+        for (i = 0; i < uniforms->capacity; ++i) {
+            unsigned int j = cgl_hash_location((GLint) uniforms->programs[i].program);
+
+            if (uniforms->programs[i].program == 0)
+                continue;
+            while (programs[j & (capacity - 1)].program != 0)
+                ++j;
+            programs[j & (capacity - 1)] = uniforms->programs[i];
+        }
+        free(uniforms->programs);
+        uniforms->programs = programs;
+        uniforms->capacity = capacity;
+        uniforms->current = nullptr;
+    }
+    if (uniforms->capacity == 0)
+        return nullptr;
+    for (i = cgl_hash_location((GLint) program); ; ++i) {
+        CGLUniformProgram *entry = &uniforms->programs[i & (uniforms->capacity - 1)];
+
+        if (entry->program == program)
+            return entry;
+        if (entry->program == 0) {
+            if (!create)
+                return nullptr;
+            entry->program = program;
+            ++uniforms->count;
+            return entry;
+        }
+    }
+}
+
+/* the entry of name, or the free entry where it belongs; NULL if there is no memory */
+static CGLUniformName *cgl_uniform_name(CGLUniformProgram *entry, const char *name, unsigned long hash) {
+    unsigned int i;
+
+    if ((entry->name_count + 1) * 2 > entry->name_capacity) {
+        unsigned int capacity = entry->name_capacity > 0 ? entry->name_capacity * 2 : 64;
+        CGLUniformName *names = (CGLUniformName *) calloc(capacity, sizeof(CGLUniformName));
+
+        if (names == nullptr)
+            return nullptr;
+        for (i = 0; i < entry->name_capacity; ++i) {
+            unsigned long j = entry->names[i].hash;
+
+            if (entry->names[i].name == nullptr)
+                continue;
+            while (names[j & (capacity - 1)].name != nullptr)
+                ++j;
+            names[j & (capacity - 1)] = entry->names[i];
+        }
+        free(entry->names);
+        entry->names = names;
+        entry->name_capacity = capacity;
+    }
+    for (i = (unsigned int) hash; ; ++i) {
+        CGLUniformName *slot = &entry->names[i & (entry->name_capacity - 1)];
+
+        if (slot->name == nullptr || (slot->hash == hash && strcmp(slot->name, name) == 0))
+            return slot;
+    }
+}
+
+/* the value at location, added if create is set; NULL if there is none or no memory */
+static CGLUniformValue *cgl_uniform_value(CGLUniformProgram *entry, GLint location, int create) {
+    unsigned int i;
+
+    if (create && (entry->value_count + 1) * 2 > entry->value_capacity) {
+        unsigned int capacity = entry->value_capacity > 0 ? entry->value_capacity * 2 : 64;
+        CGLUniformValue *values = (CGLUniformValue *) malloc(capacity * sizeof(CGLUniformValue));
+
+        if (values == nullptr)
+            return nullptr;
+        for (i = 0; i < capacity; ++i)
+            values[i].location = -1;
+        for (i = 0; i < entry->value_capacity; ++i) {
+            unsigned int j = cgl_hash_location(entry->values[i].location);
+
+            if (entry->values[i].location == -1)
+                continue;
+            while (values[j & (capacity - 1)].location != -1)
+                ++j;
+            values[j & (capacity - 1)] = entry->values[i];
+        }
+        free(entry->values);
+        entry->values = values;
+        entry->value_capacity = capacity;
+    }
+    if (entry->value_capacity == 0)
+        return nullptr;
+    for (i = cgl_hash_location(location); ; ++i) {
+        CGLUniformValue *value = &entry->values[i & (entry->value_capacity - 1)];
+
+        if (value->location == location)
+            return value;
+        if (value->location == -1) {
+            if (!create)
+                return nullptr;
+            value->location = location;
+            value->kind = 0;
+            ++entry->value_count;
+            return value;
+        }
+    }
+}
+
+/* counts the call, and either filters it or takes value as the new value at location of the program in use.
+ * Array elements are at consecutive locations in all implementations (and must be since GL 4.3),
+ * so a call with count != 1 makes the values of all locations it sets unknown, and is passed on.
+ */
+static int cgl_filter_uniform(CGLCaches *caches, size_t slot, GLint location, GLsizei count, unsigned int kind,
+                              const void *value, size_t size) {
+    CGLUniforms *uniforms = &caches->uniforms;
+    CGLUniformProgram *entry = uniforms->current;
+    CGLUniformValue *shadow;
+
+    ++caches->stats.calls[slot];
+    if (location == -1) {
+        ++caches->stats.filtered[slot];
+        return 1;
+    }
+    if (entry == nullptr)
+        entry = uniforms->current = cgl_uniform_program(uniforms, uniforms->program, 1);
+    if (entry == nullptr)
+        return 0;
+    if (count != 1) {
+        GLsizei i;
+
+        for (i = 0; i < count; ++i)
+            if ((shadow = cgl_uniform_value(entry, location + i, 0)) != nullptr)
+                shadow->kind = 0;
+        return 0;
+    }
+    shadow = cgl_uniform_value(entry, location, 1);
+    if (shadow == nullptr)
+        return 0;
+    if (shadow->kind == kind && memcmp(shadow->data, value, size) == 0) {
+        ++caches->stats.filtered[slot];
+        return 1;
+    }
+    shadow->kind = kind;
+    memcpy(shadow->data, value, size);
+    return 0;
+}
+
+/* linking gives new locations and sets all values to 0, deleting frees the name for another program */
+static void APIENTRY cgl_cache_glLinkProgram(GLuint program) {
+    CGLCaches *caches = cgl_current_caches();
+    CGLUniformProgram *entry = cgl_uniform_program(&caches->uniforms, program, 0);
+
+    ++caches->stats.calls[CGL_SLOT(LinkProgram)];
+    if (entry != nullptr)
+        cgl_reset_uniform_program(entry);
+    caches->next.fn.LinkProgram(program);
+}
+
+static void APIENTRY cgl_cache_glDeleteProgram(GLuint program) {
+    CGLCaches *caches = cgl_current_caches();
+    CGLUniformProgram *entry = cgl_uniform_program(&caches->uniforms, program, 0);
+
+    ++caches->stats.calls[CGL_SLOT(DeleteProgram)];
+    if (entry != nullptr)
+        cgl_reset_uniform_program(entry);
+    caches->next.fn.DeleteProgram(program);
+}
+
+static GLint APIENTRY cgl_cache_glGetUniformLocation(GLuint program, const GLchar *name) {
+    CGLCaches *caches = cgl_current_caches();
+    CGLUniformProgram *entry = cgl_uniform_program(&caches->uniforms, program, 1);
+    CGLUniformName *slot = nullptr;
+    unsigned long hash = 0;
+    GLint location;
+
+    ++caches->stats.calls[CGL_SLOT(GetUniformLocation)];
+    if (entry != nullptr && name != nullptr) {
+        hash = cgl_hash_string(name, 0);
+        slot = cgl_uniform_name(entry, name, hash);
+        if (slot != nullptr && slot->name != nullptr) {
+            ++caches->stats.filtered[CGL_SLOT(GetUniformLocation)];
+            return slot->location;
+        }
+    }
+    location = caches->next.fn.GetUniformLocation(program, name);
+    if (slot != nullptr) {
+        size_t length = strlen(name) + 1;
+
+        slot->name = (char *) malloc(length);
+        if (slot->name != nullptr) {
+            memcpy(slot->name, name, length);
+            slot->hash = hash;
+            slot->location = location;
+            ++entry->name_count;
+        }
+    }
+    return location;
+}
+
+static void APIENTRY cgl_cache_glUniform1f(GLint location, GLfloat v0) {
+    CGLCaches *caches = cgl_current_caches();
+    GLfloat value[1];
+
+    value[0] = v0;
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform1f), location, 1, CGL_UNIFORM_FLOAT | 1, value, sizeof(value)))
+        caches->next.fn.Uniform1f(location, v0);
+}
+
+static void APIENTRY cgl_cache_glUniform1i(GLint location, GLint v0) {
+    CGLCaches *caches = cgl_current_caches();
+    GLint value[1];
+
+    value[0] = v0;
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform1i), location, 1, CGL_UNIFORM_INT | 1, value, sizeof(value)))
+        caches->next.fn.Uniform1i(location, v0);
+}
+
+static void APIENTRY cgl_cache_glUniform2f(GLint location, GLfloat v0, GLfloat v1) {
+    CGLCaches *caches = cgl_current_caches();
+    GLfloat value[2];
+
+    value[0] = v0;
+    value[1] = v1;
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform2f), location, 1, CGL_UNIFORM_FLOAT | 2, value, sizeof(value)))
+        caches->next.fn.Uniform2f(location, v0, v1);
+}
+
+static void APIENTRY cgl_cache_glUniform2i(GLint location, GLint v0, GLint v1) {
+    CGLCaches *caches = cgl_current_caches();
+    GLint value[2];
+
+    value[0] = v0;
+    value[1] = v1;
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform2i), location, 1, CGL_UNIFORM_INT | 2, value, sizeof(value)))
+        caches->next.fn.Uniform2i(location, v0, v1);
+}
+
+static void APIENTRY cgl_cache_glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    CGLCaches *caches = cgl_current_caches();
+    GLfloat value[3];
+
+    value[0] = v0;
+    value[1] = v1;
+    value[2] = v2;
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform3f), location, 1, CGL_UNIFORM_FLOAT | 3, value, sizeof(value)))
+        caches->next.fn.Uniform3f(location, v0, v1, v2);
+}
+
+static void APIENTRY cgl_cache_glUniform3i(GLint location, GLint v0, GLint v1, GLint v2) {
+    CGLCaches *caches = cgl_current_caches();
+    GLint value[3];
+
+    value[0] = v0;
+    value[1] = v1;
+    value[2] = v2;
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform3i), location, 1, CGL_UNIFORM_INT | 3, value, sizeof(value)))
+        caches->next.fn.Uniform3i(location, v0, v1, v2);
+}
+
+static void APIENTRY cgl_cache_glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    CGLCaches *caches = cgl_current_caches();
+    GLfloat value[4];
+
+    value[0] = v0;
+    value[1] = v1;
+    value[2] = v2;
+    value[3] = v3;
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform4f), location, 1, CGL_UNIFORM_FLOAT | 4, value, sizeof(value)))
+        caches->next.fn.Uniform4f(location, v0, v1, v2, v3);
+}
+
+static void APIENTRY cgl_cache_glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+    CGLCaches *caches = cgl_current_caches();
+    GLint value[4];
+
+    value[0] = v0;
+    value[1] = v1;
+    value[2] = v2;
+    value[3] = v3;
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform4i), location, 1, CGL_UNIFORM_INT | 4, value, sizeof(value)))
+        caches->next.fn.Uniform4i(location, v0, v1, v2, v3);
+}
+
+static void APIENTRY cgl_cache_glUniform1fv(GLint location, GLsizei count, const GLfloat *value) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform1fv), location, count, CGL_UNIFORM_FLOAT | 1, value, 1 * sizeof(GLfloat)))
+        caches->next.fn.Uniform1fv(location, count, value);
+}
+
+static void APIENTRY cgl_cache_glUniform1iv(GLint location, GLsizei count, const GLint *value) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform1iv), location, count, CGL_UNIFORM_INT | 1, value, 1 * sizeof(GLint)))
+        caches->next.fn.Uniform1iv(location, count, value);
+}
+
+static void APIENTRY cgl_cache_glUniform2fv(GLint location, GLsizei count, const GLfloat *value) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform2fv), location, count, CGL_UNIFORM_FLOAT | 2, value, 2 * sizeof(GLfloat)))
+        caches->next.fn.Uniform2fv(location, count, value);
+}
+
+static void APIENTRY cgl_cache_glUniform2iv(GLint location, GLsizei count, const GLint *value) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform2iv), location, count, CGL_UNIFORM_INT | 2, value, 2 * sizeof(GLint)))
+        caches->next.fn.Uniform2iv(location, count, value);
+}
+
+static void APIENTRY cgl_cache_glUniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform3fv), location, count, CGL_UNIFORM_FLOAT | 3, value, 3 * sizeof(GLfloat)))
+        caches->next.fn.Uniform3fv(location, count, value);
+}
+
+static void APIENTRY cgl_cache_glUniform3iv(GLint location, GLsizei count, const GLint *value) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform3iv), location, count, CGL_UNIFORM_INT | 3, value, 3 * sizeof(GLint)))
+        caches->next.fn.Uniform3iv(location, count, value);
+}
+
+static void APIENTRY cgl_cache_glUniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform4fv), location, count, CGL_UNIFORM_FLOAT | 4, value, 4 * sizeof(GLfloat)))
+        caches->next.fn.Uniform4fv(location, count, value);
+}
+
+static void APIENTRY cgl_cache_glUniform4iv(GLint location, GLsizei count, const GLint *value) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(Uniform4iv), location, count, CGL_UNIFORM_INT | 4, value, 4 * sizeof(GLint)))
+        caches->next.fn.Uniform4iv(location, count, value);
+}
+
+static void APIENTRY cgl_cache_glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    CGLCaches *caches = cgl_current_caches();
+    unsigned int kind = (transpose != GL_FALSE ? CGL_UNIFORM_TRANSPOSED : CGL_UNIFORM_MATRIX) | 2;
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(UniformMatrix2fv), location, count, kind, value, 4 * sizeof(GLfloat)))
+        caches->next.fn.UniformMatrix2fv(location, count, transpose, value);
+}
+
+static void APIENTRY cgl_cache_glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    CGLCaches *caches = cgl_current_caches();
+    unsigned int kind = (transpose != GL_FALSE ? CGL_UNIFORM_TRANSPOSED : CGL_UNIFORM_MATRIX) | 3;
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(UniformMatrix3fv), location, count, kind, value, 9 * sizeof(GLfloat)))
+        caches->next.fn.UniformMatrix3fv(location, count, transpose, value);
+}
+
+static void APIENTRY cgl_cache_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    CGLCaches *caches = cgl_current_caches();
+    unsigned int kind = (transpose != GL_FALSE ? CGL_UNIFORM_TRANSPOSED : CGL_UNIFORM_MATRIX) | 4;
+
+    if (!cgl_filter_uniform(caches, CGL_SLOT(UniformMatrix4fv), location, count, kind, value, 16 * sizeof(GLfloat)))
+        caches->next.fn.UniformMatrix4fv(location, count, transpose, value);
+}
+
+static const CGLCacheEntry cgl_uniform_cache_entries[] = {
+    { CGL_SLOT(UseProgram),         (GLADproc) cgl_cache_glUseProgram },
+    { CGL_SLOT(LinkProgram),        (GLADproc) cgl_cache_glLinkProgram },
+    { CGL_SLOT(DeleteProgram),      (GLADproc) cgl_cache_glDeleteProgram },
+    { CGL_SLOT(GetUniformLocation), (GLADproc) cgl_cache_glGetUniformLocation },
+    { CGL_SLOT(Uniform1f),          (GLADproc) cgl_cache_glUniform1f },
+    { CGL_SLOT(Uniform1i),          (GLADproc) cgl_cache_glUniform1i },
+    { CGL_SLOT(Uniform2f),          (GLADproc) cgl_cache_glUniform2f },
+    { CGL_SLOT(Uniform2i),          (GLADproc) cgl_cache_glUniform2i },
+    { CGL_SLOT(Uniform3f),          (GLADproc) cgl_cache_glUniform3f },
+    { CGL_SLOT(Uniform3i),          (GLADproc) cgl_cache_glUniform3i },
+    { CGL_SLOT(Uniform4f),          (GLADproc) cgl_cache_glUniform4f },
+    { CGL_SLOT(Uniform4i),          (GLADproc) cgl_cache_glUniform4i },
+    { CGL_SLOT(Uniform1fv),         (GLADproc) cgl_cache_glUniform1fv },
+    { CGL_SLOT(Uniform1iv),         (GLADproc) cgl_cache_glUniform1iv },
+    { CGL_SLOT(Uniform2fv),         (GLADproc) cgl_cache_glUniform2fv },
+    { CGL_SLOT(Uniform2iv),         (GLADproc) cgl_cache_glUniform2iv },
+    { CGL_SLOT(Uniform3fv),         (GLADproc) cgl_cache_glUniform3fv },
+    { CGL_SLOT(Uniform3iv),         (GLADproc) cgl_cache_glUniform3iv },
+    { CGL_SLOT(Uniform4fv),         (GLADproc) cgl_cache_glUniform4fv },
+    { CGL_SLOT(Uniform4iv),         (GLADproc) cgl_cache_glUniform4iv },
+    { CGL_SLOT(UniformMatrix2fv),   (GLADproc) cgl_cache_glUniformMatrix2fv },
+    { CGL_SLOT(UniformMatrix3fv),   (GLADproc) cgl_cache_glUniformMatrix3fv },
+    { CGL_SLOT(UniformMatrix4fv),   (GLADproc) cgl_cache_glUniformMatrix4fv }
+};
+
+static void cgl_install_uniform_cache(void) {
+    cgl_install_cache(cgl_uniform_cache_entries, sizeof(cgl_uniform_cache_entries) / sizeof(cgl_uniform_cache_entries[0]));
+}
+
+void cglEnableUniformCache(void) {
+    CGLCaches *caches = cgl_current_caches();
 
+    if (caches->enabled & CGL_CACHE_UNIFORMS)
+        return;
+    cgl_install_uniform_cache();
+    caches->enabled |= CGL_CACHE_UNIFORMS;
 
+    /* no program in use in a new context */
+    caches->uniforms.program = 0;
+    caches->uniforms.current = nullptr;
+}
+
+void cglDisableUniformCache(void) {
+    CGLCaches *caches = cgl_current_caches();
+
+    if ((caches->enabled & CGL_CACHE_UNIFORMS) == 0)
+        return;
+    cgl_remove_cache(cgl_uniform_cache_entries, sizeof(cgl_uniform_cache_entries) / sizeof(cgl_uniform_cache_entries[0]));
+    caches->enabled &= ~CGL_CACHE_UNIFORMS;
+    if (caches->enabled & CGL_CACHE_BINDINGS)
+        cgl_install_cache(cgl_binding_cache_entries, sizeof(cgl_binding_cache_entries) / sizeof(cgl_binding_cache_entries[0]));
+    cgl_free_uniforms(&caches->uniforms);
+}
 
 
+void cglInvalidateStateCache(void) {
+    CGLCaches *caches = cgl_current_caches();
+    GLuint *binding = &caches->bindings.textures[0][0];
+    unsigned int i;
+
+    caches->state.known = 0;
+    caches->state.known_caps = 0;
+    caches->bindings.array_buffer = caches->bindings.element_array_buffer = CGL_UNKNOWN_NAME;
+    caches->bindings.program = caches->bindings.active_texture = CGL_UNKNOWN_NAME;
+    for (i = 0; i < CGL_CACHED_TEXTURE_UNITS * 2; ++i)
+        binding[i] = CGL_UNKNOWN_NAME;
+    cgl_free_uniforms(&caches->uniforms);
+    caches->uniforms.program = CGL_UNKNOWN_NAME;
+}
+
+const CGLCacheStats *cglGetCacheStats(void) {
+    return &cgl_current_caches()->stats;
+}
 
+void cglResetCacheStats(void) {
+    memset(&cgl_current_caches()->stats, 0, sizeof(CGLCacheStats));
+}
+
+#else
+
+/* directly linked, nothing to load */
 void cglLoadGL(GLADloadproc loader) {
-    glad_glActiveTexture = (PFNGLACTIVETEXTUREPROC) load("glActiveTexture");
+    (void) loader;
+}
+
+void cglLoadGLLazy(GLADloadproc loader) {
+    (void) loader;
+}
+
+#endif /* CGL_DIRECT_LINK */
+
 
 
+static CGLAppliedPipeline *cgl_current_pipeline(void) {
+#ifdef CGL_MULTI_CONTEXT
+    if (cgl_current_context != nullptr)
+        return &cgl_current_context->pipeline;
+#endif
+    return &cgl_applied_pipeline;
 }
 
+static void cgl_default_stencil_face(CGLStencilFace *face) {
+    face->func = GL_ALWAYS;
+    face->ref = 0;
+    face->value_mask = ~(GLuint) 0;
+    face->sfail = face->dpfail = face->dppass = GL_KEEP;
+    face->write_mask = ~(GLuint) 0;
+}
 
+void cglDefaultPipelineDesc(CGLPipelineDesc *desc) {
+    memset(desc, 0, sizeof(*desc));
+    desc->blend = GL_FALSE;
+    desc->blend_src_rgb = desc->blend_src_alpha = GL_ONE;
+    desc->blend_dst_rgb = desc->blend_dst_alpha = GL_ZERO;
+    desc->blend_equation_rgb = desc->blend_equation_alpha = GL_FUNC_ADD;
+    desc->depth_test = GL_FALSE;
+    desc->depth_func = GL_LESS;
+    desc->depth_mask = GL_TRUE;
+    desc->stencil_test = GL_FALSE;
+    cgl_default_stencil_face(&desc->stencil_front);
+    cgl_default_stencil_face(&desc->stencil_back);
+    desc->cull_face = GL_FALSE;
+    desc->cull_mode = GL_BACK;
+    desc->front_face = GL_CCW;
+    desc->color_mask[0] = desc->color_mask[1] = desc->color_mask[2] = desc->color_mask[3] = GL_TRUE;
+    desc->polygon_offset_fill = GL_FALSE;
+}
 
+CGLPipelineState *cglCreatePipeline(const CGLPipelineDesc *desc) {
+    CGLPipelineState *pipeline = (CGLPipelineState *) malloc(sizeof(CGLPipelineState));
+    CGLPipelineDesc *copy;
+    unsigned int i;
 
+    if (pipeline == nullptr)
+        return nullptr;
+    copy = &pipeline->desc;
+    *copy = *desc;
+    pipeline->caps = (desc->blend ? CGL_PIPELINE_BLEND : 0) | (desc->depth_test ? CGL_PIPELINE_DEPTH_TEST : 0)
+                   | (desc->stencil_test ? CGL_PIPELINE_STENCIL_TEST : 0) | (desc->cull_face ? CGL_PIPELINE_CULL_FACE : 0)
+                   | (desc->polygon_offset_fill ? CGL_PIPELINE_POLYGON_OFFSET_FILL : 0);
+    copy->blend = copy->depth_test = copy->stencil_test = copy->cull_face = copy->polygon_offset_fill = GL_FALSE;
+    copy->depth_mask = desc->depth_mask != GL_FALSE;
+    for (i = 0; i < 4; ++i) {
+        copy->color_mask[i] = desc->color_mask[i] != GL_FALSE;
+        copy->blend_color[i] = desc->blend_color[i] < 0.0f ? 0.0f : desc->blend_color[i] > 1.0f ? 1.0f : desc->blend_color[i];
+    }
+    return pipeline;
+}
 
+void cglDestroyPipeline(CGLPipelineState *pipeline) {
+    free(pipeline);
+}
 
+static int cgl_stencil_func_equal(const CGLStencilFace *a, const CGLStencilFace *b) {
+    return a->func == b->func && a->ref == b->ref && a->value_mask == b->value_mask;
+}
 
+static int cgl_stencil_op_equal(const CGLStencilFace *a, const CGLStencilFace *b) {
+    return a->sfail == b->sfail && a->dpfail == b->dpfail && a->dppass == b->dppass;
+}
 
+static unsigned int cgl_pipeline_dirty(const CGLPipelineDesc *a, const CGLPipelineDesc *b) {
+    unsigned int dirty = 0;
 
+    if (a->blend_src_rgb != b->blend_src_rgb || a->blend_dst_rgb != b->blend_dst_rgb
+            || a->blend_src_alpha != b->blend_src_alpha || a->blend_dst_alpha != b->blend_dst_alpha)
+        dirty |= CGL_DIRTY_BLEND_FUNC;
+    if (a->blend_equation_rgb != b->blend_equation_rgb || a->blend_equation_alpha != b->blend_equation_alpha)
+        dirty |= CGL_DIRTY_BLEND_EQUATION;
+    if (memcmp(a->blend_color, b->blend_color, sizeof(a->blend_color)) != 0)
+        dirty |= CGL_DIRTY_BLEND_COLOR;
+    if (a->depth_func != b->depth_func)
+        dirty |= CGL_DIRTY_DEPTH_FUNC;
+    if (a->depth_mask != b->depth_mask)
+        dirty |= CGL_DIRTY_DEPTH_MASK;
+    if (!cgl_stencil_func_equal(&a->stencil_front, &b->stencil_front))
+        dirty |= CGL_DIRTY_STENCIL_FUNC_FRONT;
+    if (!cgl_stencil_func_equal(&a->stencil_back, &b->stencil_back))
+        dirty |= CGL_DIRTY_STENCIL_FUNC_BACK;
+    if (!cgl_stencil_op_equal(&a->stencil_front, &b->stencil_front))
+        dirty |= CGL_DIRTY_STENCIL_OP_FRONT;
+    if (!cgl_stencil_op_equal(&a->stencil_back, &b->stencil_back))
+        dirty |= CGL_DIRTY_STENCIL_OP_BACK;
+    if (a->stencil_front.write_mask != b->stencil_front.write_mask)
+        dirty |= CGL_DIRTY_STENCIL_MASK_FRONT;
+    if (a->stencil_back.write_mask != b->stencil_back.write_mask)
+        dirty |= CGL_DIRTY_STENCIL_MASK_BACK;
+    if (a->cull_mode != b->cull_mode)
+        dirty |= CGL_DIRTY_CULL_FACE;
+    if (a->front_face != b->front_face)
+        dirty |= CGL_DIRTY_FRONT_FACE;
+    if (memcmp(a->color_mask, b->color_mask, sizeof(a->color_mask)) != 0)
+        dirty |= CGL_DIRTY_COLOR_MASK;
+    if (memcmp(&a->polygon_offset_factor, &b->polygon_offset_factor, sizeof(GLfloat)) != 0
+            || memcmp(&a->polygon_offset_units, &b->polygon_offset_units, sizeof(GLfloat)) != 0)
+        dirty |= CGL_DIRTY_POLYGON_OFFSET;
+    return dirty;
+}
+
+/* front and back are set by one call if both changed to the same value */
+static void cgl_apply_stencil(const CGLPipelineDesc *desc, unsigned int dirty) {
+    const CGLStencilFace *front = &desc->stencil_front, *back = &desc->stencil_back;
+
+    if ((dirty & CGL_DIRTY_STENCIL_FUNC_FRONT) && (dirty & CGL_DIRTY_STENCIL_FUNC_BACK) && cgl_stencil_func_equal(front, back)) {
+        glStencilFuncSeparate(GL_FRONT_AND_BACK, front->func, front->ref, front->value_mask);
+    } else {
+        if (dirty & CGL_DIRTY_STENCIL_FUNC_FRONT)
+            glStencilFuncSeparate(GL_FRONT, front->func, front->ref, front->value_mask);
+        if (dirty & CGL_DIRTY_STENCIL_FUNC_BACK)
+            glStencilFuncSeparate(GL_BACK, back->func, back->ref, back->value_mask);
+    }
+    if ((dirty & CGL_DIRTY_STENCIL_OP_FRONT) && (dirty & CGL_DIRTY_STENCIL_OP_BACK) && cgl_stencil_op_equal(front, back)) {
+        glStencilOpSeparate(GL_FRONT_AND_BACK, front->sfail, front->dpfail, front->dppass);
+    } else {
+        if (dirty & CGL_DIRTY_STENCIL_OP_FRONT)
+            glStencilOpSeparate(GL_FRONT, front->sfail, front->dpfail, front->dppass);
+        if (dirty & CGL_DIRTY_STENCIL_OP_BACK)
+            glStencilOpSeparate(GL_BACK, back->sfail, back->dpfail, back->dppass);
+    }
+    if ((dirty & CGL_DIRTY_STENCIL_MASK_FRONT) && (dirty & CGL_DIRTY_STENCIL_MASK_BACK) && front->write_mask == back->write_mask) {
+        glStencilMaskSeparate(GL_FRONT_AND_BACK, front->write_mask);
+    } else {
+        if (dirty & CGL_DIRTY_STENCIL_MASK_FRONT)
+            glStencilMaskSeparate(GL_FRONT, front->write_mask);
+        if (dirty & CGL_DIRTY_STENCIL_MASK_BACK)
+            glStencilMaskSeparate(GL_BACK, back->write_mask);
+    }
+}
+
+void cglApplyPipeline(const CGLPipelineState *pipeline) {
+    CGLAppliedPipeline *applied = cgl_current_pipeline();
+    const CGLPipelineDesc *desc;
+    unsigned int dirty, caps, i;
+
+    if (pipeline == nullptr)
+        return;
+    desc = &pipeline->desc;
+    if (applied->valid) {
+        dirty = cgl_pipeline_dirty(&applied->state.desc, desc);
+        caps = applied->state.caps ^ pipeline->caps;
+    } else {
+        dirty = CGL_DIRTY_ALL;
+        caps = CGL_PIPELINE_CAPS;
+    }
+
+    for (i = 0; caps != 0; ++i, caps >>= 1) {
+        if ((caps & 1) == 0)
+            continue;
+        if (pipeline->caps & (1u << i))
+            glEnable(cgl_pipeline_caps[i]);
+        else
+            glDisable(cgl_pipeline_caps[i]);
+    }
+    if (dirty & CGL_DIRTY_BLEND_FUNC)
+        glBlendFuncSeparate(desc->blend_src_rgb, desc->blend_dst_rgb, desc->blend_src_alpha, desc->blend_dst_alpha);
+    if (dirty & CGL_DIRTY_BLEND_EQUATION)
+        glBlendEquationSeparate(desc->blend_equation_rgb, desc->blend_equation_alpha);
+    if (dirty & CGL_DIRTY_BLEND_COLOR)
+        glBlendColor(desc->blend_color[0], desc->blend_color[1], desc->blend_color[2], desc->blend_color[3]);
+    if (dirty & CGL_DIRTY_DEPTH_FUNC)
+        glDepthFunc(desc->depth_func);
+    if (dirty & CGL_DIRTY_DEPTH_MASK)
+        glDepthMask(desc->depth_mask);
+    cgl_apply_stencil(desc, dirty);
+    if (dirty & CGL_DIRTY_CULL_FACE)
+        glCullFace(desc->cull_mode);
+    if (dirty & CGL_DIRTY_FRONT_FACE)
+        glFrontFace(desc->front_face);
+    if (dirty & CGL_DIRTY_COLOR_MASK)
+        glColorMask(desc->color_mask[0], desc->color_mask[1], desc->color_mask[2], desc->color_mask[3]);
+    if (dirty & CGL_DIRTY_POLYGON_OFFSET)
+        glPolygonOffset(desc->polygon_offset_factor, desc->polygon_offset_units);
+
+    applied->state = *pipeline;
+    applied->valid = 1;
+}
+
+void cglInvalidatePipeline(void) {
+    cgl_current_pipeline()->valid = 0;
+}
+
+
+
+static CGLAppliedVertexFormat *cgl_current_vertex_format(void) {
+#ifdef CGL_MULTI_CONTEXT
+    if (cgl_current_context != nullptr)
+        return &cgl_current_context->vertex_format;
+#endif
+    return &cgl_applied_vertex_format;
+}
+
+static int cgl_same_attrib(const CGLVertexAttrib *a, const CGLVertexAttrib *b) {
+    return a->buffer == b->buffer && a->offset == b->offset && a->size == b->size && a->type == b->type
+        && a->normalized == b->normalized && a->stride == b->stride;
+}
+
+CGLVertexFormat *cglCreateVertexFormat(const CGLVertexAttrib *attribs, unsigned int count) {
+    CGLVertexFormat *format;
+    unsigned int i;
 
+    format = (CGLVertexFormat *) calloc(1, sizeof(CGLVertexFormat));
+    if (format == nullptr)
+        return nullptr;
+    for (i = 0; i < count; ++i) {
+        GLuint index = attribs[i].index;
+
+        if (index >= CGL_VERTEX_FORMAT_ATTRIBS || (format->enabled & (1u << index))) {
+            free(format);
+            return nullptr;
+        }
+        format->enabled |= 1u << index;
+        format->attribs[index] = attribs[i];
+    }
+    return format;
+}
+
+void cglDestroyVertexFormat(CGLVertexFormat *format) {
+    free(format);
+}
 
+void cglApplyVertexFormat(const CGLVertexFormat *format) {
+    CGLAppliedVertexFormat *applied = cgl_current_vertex_format();
+    unsigned int enable, disable, set;
+    GLuint index, bound = 0;
+    int binding = 0;
+
+    if (format == nullptr)
+        return;
+    set = format->enabled;
+    if (applied->valid) {
+        enable = format->enabled & ~applied->format.enabled;
+        disable = applied->format.enabled & ~format->enabled;
+        for (index = 0; index < CGL_VERTEX_FORMAT_ATTRIBS; ++index)
+            if ((format->enabled & applied->known & (1u << index))
+                    && cgl_same_attrib(&format->attribs[index], &applied->format.attribs[index]))
+                set &= ~(1u << index);
+    } else {
+        /* the arrays of all attributes the implementation has, as far as known, and at least the 8 of GL ES 2.0 */
+        GLint attribs = CGL_CURRENT_LIMITS->max_vertex_attribs;
+
+        if (attribs < 8)
+            attribs = 8;
+        if (attribs > CGL_VERTEX_FORMAT_ATTRIBS)
+            attribs = CGL_VERTEX_FORMAT_ATTRIBS;
+        enable = format->enabled;
+        disable = ~format->enabled & ((1u << attribs) - 1);
+        applied->known = 0;
+    }
+    applied->format.enabled = format->enabled;
+    applied->known |= set;
+
+    for (index = 0; disable != 0; ++index, disable >>= 1)
+        if (disable & 1)
+            glDisableVertexAttribArray(index);
+    for (index = 0; set != 0; ++index, set >>= 1) {
+        const CGLVertexAttrib *attrib = &format->attribs[index];
+
+        if ((set & 1) == 0)
+            continue;
+        if (!binding || attrib->buffer != bound) {
+            glBindBuffer(GL_ARRAY_BUFFER, attrib->buffer);
+            bound = attrib->buffer;
+            binding = 1;
+        }
+        glVertexAttribPointer(index, attrib->size, attrib->type, attrib->normalized, attrib->stride,
+                              (const void *) (size_t) attrib->offset);
+        applied->format.attribs[index] = *attrib;
+    }
+    for (index = 0; enable != 0; ++index, enable >>= 1)
+        if (enable & 1)
+            glEnableVertexAttribArray(index);
+    applied->valid = 1;
+}
+
+void cglInvalidateVertexFormat(void) {
+    cgl_current_vertex_format()->valid = 0;
+}
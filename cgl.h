@@ -29,7 +29,8 @@
  * Or maybe even as an extern, that's defined in the implementation / function loader file?
  *
  * glEnableVertexAttribArray, glDisableVertexAttribArray: why does it need VAOs? is this an incompatibility
- * to GL 2.1 / GL ES 2.0?
+ * to GL 2.1 / GL ES 2.0? (GL 4 core needs a bound VAO for them, the common subset has none,
+ * CGLVertexFormat is the replacement: it only makes the calls for attributes that changed.)
  *
  *
  */
@@ -94,6 +95,42 @@ typedef GLADproc (* GLADloadproc)(const char *name);
 # endif
 #endif
 
+/* the dispatch table is kept on its own cache lines, so that the hot entry points
+ * of a frame share as few lines as possible with unrelated data
+ */
+#ifndef CGL_CACHE_ALIGNED
+# if defined(__GNUC__) || defined(__clang__)
+#  define CGL_CACHE_ALIGNED __attribute__ ((aligned (64)))
+# elif defined(_MSC_VER)
+#  define CGL_CACHE_ALIGNED __declspec(align(64))
+# else
+#  define CGL_CACHE_ALIGNED
+# endif
+#endif
+
+#ifndef CGL_INLINE
+# if defined(__cplusplus) || (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L)
+#  define CGL_INLINE static inline
+# elif defined(__GNUC__) || defined(_MSC_VER)
+#  define CGL_INLINE static __inline
+# else
+#  define CGL_INLINE static
+# endif
+#endif
+
+/* only needed with CGL_MULTI_CONTEXT, see cglCreateContext */
+#ifndef CGL_THREAD_LOCAL
+# if defined(__cplusplus) && __cplusplus >= 201103L
+#  define CGL_THREAD_LOCAL thread_local
+# elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#  define CGL_THREAD_LOCAL _Thread_local
+# elif defined(__GNUC__) || defined(__clang__)
+#  define CGL_THREAD_LOCAL __thread
+# elif defined(_MSC_VER)
+#  define CGL_THREAD_LOCAL __declspec(thread)
+# endif
+#endif
+
 /*! \brief loads the GL functions
  * this is the whole interface to cglad - since it only loads one version,
  * there is no necessity for a version struct or other options.
@@ -106,10 +143,31 @@ typedef GLADproc (* GLADloadproc)(const char *name);
  * so that's easy to check for the library user, and must be done regardless in case of loader
  * error / bugs.
  *
+ * All entry points live in one contiguous table, cgl_dispatch (see the end of this header),
+ * and are resolved in a single pass over a packed pool of their names, so loading costs
+ * exactly CGL_DISPATCH_COUNT calls of \ref loader and the table takes
+ * sizeof(CGLDispatch) bytes, i.e. CGL_DISPATCH_COUNT pointers rounded up to whole cache lines.
+ *
  * \param loader loader function that returns the function pointer
  */
 GLAPI void cglLoadGL(GLADloadproc loader);
 
+/*! \brief sets up the GL functions to be loaded on first use
+ * like cglLoadGL, but does not call \ref loader at all yet. Instead, every glad_gl* pointer
+ * is set to a small stub, which on its first call resolves the real function by \ref loader,
+ * stores it in place of itself and then forwards the call. Afterwards calls go directly to the
+ * driver, so only the startup cost changes: programs that use only a handful of the functions
+ * only pay for looking up those.
+ *
+ * this means that the pointers are never NULL in this mode, a missing function is only noticed
+ * when it is called (with the same result as calling a NULL pointer after cglLoadGL).
+ * \ref loader must stay valid as long as not all functions have been called once, and like with
+ * the usual GL loaders the GL context it was created for must be current on the first calls.
+ *
+ * \param loader loader function that returns the function pointer
+ */
+GLAPI void cglLoadGLLazy(GLADloadproc loader);
+
 
 /* only those types that are actually used, also reduced from the khrplatform.h layer */
 typedef unsigned int GLenum;
@@ -234,8 +292,20 @@ typedef GLsizeiptr     GLintptr;
 #define GL_TEXTURE_CUBE_MAP_POSITIVE_Z 0x8519
 #define GL_TEXTURE_CUBE_MAP_NEGATIVE_Z 0x851A
 
+#define GL_ALPHA 0x1906
 #define GL_RGB 0x1907
 #define GL_RGBA 0x1908
+#define GL_LUMINANCE 0x1909
+#define GL_LUMINANCE_ALPHA 0x190A
+
+#define GL_NEAREST 0x2600
+#define GL_LINEAR 0x2601
+#define GL_TEXTURE_MAG_FILTER 0x2800
+#define GL_TEXTURE_MIN_FILTER 0x2801
+#define GL_TEXTURE_WRAP_S 0x2802
+#define GL_TEXTURE_WRAP_T 0x2803
+#define GL_REPEAT 0x2901
+#define GL_CLAMP_TO_EDGE 0x812F
 
 #define GL_FRAGMENT_SHADER 0x8B30
 #define GL_VERTEX_SHADER 0x8B31
@@ -253,6 +323,14 @@ typedef GLsizeiptr     GLintptr;
 #define GL_GEQUAL 0x0206
 #define GL_ALWAYS 0x0207
 
+#define GL_KEEP 0x1E00
+#define GL_REPLACE 0x1E01
+#define GL_INCR 0x1E02
+#define GL_DECR 0x1E03
+#define GL_INVERT 0x150A
+#define GL_INCR_WRAP 0x8507
+#define GL_DECR_WRAP 0x8508
+
 #define GL_BLEND 0x0BE2
 #define GL_CULL_FACE 0x0B44
 #define GL_DEPTH_TEST 0x0B71
@@ -271,7 +349,9 @@ typedef GLsizeiptr     GLintptr;
 #define GL_TRIANGLE_STRIP 0x0005
 #define GL_TRIANGLE_FAN 0x0006
 
+#define GL_BYTE 0x1400
 #define GL_UNSIGNED_BYTE 0x1401
+#define GL_SHORT 0x1402
 #define GL_UNSIGNED_SHORT 0x1403
 
 #define GL_CW 0x0900
@@ -341,6 +421,64 @@ typedef GLsizeiptr     GLintptr;
 #define GL_FLOAT_MAT2 0x8B5A
 #define GL_FLOAT_MAT3 0x8B5B
 #define GL_FLOAT_MAT4 0x8B5C
+#define GL_INT 0x1404
+#define GL_INT_VEC2 0x8B53
+#define GL_INT_VEC3 0x8B54
+#define GL_INT_VEC4 0x8B55
+#define GL_BOOL 0x8B56
+#define GL_BOOL_VEC2 0x8B57
+#define GL_BOOL_VEC3 0x8B58
+#define GL_BOOL_VEC4 0x8B59
+#define GL_SAMPLER_2D 0x8B5E
+#define GL_SAMPLER_CUBE 0x8B60
+
+#define GL_DELETE_STATUS 0x8B80
+#define GL_LINK_STATUS 0x8B82
+#define GL_VALIDATE_STATUS 0x8B83
+#define GL_INFO_LOG_LENGTH 0x8B84
+#define GL_ATTACHED_SHADERS 0x8B85
+#define GL_ACTIVE_UNIFORMS 0x8B86
+#define GL_ACTIVE_UNIFORM_MAX_LENGTH 0x8B87
+#define GL_ACTIVE_ATTRIBUTES 0x8B89
+#define GL_ACTIVE_ATTRIBUTE_MAX_LENGTH 0x8B8A
+
+#define GL_MAX_FRAGMENT_UNIFORM_COMPONENTS 0x8B49
+#define GL_MAX_VERTEX_UNIFORM_COMPONENTS 0x8B4A
+#define GL_MAX_VERTEX_UNIFORM_VECTORS 0x8DFB
+#define GL_MAX_FRAGMENT_UNIFORM_VECTORS 0x8DFD
+#define GL_SMOOTH_LINE_WIDTH_RANGE 0x0B22
+#define GL_SMOOTH_LINE_WIDTH_GRANULARITY 0x0B23
+#define GL_STENCIL_BITS 0x0D57
+#define GL_IMPLEMENTATION_COLOR_READ_TYPE 0x8B9A
+#define GL_IMPLEMENTATION_COLOR_READ_FORMAT 0x8B9B
+#define GL_SHADER_COMPILER 0x8DFA
+
+
+/*! \brief value returned by cglGetEnumValue for names it doesn't know */
+#define CGL_UNKNOWN_ENUM 0xFFFFFFFFu
+
+/*! \brief get the value of a GL enum by its name
+ *
+ * the counterpart to alGetEnumValue in OpenAL, for all the GL_* constants defined in this header,
+ * e.g. for enum names read from files. The lookup is a perfect hash generated from this header,
+ * so it takes constant time (besides hashing the name once) and allocates nothing.
+ *
+ * \param name the name of the constant, e.g. "GL_TEXTURE_2D" (case sensitive, with the GL_ prefix)
+ *
+ * \return the value of the constant, or CGL_UNKNOWN_ENUM if \ref name isn't one
+ */
+GLAPI GLenum cglGetEnumValue(const char *name);
+
+/*! \brief get the name of a GL enum value
+ *
+ * the reverse of cglGetEnumValue, e.g. for logging. Where more than one constant has the same value,
+ * the one defined first in this header is returned, so e.g. 0 gives "GL_FALSE" and not "GL_POINTS".
+ *
+ * \param value the value of the constant
+ *
+ * \return the name of the constant, or NULL if there is no constant with that value
+ */
+GLAPI const char *cglGetEnumName(GLenum value);
 
 
 
@@ -403,10 +541,8 @@ typedef GLsizeiptr     GLintptr;
  * \ingroup general
  */
 typedef void (APIENTRYP PFNGLDISABLEPROC)(GLenum cap);
-GLAPI PFNGLDISABLEPROC glad_glDisable;
 #define glDisable glad_glDisable
 typedef void (APIENTRYP PFNGLENABLEPROC)(GLenum cap);
-GLAPI PFNGLENABLEPROC glad_glEnable;
 #define glEnable glad_glEnable
 
 /*! \brief block until all GL execution is complete
@@ -419,7 +555,6 @@ GLAPI PFNGLENABLEPROC glad_glEnable;
  * \ingroup general
  */
 typedef void (APIENTRYP PFNGLFINISHPROC)(void);
-GLAPI PFNGLFINISHPROC glad_glFinish;
 #define glFinish glad_glFinish
 
 /*! \brief force execution of GL commands in finite time
@@ -435,9 +570,27 @@ GLAPI PFNGLFINISHPROC glad_glFinish;
  * \ingroup general
  */
 typedef void (APIENTRYP PFNGLFLUSHPROC)(void);
-GLAPI PFNGLFLUSHPROC glad_glFlush;
 #define glFlush glad_glFlush
 
+/*! \brief return error information
+ *
+ * returns the value of the error flag and resets it to GL_NO_ERROR. When an error occurs, the flag
+ * is set and no other errors are recorded until glGetError is called. The command that caused the
+ * error is ignored (except for GL_OUT_OF_MEMORY, after which the GL state is undefined).
+ * There may be several flags, one of which is returned and reset per call, so to reset all of them
+ * glGetError must be called in a loop until it returns GL_NO_ERROR.
+ * Possible values are GL_NO_ERROR, GL_INVALID_ENUM, GL_INVALID_VALUE, GL_INVALID_OPERATION
+ * and GL_OUT_OF_MEMORY, the others are not achievable in CGL.
+ *
+ * \return the error code, GL_NO_ERROR if there was no error since the last call
+ *
+ * \errors none
+ *
+ * \ingroup general
+ */
+typedef GLenum (APIENTRYP PFNGLGETERRORPROC)(void);
+#define glGetError glad_glGetError
+
 
 /*! \brief return the value or values of a selected parameter
  *
@@ -530,13 +683,10 @@ GLAPI PFNGLFLUSHPROC glad_glFlush;
  * \ingroup general
  */
 typedef void (APIENTRYP PFNGLGETBOOLEANVPROC)(GLenum pname, GLboolean *data);
-GLAPI PFNGLGETBOOLEANVPROC glad_glGetBooleanv;
 #define glGetBooleanv glad_glGetBooleanv
 typedef void (APIENTRYP PFNGLGETFLOATVPROC)(GLenum pname, GLfloat *data);
-GLAPI PFNGLGETFLOATVPROC glad_glGetFloatv;
 #define glGetFloatv glad_glGetFloatv
 typedef void (APIENTRYP PFNGLGETINTEGERVPROC)(GLenum pname, GLint *data);
-GLAPI PFNGLGETINTEGERVPROC glad_glGetIntegerv;
 #define glGetIntegerv glad_glGetIntegerv
 
 
@@ -565,7 +715,6 @@ GLAPI PFNGLGETINTEGERVPROC glad_glGetIntegerv;
  * \ingroup framebuffer
  */
 typedef void (APIENTRYP PFNGLDRAWARRAYSPROC)(GLenum mode, GLint first, GLsizei count);
-GLAPI PFNGLDRAWARRAYSPROC glad_glDrawArrays;
 #define glDrawArrays glad_glDrawArrays
 
 /*! \brief render primitives from array data
@@ -592,7 +741,6 @@ GLAPI PFNGLDRAWARRAYSPROC glad_glDrawArrays;
  * \ingroup framebuffer
  */
 typedef void (APIENTRYP PFNGLDRAWELEMENTSPROC)(GLenum mode, GLsizei count, GLenum type, const void *indices);
-GLAPI PFNGLDRAWELEMENTSPROC glad_glDrawElements;
 #define glDrawElements glad_glDrawElements
 
 
@@ -622,7 +770,6 @@ GLAPI PFNGLDRAWELEMENTSPROC glad_glDrawElements;
  * \errors GL_INVALID_VALUE if other bits in \param mask are set than the three allowed.
  */
 typedef void (APIENTRYP PFNGLCLEARPROC)(GLbitfield mask);
-GLAPI PFNGLCLEARPROC glad_glClear;
 #define glClear glad_glClear
 
 /*! \brief specify clear values for the color buffers
@@ -638,7 +785,6 @@ GLAPI PFNGLCLEARPROC glad_glClear;
  * \errors none
  */
 typedef void (APIENTRYP PFNGLCLEARCOLORPROC)(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
-GLAPI PFNGLCLEARCOLORPROC glad_glClearColor;
 #define glClearColor glad_glClearColor
 
 /*! \brief specify the clear value for the depth buffer
@@ -654,7 +800,6 @@ GLAPI PFNGLCLEARCOLORPROC glad_glClearColor;
  * \errors none
  */
 typedef void (APIENTRYP PFNGLCLEARDEPTHPROC)(GLdouble depth);
-GLAPI PFNGLCLEARDEPTHPROC glad_glClearDepth;
 #define glClearDepth glad_glClearDepth
 /* ??? */
 #define glClearDepthf glad_glClearDepth
@@ -670,7 +815,6 @@ GLAPI PFNGLCLEARDEPTHPROC glad_glClearDepth;
  * \errors none
  */
 typedef void (APIENTRYP PFNGLCLEARSTENCILPROC)(GLint s);
-GLAPI PFNGLCLEARSTENCILPROC glad_glClearStencil;
 #define glClearStencil glad_glClearStencil
 
 /*! \} */
@@ -699,7 +843,6 @@ GLAPI PFNGLCLEARSTENCILPROC glad_glClearStencil;
  * \errors none
  */
 typedef void (APIENTRYP PFNGLCOLORMASKPROC)(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
-GLAPI PFNGLCOLORMASKPROC glad_glColorMask;
 #define glColorMask glad_glColorMask
 
 /*! \brief enable and disable writing of the frame buffers depth buffer
@@ -712,7 +855,6 @@ GLAPI PFNGLCOLORMASKPROC glad_glColorMask;
  * \errors none
  */
 typedef void (APIENTRYP PFNGLDEPTHMASKPROC)(GLboolean flag);
-GLAPI PFNGLDEPTHMASKPROC glad_glDepthMask;
 #define glDepthMask glad_glDepthMask
 
 /*! \} */
@@ -749,7 +891,6 @@ GLAPI PFNGLDEPTHMASKPROC glad_glDepthMask;
  * \errors none
  */
 typedef void (APIENTRYP PFNGLBLENDCOLORPROC)(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
-GLAPI PFNGLBLENDCOLORPROC glad_glBlendColor;
 #define glBlendColor glad_glBlendColor
 
 /*! \brief specify the equation used for both the RGB blend equation and the Alpha blend equation
@@ -772,7 +913,6 @@ GLAPI PFNGLBLENDCOLORPROC glad_glBlendColor;
  * \errors GL_INVALID_ENUM if \ref mode is not GL_FUNC_ADD, GL_FUNC_SUBTRACT or GL_FUNC_REVERSE_SUBTRACT
  */
 typedef void (APIENTRYP PFNGLBLENDEQUATIONPROC)(GLenum mode);
-GLAPI PFNGLBLENDEQUATIONPROC glad_glBlendEquation;
 #define glBlendEquation glad_glBlendEquation
 
 /*! \brief set the RGB blend equation and the alpha blend equation separately
@@ -787,7 +927,6 @@ GLAPI PFNGLBLENDEQUATIONPROC glad_glBlendEquation;
  *                              GL_FUNC_ADD, GL_FUNC_SUBTRACT or GL_FUNC_REVERSE_SUBTRACT
  */
 typedef void (APIENTRYP PFNGLBLENDEQUATIONSEPARATEPROC)(GLenum modeRGB, GLenum modeAlpha);
-GLAPI PFNGLBLENDEQUATIONSEPARATEPROC glad_glBlendEquationSeparate;
 #define glBlendEquationSeparate glad_glBlendEquationSeparate
 
 /*! \brief specify pixel arithmetic
@@ -839,7 +978,6 @@ GLAPI PFNGLBLENDEQUATIONSEPARATEPROC glad_glBlendEquationSeparate;
  *                              GL_SRC_ALPHA_SATURATE is used for the destination
  */
 typedef void (APIENTRYP PFNGLBLENDFUNCPROC)(GLenum sfactor, GLenum dfactor);
-GLAPI PFNGLBLENDFUNCPROC glad_glBlendFunc;
 #define glBlendFunc glad_glBlendFunc
 
 /*! \brief specify pixel arithmetic for RGB and alpha components separately
@@ -856,7 +994,6 @@ GLAPI PFNGLBLENDFUNCPROC glad_glBlendFunc;
  *                              (desktop GL does specify only warnings on RGB, not alpha factors)
  */
 typedef void (APIENTRYP PFNGLBLENDFUNCSEPARATEPROC)(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
-GLAPI PFNGLBLENDFUNCSEPARATEPROC glad_glBlendFuncSeparate;
 #define glBlendFuncSeparate glad_glBlendFuncSeparate
 
 /*! \} */
@@ -885,7 +1022,6 @@ GLAPI PFNGLBLENDFUNCSEPARATEPROC glad_glBlendFuncSeparate;
  * \ingroup postprocessing
  */
 typedef void (APIENTRYP PFNGLDEPTHFUNCPROC)(GLenum func);
-GLAPI PFNGLDEPTHFUNCPROC glad_glDepthFunc;
 #define glDepthFunc glad_glDepthFunc
 
 /*! \brief specify mapping of depth values from normalized device coordinates to window coordinates
@@ -909,7 +1045,6 @@ GLAPI PFNGLDEPTHFUNCPROC glad_glDepthFunc;
  * \ingroup postprocessing
  */
 typedef void (APIENTRYP PFNGLDEPTHRANGEPROC)(GLdouble n, GLdouble f);
-GLAPI PFNGLDEPTHRANGEPROC glad_glDepthRange;
 #define glDepthRange glad_glDepthRange
 /* ??? */
 #define glDepthRangef glad_glDepthRange
@@ -929,7 +1064,6 @@ GLAPI PFNGLDEPTHRANGEPROC glad_glDepthRange;
  * \ingroup postprocessing
  */
 typedef void (APIENTRYP PFNGLCULLFACEPROC)(GLenum mode);
-GLAPI PFNGLCULLFACEPROC glad_glCullFace;
 #define glCullFace glad_glCullFace
 
 /*! \brief define front- and back-facing polygons
@@ -947,9 +1081,109 @@ GLAPI PFNGLCULLFACEPROC glad_glCullFace;
  * \ingroup postprocessing
  */
 typedef void (APIENTRYP PFNGLFRONTFACEPROC)(GLenum mode);
-GLAPI PFNGLFRONTFACEPROC glad_glFrontFace;
 #define glFrontFace glad_glFrontFace
 
+/*! \brief set the scale and units used to calculate depth values
+ *
+ * when GL_POLYGON_OFFSET_FILL is enabled, the depth value of each fragment of a polygon is offset by
+ *      factor * DZ + r * units
+ * where DZ is the change of depth relative to the screen area of the polygon and r the smallest offset
+ * guaranteed to make a difference. The offset is added before the depth test and before writing the depth buffer.
+ * Useful for decals, hidden-line images and highlighted edges. Both default to 0.
+ *
+ * \param factor scale factor for the variable depth offset of each polygon
+ * \param units  multiplied by r to give a constant depth offset
+ *
+ * \errors none
+ *
+ * \ingroup postprocessing
+ */
+typedef void (APIENTRYP PFNGLPOLYGONOFFSETPROC)(GLfloat factor, GLfloat units);
+#define glPolygonOffset glad_glPolygonOffset
+
+
+/*! \defgroup stencil stencil test
+ *
+ * when GL_STENCIL_TEST is enabled, every fragment is tested against the value in the stencil buffer,
+ * and the stencil buffer is updated depending on the outcome of this and the depth test.
+ * There are two sets of this state, one for back-facing polygons, and one for front-facing polygons
+ * and everything else. The functions without Separate set both of them, like calling the Separate
+ * version with \ref face == GL_FRONT_AND_BACK.
+ * If there is no stencil buffer, nothing can be modified and the test always passes.
+ *
+ * \ingroup postprocessing
+ * \{
+ */
+
+/*! \brief set front and/or back function and reference value for stencil testing
+ *
+ * the test compares (ref & mask) with (stencil & mask), where stencil is the value in the stencil buffer:
+ *  GL_NEVER        always fails
+ *  GL_LESS         passes if (ref & mask) <  (stencil & mask)
+ *  GL_LEQUAL       passes if (ref & mask) <= (stencil & mask)
+ *  GL_GREATER      passes if (ref & mask) >  (stencil & mask)
+ *  GL_GEQUAL       passes if (ref & mask) >= (stencil & mask)
+ *  GL_EQUAL        passes if (ref & mask) == (stencil & mask)
+ *  GL_NOTEQUAL     passes if (ref & mask) != (stencil & mask)
+ *  GL_ALWAYS       always passes
+ * all values are taken as unsigned integers in [0, 2^n - 1], n being the number of stencil bits,
+ * and ref is clamped to that range. The defaults are GL_ALWAYS, 0 and all 1's.
+ *
+ * \param face whose state is set, must be GL_FRONT, GL_BACK or GL_FRONT_AND_BACK
+ * \param func the test function, one of the above
+ * \param ref  the reference value
+ * \param mask ANDed to both ref and the stored value before comparing
+ *
+ * \errors GL_INVALID_ENUM if \ref face or \ref func is not one of the accepted values
+ */
+typedef void (APIENTRYP PFNGLSTENCILFUNCPROC)(GLenum func, GLint ref, GLuint mask);
+#define glStencilFunc glad_glStencilFunc
+typedef void (APIENTRYP PFNGLSTENCILFUNCSEPARATEPROC)(GLenum face, GLenum func, GLint ref, GLuint mask);
+#define glStencilFuncSeparate glad_glStencilFuncSeparate
+
+/*! \brief control the front and/or back writing of individual bits in the stencil planes
+ *
+ * bits set to 1 in the lowest n bits of \ref mask (n being the number of stencil bits)
+ * can be written to, those set to 0 are write-protected. Initially, all bits can be written.
+ *
+ * \param face whose mask is set, must be GL_FRONT, GL_BACK or GL_FRONT_AND_BACK
+ * \param mask the write mask
+ *
+ * \errors GL_INVALID_ENUM if \ref face is not one of the accepted values
+ */
+typedef void (APIENTRYP PFNGLSTENCILMASKPROC)(GLuint mask);
+#define glStencilMask glad_glStencilMask
+typedef void (APIENTRYP PFNGLSTENCILMASKSEPARATEPROC)(GLenum face, GLuint mask);
+#define glStencilMaskSeparate glad_glStencilMaskSeparate
+
+/*! \brief set front and/or back stencil test actions
+ *
+ * what happens to the value in the stencil buffer, if the stencil test fails (\ref sfail), if it passes,
+ * but the depth test fails (\ref dpfail), or if both pass (\ref dppass, also if there is no depth test):
+ *  GL_KEEP         keep the current value
+ *  GL_ZERO         set it to 0
+ *  GL_REPLACE      set it to ref as given to glStencilFunc
+ *  GL_INCR         increment it, up to the maximum value
+ *  GL_INCR_WRAP    increment it, wrapping to 0 after the maximum value
+ *  GL_DECR         decrement it, down to 0
+ *  GL_DECR_WRAP    decrement it, wrapping to the maximum value after 0
+ *  GL_INVERT       invert it bitwise
+ * all three default to GL_KEEP.
+ *
+ * \param face   whose actions are set, must be GL_FRONT, GL_BACK or GL_FRONT_AND_BACK
+ * \param sfail  action if the stencil test fails
+ * \param dpfail action if the stencil test passes and the depth test fails
+ * \param dppass action if both pass
+ *
+ * \errors GL_INVALID_ENUM if any argument is not one of the accepted values
+ */
+typedef void (APIENTRYP PFNGLSTENCILOPPROC)(GLenum sfail, GLenum dpfail, GLenum dppass);
+#define glStencilOp glad_glStencilOp
+typedef void (APIENTRYP PFNGLSTENCILOPSEPARATEPROC)(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
+#define glStencilOpSeparate glad_glStencilOpSeparate
+
+/*! \} */
+
 
 
 
@@ -994,7 +1228,6 @@ GLAPI PFNGLFRONTFACEPROC glad_glFrontFace;
  * \ingroup buffer
  */
 typedef void (APIENTRYP PFNGLBINDBUFFERPROC)(GLenum target, GLuint buffer);
-GLAPI PFNGLBINDBUFFERPROC glad_glBindBuffer;
 #define glBindBuffer glad_glBindBuffer
 
 /*! \brief create and initialize a buffer object's data store
@@ -1026,7 +1259,6 @@ GLAPI PFNGLBINDBUFFERPROC glad_glBindBuffer;
  *
  */
 typedef void (APIENTRYP PFNGLBUFFERDATAPROC)(GLenum target, GLsizeiptr size, const void *data, GLenum usage);
-GLAPI PFNGLBUFFERDATAPROC glad_glBufferData;
 #define glBufferData glad_glBufferData
 
 /*! \brief update a subset of a buffer object's data store
@@ -1053,7 +1285,6 @@ GLAPI PFNGLBUFFERDATAPROC glad_glBufferData;
  * \ingroup buffer
  */
 typedef void (APIENTRYP PFNGLBUFFERSUBDATAPROC)(GLenum target, GLintptr offset, GLsizeiptr size, const void *data);
-GLAPI PFNGLBUFFERSUBDATAPROC glad_glBufferSubData;
 #define glBufferSubData glad_glBufferSubData
 
 /*! \brief delete named buffer objects
@@ -1070,7 +1301,6 @@ GLAPI PFNGLBUFFERSUBDATAPROC glad_glBufferSubData;
  * \ingroup buffer
  */
 typedef void (APIENTRYP PFNGLDELETEBUFFERSPROC)(GLsizei n, const GLuint *buffers);
-GLAPI PFNGLDELETEBUFFERSPROC glad_glDeleteBuffers;
 #define glDeleteBuffers glad_glDeleteBuffers
 
 /*! \brief generate buffer object names
@@ -1085,7 +1315,6 @@ GLAPI PFNGLDELETEBUFFERSPROC glad_glDeleteBuffers;
  * \ingroup buffer
  */
 typedef void (APIENTRYP PFNGLGENBUFFERSPROC)(GLsizei n, GLuint *buffers);
-GLAPI PFNGLGENBUFFERSPROC glad_glGenBuffers;
 #define glGenBuffers glad_glGenBuffers
 
 
@@ -1116,7 +1345,6 @@ GLAPI PFNGLGENBUFFERSPROC glad_glGenBuffers;
  * \ingroup texture
  */
 typedef void (APIENTRYP PFNGLACTIVETEXTUREPROC)(GLenum texture);
-GLAPI PFNGLACTIVETEXTUREPROC glad_glActiveTexture;
 #define glActiveTexture glad_glActiveTexture
 
 /*! \brief bind a named texture to a texturing target
@@ -1151,7 +1379,6 @@ GLAPI PFNGLACTIVETEXTUREPROC glad_glActiveTexture;
  * \ingroup texture
  */
 typedef void (APIENTRYP PFNGLBINDTEXTUREPROC)(GLenum target, GLuint texture);
-GLAPI PFNGLBINDTEXTUREPROC glad_glBindTexture;
 #define glBindTexture glad_glBindTexture
 
 /*! \brief copy pixels into a 2D texture image
@@ -1195,7 +1422,6 @@ GLAPI PFNGLBINDTEXTUREPROC glad_glBindTexture;
  * \ingroup texture
  */
 typedef void (APIENTRYP PFNGLCOPYTEXIMAGE2DPROC)(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border);
-GLAPI PFNGLCOPYTEXIMAGE2DPROC glad_glCopyTexImage2D;
 #define glCopyTexImage2D glad_glCopyTexImage2D
 
 /*! \brief copy a two-dimensional texture subimage
@@ -1226,7 +1452,6 @@ GLAPI PFNGLCOPYTEXIMAGE2DPROC glad_glCopyTexImage2D;
  * \ingroup texture
  */
 typedef void (APIENTRYP PFNGLCOPYTEXSUBIMAGE2DPROC)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height);
-GLAPI PFNGLCOPYTEXSUBIMAGE2DPROC glad_glCopyTexSubImage2D;
 #define glCopyTexSubImage2D glad_glCopyTexSubImage2D
 
 /*! \brief delete named textures
@@ -1243,7 +1468,6 @@ GLAPI PFNGLCOPYTEXSUBIMAGE2DPROC glad_glCopyTexSubImage2D;
  * \ingroup texture
  */
 typedef void (APIENTRYP PFNGLDELETETEXTURESPROC)(GLsizei n, const GLuint *textures);
-GLAPI PFNGLDELETETEXTURESPROC glad_glDeleteTextures;
 #define glDeleteTextures glad_glDeleteTextures
 
 /*! \brief generate texture names
@@ -1258,9 +1482,92 @@ GLAPI PFNGLDELETETEXTURESPROC glad_glDeleteTextures;
  * \ingroup texture
  */
 typedef void (APIENTRYP PFNGLGENTEXTURESPROC)(GLsizei n, GLuint *textures);
-GLAPI PFNGLGENTEXTURESPROC glad_glGenTextures;
 #define glGenTextures glad_glGenTextures
 
+/*! \brief set pixel storage modes
+ *
+ * only the row alignment is common: rows of pixel data read by glTexImage2D and glTexSubImage2D start
+ * at multiples of GL_UNPACK_ALIGNMENT bytes, rows written by glReadPixels at multiples of GL_PACK_ALIGNMENT.
+ *
+ * \param pname GL_PACK_ALIGNMENT or GL_UNPACK_ALIGNMENT
+ * \param param 1, 2, 4 (the default) or 8
+ *
+ * \errors GL_INVALID_ENUM  if \ref pname is not an accepted value
+ *         GL_INVALID_VALUE if \ref param is not 1, 2, 4 or 8
+ *
+ * \ingroup texture
+ */
+typedef void (APIENTRYP PFNGLPIXELSTOREIPROC)(GLenum pname, GLint param);
+#define glPixelStorei glad_glPixelStorei
+
+/*! \brief specify a two-dimensional texture image
+ *
+ * (re)allocates level \ref level of the texture bound to \ref target of the active unit, and fills it
+ * with \ref data, or leaves it undefined if \ref data is NULL, to be filled by glTexSubImage2D later.
+ * In the common subset \ref internalformat must equal \ref format, and without mipmaps the texture is only
+ * complete with a GL_TEXTURE_MIN_FILTER of GL_NEAREST or GL_LINEAR.
+ *
+ * \param target         GL_TEXTURE_2D or one of the faces GL_TEXTURE_CUBE_MAP_POSITIVE_X ...
+ * \param level          mipmap level, 0 for the base image
+ * \param internalformat GL_ALPHA, GL_LUMINANCE, GL_LUMINANCE_ALPHA, GL_RGB or GL_RGBA
+ * \param width          at most GL_MAX_TEXTURE_SIZE; in GL ES 2.0 a power of two if mipmaps or GL_REPEAT are used
+ * \param height         like \ref width
+ * \param border         must be 0
+ * \param format         like \ref internalformat
+ * \param type           GL_UNSIGNED_BYTE
+ * \param data           \ref height rows of \ref width pixels, each row aligned to GL_UNPACK_ALIGNMENT, or NULL
+ *
+ * \errors GL_INVALID_ENUM      if \ref target, \ref format or \ref type is not an accepted value
+ *         GL_INVALID_VALUE     if \ref level < 0, \ref width or \ref height < 0 or > GL_MAX_TEXTURE_SIZE,
+ *                              or \ref border != 0
+ *         GL_INVALID_OPERATION if \ref format doesn't match \ref internalformat (GL ES 2.0)
+ *
+ * \ingroup texture
+ */
+typedef void (APIENTRYP PFNGLTEXIMAGE2DPROC)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *data);
+#define glTexImage2D glad_glTexImage2D
+
+/*! \brief specify a two-dimensional texture subimage
+ *
+ * replaces the rectangle from (\ref xoffset, \ref yoffset) of \ref width x \ref height pixels of a texture image
+ * defined before with glTexImage2D, with \ref data. Uploading a large image in bands of rows keeps each call short.
+ *
+ * \param target  like in glTexImage2D
+ * \param level   like in glTexImage2D
+ * \param xoffset first column to replace
+ * \param yoffset first row to replace
+ * \param width   columns to replace
+ * \param height  rows to replace
+ * \param format  the format of the texture image
+ * \param type    GL_UNSIGNED_BYTE
+ * \param data    \ref height rows of \ref width pixels, each row aligned to GL_UNPACK_ALIGNMENT
+ *
+ * \errors GL_INVALID_ENUM      if \ref target, \ref format or \ref type is not an accepted value
+ *         GL_INVALID_VALUE     if \ref level < 0, \ref xoffset, \ref yoffset, \ref width or \ref height < 0,
+ *                              or the rectangle doesn't lie inside the texture image
+ *         GL_INVALID_OPERATION if the texture image was not defined before, or \ref format doesn't match it (GL ES 2.0)
+ *
+ * \ingroup texture
+ */
+typedef void (APIENTRYP PFNGLTEXSUBIMAGE2DPROC)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *data);
+#define glTexSubImage2D glad_glTexSubImage2D
+
+/*! \brief set a texture parameter
+ *
+ * sets a parameter of the texture bound to \ref target of the active unit.
+ *
+ * \param target GL_TEXTURE_2D or GL_TEXTURE_CUBE_MAP
+ * \param pname  GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER, GL_TEXTURE_WRAP_S or GL_TEXTURE_WRAP_T
+ * \param param  GL_NEAREST or GL_LINEAR for the filters (and the mipmap filters for GL_TEXTURE_MIN_FILTER),
+ *               GL_REPEAT or GL_CLAMP_TO_EDGE for the wrap modes
+ *
+ * \errors GL_INVALID_ENUM if \ref target, \ref pname or \ref param is not an accepted value
+ *
+ * \ingroup texture
+ */
+typedef void (APIENTRYP PFNGLTEXPARAMETERIPROC)(GLenum target, GLenum pname, GLint param);
+#define glTexParameteri glad_glTexParameteri
+
 
 
 
@@ -1294,7 +1601,6 @@ GLAPI PFNGLGENTEXTURESPROC glad_glGenTextures;
  * \ingroup shader
  */
 typedef void (APIENTRYP PFNGLATTACHSHADERPROC)(GLuint program, GLuint shader);
-GLAPI PFNGLATTACHSHADERPROC glad_glAttachShader;
 #define glAttachShader glad_glAttachShader
 
 /*! \brief compile a shader object
@@ -1311,7 +1617,6 @@ GLAPI PFNGLATTACHSHADERPROC glad_glAttachShader;
  * \ingroup shader
  */
 typedef void (APIENTRYP PFNGLCOMPILESHADERPROC)(GLuint shader);
-GLAPI PFNGLCOMPILESHADERPROC glad_glCompileShader;
 #define glCompileShader glad_glCompileShader
 
 /*! \brief create a program object
@@ -1325,7 +1630,6 @@ GLAPI PFNGLCOMPILESHADERPROC glad_glCompileShader;
  * \ingroup shader
  */
 typedef GLuint (APIENTRYP PFNGLCREATEPROGRAMPROC)(void);
-GLAPI PFNGLCREATEPROGRAMPROC glad_glCreateProgram;
 #define glCreateProgram glad_glCreateProgram
 
 /*! \brief create a shader object
@@ -1341,7 +1645,6 @@ GLAPI PFNGLCREATEPROGRAMPROC glad_glCreateProgram;
  * \ingroup shader
  */
 typedef GLuint (APIENTRYP PFNGLCREATESHADERPROC)(GLenum type);
-GLAPI PFNGLCREATESHADERPROC glad_glCreateShader;
 #define glCreateShader glad_glCreateShader
 
 /*! \brief delete a program object
@@ -1359,7 +1662,6 @@ GLAPI PFNGLCREATESHADERPROC glad_glCreateShader;
  * \ingroup shader
  */
 typedef void (APIENTRYP PFNGLDELETEPROGRAMPROC)(GLuint program);
-GLAPI PFNGLDELETEPROGRAMPROC glad_glDeleteProgram;
 #define glDeleteProgram glad_glDeleteProgram
 
 /*! \brief delete a shader object
@@ -1376,7 +1678,6 @@ GLAPI PFNGLDELETEPROGRAMPROC glad_glDeleteProgram;
  * \ingroup shader
  */
 typedef void (APIENTRYP PFNGLDELETESHADERPROC)(GLuint shader);
-GLAPI PFNGLDELETESHADERPROC glad_glDeleteShader;
 #define glDeleteShader glad_glDeleteShader
 
 /*! \brief detach a shader object from a program object (to which it is attached)
@@ -1394,9 +1695,161 @@ GLAPI PFNGLDELETESHADERPROC glad_glDeleteShader;
  * \ingroup shader
  */
 typedef void (APIENTRYP PFNGLDETACHSHADERPROC)(GLuint program, GLuint shader);
-GLAPI PFNGLDETACHSHADERPROC glad_glDetachShader;
 #define glDetachShader glad_glDetachShader
 
+/*! \brief install a program object as part of current rendering state
+ *
+ * makes the executables of a linked program the ones used by glDrawArrays and glDrawElements.
+ * The program stays in use even if its shaders are changed, detached or deleted afterwards, and also
+ * if it is deleted with glDeleteProgram (it is then only flagged for deletion, until it is no longer in use).
+ * Relinking the program in use installs the new executables directly if the link was successful.
+ * \ref program == 0 means no program, drawing then gives undefined results (in GL 2.1: fixed functionality).
+ *
+ * \param program the program object to use, or 0
+ *
+ * \errors GL_INVALID_VALUE     if \ref program is neither 0 nor a value generated by OpenGL
+ *         GL_INVALID_OPERATION if \ref program isn't a program object or could not be made part of current state
+ *
+ * \ingroup shader
+ */
+typedef void (APIENTRYP PFNGLUSEPROGRAMPROC)(GLuint program);
+#define glUseProgram glad_glUseProgram
+
+/*! \brief link a program object
+ *
+ * links the shaders attached to \ref program into its executables. The result can be queried with glGetProgramiv
+ * and GL_LINK_STATUS. A successful link assigns new locations to all active uniforms, which have to be queried
+ * again with glGetUniformLocation, and sets all of their values to 0; a failed link loses the previous executables.
+ *
+ * \param program the program object to be linked
+ *
+ * \errors GL_INVALID_VALUE     if \ref program is not a value generated by OpenGL
+ *         GL_INVALID_OPERATION if \ref program isn't a program object
+ *
+ * \ingroup shader
+ */
+typedef void (APIENTRYP PFNGLLINKPROGRAMPROC)(GLuint program);
+#define glLinkProgram glad_glLinkProgram
+
+/*! \brief return the location of a uniform variable
+ *
+ * only valid after \ref program has been linked successfully, and until it is linked again.
+ * Elements of arrays and fields of structures are selected with "[]" and ".", the first element of an array
+ * can also be named by the array name alone.
+ *
+ * \param program the program object to be queried
+ * \param name    null terminated name of the uniform variable
+ *
+ * \return the location, or -1 if \ref name is not an active uniform of \ref program or starts with "gl_"
+ *
+ * \errors GL_INVALID_VALUE     if \ref program is not a value generated by OpenGL
+ *         GL_INVALID_OPERATION if \ref program isn't a program object or hasn't been linked successfully
+ *
+ * \ingroup shader
+ */
+typedef GLint (APIENTRYP PFNGLGETUNIFORMLOCATIONPROC)(GLuint program, const GLchar *name);
+#define glGetUniformLocation glad_glGetUniformLocation
+
+/*! \brief specify the value of a uniform variable for the current program object
+ *
+ * sets the uniform at \ref location (from glGetUniformLocation) of the program in use, where the number in the name
+ * is the number of components and the suffix the type: f for float, vec2, ..., i for int, ivec2, ... and samplers
+ * (only glUniform1i and glUniform1iv), either for bool, bvec2, ...
+ * The v variants set \ref count elements of an array, starting at \ref location (1 for a single variable),
+ * glUniformMatrix*fv sets \ref count matrices given in column major order; \ref transpose must be GL_FALSE.
+ * A \ref location of -1 is silently ignored. Values are kept per program until it is linked again,
+ * which sets them to 0.
+ *
+ * \param location location of the uniform to be modified
+ * \param v0, v1, v2, v3 the new values
+ * \param count number of elements or matrices to be modified
+ * \param transpose must be GL_FALSE
+ * \param value the new values, count times the components of one element
+ *
+ * \errors GL_INVALID_VALUE     if \ref count is negative or \ref transpose isn't GL_FALSE (GL ES 2.0 only)
+ *         GL_INVALID_OPERATION if there is no program in use, \ref location is neither -1 nor a location
+ *                              of it, the type or size doesn't match the uniform, \ref count is greater than 1
+ *                              for a variable that isn't an array, or a sampler is set other than by glUniform1i(v)
+ *
+ * \ingroup shader
+ */
+typedef void (APIENTRYP PFNGLUNIFORM1FPROC)(GLint location, GLfloat v0);
+#define glUniform1f glad_glUniform1f
+typedef void (APIENTRYP PFNGLUNIFORM2FPROC)(GLint location, GLfloat v0, GLfloat v1);
+#define glUniform2f glad_glUniform2f
+typedef void (APIENTRYP PFNGLUNIFORM3FPROC)(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+#define glUniform3f glad_glUniform3f
+typedef void (APIENTRYP PFNGLUNIFORM4FPROC)(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+#define glUniform4f glad_glUniform4f
+typedef void (APIENTRYP PFNGLUNIFORM1IPROC)(GLint location, GLint v0);
+#define glUniform1i glad_glUniform1i
+typedef void (APIENTRYP PFNGLUNIFORM2IPROC)(GLint location, GLint v0, GLint v1);
+#define glUniform2i glad_glUniform2i
+typedef void (APIENTRYP PFNGLUNIFORM3IPROC)(GLint location, GLint v0, GLint v1, GLint v2);
+#define glUniform3i glad_glUniform3i
+typedef void (APIENTRYP PFNGLUNIFORM4IPROC)(GLint location, GLint v0, GLint v1, GLint v2, GLint v3);
+#define glUniform4i glad_glUniform4i
+typedef void (APIENTRYP PFNGLUNIFORM1FVPROC)(GLint location, GLsizei count, const GLfloat *value);
+#define glUniform1fv glad_glUniform1fv
+typedef void (APIENTRYP PFNGLUNIFORM2FVPROC)(GLint location, GLsizei count, const GLfloat *value);
+#define glUniform2fv glad_glUniform2fv
+typedef void (APIENTRYP PFNGLUNIFORM3FVPROC)(GLint location, GLsizei count, const GLfloat *value);
+#define glUniform3fv glad_glUniform3fv
+typedef void (APIENTRYP PFNGLUNIFORM4FVPROC)(GLint location, GLsizei count, const GLfloat *value);
+#define glUniform4fv glad_glUniform4fv
+typedef void (APIENTRYP PFNGLUNIFORM1IVPROC)(GLint location, GLsizei count, const GLint *value);
+#define glUniform1iv glad_glUniform1iv
+typedef void (APIENTRYP PFNGLUNIFORM2IVPROC)(GLint location, GLsizei count, const GLint *value);
+#define glUniform2iv glad_glUniform2iv
+typedef void (APIENTRYP PFNGLUNIFORM3IVPROC)(GLint location, GLsizei count, const GLint *value);
+#define glUniform3iv glad_glUniform3iv
+typedef void (APIENTRYP PFNGLUNIFORM4IVPROC)(GLint location, GLsizei count, const GLint *value);
+#define glUniform4iv glad_glUniform4iv
+typedef void (APIENTRYP PFNGLUNIFORMMATRIX2FVPROC)(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+#define glUniformMatrix2fv glad_glUniformMatrix2fv
+typedef void (APIENTRYP PFNGLUNIFORMMATRIX3FVPROC)(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+#define glUniformMatrix3fv glad_glUniformMatrix3fv
+typedef void (APIENTRYP PFNGLUNIFORMMATRIX4FVPROC)(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+#define glUniformMatrix4fv glad_glUniformMatrix4fv
+
+/*! \brief return a parameter of a program object
+ *
+ * \param program the program object to be queried
+ * \param pname   GL_DELETE_STATUS, GL_LINK_STATUS, GL_VALIDATE_STATUS, GL_INFO_LOG_LENGTH, GL_ATTACHED_SHADERS,
+ *                GL_ACTIVE_ATTRIBUTES, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, GL_ACTIVE_UNIFORMS or GL_ACTIVE_UNIFORM_MAX_LENGTH
+ * \param params  returns the single value of the parameter
+ *
+ * \errors GL_INVALID_ENUM      if \ref pname is not one of the above
+ *         GL_INVALID_VALUE     if \ref program is not a value generated by OpenGL
+ *         GL_INVALID_OPERATION if \ref program isn't a program object
+ *
+ * \ingroup shader
+ */
+typedef void (APIENTRYP PFNGLGETPROGRAMIVPROC)(GLuint program, GLenum pname, GLint *params);
+#define glGetProgramiv glad_glGetProgramiv
+
+/*! \brief return information about an active uniform variable of a program object
+ *
+ * \ref index goes from 0 to GL_ACTIVE_UNIFORMS - 1 (see glGetProgramiv), after \ref program has been linked.
+ * Arrays are returned once, with the name of the first element ("name[0]") and their length in \ref size;
+ * every field of a structure is returned on its own ("name.field"). Built-in uniforms start with "gl_".
+ *
+ * \param program the program object to be queried
+ * \param index   index of the uniform variable
+ * \param bufSize size of \ref name in characters, GL_ACTIVE_UNIFORM_MAX_LENGTH is always enough
+ * \param length  returns the length of the name without the null terminator, can be NULL
+ * \param size    returns the number of array elements, 1 if it is not an array
+ * \param type    returns the type, e.g. GL_FLOAT_VEC4, GL_FLOAT_MAT4, GL_INT or GL_SAMPLER_2D
+ * \param name    returns the null terminated name
+ *
+ * \errors GL_INVALID_VALUE     if \ref program is not a value generated by OpenGL, \ref index is too large or \ref bufSize < 0
+ *         GL_INVALID_OPERATION if \ref program isn't a program object
+ *
+ * \ingroup shader
+ */
+typedef void (APIENTRYP PFNGLGETACTIVEUNIFORMPROC)(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name);
+#define glGetActiveUniform glad_glGetActiveUniform
+
 
 /*! \brief associate a generic vertex attribute index with a named attribute variable
  *
@@ -1431,7 +1884,6 @@ GLAPI PFNGLDETACHSHADERPROC glad_glDetachShader;
  * \ingroup shader
  */
 typedef void (APIENTRYP PFNGLBINDATTRIBLOCATIONPROC)(GLuint program, GLuint index, const GLchar *name);
-GLAPI PFNGLBINDATTRIBLOCATIONPROC glad_glBindAttribLocation;
 #define glBindAttribLocation glad_glBindAttribLocation
 
 /*! \brief enable or disable a generic vertex attribute array
@@ -1446,21 +1898,906 @@ GLAPI PFNGLBINDATTRIBLOCATIONPROC glad_glBindAttribLocation;
  * \ingroup shader
  */
 typedef void (APIENTRYP PFNGLDISABLEVERTEXATTRIBARRAYPROC)(GLuint index);
-GLAPI PFNGLDISABLEVERTEXATTRIBARRAYPROC glad_glDisableVertexAttribArray;
 #define glDisableVertexAttribArray glad_glDisableVertexAttribArray
 typedef void (APIENTRYP PFNGLENABLEVERTEXATTRIBARRAYPROC)(GLuint index);
-GLAPI PFNGLENABLEVERTEXATTRIBARRAYPROC glad_glEnableVertexAttribArray;
 #define glEnableVertexAttribArray glad_glEnableVertexAttribArray
 
+/*! \brief define an array of generic vertex attribute data
+ *
+ * the buffer bound to GL_ARRAY_BUFFER is saved with the array, and \ref pointer is an offset into it.
+ * Without a bound buffer, \ref pointer is client memory in GL 2.1 and GL ES 2.0, and an error in GL 4 core,
+ * so for the common subset the attributes always come from a buffer.
+ *
+ * \param index      index of the generic vertex attribute
+ * \param size       components per attribute, 1, 2, 3 or 4
+ * \param type       GL_BYTE, GL_UNSIGNED_BYTE, GL_SHORT, GL_UNSIGNED_SHORT or GL_FLOAT
+ * \param normalized whether integer values are mapped to [-1,1] or [0,1] (GL_TRUE) or converted directly
+ * \param stride     bytes from one attribute to the next, 0 for tightly packed
+ * \param pointer    byte offset of the first attribute in the buffer
+ *
+ * \errors GL_INVALID_ENUM      if \ref type is not an accepted value
+ *         GL_INVALID_VALUE     if \ref index >= GL_MAX_VERTEX_ATTRIBS, \ref size is not 1 to 4 or \ref stride < 0
+ *         GL_INVALID_OPERATION if no buffer is bound and \ref pointer is not NULL only in GL 4
+ *
+ * \ingroup shader
+ */
+typedef void (APIENTRYP PFNGLVERTEXATTRIBPOINTERPROC)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer);
+#define glVertexAttribPointer glad_glVertexAttribPointer
+
 /*! \brief return information about an active attribute variable (for the specified program object)
  *
  *
  */
 typedef void (APIENTRYP PFNGLGETACTIVEATTRIBPROC)(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name);
-GLAPI PFNGLGETACTIVEATTRIBPROC glad_glGetActiveAttrib;
 #define glGetActiveAttrib glad_glGetActiveAttrib
 
 
+/*! \brief table of all loaded entry points
+ *
+ * one slot per function of this header, in the order of the reference pages.
+ * The glad_gl* names used by the macros above are aliases of the members of \ref cgl_dispatch,
+ * so they can still be checked against NULL or overwritten as before.
+ * \ref slot gives the same pointers as an array, which is what the loader iterates over.
+ *
+ * Without CGL_MULTI_CONTEXT the aliases name the members of cgl_dispatch directly, so a call costs
+ * exactly one load from a fixed address, as with glad. With it, they go through the thread-local
+ * pointer cgl_current_dispatch instead, see cglCreateContext.
+ *
+ * With CGL_DIRECT_LINK, there is no table lookup at all: the aliases name the GL functions
+ * themselves, declared as ordinary extern functions, and the program has to be linked against
+ * a library exporting all of them, e.g. -lGL (Mesa, or libOpenGL with GLVND) or -lGLESv2.
+ * For the latter, also define CGL_DIRECT_LINK_ES, which maps glClearDepth and glDepthRange to
+ * glClearDepthf and glDepthRangef, as GL ES 2.0 only has those.
+ * cglLoadGL and cglLoadGLLazy do nothing in this mode, so the calling code stays the same.
+ * This must be set the same way for cgl.c and all users of this header.
+ * (Windows' opengl32.dll only exports GL 1.1, so this mode is of no use there.)
+ *
+ * The section between the cglgen markers is generated by cglgen.py, do not edit it by hand.
+ */
+/* cglgen:begin dispatch */
+#define CGL_DISPATCH_COUNT 83
+
+typedef union CGL_CACHE_ALIGNED CGLDispatch {
+    struct {
+        PFNGLACTIVETEXTUREPROC            ActiveTexture;
+        PFNGLATTACHSHADERPROC             AttachShader;
+        PFNGLBINDATTRIBLOCATIONPROC       BindAttribLocation;
+        PFNGLBINDBUFFERPROC               BindBuffer;
+        PFNGLBINDTEXTUREPROC              BindTexture;
+        PFNGLBLENDCOLORPROC               BlendColor;
+        PFNGLBLENDEQUATIONPROC            BlendEquation;
+        PFNGLBLENDEQUATIONSEPARATEPROC    BlendEquationSeparate;
+        PFNGLBLENDFUNCPROC                BlendFunc;
+        PFNGLBLENDFUNCSEPARATEPROC        BlendFuncSeparate;
+        PFNGLBUFFERDATAPROC               BufferData;
+        PFNGLBUFFERSUBDATAPROC            BufferSubData;
+        PFNGLCLEARPROC                    Clear;
+        PFNGLCLEARCOLORPROC               ClearColor;
+        PFNGLCLEARDEPTHPROC               ClearDepth;
+        PFNGLCLEARSTENCILPROC             ClearStencil;
+        PFNGLCOLORMASKPROC                ColorMask;
+        PFNGLCOMPILESHADERPROC            CompileShader;
+        PFNGLCOPYTEXIMAGE2DPROC           CopyTexImage2D;
+        PFNGLCOPYTEXSUBIMAGE2DPROC        CopyTexSubImage2D;
+        PFNGLCREATEPROGRAMPROC            CreateProgram;
+        PFNGLCREATESHADERPROC             CreateShader;
+        PFNGLCULLFACEPROC                 CullFace;
+        PFNGLDELETEBUFFERSPROC            DeleteBuffers;
+        PFNGLDELETEPROGRAMPROC            DeleteProgram;
+        PFNGLDELETESHADERPROC             DeleteShader;
+        PFNGLDELETETEXTURESPROC           DeleteTextures;
+        PFNGLDEPTHFUNCPROC                DepthFunc;
+        PFNGLDEPTHMASKPROC                DepthMask;
+        PFNGLDEPTHRANGEPROC               DepthRange;
+        PFNGLDETACHSHADERPROC             DetachShader;
+        PFNGLENABLEPROC                   Enable;
+        PFNGLDISABLEPROC                  Disable;
+        PFNGLENABLEVERTEXATTRIBARRAYPROC  EnableVertexAttribArray;
+        PFNGLDISABLEVERTEXATTRIBARRAYPROC DisableVertexAttribArray;
+        PFNGLDRAWARRAYSPROC               DrawArrays;
+        PFNGLDRAWELEMENTSPROC             DrawElements;
+        PFNGLFINISHPROC                   Finish;
+        PFNGLFLUSHPROC                    Flush;
+        PFNGLFRONTFACEPROC                FrontFace;
+        PFNGLGENBUFFERSPROC               GenBuffers;
+        PFNGLGENTEXTURESPROC              GenTextures;
+        PFNGLGETBOOLEANVPROC              GetBooleanv;
+        PFNGLGETFLOATVPROC                GetFloatv;
+        PFNGLGETINTEGERVPROC              GetIntegerv;
+        PFNGLGETACTIVEATTRIBPROC          GetActiveAttrib;
+        PFNGLGETACTIVEUNIFORMPROC         GetActiveUniform;
+        PFNGLGETERRORPROC                 GetError;
+        PFNGLGETPROGRAMIVPROC             GetProgramiv;
+        PFNGLGETUNIFORMLOCATIONPROC       GetUniformLocation;
+        PFNGLLINKPROGRAMPROC              LinkProgram;
+        PFNGLPIXELSTOREIPROC              PixelStorei;
+        PFNGLPOLYGONOFFSETPROC            PolygonOffset;
+        PFNGLSTENCILFUNCPROC              StencilFunc;
+        PFNGLSTENCILFUNCSEPARATEPROC      StencilFuncSeparate;
+        PFNGLSTENCILMASKPROC              StencilMask;
+        PFNGLSTENCILMASKSEPARATEPROC      StencilMaskSeparate;
+        PFNGLSTENCILOPPROC                StencilOp;
+        PFNGLSTENCILOPSEPARATEPROC        StencilOpSeparate;
+        PFNGLTEXIMAGE2DPROC               TexImage2D;
+        PFNGLTEXPARAMETERIPROC            TexParameteri;
+        PFNGLTEXSUBIMAGE2DPROC            TexSubImage2D;
+        PFNGLUNIFORM1FPROC                Uniform1f;
+        PFNGLUNIFORM2FPROC                Uniform2f;
+        PFNGLUNIFORM3FPROC                Uniform3f;
+        PFNGLUNIFORM4FPROC                Uniform4f;
+        PFNGLUNIFORM1IPROC                Uniform1i;
+        PFNGLUNIFORM2IPROC                Uniform2i;
+        PFNGLUNIFORM3IPROC                Uniform3i;
+        PFNGLUNIFORM4IPROC                Uniform4i;
+        PFNGLUNIFORM1FVPROC               Uniform1fv;
+        PFNGLUNIFORM2FVPROC               Uniform2fv;
+        PFNGLUNIFORM3FVPROC               Uniform3fv;
+        PFNGLUNIFORM4FVPROC               Uniform4fv;
+        PFNGLUNIFORM1IVPROC               Uniform1iv;
+        PFNGLUNIFORM2IVPROC               Uniform2iv;
+        PFNGLUNIFORM3IVPROC               Uniform3iv;
+        PFNGLUNIFORM4IVPROC               Uniform4iv;
+        PFNGLUNIFORMMATRIX2FVPROC         UniformMatrix2fv;
+        PFNGLUNIFORMMATRIX3FVPROC         UniformMatrix3fv;
+        PFNGLUNIFORMMATRIX4FVPROC         UniformMatrix4fv;
+        PFNGLUSEPROGRAMPROC               UseProgram;
+        PFNGLVERTEXATTRIBPOINTERPROC      VertexAttribPointer;
+    } fn;
+    GLADproc slot[CGL_DISPATCH_COUNT];
+} CGLDispatch;
+
+GLAPI CGLDispatch cgl_dispatch;
+
+#ifdef CGL_DIRECT_LINK
+
+#undef glActiveTexture
+#undef glAttachShader
+#undef glBindAttribLocation
+#undef glBindBuffer
+#undef glBindTexture
+#undef glBlendColor
+#undef glBlendEquation
+#undef glBlendEquationSeparate
+#undef glBlendFunc
+#undef glBlendFuncSeparate
+#undef glBufferData
+#undef glBufferSubData
+#undef glClear
+#undef glClearColor
+#undef glClearDepth
+#undef glClearStencil
+#undef glColorMask
+#undef glCompileShader
+#undef glCopyTexImage2D
+#undef glCopyTexSubImage2D
+#undef glCreateProgram
+#undef glCreateShader
+#undef glCullFace
+#undef glDeleteBuffers
+#undef glDeleteProgram
+#undef glDeleteShader
+#undef glDeleteTextures
+#undef glDepthFunc
+#undef glDepthMask
+#undef glDepthRange
+#undef glDetachShader
+#undef glEnable
+#undef glDisable
+#undef glEnableVertexAttribArray
+#undef glDisableVertexAttribArray
+#undef glDrawArrays
+#undef glDrawElements
+#undef glFinish
+#undef glFlush
+#undef glFrontFace
+#undef glGenBuffers
+#undef glGenTextures
+#undef glGetBooleanv
+#undef glGetFloatv
+#undef glGetIntegerv
+#undef glGetActiveAttrib
+#undef glGetActiveUniform
+#undef glGetError
+#undef glGetProgramiv
+#undef glGetUniformLocation
+#undef glLinkProgram
+#undef glPixelStorei
+#undef glPolygonOffset
+#undef glStencilFunc
+#undef glStencilFuncSeparate
+#undef glStencilMask
+#undef glStencilMaskSeparate
+#undef glStencilOp
+#undef glStencilOpSeparate
+#undef glTexImage2D
+#undef glTexParameteri
+#undef glTexSubImage2D
+#undef glUniform1f
+#undef glUniform2f
+#undef glUniform3f
+#undef glUniform4f
+#undef glUniform1i
+#undef glUniform2i
+#undef glUniform3i
+#undef glUniform4i
+#undef glUniform1fv
+#undef glUniform2fv
+#undef glUniform3fv
+#undef glUniform4fv
+#undef glUniform1iv
+#undef glUniform2iv
+#undef glUniform3iv
+#undef glUniform4iv
+#undef glUniformMatrix2fv
+#undef glUniformMatrix3fv
+#undef glUniformMatrix4fv
+#undef glUseProgram
+#undef glVertexAttribPointer
+
+#define glad_glActiveTexture            glActiveTexture
+#define glad_glAttachShader             glAttachShader
+#define glad_glBindAttribLocation       glBindAttribLocation
+#define glad_glBindBuffer               glBindBuffer
+#define glad_glBindTexture              glBindTexture
+#define glad_glBlendColor               glBlendColor
+#define glad_glBlendEquation            glBlendEquation
+#define glad_glBlendEquationSeparate    glBlendEquationSeparate
+#define glad_glBlendFunc                glBlendFunc
+#define glad_glBlendFuncSeparate        glBlendFuncSeparate
+#define glad_glBufferData               glBufferData
+#define glad_glBufferSubData            glBufferSubData
+#define glad_glClear                    glClear
+#define glad_glClearColor               glClearColor
+#define glad_glClearDepth               glClearDepth
+#define glad_glClearStencil             glClearStencil
+#define glad_glColorMask                glColorMask
+#define glad_glCompileShader            glCompileShader
+#define glad_glCopyTexImage2D           glCopyTexImage2D
+#define glad_glCopyTexSubImage2D        glCopyTexSubImage2D
+#define glad_glCreateProgram            glCreateProgram
+#define glad_glCreateShader             glCreateShader
+#define glad_glCullFace                 glCullFace
+#define glad_glDeleteBuffers            glDeleteBuffers
+#define glad_glDeleteProgram            glDeleteProgram
+#define glad_glDeleteShader             glDeleteShader
+#define glad_glDeleteTextures           glDeleteTextures
+#define glad_glDepthFunc                glDepthFunc
+#define glad_glDepthMask                glDepthMask
+#define glad_glDepthRange               glDepthRange
+#define glad_glDetachShader             glDetachShader
+#define glad_glEnable                   glEnable
+#define glad_glDisable                  glDisable
+#define glad_glEnableVertexAttribArray  glEnableVertexAttribArray
+#define glad_glDisableVertexAttribArray glDisableVertexAttribArray
+#define glad_glDrawArrays               glDrawArrays
+#define glad_glDrawElements             glDrawElements
+#define glad_glFinish                   glFinish
+#define glad_glFlush                    glFlush
+#define glad_glFrontFace                glFrontFace
+#define glad_glGenBuffers               glGenBuffers
+#define glad_glGenTextures              glGenTextures
+#define glad_glGetBooleanv              glGetBooleanv
+#define glad_glGetFloatv                glGetFloatv
+#define glad_glGetIntegerv              glGetIntegerv
+#define glad_glGetActiveAttrib          glGetActiveAttrib
+#define glad_glGetActiveUniform         glGetActiveUniform
+#define glad_glGetError                 glGetError
+#define glad_glGetProgramiv             glGetProgramiv
+#define glad_glGetUniformLocation       glGetUniformLocation
+#define glad_glLinkProgram              glLinkProgram
+#define glad_glPixelStorei              glPixelStorei
+#define glad_glPolygonOffset            glPolygonOffset
+#define glad_glStencilFunc              glStencilFunc
+#define glad_glStencilFuncSeparate      glStencilFuncSeparate
+#define glad_glStencilMask              glStencilMask
+#define glad_glStencilMaskSeparate      glStencilMaskSeparate
+#define glad_glStencilOp                glStencilOp
+#define glad_glStencilOpSeparate        glStencilOpSeparate
+#define glad_glTexImage2D               glTexImage2D
+#define glad_glTexParameteri            glTexParameteri
+#define glad_glTexSubImage2D            glTexSubImage2D
+#define glad_glUniform1f                glUniform1f
+#define glad_glUniform2f                glUniform2f
+#define glad_glUniform3f                glUniform3f
+#define glad_glUniform4f                glUniform4f
+#define glad_glUniform1i                glUniform1i
+#define glad_glUniform2i                glUniform2i
+#define glad_glUniform3i                glUniform3i
+#define glad_glUniform4i                glUniform4i
+#define glad_glUniform1fv               glUniform1fv
+#define glad_glUniform2fv               glUniform2fv
+#define glad_glUniform3fv               glUniform3fv
+#define glad_glUniform4fv               glUniform4fv
+#define glad_glUniform1iv               glUniform1iv
+#define glad_glUniform2iv               glUniform2iv
+#define glad_glUniform3iv               glUniform3iv
+#define glad_glUniform4iv               glUniform4iv
+#define glad_glUniformMatrix2fv         glUniformMatrix2fv
+#define glad_glUniformMatrix3fv         glUniformMatrix3fv
+#define glad_glUniformMatrix4fv         glUniformMatrix4fv
+#define glad_glUseProgram               glUseProgram
+#define glad_glVertexAttribPointer      glVertexAttribPointer
+
+extern void APIENTRY glActiveTexture(GLenum texture);
+extern void APIENTRY glAttachShader(GLuint program, GLuint shader);
+extern void APIENTRY glBindAttribLocation(GLuint program, GLuint index, const GLchar *name);
+extern void APIENTRY glBindBuffer(GLenum target, GLuint buffer);
+extern void APIENTRY glBindTexture(GLenum target, GLuint texture);
+extern void APIENTRY glBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+extern void APIENTRY glBlendEquation(GLenum mode);
+extern void APIENTRY glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha);
+extern void APIENTRY glBlendFunc(GLenum sfactor, GLenum dfactor);
+extern void APIENTRY glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
+extern void APIENTRY glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage);
+extern void APIENTRY glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data);
+extern void APIENTRY glClear(GLbitfield mask);
+extern void APIENTRY glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+extern void APIENTRY glClearDepth(GLdouble depth);
+extern void APIENTRY glClearStencil(GLint s);
+extern void APIENTRY glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+extern void APIENTRY glCompileShader(GLuint shader);
+extern void APIENTRY glCopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border);
+extern void APIENTRY glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height);
+extern GLuint APIENTRY glCreateProgram(void);
+extern GLuint APIENTRY glCreateShader(GLenum type);
+extern void APIENTRY glCullFace(GLenum mode);
+extern void APIENTRY glDeleteBuffers(GLsizei n, const GLuint *buffers);
+extern void APIENTRY glDeleteProgram(GLuint program);
+extern void APIENTRY glDeleteShader(GLuint shader);
+extern void APIENTRY glDeleteTextures(GLsizei n, const GLuint *textures);
+extern void APIENTRY glDepthFunc(GLenum func);
+extern void APIENTRY glDepthMask(GLboolean flag);
+extern void APIENTRY glDepthRange(GLdouble n, GLdouble f);
+extern void APIENTRY glDetachShader(GLuint program, GLuint shader);
+extern void APIENTRY glEnable(GLenum cap);
+extern void APIENTRY glDisable(GLenum cap);
+extern void APIENTRY glEnableVertexAttribArray(GLuint index);
+extern void APIENTRY glDisableVertexAttribArray(GLuint index);
+extern void APIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count);
+extern void APIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices);
+extern void APIENTRY glFinish(void);
+extern void APIENTRY glFlush(void);
+extern void APIENTRY glFrontFace(GLenum mode);
+extern void APIENTRY glGenBuffers(GLsizei n, GLuint *buffers);
+extern void APIENTRY glGenTextures(GLsizei n, GLuint *textures);
+extern void APIENTRY glGetBooleanv(GLenum pname, GLboolean *data);
+extern void APIENTRY glGetFloatv(GLenum pname, GLfloat *data);
+extern void APIENTRY glGetIntegerv(GLenum pname, GLint *data);
+extern void APIENTRY glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name);
+extern void APIENTRY glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name);
+extern GLenum APIENTRY glGetError(void);
+extern void APIENTRY glGetProgramiv(GLuint program, GLenum pname, GLint *params);
+extern GLint APIENTRY glGetUniformLocation(GLuint program, const GLchar *name);
+extern void APIENTRY glLinkProgram(GLuint program);
+extern void APIENTRY glPixelStorei(GLenum pname, GLint param);
+extern void APIENTRY glPolygonOffset(GLfloat factor, GLfloat units);
+extern void APIENTRY glStencilFunc(GLenum func, GLint ref, GLuint mask);
+extern void APIENTRY glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+extern void APIENTRY glStencilMask(GLuint mask);
+extern void APIENTRY glStencilMaskSeparate(GLenum face, GLuint mask);
+extern void APIENTRY glStencilOp(GLenum sfail, GLenum dpfail, GLenum dppass);
+extern void APIENTRY glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
+extern void APIENTRY glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *data);
+extern void APIENTRY glTexParameteri(GLenum target, GLenum pname, GLint param);
+extern void APIENTRY glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *data);
+extern void APIENTRY glUniform1f(GLint location, GLfloat v0);
+extern void APIENTRY glUniform2f(GLint location, GLfloat v0, GLfloat v1);
+extern void APIENTRY glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+extern void APIENTRY glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+extern void APIENTRY glUniform1i(GLint location, GLint v0);
+extern void APIENTRY glUniform2i(GLint location, GLint v0, GLint v1);
+extern void APIENTRY glUniform3i(GLint location, GLint v0, GLint v1, GLint v2);
+extern void APIENTRY glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3);
+extern void APIENTRY glUniform1fv(GLint location, GLsizei count, const GLfloat *value);
+extern void APIENTRY glUniform2fv(GLint location, GLsizei count, const GLfloat *value);
+extern void APIENTRY glUniform3fv(GLint location, GLsizei count, const GLfloat *value);
+extern void APIENTRY glUniform4fv(GLint location, GLsizei count, const GLfloat *value);
+extern void APIENTRY glUniform1iv(GLint location, GLsizei count, const GLint *value);
+extern void APIENTRY glUniform2iv(GLint location, GLsizei count, const GLint *value);
+extern void APIENTRY glUniform3iv(GLint location, GLsizei count, const GLint *value);
+extern void APIENTRY glUniform4iv(GLint location, GLsizei count, const GLint *value);
+extern void APIENTRY glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+extern void APIENTRY glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+extern void APIENTRY glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+extern void APIENTRY glUseProgram(GLuint program);
+extern void APIENTRY glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer);
+
+#else
+
+#define glad_glActiveTexture            CGL_CURRENT_DISPATCH->fn.ActiveTexture
+#define glad_glAttachShader             CGL_CURRENT_DISPATCH->fn.AttachShader
+#define glad_glBindAttribLocation       CGL_CURRENT_DISPATCH->fn.BindAttribLocation
+#define glad_glBindBuffer               CGL_CURRENT_DISPATCH->fn.BindBuffer
+#define glad_glBindTexture              CGL_CURRENT_DISPATCH->fn.BindTexture
+#define glad_glBlendColor               CGL_CURRENT_DISPATCH->fn.BlendColor
+#define glad_glBlendEquation            CGL_CURRENT_DISPATCH->fn.BlendEquation
+#define glad_glBlendEquationSeparate    CGL_CURRENT_DISPATCH->fn.BlendEquationSeparate
+#define glad_glBlendFunc                CGL_CURRENT_DISPATCH->fn.BlendFunc
+#define glad_glBlendFuncSeparate        CGL_CURRENT_DISPATCH->fn.BlendFuncSeparate
+#define glad_glBufferData               CGL_CURRENT_DISPATCH->fn.BufferData
+#define glad_glBufferSubData            CGL_CURRENT_DISPATCH->fn.BufferSubData
+#define glad_glClear                    CGL_CURRENT_DISPATCH->fn.Clear
+#define glad_glClearColor               CGL_CURRENT_DISPATCH->fn.ClearColor
+#define glad_glClearDepth               CGL_CURRENT_DISPATCH->fn.ClearDepth
+#define glad_glClearStencil             CGL_CURRENT_DISPATCH->fn.ClearStencil
+#define glad_glColorMask                CGL_CURRENT_DISPATCH->fn.ColorMask
+#define glad_glCompileShader            CGL_CURRENT_DISPATCH->fn.CompileShader
+#define glad_glCopyTexImage2D           CGL_CURRENT_DISPATCH->fn.CopyTexImage2D
+#define glad_glCopyTexSubImage2D        CGL_CURRENT_DISPATCH->fn.CopyTexSubImage2D
+#define glad_glCreateProgram            CGL_CURRENT_DISPATCH->fn.CreateProgram
+#define glad_glCreateShader             CGL_CURRENT_DISPATCH->fn.CreateShader
+#define glad_glCullFace                 CGL_CURRENT_DISPATCH->fn.CullFace
+#define glad_glDeleteBuffers            CGL_CURRENT_DISPATCH->fn.DeleteBuffers
+#define glad_glDeleteProgram            CGL_CURRENT_DISPATCH->fn.DeleteProgram
+#define glad_glDeleteShader             CGL_CURRENT_DISPATCH->fn.DeleteShader
+#define glad_glDeleteTextures           CGL_CURRENT_DISPATCH->fn.DeleteTextures
+#define glad_glDepthFunc                CGL_CURRENT_DISPATCH->fn.DepthFunc
+#define glad_glDepthMask                CGL_CURRENT_DISPATCH->fn.DepthMask
+#define glad_glDepthRange               CGL_CURRENT_DISPATCH->fn.DepthRange
+#define glad_glDetachShader             CGL_CURRENT_DISPATCH->fn.DetachShader
+#define glad_glEnable                   CGL_CURRENT_DISPATCH->fn.Enable
+#define glad_glDisable                  CGL_CURRENT_DISPATCH->fn.Disable
+#define glad_glEnableVertexAttribArray  CGL_CURRENT_DISPATCH->fn.EnableVertexAttribArray
+#define glad_glDisableVertexAttribArray CGL_CURRENT_DISPATCH->fn.DisableVertexAttribArray
+#define glad_glDrawArrays               CGL_CURRENT_DISPATCH->fn.DrawArrays
+#define glad_glDrawElements             CGL_CURRENT_DISPATCH->fn.DrawElements
+#define glad_glFinish                   CGL_CURRENT_DISPATCH->fn.Finish
+#define glad_glFlush                    CGL_CURRENT_DISPATCH->fn.Flush
+#define glad_glFrontFace                CGL_CURRENT_DISPATCH->fn.FrontFace
+#define glad_glGenBuffers               CGL_CURRENT_DISPATCH->fn.GenBuffers
+#define glad_glGenTextures              CGL_CURRENT_DISPATCH->fn.GenTextures
+#define glad_glGetBooleanv              CGL_CURRENT_DISPATCH->fn.GetBooleanv
+#define glad_glGetFloatv                CGL_CURRENT_DISPATCH->fn.GetFloatv
+#define glad_glGetIntegerv              CGL_CURRENT_DISPATCH->fn.GetIntegerv
+#define glad_glGetActiveAttrib          CGL_CURRENT_DISPATCH->fn.GetActiveAttrib
+#define glad_glGetActiveUniform         CGL_CURRENT_DISPATCH->fn.GetActiveUniform
+#define glad_glGetError                 CGL_CURRENT_DISPATCH->fn.GetError
+#define glad_glGetProgramiv             CGL_CURRENT_DISPATCH->fn.GetProgramiv
+#define glad_glGetUniformLocation       CGL_CURRENT_DISPATCH->fn.GetUniformLocation
+#define glad_glLinkProgram              CGL_CURRENT_DISPATCH->fn.LinkProgram
+#define glad_glPixelStorei              CGL_CURRENT_DISPATCH->fn.PixelStorei
+#define glad_glPolygonOffset            CGL_CURRENT_DISPATCH->fn.PolygonOffset
+#define glad_glStencilFunc              CGL_CURRENT_DISPATCH->fn.StencilFunc
+#define glad_glStencilFuncSeparate      CGL_CURRENT_DISPATCH->fn.StencilFuncSeparate
+#define glad_glStencilMask              CGL_CURRENT_DISPATCH->fn.StencilMask
+#define glad_glStencilMaskSeparate      CGL_CURRENT_DISPATCH->fn.StencilMaskSeparate
+#define glad_glStencilOp                CGL_CURRENT_DISPATCH->fn.StencilOp
+#define glad_glStencilOpSeparate        CGL_CURRENT_DISPATCH->fn.StencilOpSeparate
+#define glad_glTexImage2D               CGL_CURRENT_DISPATCH->fn.TexImage2D
+#define glad_glTexParameteri            CGL_CURRENT_DISPATCH->fn.TexParameteri
+#define glad_glTexSubImage2D            CGL_CURRENT_DISPATCH->fn.TexSubImage2D
+#define glad_glUniform1f                CGL_CURRENT_DISPATCH->fn.Uniform1f
+#define glad_glUniform2f                CGL_CURRENT_DISPATCH->fn.Uniform2f
+#define glad_glUniform3f                CGL_CURRENT_DISPATCH->fn.Uniform3f
+#define glad_glUniform4f                CGL_CURRENT_DISPATCH->fn.Uniform4f
+#define glad_glUniform1i                CGL_CURRENT_DISPATCH->fn.Uniform1i
+#define glad_glUniform2i                CGL_CURRENT_DISPATCH->fn.Uniform2i
+#define glad_glUniform3i                CGL_CURRENT_DISPATCH->fn.Uniform3i
+#define glad_glUniform4i                CGL_CURRENT_DISPATCH->fn.Uniform4i
+#define glad_glUniform1fv               CGL_CURRENT_DISPATCH->fn.Uniform1fv
+#define glad_glUniform2fv               CGL_CURRENT_DISPATCH->fn.Uniform2fv
+#define glad_glUniform3fv               CGL_CURRENT_DISPATCH->fn.Uniform3fv
+#define glad_glUniform4fv               CGL_CURRENT_DISPATCH->fn.Uniform4fv
+#define glad_glUniform1iv               CGL_CURRENT_DISPATCH->fn.Uniform1iv
+#define glad_glUniform2iv               CGL_CURRENT_DISPATCH->fn.Uniform2iv
+#define glad_glUniform3iv               CGL_CURRENT_DISPATCH->fn.Uniform3iv
+#define glad_glUniform4iv               CGL_CURRENT_DISPATCH->fn.Uniform4iv
+#define glad_glUniformMatrix2fv         CGL_CURRENT_DISPATCH->fn.UniformMatrix2fv
+#define glad_glUniformMatrix3fv         CGL_CURRENT_DISPATCH->fn.UniformMatrix3fv
+#define glad_glUniformMatrix4fv         CGL_CURRENT_DISPATCH->fn.UniformMatrix4fv
+#define glad_glUseProgram               CGL_CURRENT_DISPATCH->fn.UseProgram
+#define glad_glVertexAttribPointer      CGL_CURRENT_DISPATCH->fn.VertexAttribPointer
+
+#endif /* CGL_DIRECT_LINK */
+/* cglgen:end dispatch */
+
+
+#ifndef CGL_DIRECT_LINK
+
+/*! \brief result of cglLoadGLFromLibrary
+ *
+ * \ref missing_mask has bit (i % 32) of word i / 32 set for every slot i of the dispatch table
+ * that could not be loaded, see cglSymbolName for the name of the function in the slot.
+ */
+typedef struct CGLLoadReport {
+    unsigned int loaded;    /*!< number of functions found */
+    unsigned int missing;   /*!< number of functions not found, CGL_DISPATCH_COUNT if there was no library */
+    unsigned long missing_mask[(CGL_DISPATCH_COUNT + 31) / 32];
+} CGLLoadReport;
+
+/*! \brief loads the GL functions directly from the GL library
+ *
+ * for programs without a windowing library to supply a loader function, e.g. headless rendering
+ * with EGL or offscreen contexts. Opens \ref path, or if that is NULL, the first one
+ * of the usual GL libraries found: libGL.so.1, libOpenGL.so.0, libGLESv2.so.2 (then the same without
+ * version), opengl32.dll on Windows or the OpenGL framework on macOS, and loads all functions
+ * from it into the current dispatch table, like cglLoadGL.
+ *
+ * On Linux, the functions are searched for directly in the symbol table of the library, with hashes
+ * computed at build time, which is faster than dlsym; other systems use dlsym or GetProcAddress.
+ * The library is never unloaded. Depending on the system, linking may need -ldl.
+ *
+ * \param path file name or path of the library to load, or NULL to try the default ones
+ *
+ * \return which functions were found, all of them missing if no library could be opened
+ */
+GLAPI CGLLoadReport cglLoadGLFromLibrary(const char *path);
+
+/*! \brief name of the function in a slot of the dispatch table
+ *
+ * \param slot index into CGLDispatch::slot, less than CGL_DISPATCH_COUNT
+ *
+ * \return the name, e.g. "glActiveTexture", or NULL if \ref slot is out of range
+ */
+GLAPI const char *cglSymbolName(unsigned int slot);
+
+/*! \brief resolve the lazy stubs left in a copy of a dispatch table
+ *
+ * for code keeping its own copy of the table, like the render thread proxy of cglcmd.h:
+ * stubs set up by cglLoadGLLazy only replace themselves in the current table, so in a copy they
+ * would resolve their function again on each call. This replaces them by the real functions,
+ * using the loader of the current table, so the GL context has to be current on the calling thread.
+ *
+ * \param table the table to update, slots that don't hold a lazy stub are left alone
+ */
+GLAPI void cglResolveLazy(CGLDispatch *table);
+
+#endif /* CGL_DIRECT_LINK */
+
+
+#if defined(CGL_DIRECT_LINK) && defined(CGL_DIRECT_LINK_ES)
+#undef glClearDepthf
+#undef glDepthRangef
+#undef glad_glClearDepth
+#undef glad_glDepthRange
+extern void APIENTRY glClearDepthf(GLfloat d);
+extern void APIENTRY glDepthRangef(GLfloat n, GLfloat f);
+CGL_INLINE void APIENTRY cgl_glClearDepth(GLdouble depth) {
+    glClearDepthf((GLfloat) depth);
+}
+CGL_INLINE void APIENTRY cgl_glDepthRange(GLdouble n, GLdouble f) {
+    glDepthRangef((GLfloat) n, (GLfloat) f);
+}
+#define glad_glClearDepth cgl_glClearDepth
+#define glad_glDepthRange cgl_glDepthRange
+#define glClearDepth glad_glClearDepth
+#define glDepthRange glad_glDepthRange
+#endif
+
+
+#if defined(CGL_MULTI_CONTEXT) && defined(CGL_DIRECT_LINK)
+#error CGL_MULTI_CONTEXT and CGL_DIRECT_LINK exclude each other, directly linked functions cannot be switched per context
+#endif
+
+/*! \brief implementation dependent limits of the GL context
+ *
+ * the values that can't be changed by the user, but are needed to use the API correctly, e.g. the
+ * number of texture units for glActiveTexture. These are constant for a context, but querying them
+ * by glGet in the middle of a frame can stall the pipeline like any other glGet, since on threaded
+ * drivers the query has to wait for all previous commands. So rather than asking GL again each time,
+ * read them once with cglLoadLimits and use the copy through cglGetLimits.
+ *
+ * Limits that only exist in some of the APIs (see the comments) are -1 where not supported.
+ */
+typedef struct CGLLimits {
+    GLint max_combined_texture_image_units; /*!< texture units of vertex+fragment shader, at least 2 / 8 (GL 2.1 / ES 2.0) */
+    GLint max_texture_image_units;          /*!< texture units of the fragment shader, at least 2 / 8 */
+    GLint max_vertex_texture_image_units;   /*!< texture units of the vertex shader, can be 0 */
+    GLint max_texture_size;                 /*!< rough limit for the width and height of textures, at least 64 */
+    GLint max_cube_map_texture_size;        /*!< rough limit for cube map faces, at least 16 */
+    GLint max_viewport_dims[2];             /*!< maximum viewport width and height */
+    GLint max_vertex_attribs;               /*!< number of vec4 vertex attributes, at least 8 */
+    GLint max_vertex_uniform_vectors;       /*!< vec4 uniforms of the vertex shader (GL 2.1: components / 4) */
+    GLint max_fragment_uniform_vectors;     /*!< vec4 uniforms of the fragment shader (GL 2.1: components / 4) */
+    GLint num_compressed_texture_formats;   /*!< can be 0 */
+    GLint subpixel_bits;                    /*!< at least 4 */
+    GLint sample_buffers;                   /*!< of the framebuffer */
+    GLint samples;                          /*!< coverage mask size of the framebuffer */
+    GLint stencil_bits;                     /*!< -1 in GL 4 core profile */
+    GLint implementation_color_read_format; /*!< second format allowed by glReadPixels, -1 in GL 2.1 */
+    GLint implementation_color_read_type;   /*!< second type allowed by glReadPixels, -1 in GL 2.1 */
+    GLint shader_compiler;                  /*!< GL_TRUE if shaders can be compiled (always for desktop GL) */
+    GLfloat aliased_line_width_range[2];    /*!< smallest and largest width for glLineWidth */
+    GLfloat smooth_line_width_range[2];     /*!< the same for antialiased lines, -1 in GL ES 2.0 */
+    GLfloat smooth_line_width_granularity;  /*!< -1 in GL ES 2.0 */
+} CGLLimits;
+
+/*! \brief read all implementation dependent limits into the current CGLLimits
+ *
+ * queries everything in CGLLimits in a single batch of glGetIntegerv and glGetFloatv calls, to be
+ * called once after loading the functions (and again when the context changes). Limits not supported by
+ * the API generate GL_INVALID_ENUM, so the error flags are reset afterwards by glGetError, which means
+ * that errors from before the call are lost as well.
+ */
+GLAPI void cglLoadLimits(void);
+
+#ifdef CGL_MULTI_CONTEXT
+
+#ifndef CGL_THREAD_LOCAL
+#error CGL_MULTI_CONTEXT needs thread-local storage, define CGL_THREAD_LOCAL for this compiler
+#endif
+
+/*! \brief function table of one GL context
+ *
+ * only available if both cgl.c and the users of this header are compiled with CGL_MULTI_CONTEXT.
+ *
+ * Entry points are, strictly speaking, only valid for the GL context they were loaded with.
+ * For programs with more than one GL context, e.g. one per worker thread for offscreen
+ * rendering, every GL context gets its own CGLContext, holding its own dispatch table.
+ * Each thread has a current CGLContext, and the glFoo macros call through its table.
+ * Threads without one use the shared cgl_dispatch, so the single context case keeps working
+ * unchanged, only with one more (thread-local) load per call.
+ *
+ * typical use, on the thread where the GL context is current:
+ *      CGLContext *context = cglCreateContext();
+ *      cglMakeCurrent(context);
+ *      cglLoadGL(loader);              (or cglLoadGLLazy, both load into the current table)
+ *
+ * This does not create a GL context, that still has to be done by the windowing library;
+ * likewise, cglMakeCurrent has to be called whenever the GL context is made current on another thread.
+ */
+typedef struct CGLContext CGLContext;
+
+/*! \brief create an empty function table, with all pointers NULL
+ *
+ * \return the new table, or NULL if there is not enough memory
+ */
+GLAPI CGLContext *cglCreateContext(void);
+
+/*! \brief free a function table created by cglCreateContext
+ *
+ * must not be current on any thread anymore. \ref context == NULL is ignored
+ */
+GLAPI void cglDestroyContext(CGLContext *context);
+
+/*! \brief make the table of \ref context the one used by the calling thread
+ *
+ * \param context the table to use, or NULL to return to the shared cgl_dispatch
+ */
+GLAPI void cglMakeCurrent(CGLContext *context);
+
+/*! \brief return the table used by the calling thread, or NULL if it's the shared cgl_dispatch */
+GLAPI CGLContext *cglGetCurrentContext(void);
+
+GLAPI CGL_THREAD_LOCAL CGLDispatch *cgl_current_dispatch;
+GLAPI CGL_THREAD_LOCAL CGLLimits *cgl_current_limits;
+#define CGL_CURRENT_DISPATCH cgl_current_dispatch
+#define CGL_CURRENT_LIMITS cgl_current_limits
+
+#else
+
+#define CGL_CURRENT_DISPATCH (&cgl_dispatch)
+#define CGL_CURRENT_LIMITS (&cgl_limits)
+
+#endif /* CGL_MULTI_CONTEXT */
+
+GLAPI CGLLimits cgl_limits;
+
+/*! \brief the limits of the current context, as read by cglLoadLimits
+ *
+ * just returns a pointer, so this can be used freely in hot code instead of glGet.
+ */
+CGL_INLINE const CGLLimits *cglGetLimits(void) {
+    return CGL_CURRENT_LIMITS;
+}
+
+
+#ifndef CGL_DIRECT_LINK
+
+/*! \brief call counters of the state caches
+ *
+ * indexed by dispatch slot like CGLDispatch::slot (cglSymbolName gives the function name),
+ * only the slots of functions replaced by a cache count anything.
+ */
+typedef struct CGLCacheStats {
+    unsigned long calls[CGL_DISPATCH_COUNT];    /*!< calls made by the program */
+    unsigned long filtered[CGL_DISPATCH_COUNT]; /*!< calls that changed nothing and were not passed on to GL */
+} CGLCacheStats;
+
+/*! \brief put the shadow-state cache in front of the fixed function state setters
+ *
+ * replaces glEnable, glDisable, glBlendFunc, glBlendFuncSeparate, glBlendEquation,
+ * glBlendEquationSeparate, glBlendColor, glDepthFunc, glDepthMask, glColorMask, glCullFace,
+ * glFrontFace and glDepthRange in the current dispatch table by versions that keep a copy
+ * of the state and drop every call that would set the value that is already there.
+ * Nothing else changes for the calling code, it can keep setting all of its state before each draw.
+ *
+ * The copy starts out with the initial values of a new GL context, so this should be called right after
+ * loading, or else followed by cglInvalidateStateCache. Capabilities of glEnable other than the ones
+ * of the common subset are passed on unfiltered, as are calls made while the cache doesn't know the value.
+ * As the cache doesn't check the arguments, repeating a call with an invalid argument will generate
+ * the GL error only the first time.
+ *
+ * Everything is kept per dispatch table, so with CGL_MULTI_CONTEXT this has to be done for each
+ * CGLContext. Not available with CGL_DIRECT_LINK, since there is no table to change.
+ */
+GLAPI void cglEnableStateCache(void);
+
+/*! \brief restore the functions replaced by cglEnableStateCache */
+GLAPI void cglDisableStateCache(void);
+
+/*! \brief put the binding cache in front of the bind functions
+ *
+ * replaces glBindBuffer, glActiveTexture, glBindTexture and glUseProgram in the current dispatch table
+ * by versions that skip binding what is already bound, like cglEnableStateCache does for the fixed function state.
+ * Tracked are the buffers bound to GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER, the active texture unit,
+ * the GL_TEXTURE_2D and GL_TEXTURE_CUBE_MAP textures of the first 32 units and the program in use.
+ * Other targets and units are passed on unfiltered.
+ *
+ * glDeleteBuffers and glDeleteTextures are replaced as well, since deleting a bound buffer or texture
+ * reverts its bindings to 0. glDeleteProgram is not, as the program in use stays in use after
+ * it was deleted, and its name can't be given out again before it's no longer in use.
+ *
+ * The bindings start out as in a new GL context, so this should be called right after loading.
+ */
+GLAPI void cglEnableBindingCache(void);
+
+/*! \brief restore the functions replaced by cglEnableBindingCache */
+GLAPI void cglDisableBindingCache(void);
+
+/*! \brief put the uniform cache in front of glGetUniformLocation and the glUniform functions
+ *
+ * keeps, for each program, the locations already asked for by name, and a shadow copy of the value
+ * last set at each location. glGetUniformLocation answers from the copy after the first call for a name,
+ * and glUniform calls that set the value already there, or set location -1, are dropped.
+ * Calls for arrays (count above 1) are passed on, and make the values of the locations they set unknown.
+ *
+ * glUseProgram, glLinkProgram and glDeleteProgram are replaced as well: linking sets new locations and
+ * resets all values, so the copies of a program are forgotten when it is linked or deleted.
+ * Works together with cglEnableBindingCache, which shares the replaced glUseProgram.
+ *
+ * Like the other caches, this assumes the program in use only changes through the dispatch table,
+ * so it should be called right after loading, or else followed by cglInvalidateStateCache.
+ */
+GLAPI void cglEnableUniformCache(void);
+
+/*! \brief restore the functions replaced by cglEnableUniformCache and free the copies */
+GLAPI void cglDisableUniformCache(void);
+
+/*! \brief forget the state and bindings known to the caches
+ *
+ * for after something changed the GL state without going through the dispatch table,
+ * e.g. another library with its own loader. The next call of each function is passed on to GL.
+ */
+GLAPI void cglInvalidateStateCache(void);
+
+/*! \brief counters of the caches of the current dispatch table, since enabling or the last reset */
+GLAPI const CGLCacheStats *cglGetCacheStats(void);
+
+/*! \brief set all counters of the current dispatch table to 0 */
+GLAPI void cglResetCacheStats(void);
+
+#endif /* CGL_DIRECT_LINK */
+
+
+/*! \brief stencil state of one face, see glStencilFuncSeparate, glStencilOpSeparate and glStencilMaskSeparate */
+typedef struct CGLStencilFace {
+    GLenum func;
+    GLint ref;
+    GLuint value_mask;
+    GLenum sfail;
+    GLenum dpfail;
+    GLenum dppass;
+    GLuint write_mask;
+} CGLStencilFace;
+
+/*! \brief description of the fixed function state of a CGLPipelineState
+ *
+ * the members have the meaning of the arguments of the GL functions setting them;
+ * cglDefaultPipelineDesc gives the initial values of a GL context.
+ */
+typedef struct CGLPipelineDesc {
+    GLboolean blend;                /*!< glEnable(GL_BLEND) */
+    GLenum blend_src_rgb;           /*!< glBlendFuncSeparate */
+    GLenum blend_dst_rgb;
+    GLenum blend_src_alpha;
+    GLenum blend_dst_alpha;
+    GLenum blend_equation_rgb;      /*!< glBlendEquationSeparate */
+    GLenum blend_equation_alpha;
+    GLfloat blend_color[4];         /*!< glBlendColor */
+    GLboolean depth_test;           /*!< glEnable(GL_DEPTH_TEST) */
+    GLenum depth_func;              /*!< glDepthFunc */
+    GLboolean depth_mask;           /*!< glDepthMask */
+    GLboolean stencil_test;         /*!< glEnable(GL_STENCIL_TEST) */
+    CGLStencilFace stencil_front;
+    CGLStencilFace stencil_back;
+    GLboolean cull_face;            /*!< glEnable(GL_CULL_FACE) */
+    GLenum cull_mode;               /*!< glCullFace */
+    GLenum front_face;              /*!< glFrontFace */
+    GLboolean color_mask[4];        /*!< glColorMask */
+    GLboolean polygon_offset_fill;  /*!< glEnable(GL_POLYGON_OFFSET_FILL) */
+    GLfloat polygon_offset_factor;  /*!< glPolygonOffset */
+    GLfloat polygon_offset_units;
+} CGLPipelineDesc;
+
+/*! \brief an immutable bundle of blend, depth, stencil, cull, color mask and polygon offset state
+ *
+ * the common subset has no pipeline objects, so they are emulated: a pipeline is built once from a
+ * CGLPipelineDesc, and cglApplyPipeline then only makes the GL calls for the parts that differ
+ * from the pipeline applied before, instead of setting all of the state for every draw.
+ *
+ * The state last applied is remembered per dispatch table (so per CGLContext with CGL_MULTI_CONTEXT).
+ * If the same state is changed by direct GL calls in between, call cglInvalidatePipeline afterwards.
+ */
+typedef struct CGLPipelineState CGLPipelineState;
+
+/*! \brief fill \ref desc with the initial state of a GL context */
+GLAPI void cglDefaultPipelineDesc(CGLPipelineDesc *desc);
+
+/*! \brief build a pipeline from a description
+ *
+ * \param desc the state of the pipeline, not used anymore after the call
+ *
+ * \return the new pipeline, or NULL if there is not enough memory
+ */
+GLAPI CGLPipelineState *cglCreatePipeline(const CGLPipelineDesc *desc);
+
+/*! \brief free a pipeline created by cglCreatePipeline, NULL is ignored */
+GLAPI void cglDestroyPipeline(CGLPipelineState *pipeline);
+
+/*! \brief set the GL state to the one of \ref pipeline
+ *
+ * compares \ref pipeline with the state last applied and issues only the GL calls for what changed.
+ * The first call after loading or cglInvalidatePipeline sets everything.
+ */
+GLAPI void cglApplyPipeline(const CGLPipelineState *pipeline);
+
+/*! \brief forget the state last applied, so that the next cglApplyPipeline sets all of it */
+GLAPI void cglInvalidatePipeline(void);
+
+
+/*! \brief number of generic vertex attributes a CGLVertexFormat can use, GL ES 2.0 only guarantees 8 */
+#define CGL_VERTEX_FORMAT_ATTRIBS 16
+
+/*! \brief one attribute of a CGLVertexFormat, with the arguments of glVertexAttribPointer */
+typedef struct CGLVertexAttrib {
+    GLuint index;           /*!< generic attribute index, below CGL_VERTEX_FORMAT_ATTRIBS */
+    GLint size;             /*!< components, 1 to 4 */
+    GLenum type;            /*!< GL_BYTE, GL_UNSIGNED_BYTE, GL_SHORT, GL_UNSIGNED_SHORT or GL_FLOAT */
+    GLboolean normalized;
+    GLsizei stride;
+    GLintptr offset;        /*!< in bytes, into \ref buffer */
+    GLuint buffer;          /*!< the source buffer, bound to GL_ARRAY_BUFFER for glVertexAttribPointer */
+} CGLVertexAttrib;
+
+/*! \brief an immutable attribute layout, in place of a vertex array object
+ *
+ * vertex array objects are not part of GL 2.1 and GL ES 2.0, so like CGLPipelineState, a format is built once,
+ * and cglApplyVertexFormat compares it to the format applied before, attribute by attribute: arrays the new format
+ * doesn't use are disabled, new ones enabled, and glVertexAttribPointer (with the glBindBuffer before it)
+ * is only called for attributes whose buffer, offset or layout differs. Drawing meshes that share a buffer
+ * and layout one after another thus costs no attribute calls at all.
+ *
+ * The state last applied is remembered per dispatch table (so per CGLContext with CGL_MULTI_CONTEXT).
+ * If attributes are changed by direct GL calls in between, or a buffer of the applied format is deleted
+ * (which unbinds it from the attribute), call cglInvalidateVertexFormat afterwards.
+ */
+typedef struct CGLVertexFormat CGLVertexFormat;
+
+/*! \brief build a format from its attributes
+ *
+ * \param attribs the attributes, each index at most once, not used anymore after the call
+ * \param count   number of elements of \ref attribs
+ *
+ * \return the new format, or NULL if there is not enough memory or an index is out of range or used twice
+ */
+GLAPI CGLVertexFormat *cglCreateVertexFormat(const CGLVertexAttrib *attribs, unsigned int count);
+
+/*! \brief free a format created by cglCreateVertexFormat, NULL is ignored */
+GLAPI void cglDestroyVertexFormat(CGLVertexFormat *format);
+
+/*! \brief set the vertex attribute arrays to the ones of \ref format
+ *
+ * issues only the calls for the attributes that differ from the format applied last, the first call
+ * after loading or cglInvalidateVertexFormat sets everything. Leaves GL_ARRAY_BUFFER bound to the buffer
+ * of the last attribute that had to be set, if any.
+ */
+GLAPI void cglApplyVertexFormat(const CGLVertexFormat *format);
+
+/*! \brief forget the attributes last applied, so that the next cglApplyVertexFormat sets all of them */
+GLAPI void cglInvalidateVertexFormat(void);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,638 @@
+/*
+ *  Texture atlases for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cglatlas.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+
+#define CGL_ATLAS_NONE ((unsigned int) -1)      /* page of an unused handle, or no page found */
+#define CGL_ATLAS_EVICTED ((unsigned int) -2)   /* page of an evicted image */
+
+/* a segment of the top edge of the used area of a page, the segments cover the whole width */
+typedef struct CGLSkyline {
+    int x;
+    int y;
+    int width;
+} CGLSkyline;
+
+/* a rectangle of a page to upload, with the padding of the image */
+typedef struct CGLAtlasUpdate {
+    int x;
+    int y;
+    int width;
+    int height;
+} CGLAtlasUpdate;
+
+typedef struct CGLAtlasPage {
+    GLuint texture;
+    int full;                   /* upload the whole page, when new, cleared or after cglRepackAtlas */
+    unsigned char *pixels;      /* copy of the page, rows aligned to 4 bytes */
+    CGLSkyline *skyline;        /* room for page_size segments, each one at least 1 wide, and one being inserted */
+    size_t skyline_count;
+    CGLAtlasUpdate updates[CGL_ATLAS_SPARSE];
+    unsigned int update_count;  /* may be more than CGL_ATLAS_SPARSE, then the band is uploaded */
+    int band_begin;             /* rows around all updates */
+    int band_end;
+    unsigned long used;         /* frame of the last use */
+    unsigned int images;
+    size_t area;
+    size_t holes;
+} CGLAtlasPage;
+
+typedef struct CGLAtlasImage {
+    unsigned int page;          /* or CGL_ATLAS_NONE, CGL_ATLAS_EVICTED */
+    int x;
+    int y;
+    int width;
+    int height;
+} CGLAtlasImage;
+
+/* an image for cglRepackAtlas, and where it goes */
+typedef struct CGLAtlasMove {
+    unsigned int image;
+    int height;
+    unsigned int page;
+    int x;
+    int y;
+} CGLAtlasMove;
+
+struct CGLAtlas {
+    int page_size;
+    int padding;
+    GLenum format;
+    size_t pixel;
+    size_t stride;
+    unsigned int max_pages;
+    CGLAtlasPage *pages;
+    size_t page_count;
+    size_t page_capacity;
+    CGLAtlasImage *images;
+    size_t image_count;
+    size_t image_capacity;
+    unsigned int *free_images;  /* with room for image_capacity */
+    size_t free_count;
+    unsigned char *scratch;     /* an update gathered out of the page copy */
+    size_t scratch_size;
+    unsigned long frame;
+    unsigned long evicted;
+    unsigned int uploads;
+    size_t bytes;
+};
+
+
+/* grows an array to hold count elements, returns the new array, or NULL with the old one untouched */
+static void *cgl_atlas_grow(void *array, size_t *capacity, size_t count, size_t size) {
+    size_t grown = *capacity > 0 ? *capacity : 16;
+    void *memory;
+
+    while (grown < count)
+        grown += grown / 2;
+    memory = realloc(array, grown * size);
+    if (memory != nullptr)
+        *capacity = grown;
+    return memory;
+}
+
+/* empties a page and clears its copy, so that no texels of earlier images are left next to the padding
+ * of new ones; the page is uploaded as a whole with them */
+static void cgl_atlas_reset_page(const CGLAtlas *atlas, CGLAtlasPage *page) {
+    memset(page->pixels, 0, (size_t) atlas->page_size * atlas->stride);
+    page->full = 1;
+    page->skyline[0].x = 0;
+    page->skyline[0].y = 0;
+    page->skyline[0].width = atlas->page_size;
+    page->skyline_count = 1;
+    page->update_count = 0;
+    page->band_begin = atlas->page_size;
+    page->band_end = 0;
+    page->images = 0;
+    page->area = 0;
+    page->holes = 0;
+}
+
+static int cgl_atlas_init_page(const CGLAtlas *atlas, CGLAtlasPage *page) {
+    memset(page, 0, sizeof(CGLAtlasPage));
+    page->pixels = (unsigned char *) malloc((size_t) atlas->page_size * atlas->stride);
+    page->skyline = (CGLSkyline *) malloc(((size_t) atlas->page_size + 1) * sizeof(CGLSkyline));
+    if (page->pixels == nullptr || page->skyline == nullptr) {
+        free(page->pixels);
+        free(page->skyline);
+        return 0;
+    }
+    cgl_atlas_reset_page(atlas, page);
+    page->used = atlas->frame;
+    return 1;
+}
+
+/* the lowest y at which a rectangle starting at segment i fits, or -1 */
+static int cgl_skyline_fit(const CGLAtlasPage *page, int size, size_t i, int width, int height) {
+    int y = 0, left = width;
+
+    if (page->skyline[i].x + width > size)
+        return -1;
+    for (; left > 0; ++i) {
+        if (page->skyline[i].y > y)
+            y = page->skyline[i].y;
+        if (y + height > size)
+            return -1;
+        left -= page->skyline[i].width;
+    }
+    return y;
+}
+
+/* place a rectangle as low as possible, of equally low places on the narrowest segment; 0 if it does not fit */
+static int cgl_skyline_place(CGLAtlasPage *page, int size, int width, int height, int *x, int *y) {
+    size_t i, best = (size_t) -1;
+    int best_y = size, best_width = size + 1, right;
+
+    for (i = 0; i < page->skyline_count; ++i) {
+        int fit = cgl_skyline_fit(page, size, i, width, height);
+
+        if (fit >= 0 && (fit < best_y || (fit == best_y && page->skyline[i].width < best_width))) {
+            best = i;
+            best_y = fit;
+            best_width = page->skyline[i].width;
+        }
+    }
+    if (best == (size_t) -1)
+        return 0;
+
+    *x = page->skyline[best].x;
+    *y = best_y;
+    right = *x + width;
+    memmove(page->skyline + best + 1, page->skyline + best, (page->skyline_count - best) * sizeof(CGLSkyline));
+    page->skyline[best].y = best_y + height;
+    page->skyline[best].width = width;
+    ++page->skyline_count;
+
+    /* cut the segments now below the new one */
+    i = best + 1;
+    while (i < page->skyline_count && page->skyline[i].x < right) {
+        int covered = right - page->skyline[i].x;
+
+        if (page->skyline[i].width > covered) {
+            page->skyline[i].x += covered;
+            page->skyline[i].width -= covered;
+            break;
+        }
+        memmove(page->skyline + i, page->skyline + i + 1, (page->skyline_count - i - 1) * sizeof(CGLSkyline));
+        --page->skyline_count;
+    }
+
+    /* and merge neighbours of the same height */
+    for (i = best > 0 ? best - 1 : 0; i + 1 < page->skyline_count && i <= best + 1;) {
+        if (page->skyline[i].y == page->skyline[i + 1].y) {
+            page->skyline[i].width += page->skyline[i + 1].width;
+            memmove(page->skyline + i + 1, page->skyline + i + 2, (page->skyline_count - i - 2) * sizeof(CGLSkyline));
+            --page->skyline_count;
+        } else {
+            ++i;
+        }
+    }
+    return 1;
+}
+
+/* copy an image into a page, clear its padding and remember the rectangle for the upload */
+static void cgl_atlas_write(const CGLAtlas *atlas, CGLAtlasPage *page, int x, int y, int width, int height,
+                            const unsigned char *pixels, size_t stride) {
+    int right = x + width + atlas->padding, top = y + height + atlas->padding, row;
+    size_t line = (size_t) width * atlas->pixel, pad;
+
+    if (right > atlas->page_size)
+        right = atlas->page_size;
+    if (top > atlas->page_size)
+        top = atlas->page_size;
+    pad = (size_t) (right - x) * atlas->pixel - line;
+    for (row = y; row < top; ++row) {
+        unsigned char *to = page->pixels + (size_t) row * atlas->stride + (size_t) x * atlas->pixel;
+
+        if (row < y + height) {
+            memcpy(to, pixels + (size_t) (row - y) * stride, line);
+            memset(to + line, 0, pad);
+        } else {
+            memset(to, 0, line + pad);
+        }
+    }
+
+    if (page->update_count < CGL_ATLAS_SPARSE) {
+        CGLAtlasUpdate *update = &page->updates[page->update_count];
+
+        update->x = x;
+        update->y = y;
+        update->width = right - x;
+        update->height = top - y;
+    }
+    ++page->update_count;
+    if (y < page->band_begin)
+        page->band_begin = y;
+    if (top > page->band_end)
+        page->band_end = top;
+}
+
+/* the page least recently used, not in this frame, or CGL_ATLAS_NONE */
+static unsigned int cgl_atlas_victim(const CGLAtlas *atlas) {
+    unsigned int i, victim = CGL_ATLAS_NONE;
+
+    for (i = 0; i < atlas->page_count; ++i) {
+        const CGLAtlasPage *page = &atlas->pages[i];
+
+        if (page->used != atlas->frame && (victim == CGL_ATLAS_NONE || page->used < atlas->pages[victim].used))
+            victim = i;
+    }
+    return victim;
+}
+
+static void cgl_atlas_evict(CGLAtlas *atlas, unsigned int victim) {
+    size_t i;
+
+    for (i = 0; i < atlas->image_count; ++i) {
+        if (atlas->images[i].page == victim) {
+            atlas->images[i].page = CGL_ATLAS_EVICTED;
+            ++atlas->evicted;
+        }
+    }
+    cgl_atlas_reset_page(atlas, &atlas->pages[victim]);
+}
+
+static size_t cgl_atlas_area(const CGLAtlas *atlas, const CGLAtlasImage *image) {
+    return (size_t) (image->width + atlas->padding) * (size_t) (image->height + atlas->padding);
+}
+
+static int cgl_image_taller(const void *a, const void *b) {
+    const CGLAtlasMove *first = (const CGLAtlasMove *) a, *second = (const CGLAtlasMove *) b;
+
+    if (first->height != second->height)
+        return first->height > second->height ? -1 : 1;
+    return first->image < second->image ? -1 : first->image > second->image;
+}
+
+static void cgl_atlas_free_pages(CGLAtlasPage *pages, size_t count) {
+    size_t i;
+
+    for (i = 0; i < count; ++i) {
+        free(pages[i].pixels);
+        free(pages[i].skyline);
+    }
+    free(pages);
+}
+
+/* the placement of cglRepackAtlas, into new pages; 0 if there is not enough memory */
+static int cgl_atlas_pack(CGLAtlas *atlas, CGLAtlasMove *moves, size_t move_count, CGLAtlasPage **pages,
+                          size_t *page_count, size_t *capacity) {
+    size_t i;
+
+    *pages = nullptr;
+    *capacity = 0;
+    *page_count = 0;
+    for (i = 0; i < move_count; ++i) {
+        const CGLAtlasImage *image = &atlas->images[moves[i].image];
+        int width = image->width + atlas->padding, height = image->height + atlas->padding;
+        size_t page;
+
+        for (page = 0; page < *page_count; ++page) {
+            if (cgl_skyline_place(&(*pages)[page], atlas->page_size, width, height, &moves[i].x, &moves[i].y))
+                break;
+        }
+        if (page == *page_count && atlas->max_pages != 0 && page == atlas->max_pages) {
+            moves[i].page = CGL_ATLAS_EVICTED;
+            continue;
+        }
+        if (page == *page_count) {
+            CGLAtlasPage *grown = *page_count < *capacity ? *pages
+                : (CGLAtlasPage *) cgl_atlas_grow(*pages, capacity, *page_count + 1, sizeof(CGLAtlasPage));
+
+            if (grown == nullptr)
+                return 0;
+            *pages = grown;
+            if (!cgl_atlas_init_page(atlas, &grown[page]))
+                return 0;
+            ++*page_count;
+            cgl_skyline_place(&grown[page], atlas->page_size, width, height, &moves[i].x, &moves[i].y);
+        }
+        moves[i].page = (unsigned int) page;
+    }
+    return 1;
+}
+
+
+CGLAtlas *cglCreateAtlas(int page_size, GLenum format, unsigned int max_pages, int padding) {
+    CGLAtlas *atlas;
+    size_t pixel;
+
+    switch (format) {
+    case GL_ALPHA:
+    case GL_LUMINANCE:
+        pixel = 1;
+        break;
+    case GL_LUMINANCE_ALPHA:
+        pixel = 2;
+        break;
+    case GL_RGB:
+        pixel = 3;
+        break;
+    case GL_RGBA:
+        pixel = 4;
+        break;
+    default:
+        return nullptr;
+    }
+    if (page_size <= 0 || padding < 0 || padding >= page_size)
+        return nullptr;
+    atlas = (CGLAtlas *) calloc(1, sizeof(CGLAtlas));
+    if (atlas == nullptr)
+        return nullptr;
+    atlas->page_size = page_size;
+    atlas->padding = padding;
+    atlas->format = format;
+    atlas->pixel = pixel;
+    atlas->stride = ((size_t) page_size * pixel + 3) & ~(size_t) 3;
+    atlas->max_pages = max_pages;
+    return atlas;
+}
+
+void cglDestroyAtlas(CGLAtlas *atlas) {
+    size_t i;
+
+    if (atlas == nullptr)
+        return;
+    for (i = 0; i < atlas->page_count; ++i) {
+        if (atlas->pages[i].texture != 0)
+            glDeleteTextures(1, &atlas->pages[i].texture);
+    }
+    cgl_atlas_free_pages(atlas->pages, atlas->page_count);
+    free(atlas->images);
+    free(atlas->free_images);
+    free(atlas->scratch);
+    free(atlas);
+}
+
+CGLAtlasHandle cglAddAtlasImage(CGLAtlas *atlas, int width, int height, const void *pixels) {
+    int padded_width = width + atlas->padding, padded_height = height + atlas->padding, x = 0, y = 0;
+    unsigned int page = CGL_ATLAS_NONE, index;
+    size_t i;
+    CGLAtlasImage *image;
+
+    if (width <= 0 || height <= 0 || padded_width > atlas->page_size || padded_height > atlas->page_size)
+        return 0;
+    if (atlas->free_count == 0 && atlas->image_count == atlas->image_capacity) {
+        size_t capacity = atlas->image_capacity;
+        CGLAtlasImage *images = (CGLAtlasImage *) cgl_atlas_grow(atlas->images, &capacity, atlas->image_count + 1,
+                                                                 sizeof(CGLAtlasImage));
+        unsigned int *free_images;
+
+        if (images == nullptr)
+            return 0;
+        atlas->images = images;
+        free_images = (unsigned int *) realloc(atlas->free_images, capacity * sizeof(unsigned int));
+        if (free_images == nullptr)
+            return 0;
+        atlas->free_images = free_images;
+        atlas->image_capacity = capacity;
+    }
+
+    for (i = 0; i < atlas->page_count && page == CGL_ATLAS_NONE; ++i) {
+        if (cgl_skyline_place(&atlas->pages[i], atlas->page_size, padded_width, padded_height, &x, &y))
+            page = (unsigned int) i;
+    }
+    if (page == CGL_ATLAS_NONE && (atlas->max_pages == 0 || atlas->page_count < atlas->max_pages)) {
+        if (atlas->page_count == atlas->page_capacity) {
+            CGLAtlasPage *pages = (CGLAtlasPage *) cgl_atlas_grow(atlas->pages, &atlas->page_capacity,
+                                                                  atlas->page_count + 1, sizeof(CGLAtlasPage));
+
+            if (pages == nullptr)
+                return 0;
+            atlas->pages = pages;
+        }
+        if (!cgl_atlas_init_page(atlas, &atlas->pages[atlas->page_count]))
+            return 0;
+        page = (unsigned int) atlas->page_count++;
+        cgl_skyline_place(&atlas->pages[page], atlas->page_size, padded_width, padded_height, &x, &y);
+    } else if (page == CGL_ATLAS_NONE) {
+        page = cgl_atlas_victim(atlas);
+        if (page == CGL_ATLAS_NONE)
+            return 0;
+        cgl_atlas_evict(atlas, page);
+        cgl_skyline_place(&atlas->pages[page], atlas->page_size, padded_width, padded_height, &x, &y);
+    }
+
+    index = atlas->free_count > 0 ? atlas->free_images[--atlas->free_count] : (unsigned int) atlas->image_count++;
+    image = &atlas->images[index];
+    image->page = page;
+    image->x = x;
+    image->y = y;
+    image->width = width;
+    image->height = height;
+    cgl_atlas_write(atlas, &atlas->pages[page], x, y, width, height, (const unsigned char *) pixels,
+                    (size_t) width * atlas->pixel);
+    atlas->pages[page].used = atlas->frame;
+    ++atlas->pages[page].images;
+    atlas->pages[page].area += cgl_atlas_area(atlas, image);
+    return index + 1;
+}
+
+/* whether a handle was given out and not removed since, evicted or not */
+static int cgl_atlas_is_image(const CGLAtlas *atlas, CGLAtlasHandle image) {
+    return image != 0 && image <= atlas->image_count && atlas->images[image - 1].page != CGL_ATLAS_NONE;
+}
+
+void cglRemoveAtlasImage(CGLAtlas *atlas, CGLAtlasHandle image) {
+    CGLAtlasImage *removed;
+
+    if (!cgl_atlas_is_image(atlas, image))
+        return;
+    removed = &atlas->images[image - 1];
+    if (removed->page < atlas->page_count) {
+        CGLAtlasPage *page = &atlas->pages[removed->page];
+
+        if (--page->images == 0) {
+            cgl_atlas_reset_page(atlas, page);
+        } else {
+            page->area -= cgl_atlas_area(atlas, removed);
+            page->holes += cgl_atlas_area(atlas, removed);
+        }
+    }
+    removed->page = CGL_ATLAS_NONE;
+    atlas->free_images[atlas->free_count++] = image - 1;
+}
+
+int cglGetAtlasImage(CGLAtlas *atlas, CGLAtlasHandle image, CGLAtlasRect *rect) {
+    const CGLAtlasImage *found = cgl_atlas_is_image(atlas, image) ? &atlas->images[image - 1] : nullptr;
+    float scale = 1.0f / (float) atlas->page_size;
+
+    if (found == nullptr || found->page >= atlas->page_count) {
+        memset(rect, 0, sizeof(CGLAtlasRect));
+        return 0;
+    }
+    atlas->pages[found->page].used = atlas->frame;
+    rect->texture = atlas->pages[found->page].texture;
+    rect->page = found->page;
+    rect->x = found->x;
+    rect->y = found->y;
+    rect->width = found->width;
+    rect->height = found->height;
+    rect->u0 = (float) found->x * scale;
+    rect->v0 = (float) found->y * scale;
+    rect->u1 = (float) (found->x + found->width) * scale;
+    rect->v1 = (float) (found->y + found->height) * scale;
+    return 1;
+}
+
+void cglUploadAtlas(CGLAtlas *atlas) {
+    size_t i;
+    unsigned int j;
+
+    atlas->uploads = 0;
+    atlas->bytes = 0;
+    for (i = 0; i < atlas->page_count; ++i) {
+        CGLAtlasPage *page = &atlas->pages[i];
+
+        if (page->texture == 0) {
+            glGenTextures(1, &page->texture);
+            glBindTexture(GL_TEXTURE_2D, page->texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            /* from the copy, cleared or repacked, as the texels of glTexImage2D(NULL) are undefined; new pages are full */
+            glTexImage2D(GL_TEXTURE_2D, 0, (GLint) atlas->format, atlas->page_size, atlas->page_size, 0,
+                         atlas->format, GL_UNSIGNED_BYTE, page->pixels);
+            ++atlas->uploads;
+            atlas->bytes += (size_t) atlas->page_size * atlas->stride;
+        } else if (page->full) {
+            glBindTexture(GL_TEXTURE_2D, page->texture);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, atlas->page_size, atlas->page_size, atlas->format,
+                            GL_UNSIGNED_BYTE, page->pixels);
+            ++atlas->uploads;
+            atlas->bytes += (size_t) atlas->page_size * atlas->stride;
+        }
+
+        if (page->full || page->update_count == 0) {
+            /* nothing more to upload */
+        } else if (page->update_count > CGL_ATLAS_SPARSE) {
+            glBindTexture(GL_TEXTURE_2D, page->texture);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, page->band_begin, atlas->page_size,
+                            page->band_end - page->band_begin, atlas->format, GL_UNSIGNED_BYTE,
+                            page->pixels + (size_t) page->band_begin * atlas->stride);
+            ++atlas->uploads;
+            atlas->bytes += (size_t) (page->band_end - page->band_begin) * atlas->stride;
+        } else {
+            glBindTexture(GL_TEXTURE_2D, page->texture);
+            for (j = 0; j < page->update_count; ++j) {
+                const CGLAtlasUpdate *update = &page->updates[j];
+                size_t line = (size_t) update->width * atlas->pixel, stride = (line + 3) & ~(size_t) 3;
+                int row;
+
+                if (stride * (size_t) update->height > atlas->scratch_size) {
+                    unsigned char *scratch = (unsigned char *) realloc(atlas->scratch,
+                                                                       stride * (size_t) update->height);
+
+                    if (scratch == nullptr) {
+                        /* upload the rows of the update instead */
+                        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, update->y, atlas->page_size, update->height,
+                                        atlas->format, GL_UNSIGNED_BYTE,
+                                        page->pixels + (size_t) update->y * atlas->stride);
+                        ++atlas->uploads;
+                        atlas->bytes += (size_t) update->height * atlas->stride;
+                        continue;
+                    }
+                    atlas->scratch = scratch;
+                    atlas->scratch_size = stride * (size_t) update->height;
+                }
+                for (row = 0; row < update->height; ++row)
+                    memcpy(atlas->scratch + (size_t) row * stride, page->pixels
+                           + (size_t) (update->y + row) * atlas->stride + (size_t) update->x * atlas->pixel, line);
+                glTexSubImage2D(GL_TEXTURE_2D, 0, update->x, update->y, update->width, update->height,
+                                atlas->format, GL_UNSIGNED_BYTE, atlas->scratch);
+                ++atlas->uploads;
+                atlas->bytes += stride * (size_t) update->height;
+            }
+        }
+        page->full = 0;
+        page->update_count = 0;
+        page->band_begin = atlas->page_size;
+        page->band_end = 0;
+    }
+    ++atlas->frame;
+}
+
+long cglRepackAtlas(CGLAtlas *atlas) {
+    CGLAtlasMove *moves = (CGLAtlasMove *) malloc((atlas->image_count > 0 ? atlas->image_count : 1)
+                                                  * sizeof(CGLAtlasMove));
+    CGLAtlasPage *pages;
+    size_t i, move_count = 0, page_count, page_capacity;
+    long evicted = 0;
+
+    if (moves == nullptr)
+        return -1;
+    for (i = 0; i < atlas->image_count; ++i) {
+        if (atlas->images[i].page < atlas->page_count) {
+            moves[move_count].image = (unsigned int) i;
+            moves[move_count].height = atlas->images[i].height;
+            ++move_count;
+        }
+    }
+    qsort(moves, move_count, sizeof(CGLAtlasMove), cgl_image_taller);
+    if (!cgl_atlas_pack(atlas, moves, move_count, &pages, &page_count, &page_capacity)) {
+        cgl_atlas_free_pages(pages, page_count);
+        free(moves);
+        return -1;
+    }
+
+    for (i = 0; i < move_count; ++i) {
+        CGLAtlasImage *image = &atlas->images[moves[i].image];
+
+        if (moves[i].page == CGL_ATLAS_EVICTED) {
+            image->page = CGL_ATLAS_EVICTED;
+            ++evicted;
+            continue;
+        }
+        cgl_atlas_write(atlas, &pages[moves[i].page], moves[i].x, moves[i].y, image->width, image->height,
+                        atlas->pages[image->page].pixels + (size_t) image->y * atlas->stride
+                        + (size_t) image->x * atlas->pixel, atlas->stride);
+        image->page = moves[i].page;
+        image->x = moves[i].x;
+        image->y = moves[i].y;
+        ++pages[image->page].images;
+        pages[image->page].area += cgl_atlas_area(atlas, image);
+    }
+    for (i = 0; i < page_count; ++i) {
+        pages[i].full = 1;
+        if (i < atlas->page_count)
+            pages[i].texture = atlas->pages[i].texture;
+    }
+    for (; i < atlas->page_count; ++i) {
+        if (atlas->pages[i].texture != 0)
+            glDeleteTextures(1, &atlas->pages[i].texture);
+    }
+    cgl_atlas_free_pages(atlas->pages, atlas->page_count);
+    atlas->pages = pages;
+    atlas->page_count = page_count;
+    atlas->page_capacity = page_capacity;
+    atlas->evicted += (unsigned long) evicted;
+    free(moves);
+    return evicted;
+}
+
+void cglGetAtlasStats(const CGLAtlas *atlas, CGLAtlasStats *stats) {
+    size_t i;
+
+    memset(stats, 0, sizeof(CGLAtlasStats));
+    stats->pages = (unsigned int) atlas->page_count;
+    for (i = 0; i < atlas->page_count; ++i) {
+        stats->images += atlas->pages[i].images;
+        stats->used += atlas->pages[i].area;
+        stats->holes += atlas->pages[i].holes;
+    }
+    stats->evicted = atlas->evicted;
+    stats->uploads = atlas->uploads;
+    stats->bytes = atlas->bytes;
+}
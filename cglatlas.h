@@ -0,0 +1,133 @@
+/*
+ *  Texture atlases for the common OpenGL subset: many small images packed into a few large textures
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLATLAS_H
+#define CGLATLAS_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief new images a page can have before cglUploadAtlas uploads a band of rows instead of each image */
+#define CGL_ATLAS_SPARSE 16
+
+/*! \brief an image in an atlas, 0 is never a valid handle */
+typedef unsigned int CGLAtlasHandle;
+
+/*! \brief a set of GL_TEXTURE_2D pages with many small images, e.g. glyphs, sprites or icons, packed into each
+ *
+ * giving every small image its own texture object costs a glBindTexture for every draw, and keeps draws
+ * from being merged. An atlas places the images into a few large textures ("pages") instead,
+ * so that draws differ only in their texture coordinates.
+ *
+ * Each page is packed with a bottom-left skyline: the top edge of the used area is kept as a list of segments,
+ * and an image is placed where it ends up lowest, which is fast and packs images of similar height well.
+ * The atlas keeps a copy of each page in client memory. New images are written into it and uploaded by
+ * cglUploadAtlas, each with a glTexSubImage2D of its rectangle, or with one of the rows around them if there
+ * are many, since GL ES 2.0 has no GL_UNPACK_ROW_LENGTH to upload a rectangle out of the page copy directly.
+ *
+ * Removed images leave a hole until cglRepackAtlas packs all images again. When all pages are full,
+ * the page least recently used is evicted as a whole: its images are dropped, and cglGetAtlasImage returns 0 for
+ * them, so that the caller can add them again, as a glyph cache does. Pages used in the current frame,
+ * that is since the last cglUploadAtlas, are never evicted. New pages, evicted ones and pages whose last image
+ * was removed are cleared to 0 and uploaded as a whole, so no stale texels are left beside the padding.
+ *
+ * The atlas must not be used by several threads at the same time, the functions making GL calls say so.
+ */
+typedef struct CGLAtlas CGLAtlas;
+
+/*! \brief where an image is, as of the last cglUploadAtlas */
+typedef struct CGLAtlasRect {
+    GLuint texture;         /*!< of the page, 0 until cglUploadAtlas made it */
+    unsigned int page;
+    int x;                  /*!< in texels from the left edge of the page */
+    int y;                  /*!< in texels from the bottom edge, where the first row of the pixels went */
+    int width;
+    int height;
+    float u0;               /*!< texture coordinates of the corner at x, y */
+    float v0;
+    float u1;               /*!< and of the opposite corner */
+    float v1;
+} CGLAtlasRect;
+
+/*! \brief how full an atlas is, and what the last cglUploadAtlas did */
+typedef struct CGLAtlasStats {
+    unsigned int pages;
+    unsigned int images;        /*!< images in the pages, not counting evicted ones */
+    size_t used;                /*!< texels of these images, with their padding */
+    size_t holes;               /*!< texels of removed images, to be reclaimed by cglRepackAtlas */
+    unsigned long evicted;      /*!< images evicted since the atlas was created */
+    unsigned int uploads;       /*!< glTexImage2D and glTexSubImage2D calls of the last cglUploadAtlas */
+    size_t bytes;               /*!< uploaded by the last cglUploadAtlas */
+} CGLAtlasStats;
+
+/*! \brief create an empty atlas, no texture is made before the first cglUploadAtlas
+ *
+ * \param page_size width and height of each page, at most GL_MAX_TEXTURE_SIZE, e.g. 1024
+ * \param format    GL_ALPHA, GL_LUMINANCE, GL_LUMINANCE_ALPHA, GL_RGB or GL_RGBA, of the pages and the images
+ * \param max_pages before pages are evicted, 0 for no limit
+ * \param padding   empty texels kept right of and above each image, so that linear filtering does not bleed
+ *                  between neighbours, usually 1
+ *
+ * \return the atlas, or NULL if the format is unknown or there is not enough memory
+ */
+GLAPI CGLAtlas *cglCreateAtlas(int page_size, GLenum format, unsigned int max_pages, int padding);
+
+/*! \brief delete the textures of the atlas and free it, NULL is ignored; makes GL calls */
+GLAPI void cglDestroyAtlas(CGLAtlas *atlas);
+
+/*! \brief copy an image into the atlas, to be uploaded by the next cglUploadAtlas
+ *
+ * may evict the least recently used page, if all pages are full and \ref max_pages of them exist.
+ *
+ * \param pixels \ref width times \ref height pixels in the format of the atlas, rows tightly packed
+ *
+ * \return the handle, or 0 if the image (with padding) is larger than a page, all pages are full and used
+ *         in this frame, or there is not enough memory
+ */
+GLAPI CGLAtlasHandle cglAddAtlasImage(CGLAtlas *atlas, int width, int height, const void *pixels);
+
+/*! \brief remove an image, or forget an evicted one, the handle may be given out again; 0 and handles already
+ *         removed are ignored */
+GLAPI void cglRemoveAtlasImage(CGLAtlas *atlas, CGLAtlasHandle image);
+
+/*! \brief where an image is, and mark its page as used in this frame
+ *
+ * \return 1, or 0 if the image was evicted, in which case it should be removed and added again, or if the handle
+ *         is not one given out
+ */
+GLAPI int cglGetAtlasImage(CGLAtlas *atlas, CGLAtlasHandle image, CGLAtlasRect *rect);
+
+/*! \brief make the textures of new pages, upload the images added since the last call, and start a new frame
+ *
+ * makes GL calls, binds the pages to GL_TEXTURE_2D of the active unit while uploading.
+ * The pages have GL_LINEAR filters and GL_CLAMP_TO_EDGE wrapping, and the uploads expect the default
+ * GL_UNPACK_ALIGNMENT of 4.
+ */
+GLAPI void cglUploadAtlas(CGLAtlas *atlas);
+
+/*! \brief pack all images again, tallest first, to reclaim the holes of removed images
+ *
+ * afterwards, the rectangles of cglGetAtlasImage must be queried again. Pages left empty are deleted,
+ * the others are uploaded again by the next cglUploadAtlas; makes GL calls.
+ *
+ * \return the number of images that did not fit into \ref max_pages pages any more and were evicted,
+ *         or -1 if there is not enough memory, in which case the atlas is unchanged
+ */
+GLAPI long cglRepackAtlas(CGLAtlas *atlas);
+
+/*! \brief fill \ref stats with the current size of \ref atlas, and the uploads of the last cglUploadAtlas */
+GLAPI void cglGetAtlasStats(const CGLAtlas *atlas, CGLAtlasStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
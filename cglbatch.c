@@ -0,0 +1,491 @@
+/*
+ *  Static batching for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cglbatch.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+
+/* batches with up to this many changed objects upload each object's range, others the range around all of them */
+#define CGL_BATCH_SPARSE 16
+
+typedef struct CGLBatchMesh {
+    unsigned char *vertices;
+    unsigned short *indices;
+    unsigned int vertex_count;
+    size_t index_count;
+} CGLBatchMesh;
+
+typedef struct CGLBatchObject {
+    unsigned int mesh;          /* counting from 1, 0 if the slot is free */
+    unsigned int material;
+    unsigned int batch;
+    unsigned int slot;          /* position in the objects of the batch */
+    size_t first_vertex;        /* in the batch */
+    size_t first_index;
+    int dirty;                  /* to be transformed by the next build */
+    float matrix[16];
+} CGLBatchObject;
+
+/* the vertices and indices of a batch are built in client memory, each object writing only its own range,
+ * and the range of vertices and indices changed since the last upload is remembered */
+typedef struct CGLBatch {
+    unsigned int material;
+    GLuint buffers[2];          /* vertices, indices */
+    unsigned int *objects;
+    unsigned int object_count;
+    unsigned int object_capacity;
+    int repack;                 /* objects were removed, the others are laid out again */
+    size_t vertex_count;
+    size_t index_count;
+    unsigned char *vertices;
+    unsigned short *indices;
+    size_t vertex_capacity;
+    size_t index_capacity;
+    size_t buffer_vertices;     /* sizes of the buffer objects */
+    size_t buffer_indices;
+    size_t vertex_begin, vertex_end;  /* changed since the last upload */
+    size_t index_begin, index_end;
+    unsigned int dirty_objects;         /* transformed since the last upload */
+    GLsizei draw_count;
+} CGLBatch;
+
+struct CGLStaticBatcher {
+    size_t vertex_size;
+    size_t position_offset;
+    size_t normal_offset;
+    unsigned int max_vertices;
+    CGLBatchMesh *meshes;
+    unsigned int mesh_count;
+    unsigned int mesh_capacity;
+    CGLBatchObject *objects;
+    unsigned int object_count;
+    unsigned int object_capacity;
+    unsigned int *free_objects;
+    unsigned int free_object_count;
+    CGLBatch *batches;
+    unsigned int batch_count;
+    unsigned int batch_capacity;
+    unsigned int *jobs;         /* objects to transform, collected by cglPrepareStaticBatches */
+    unsigned int job_count;
+    unsigned int job_capacity;
+};
+
+
+static void cgl_batch_mark(size_t *begin, size_t *end, size_t first, size_t count) {
+    if (count == 0)
+        return;
+    if (*begin >= *end) {
+        *begin = first;
+        *end = first + count;
+        return;
+    }
+    if (first < *begin)
+        *begin = first;
+    if (first + count > *end)
+        *end = first + count;
+}
+
+/* grows an array to at least count elements, returns NULL if there is not enough memory */
+static void *cgl_batch_grow(void *array, size_t *capacity, size_t count, size_t size) {
+    size_t grown = *capacity > 0 ? *capacity : 64;
+    void *memory;
+
+    while (grown < count)
+        grown += grown / 2;
+    memory = realloc(array, grown * size);
+    if (memory != nullptr)
+        *capacity = grown;
+    return memory;
+}
+
+/* a batch of the material with room for the vertices, or a new or empty one */
+static CGLBatch *cgl_find_batch(CGLStaticBatcher *batcher, unsigned int material, unsigned int vertices) {
+    CGLBatch *empty = nullptr;
+    unsigned int i;
+
+    for (i = 0; i < batcher->batch_count; ++i) {
+        CGLBatch *batch = &batcher->batches[i];
+
+        if (batch->object_count == 0 && empty == nullptr)
+            empty = batch;
+        if (batch->object_count > 0 && batch->material == material
+                && batch->vertex_count + vertices <= batcher->max_vertices)
+            return batch;
+    }
+    if (empty == nullptr) {
+        if (batcher->batch_count == batcher->batch_capacity) {
+            unsigned int capacity = batcher->batch_capacity > 0 ? batcher->batch_capacity * 2 : 16;
+            CGLBatch *batches = (CGLBatch *) realloc(batcher->batches, capacity * sizeof(CGLBatch));
+
+            if (batches == nullptr)
+                return nullptr;
+            batcher->batches = batches;
+            batcher->batch_capacity = capacity;
+        }
+        empty = &batcher->batches[batcher->batch_count++];
+        memset(empty, 0, sizeof(CGLBatch));
+    }
+    empty->material = material;
+    return empty;
+}
+
+static void cgl_batch_transform(CGLStaticBatcher *batcher, const CGLBatchObject *object) {
+    const CGLBatchMesh *mesh = &batcher->meshes[object->mesh - 1];
+    CGLBatch *batch = &batcher->batches[object->batch];
+    const float *m = object->matrix;
+    size_t size = batcher->vertex_size, i;
+    unsigned char *out = batch->vertices + object->first_vertex * size;
+    unsigned short *indices = batch->indices + object->first_index;
+
+    memcpy(out, mesh->vertices, mesh->vertex_count * size);
+    for (i = 0; i < mesh->vertex_count; ++i, out += size) {
+        float v[3], r[3];
+
+        /* through memcpy, as the offsets need not be aligned */
+        memcpy(v, out + batcher->position_offset, sizeof(v));
+        r[0] = m[0] * v[0] + m[4] * v[1] + m[8] * v[2] + m[12];
+        r[1] = m[1] * v[0] + m[5] * v[1] + m[9] * v[2] + m[13];
+        r[2] = m[2] * v[0] + m[6] * v[1] + m[10] * v[2] + m[14];
+        memcpy(out + batcher->position_offset, r, sizeof(r));
+        if (batcher->normal_offset != CGL_BATCH_NO_NORMAL) {
+            float length;
+
+            memcpy(v, out + batcher->normal_offset, sizeof(v));
+            r[0] = m[0] * v[0] + m[4] * v[1] + m[8] * v[2];
+            r[1] = m[1] * v[0] + m[5] * v[1] + m[9] * v[2];
+            r[2] = m[2] * v[0] + m[6] * v[1] + m[10] * v[2];
+            length = (float) sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+            if (length > 0.0f) {
+                r[0] /= length;
+                r[1] /= length;
+                r[2] /= length;
+            }
+            memcpy(out + batcher->normal_offset, r, sizeof(r));
+        }
+    }
+    for (i = 0; i < mesh->index_count; ++i)
+        indices[i] = (unsigned short) (mesh->indices[i] + object->first_vertex);
+}
+
+
+CGLStaticBatcher *cglCreateStaticBatcher(size_t vertex_size, size_t position_offset, size_t normal_offset,
+                                         unsigned int max_vertices) {
+    CGLStaticBatcher *batcher;
+
+    if (max_vertices == 0)
+        max_vertices = CGL_BATCH_MAX_VERTICES;
+    if (max_vertices > CGL_BATCH_MAX_VERTICES || vertex_size < 3 * sizeof(float)
+            || position_offset > vertex_size - 3 * sizeof(float)
+            || (normal_offset != CGL_BATCH_NO_NORMAL && normal_offset > vertex_size - 3 * sizeof(float)))
+        return nullptr;
+    batcher = (CGLStaticBatcher *) calloc(1, sizeof(CGLStaticBatcher));
+    if (batcher == nullptr)
+        return nullptr;
+    batcher->vertex_size = vertex_size;
+    batcher->position_offset = position_offset;
+    batcher->normal_offset = normal_offset;
+    batcher->max_vertices = max_vertices;
+    return batcher;
+}
+
+void cglDestroyStaticBatcher(CGLStaticBatcher *batcher) {
+    unsigned int i;
+
+    if (batcher == nullptr)
+        return;
+    for (i = 0; i < batcher->batch_count; ++i) {
+        CGLBatch *batch = &batcher->batches[i];
+
+        if (batch->buffers[0] != 0)
+            glDeleteBuffers(2, batch->buffers);
+        free(batch->objects);
+        free(batch->vertices);
+        free(batch->indices);
+    }
+    for (i = 0; i < batcher->mesh_count; ++i) {
+        free(batcher->meshes[i].vertices);
+        free(batcher->meshes[i].indices);
+    }
+    free(batcher->batches);
+    free(batcher->meshes);
+    free(batcher->objects);
+    free(batcher->free_objects);
+    free(batcher->jobs);
+    free(batcher);
+}
+
+unsigned int cglAddBatchMesh(CGLStaticBatcher *batcher, const void *vertices, unsigned int vertex_count,
+                             const unsigned short *indices, size_t index_count) {
+    CGLBatchMesh *mesh;
+    size_t i;
+
+    if (vertex_count > batcher->max_vertices)
+        return 0;
+    for (i = 0; i < index_count; ++i)
+        if (indices[i] >= vertex_count)
+            return 0;
+    if (batcher->mesh_count == batcher->mesh_capacity) {
+        unsigned int capacity = batcher->mesh_capacity > 0 ? batcher->mesh_capacity * 2 : 16;
+        CGLBatchMesh *meshes = (CGLBatchMesh *) realloc(batcher->meshes, capacity * sizeof(CGLBatchMesh));
+
+        if (meshes == nullptr)
+            return 0;
+        batcher->meshes = meshes;
+        batcher->mesh_capacity = capacity;
+    }
+    mesh = &batcher->meshes[batcher->mesh_count];
+    mesh->vertices = (unsigned char *) malloc(vertex_count * batcher->vertex_size + 1);
+    mesh->indices = (unsigned short *) malloc(index_count * sizeof(unsigned short) + 1);
+    if (mesh->vertices == nullptr || mesh->indices == nullptr) {
+        free(mesh->vertices);
+        free(mesh->indices);
+        return 0;
+    }
+    memcpy(mesh->vertices, vertices, vertex_count * batcher->vertex_size);
+    memcpy(mesh->indices, indices, index_count * sizeof(unsigned short));
+    mesh->vertex_count = vertex_count;
+    mesh->index_count = index_count;
+    return ++batcher->mesh_count;
+}
+
+CGLBatchHandle cglAddBatchObject(CGLStaticBatcher *batcher, unsigned int mesh, unsigned int material,
+                                 const float *matrix) {
+    CGLBatchObject *object;
+    CGLBatch *batch;
+    unsigned int index;
+
+    if (mesh == 0 || mesh > batcher->mesh_count)
+        return 0;
+    if (batcher->free_object_count == 0 && batcher->object_count == batcher->object_capacity) {
+        unsigned int capacity = batcher->object_capacity > 0 ? batcher->object_capacity * 2 : 256;
+        CGLBatchObject *objects = (CGLBatchObject *) realloc(batcher->objects, capacity * sizeof(CGLBatchObject));
+        unsigned int *free_objects;
+
+        if (objects == nullptr)
+            return 0;
+        batcher->objects = objects;
+        free_objects = (unsigned int *) realloc(batcher->free_objects, capacity * sizeof(unsigned int));
+        if (free_objects == nullptr)
+            return 0;
+        batcher->free_objects = free_objects;
+        batcher->object_capacity = capacity;
+    }
+    batch = cgl_find_batch(batcher, material, batcher->meshes[mesh - 1].vertex_count);
+    if (batch == nullptr)
+        return 0;
+    if (batch->object_count == batch->object_capacity) {
+        unsigned int capacity = batch->object_capacity > 0 ? batch->object_capacity * 2 : 64;
+        unsigned int *objects = (unsigned int *) realloc(batch->objects, capacity * sizeof(unsigned int));
+
+        if (objects == nullptr)
+            return 0;
+        batch->objects = objects;
+        batch->object_capacity = capacity;
+    }
+
+    index = batcher->free_object_count > 0 ? batcher->free_objects[--batcher->free_object_count]
+                                           : batcher->object_count++;
+    object = &batcher->objects[index];
+    object->mesh = mesh;
+    object->material = material;
+    object->batch = (unsigned int) (batch - batcher->batches);
+    object->slot = batch->object_count;
+    object->first_vertex = batch->vertex_count;
+    object->first_index = batch->index_count;
+    object->dirty = 1;
+    memcpy(object->matrix, matrix, sizeof(object->matrix));
+    batch->objects[batch->object_count++] = index;
+    batch->vertex_count += batcher->meshes[mesh - 1].vertex_count;
+    batch->index_count += batcher->meshes[mesh - 1].index_count;
+    return index + 1;
+}
+
+/* whether the handle was given out by cglAddBatchObject and not removed since */
+static int cgl_batch_is_object(const CGLStaticBatcher *batcher, CGLBatchHandle object) {
+    return object != 0 && object <= batcher->object_count && batcher->objects[object - 1].mesh != 0;
+}
+
+void cglMoveBatchObject(CGLStaticBatcher *batcher, CGLBatchHandle object, const float *matrix) {
+    if (!cgl_batch_is_object(batcher, object))
+        return;
+    memcpy(batcher->objects[object - 1].matrix, matrix, sizeof(batcher->objects[object - 1].matrix));
+    batcher->objects[object - 1].dirty = 1;
+}
+
+void cglRemoveBatchObject(CGLStaticBatcher *batcher, CGLBatchHandle object) {
+    CGLBatchObject *removed;
+    CGLBatch *batch;
+    unsigned int last;
+
+    if (!cgl_batch_is_object(batcher, object))
+        return;
+    removed = &batcher->objects[object - 1];
+    batch = &batcher->batches[removed->batch];
+    last = batch->objects[--batch->object_count];
+    batch->objects[removed->slot] = last;
+    batcher->objects[last].slot = removed->slot;
+    if (batch->object_count == 0) {
+        batch->vertex_count = batch->index_count = 0;
+        batch->repack = 0;
+    } else {
+        batch->repack = 1;
+    }
+    removed->mesh = 0;
+    batcher->free_objects[batcher->free_object_count++] = object - 1;
+}
+
+long cglPrepareStaticBatches(CGLStaticBatcher *batcher) {
+    unsigned int i, j;
+
+    for (i = 0; i < batcher->batch_count; ++i) {
+        CGLBatch *batch = &batcher->batches[i];
+
+        if (batch->repack) {
+            batch->vertex_count = batch->index_count = 0;
+            for (j = 0; j < batch->object_count; ++j) {
+                CGLBatchObject *object = &batcher->objects[batch->objects[j]];
+
+                object->first_vertex = batch->vertex_count;
+                object->first_index = batch->index_count;
+                object->dirty = 1;
+                batch->vertex_count += batcher->meshes[object->mesh - 1].vertex_count;
+                batch->index_count += batcher->meshes[object->mesh - 1].index_count;
+            }
+            batch->repack = 0;
+        }
+        if (batch->vertex_count > batch->vertex_capacity) {
+            void *vertices = cgl_batch_grow(batch->vertices, &batch->vertex_capacity, batch->vertex_count,
+                                            batcher->vertex_size);
+
+            if (vertices == nullptr)
+                return -1;
+            batch->vertices = (unsigned char *) vertices;
+        }
+        if (batch->index_count > batch->index_capacity) {
+            void *indices = cgl_batch_grow(batch->indices, &batch->index_capacity, batch->index_count,
+                                           sizeof(unsigned short));
+
+            if (indices == nullptr)
+                return -1;
+            batch->indices = (unsigned short *) indices;
+        }
+    }
+    if (batcher->job_capacity < batcher->object_count) {
+        unsigned int *jobs = (unsigned int *) realloc(batcher->jobs, batcher->object_capacity * sizeof(unsigned int));
+
+        if (jobs == nullptr)
+            return -1;
+        batcher->jobs = jobs;
+        batcher->job_capacity = batcher->object_capacity;
+    }
+
+    batcher->job_count = 0;
+    for (i = 0; i < batcher->object_count; ++i) {
+        CGLBatchObject *object = &batcher->objects[i];
+        const CGLBatchMesh *mesh;
+        CGLBatch *batch;
+
+        if (object->mesh == 0 || !object->dirty)
+            continue;
+        mesh = &batcher->meshes[object->mesh - 1];
+        batch = &batcher->batches[object->batch];
+        cgl_batch_mark(&batch->vertex_begin, &batch->vertex_end, object->first_vertex, mesh->vertex_count);
+        cgl_batch_mark(&batch->index_begin, &batch->index_end, object->first_index, mesh->index_count);
+        object->dirty = 0;
+        ++batch->dirty_objects;
+        batcher->jobs[batcher->job_count++] = i;
+    }
+    return (long) batcher->job_count;
+}
+
+void cglBuildStaticBatches(CGLStaticBatcher *batcher, unsigned int worker, unsigned int workers) {
+    unsigned int i;
+
+    if (workers == 0)
+        workers = 1;
+    for (i = worker; i < batcher->job_count; i += workers)
+        cgl_batch_transform(batcher, &batcher->objects[batcher->jobs[i]]);
+}
+
+void cglUploadStaticBatches(CGLStaticBatcher *batcher) {
+    size_t size = batcher->vertex_size;
+    unsigned int i;
+
+    for (i = 0; i < batcher->batch_count; ++i) {
+        CGLBatch *batch = &batcher->batches[i];
+
+        batch->draw_count = (GLsizei) batch->index_count;
+        if (batch->vertex_begin >= batch->vertex_end && batch->index_begin >= batch->index_end)
+            continue;
+        if (batch->buffers[0] == 0)
+            glGenBuffers(2, batch->buffers);
+
+        if (batch->vertex_count > batch->buffer_vertices || batch->index_count > batch->buffer_indices) {
+            glBindBuffer(GL_ARRAY_BUFFER, batch->buffers[0]);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) (batch->vertex_capacity * size), batch->vertices,
+                         GL_STATIC_DRAW);
+            batch->buffer_vertices = batch->vertex_capacity;
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->buffers[1]);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr) (batch->index_capacity * sizeof(unsigned short)),
+                         batch->indices, GL_STATIC_DRAW);
+            batch->buffer_indices = batch->index_capacity;
+            batch->dirty_objects = 0;
+        } else if (batch->dirty_objects > CGL_BATCH_SPARSE) {
+            glBindBuffer(GL_ARRAY_BUFFER, batch->buffers[0]);
+            glBufferSubData(GL_ARRAY_BUFFER, (GLintptr) (batch->vertex_begin * size),
+                            (GLsizeiptr) ((batch->vertex_end - batch->vertex_begin) * size),
+                            batch->vertices + batch->vertex_begin * size);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->buffers[1]);
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr) (batch->index_begin * sizeof(unsigned short)),
+                            (GLsizeiptr) ((batch->index_end - batch->index_begin) * sizeof(unsigned short)),
+                            batch->indices + batch->index_begin);
+            batch->dirty_objects = 0;
+        }
+        batch->vertex_begin = batch->vertex_end = 0;
+        batch->index_begin = batch->index_end = 0;
+    }
+
+    /* the batches with few changed objects, e.g. a few that moved, upload only their ranges */
+    for (i = 0; i < batcher->job_count; ++i) {
+        const CGLBatchObject *object = &batcher->objects[batcher->jobs[i]];
+        const CGLBatchMesh *mesh = &batcher->meshes[object->mesh - 1];
+        CGLBatch *batch = &batcher->batches[object->batch];
+
+        if (batch->dirty_objects == 0)
+            continue;
+        glBindBuffer(GL_ARRAY_BUFFER, batch->buffers[0]);
+        glBufferSubData(GL_ARRAY_BUFFER, (GLintptr) (object->first_vertex * size),
+                        (GLsizeiptr) (mesh->vertex_count * size), batch->vertices + object->first_vertex * size);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->buffers[1]);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr) (object->first_index * sizeof(unsigned short)),
+                        (GLsizeiptr) (mesh->index_count * sizeof(unsigned short)),
+                        batch->indices + object->first_index);
+    }
+    for (i = 0; i < batcher->batch_count; ++i)
+        batcher->batches[i].dirty_objects = 0;
+    batcher->job_count = 0;
+}
+
+unsigned int cglStaticBatchCount(const CGLStaticBatcher *batcher) {
+    return batcher->batch_count;
+}
+
+void cglGetStaticBatch(const CGLStaticBatcher *batcher, unsigned int index, CGLStaticBatch *batch) {
+    const CGLBatch *source = &batcher->batches[index];
+
+    batch->material = source->material;
+    batch->vertex_buffer = source->buffers[0];
+    batch->index_buffer = source->buffers[1];
+    batch->index_count = source->draw_count;
+    batch->objects = source->object_count;
+}
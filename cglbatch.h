@@ -0,0 +1,131 @@
+/*
+ *  Static batching for the common OpenGL subset: many small objects pre-transformed into a few draws
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLBATCH_H
+#define CGLBATCH_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief vertices a batch can have at most, all GL_UNSIGNED_SHORT indices */
+#define CGL_BATCH_MAX_VERTICES 65536
+
+/*! \brief normal_offset of cglCreateStaticBatcher for vertices without a normal */
+#define CGL_BATCH_NO_NORMAL ((size_t) -1)
+
+/*! \brief an object in a batcher, 0 is never a valid handle */
+typedef unsigned int CGLBatchHandle;
+
+/*! \brief a set of objects merged into combined vertex and index buffers, in place of instancing
+ *
+ * GL 2.1 and GL ES 2.0 have no instanced drawing, so drawing many copies of small meshes, e.g. foliage,
+ * costs one glDrawElements each. A batcher instead transforms the vertices of every object by its matrix on the CPU
+ * and packs all objects of the same material (a number chosen by the caller for a program and its textures)
+ * into batches of up to max_vertices vertices, each drawn with one glDrawElements of GL_UNSIGNED_SHORT indices.
+ *
+ * Changes are applied in three steps, so that the transforms can run on worker threads:
+ * cglPrepareStaticBatches lays out the objects added or removed since the last time, and collects the objects
+ * to transform; cglBuildStaticBatches does the transforms, called by any number of threads at the same time;
+ * cglUploadStaticBatches uploads what changed on the GL thread. Moving an object only transforms and uploads
+ * its own vertices, removing one repacks only its batch.
+ * The batcher must not be used by other threads between these steps, apart from the cglBuildStaticBatches calls.
+ */
+typedef struct CGLStaticBatcher CGLStaticBatcher;
+
+/*! \brief one batch, to be drawn with its material */
+typedef struct CGLStaticBatch {
+    unsigned int material;
+    GLuint vertex_buffer;   /*!< for the attributes, with the vertex layout given to cglCreateStaticBatcher */
+    GLuint index_buffer;    /*!< to bind to GL_ELEMENT_ARRAY_BUFFER */
+    GLsizei index_count;    /*!< GL_UNSIGNED_SHORT indices of GL_TRIANGLES from offset 0, 0 if the batch is empty */
+    unsigned int objects;
+} CGLStaticBatch;
+
+/*! \brief create an empty batcher, buffer objects are made by cglUploadStaticBatches
+ *
+ * \param vertex_size     bytes of one vertex of the meshes and batches
+ * \param position_offset of the 3 floats of the position in a vertex, transformed as points
+ * \param normal_offset   of 3 floats of a normal, transformed by the upper 3x3 of the matrix and normalized,
+ *                        which is exact for rotations and uniform scales; or CGL_BATCH_NO_NORMAL
+ * \param max_vertices    per batch, at most CGL_BATCH_MAX_VERTICES; 0 for CGL_BATCH_MAX_VERTICES
+ *
+ * \return the batcher, or NULL if an offset or \ref max_vertices is invalid, or there is not enough memory
+ */
+GLAPI CGLStaticBatcher *cglCreateStaticBatcher(size_t vertex_size, size_t position_offset, size_t normal_offset,
+                                               unsigned int max_vertices);
+
+/*! \brief delete all buffer objects of the batcher and free it, NULL is ignored */
+GLAPI void cglDestroyStaticBatcher(CGLStaticBatcher *batcher);
+
+/*! \brief copy a mesh into the batcher, to be used by objects
+ *
+ * \param vertices     \ref vertex_count vertices in the layout of the batcher, in object space
+ * \param vertex_count at most the max_vertices of the batcher
+ * \param indices      \ref index_count indices of triangles
+ *
+ * \return the number of the mesh, counting from 1, or 0 if the mesh is too large or there is not enough memory
+ */
+GLAPI unsigned int cglAddBatchMesh(CGLStaticBatcher *batcher, const void *vertices, unsigned int vertex_count,
+                                   const unsigned short *indices, size_t index_count);
+
+/*! \brief add an object showing \ref mesh, transformed by \ref matrix, to the batches of \ref material
+ *
+ * \param matrix 16 floats in column-major order, as for glUniformMatrix4fv
+ *
+ * \return the handle, or 0 if \ref mesh is invalid or there is not enough memory
+ */
+GLAPI CGLBatchHandle cglAddBatchObject(CGLStaticBatcher *batcher, unsigned int mesh, unsigned int material,
+                                       const float *matrix);
+
+/*! \brief change the matrix of an object, only its vertices are transformed and uploaded again
+ *
+ * 0 and handles already removed are ignored.
+ */
+GLAPI void cglMoveBatchObject(CGLStaticBatcher *batcher, CGLBatchHandle object, const float *matrix);
+
+/*! \brief remove an object, the handle may be given out again; 0 and handles already removed are ignored */
+GLAPI void cglRemoveBatchObject(CGLStaticBatcher *batcher, CGLBatchHandle object);
+
+/*! \brief lay out the changes since the last upload, and collect the transforms for cglBuildStaticBatches
+ *
+ * to be followed by cglBuildStaticBatches and cglUploadStaticBatches before it is called again.
+ *
+ * \return the number of objects to transform, or -1 if there is not enough memory, in which case it can be called again
+ */
+GLAPI long cglPrepareStaticBatches(CGLStaticBatcher *batcher);
+
+/*! \brief do the transforms of worker \ref worker of \ref workers
+ *
+ * to be called once for each worker from 0 to workers - 1 after cglPrepareStaticBatches, on any threads
+ * at the same time; worker i takes every workers-th object, so that all write to different memory.
+ * A single thread simply calls cglBuildStaticBatches(batcher, 0, 1); \ref workers 0 is taken as 1.
+ */
+GLAPI void cglBuildStaticBatches(CGLStaticBatcher *batcher, unsigned int worker, unsigned int workers);
+
+/*! \brief upload the changes to the buffer objects, after all cglBuildStaticBatches calls have returned
+ *
+ * binds the buffers of changed batches to GL_ARRAY_BUFFER and GL_ELEMENT_ARRAY_BUFFER. Batches that grew get
+ * a new glBufferData; of the others, those with a few changed objects get a glBufferSubData of the vertices
+ * and indices of each, the rest one of the range around all changes.
+ */
+GLAPI void cglUploadStaticBatches(CGLStaticBatcher *batcher);
+
+/*! \brief the number of batches, including empty ones */
+GLAPI unsigned int cglStaticBatchCount(const CGLStaticBatcher *batcher);
+
+/*! \brief the buffers of batch \ref index, as of the last upload */
+GLAPI void cglGetStaticBatch(const CGLStaticBatcher *batcher, unsigned int index, CGLStaticBatch *batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
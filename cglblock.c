@@ -0,0 +1,305 @@
+/*
+ *  Uniform blocks for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cglblock.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+
+/* where a field goes in one program */
+typedef struct CGLBlockUniform {
+    GLint location;         /* -1 if the field is not an active uniform of the program */
+    GLsizei count;          /* elements to upload, at most the array length in both C and GLSL */
+    unsigned long serial;   /* CGLUniformBlock::serials of the field when it was uploaded last */
+} CGLBlockUniform;
+
+typedef struct CGLBlockProgram {
+    GLuint program;
+    unsigned long serial;       /* CGLUniformBlock::serial when the program was applied last */
+    CGLBlockUniform *uniforms;  /* one per field */
+} CGLBlockProgram;
+
+struct CGLUniformBlock {
+    CGLBlockField *fields;
+    size_t field_count;
+    unsigned char *data;
+    size_t size;
+    /* each update that changes something increments serial and sets the serials of the fields it changed to it,
+     * so a field has to be uploaded to a program if its serial is newer than the one the program has seen */
+    unsigned long serial;
+    unsigned long *serials;
+    CGLBlockProgram *programs;
+    size_t program_count;
+    size_t program_capacity;
+    size_t last;    /* index of the program found last, programs are usually applied many times in a row */
+};
+
+
+/* components of one element of a type and whether they are GLint, 0 for unknown types */
+static unsigned int cgl_block_components(GLenum type, int *integer) {
+    *integer = 1;
+    switch (type) {
+    case GL_INT: case GL_BOOL: case GL_SAMPLER_2D: case GL_SAMPLER_CUBE:
+        return 1;
+    case GL_INT_VEC2: case GL_BOOL_VEC2:
+        return 2;
+    case GL_INT_VEC3: case GL_BOOL_VEC3:
+        return 3;
+    case GL_INT_VEC4: case GL_BOOL_VEC4:
+        return 4;
+    }
+    *integer = 0;
+    switch (type) {
+    case GL_FLOAT:
+        return 1;
+    case GL_FLOAT_VEC2:
+        return 2;
+    case GL_FLOAT_VEC3:
+        return 3;
+    case GL_FLOAT_VEC4: case GL_FLOAT_MAT2:
+        return 4;
+    case GL_FLOAT_MAT3:
+        return 9;
+    case GL_FLOAT_MAT4:
+        return 16;
+    }
+    return 0;
+}
+
+/* whether a uniform of type active can be set with the function for field, i.e. both have the same components,
+ * floats for floats, and GLint for ints, bools and samplers (bool and sampler fields are interchangeable with int) */
+static int cgl_block_compatible(GLenum field, GLenum active) {
+    int field_integer, active_integer;
+    unsigned int components = cgl_block_components(field, &field_integer);
+
+    if (field == active)
+        return 1;
+    return field_integer && components == cgl_block_components(active, &active_integer) && active_integer;
+}
+
+static void cgl_block_upload(const CGLBlockField *field, GLint location, GLsizei count, const void *data) {
+    const GLfloat *f = (const GLfloat *) data;
+    const GLint *i = (const GLint *) data;
+
+    switch (field->type) {
+    case GL_FLOAT:       glUniform1fv(location, count, f); break;
+    case GL_FLOAT_VEC2:  glUniform2fv(location, count, f); break;
+    case GL_FLOAT_VEC3:  glUniform3fv(location, count, f); break;
+    case GL_FLOAT_VEC4:  glUniform4fv(location, count, f); break;
+    case GL_FLOAT_MAT2:  glUniformMatrix2fv(location, count, GL_FALSE, f); break;
+    case GL_FLOAT_MAT3:  glUniformMatrix3fv(location, count, GL_FALSE, f); break;
+    case GL_FLOAT_MAT4:  glUniformMatrix4fv(location, count, GL_FALSE, f); break;
+    case GL_INT_VEC2: case GL_BOOL_VEC2: glUniform2iv(location, count, i); break;
+    case GL_INT_VEC3: case GL_BOOL_VEC3: glUniform3iv(location, count, i); break;
+    case GL_INT_VEC4: case GL_BOOL_VEC4: glUniform4iv(location, count, i); break;
+    default:             glUniform1iv(location, count, i); break;
+    }
+}
+
+static size_t cgl_block_field_size(const CGLBlockField *field) {
+    int integer;
+
+    return (size_t) field->count * cgl_block_components(field->type, &integer) * 4;
+}
+
+
+CGLUniformBlock *cglCreateUniformBlock(const CGLBlockField *fields, size_t field_count, size_t size) {
+    CGLUniformBlock *block;
+    size_t i;
+
+    for (i = 0; i < field_count; ++i) {
+        int integer;
+
+        if (fields[i].name == nullptr || cgl_block_components(fields[i].type, &integer) == 0 || fields[i].count < 1
+                || fields[i].offset > size || cgl_block_field_size(&fields[i]) > size - fields[i].offset)
+            return nullptr;
+    }
+    block = (CGLUniformBlock *) calloc(1, sizeof(CGLUniformBlock));
+    if (block == nullptr)
+        return nullptr;
+    block->fields = (CGLBlockField *) malloc(field_count * sizeof(CGLBlockField) + 1);
+    block->serials = (unsigned long *) malloc(field_count * sizeof(unsigned long) + 1);
+    block->data = (unsigned char *) calloc(size + 1, 1);
+    if (block->fields == nullptr || block->serials == nullptr || block->data == nullptr) {
+        cglDestroyUniformBlock(block);
+        return nullptr;
+    }
+    if (field_count > 0)
+        memcpy(block->fields, fields, field_count * sizeof(CGLBlockField));
+    block->field_count = field_count;
+    block->size = size;
+
+    /* programs start at serial 0, so all fields are uploaded on their first apply */
+    block->serial = 1;
+    for (i = 0; i < field_count; ++i)
+        block->serials[i] = 1;
+    return block;
+}
+
+void cglDestroyUniformBlock(CGLUniformBlock *block) {
+    size_t i;
+
+    if (block == nullptr)
+        return;
+    for (i = 0; i < block->program_count; ++i)
+        free(block->programs[i].uniforms);
+    free(block->programs);
+    free(block->fields);
+    free(block->serials);
+    free(block->data);
+    free(block);
+}
+
+int cglUpdateUniformBlock(CGLUniformBlock *block, size_t offset, const void *data, size_t size) {
+    const unsigned char *bytes = (const unsigned char *) data;
+    size_t end, i;
+    int changed = 0;
+
+    if (offset > block->size || size > block->size - offset)
+        return 0;
+    end = offset + size;
+    for (i = 0; i < block->field_count; ++i) {
+        size_t first = block->fields[i].offset;
+        size_t last = first + cgl_block_field_size(&block->fields[i]);
+
+        /* only the part of the field inside the range */
+        if (first < offset)
+            first = offset;
+        if (last > end)
+            last = end;
+        if (first >= last || memcmp(block->data + first, bytes + (first - offset), last - first) == 0)
+            continue;
+        if (!changed) {
+            changed = 1;
+            ++block->serial;
+        }
+        block->serials[i] = block->serial;
+    }
+    memcpy(block->data + offset, bytes, size);
+    return changed;
+}
+
+const void *cglUniformBlockData(const CGLUniformBlock *block) {
+    return block->data;
+}
+
+
+static CGLBlockProgram *cgl_block_program(CGLUniformBlock *block, GLuint program) {
+    size_t i;
+
+    if (block->last < block->program_count && block->programs[block->last].program == program)
+        return &block->programs[block->last];
+    for (i = 0; i < block->program_count; ++i) {
+        if (block->programs[i].program == program) {
+            block->last = i;
+            return &block->programs[i];
+        }
+    }
+    return nullptr;
+}
+
+int cglLinkUniformBlock(CGLUniformBlock *block, GLuint program) {
+    CGLBlockProgram *entry = cgl_block_program(block, program);
+    GLint active = 0, max_length = 0, index;
+    GLchar *name;
+    int mapped = 0;
+    size_t i;
+
+    if (entry == nullptr) {
+        if (block->program_count == block->program_capacity) {
+            size_t capacity = block->program_capacity > 0 ? block->program_capacity * 2 : 8;
+            CGLBlockProgram *programs = (CGLBlockProgram *) realloc(block->programs, capacity * sizeof(CGLBlockProgram));
+
+            if (programs == nullptr)
+                return -1;
+            block->programs = programs;
+            block->program_capacity = capacity;
+        }
+        entry = &block->programs[block->program_count];
+        entry->program = program;
+        entry->uniforms = (CGLBlockUniform *) malloc(block->field_count * sizeof(CGLBlockUniform) + 1);
+        if (entry->uniforms == nullptr)
+            return -1;
+        ++block->program_count;
+    }
+    entry->serial = 0;
+    for (i = 0; i < block->field_count; ++i) {
+        entry->uniforms[i].location = -1;
+        entry->uniforms[i].count = 0;
+        entry->uniforms[i].serial = 0;
+    }
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &active);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+    if (active <= 0)
+        return 0;
+    if (max_length < 1)
+        max_length = 256;
+    name = (GLchar *) malloc((size_t) max_length + 1);
+    if (name == nullptr)
+        return -1;
+
+    for (index = 0; index < active; ++index) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+
+        name[0] = '\0';
+        glGetActiveUniform(program, (GLuint) index, max_length, &length, &size, &type, name);
+        name[length > 0 && length < max_length ? length : max_length - 1] = '\0';
+        /* arrays are reported as "name[0]" by most implementations, and as "name" by some */
+        if (length > 3 && strcmp(name + length - 3, "[0]") == 0)
+            name[length - 3] = '\0';
+
+        for (i = 0; i < block->field_count; ++i) {
+            const CGLBlockField *field = &block->fields[i];
+
+            if (strcmp(field->name, name) != 0 || !cgl_block_compatible(field->type, type))
+                continue;
+            entry->uniforms[i].location = glGetUniformLocation(program, name);
+            entry->uniforms[i].count = size < field->count ? size : field->count;
+            if (entry->uniforms[i].location != -1)
+                ++mapped;
+            break;
+        }
+    }
+    free(name);
+    return mapped;
+}
+
+void cglUnlinkUniformBlock(CGLUniformBlock *block, GLuint program) {
+    CGLBlockProgram *entry = cgl_block_program(block, program);
+
+    if (entry == nullptr)
+        return;
+    free(entry->uniforms);
+    *entry = block->programs[--block->program_count];
+}
+
+unsigned int cglApplyUniformBlock(CGLUniformBlock *block, GLuint program) {
+    CGLBlockProgram *entry = cgl_block_program(block, program);
+    unsigned int uploaded = 0;
+    size_t i;
+
+    if (entry == nullptr || entry->serial == block->serial)
+        return 0;
+    for (i = 0; i < block->field_count; ++i) {
+        CGLBlockUniform *uniform = &entry->uniforms[i];
+
+        if (uniform->location == -1 || uniform->serial == block->serials[i])
+            continue;
+        cgl_block_upload(&block->fields[i], uniform->location, uniform->count, block->data + block->fields[i].offset);
+        uniform->serial = block->serials[i];
+        ++uploaded;
+    }
+    entry->serial = block->serial;
+    return uploaded;
+}
@@ -0,0 +1,98 @@
+/*
+ *  Uniform blocks for the common OpenGL subset: C structs shared by many programs, uploaded as plain uniforms
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLBLOCK_H
+#define CGLBLOCK_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief one member of the C struct of a block, and the uniform it is uploaded to
+ *
+ * the member holds \ref count elements without padding between them, each made of GLfloat for the
+ * GL_FLOAT* types (column major for the matrices) and of GLint for the GL_INT*, GL_BOOL* and sampler types.
+ */
+typedef struct CGLBlockField {
+    const char *name;   /*!< name of the uniform in GLSL, e.g. "u_view" or "u_light.color", without "[0]" for arrays */
+    GLenum type;        /*!< GL_FLOAT, GL_FLOAT_VEC2..4, GL_FLOAT_MAT2..4, GL_INT, GL_INT_VEC2..4, GL_BOOL, GL_BOOL_VEC2..4,
+                             GL_SAMPLER_2D or GL_SAMPLER_CUBE, as declared in GLSL */
+    GLsizei count;      /*!< number of array elements, 1 if it is not an array */
+    size_t offset;      /*!< offsetof the member in the struct */
+} CGLBlockField;
+
+/*! \brief a C struct mapped onto the uniforms of any number of programs
+ *
+ * uniform buffer objects are not part of the common subset, so a block keeps its own copy of the struct,
+ * and sets the uniforms of each program with glUniform when it is applied. Every update compares the new bytes
+ * to the copy, field by field, and each program remembers which changes it has already received,
+ * so applying only uploads the fields that changed since that program was applied last,
+ * and applying an unchanged block costs no GL call at all.
+ *
+ * A program is mapped to a block by cglLinkUniformBlock after linking, using glGetActiveUniform. Fields that
+ * are not active in the program, or have a different type, are skipped for that program, so one block,
+ * e.g. the per frame or per view constants, can be shared by all programs that use any part of it.
+ */
+typedef struct CGLUniformBlock CGLUniformBlock;
+
+/*! \brief create a block for a struct
+ *
+ * the block starts out zeroed, and all fields are uploaded on the first apply of each program.
+ *
+ * \param fields      the members of the struct that are uniforms, copied; the names must stay valid
+ * \param field_count number of elements of \ref fields
+ * \param size        sizeof the struct
+ *
+ * \return the block, or NULL if there is not enough memory, or a field has an unknown type or doesn't fit into \ref size
+ */
+GLAPI CGLUniformBlock *cglCreateUniformBlock(const CGLBlockField *fields, size_t field_count, size_t size);
+
+/*! \brief free a block created by cglCreateUniformBlock, NULL is ignored */
+GLAPI void cglDestroyUniformBlock(CGLUniformBlock *block);
+
+/*! \brief copy \ref size bytes from \ref data to \ref offset in the struct of the block
+ *
+ * fields whose bytes changed are marked for upload to every program, the others stay as they are.
+ * cglUpdateUniformBlock(block, 0, &data, sizeof(data)) updates the whole struct.
+ *
+ * \return 1 if any field changed, 0 if not, or if the range doesn't fit into the struct
+ */
+GLAPI int cglUpdateUniformBlock(CGLUniformBlock *block, size_t offset, const void *data, size_t size);
+
+/*! \brief the current contents of the struct of the block, read only */
+GLAPI const void *cglUniformBlockData(const CGLUniformBlock *block);
+
+/*! \brief map the fields of a block to the uniforms of a program
+ *
+ * to be called after each successful glLinkProgram of \ref program, since linking gives new locations
+ * and sets all values to 0. Everything will be uploaded on the next apply.
+ *
+ * \return the number of fields that are active uniforms of \ref program, or -1 if there is not enough memory
+ */
+GLAPI int cglLinkUniformBlock(CGLUniformBlock *block, GLuint program);
+
+/*! \brief forget \ref program, e.g. before it is deleted and its name can be given out again */
+GLAPI void cglUnlinkUniformBlock(CGLUniformBlock *block, GLuint program);
+
+/*! \brief upload the fields that changed since \ref program was applied last
+ *
+ * if \ref program isn't mapped by cglLinkUniformBlock, nothing is done. It must also be in use (see glUseProgram),
+ * which is not checked, as that would need a glGetIntegerv per call: otherwise the behaviour is undefined,
+ * the fields go to the locations of whichever program is in use, and are still taken as applied to \ref program.
+ *
+ * \return the number of fields uploaded
+ */
+GLAPI unsigned int cglApplyUniformBlock(CGLUniformBlock *block, GLuint program);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
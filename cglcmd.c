@@ -0,0 +1,3577 @@
+/*
+ *  Command buffers for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L     /* nanosleep, sched_yield, mmap */
+#endif
+
+#include <cgl/cglcmd.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+
+/* one recorded call: opcode is the slot of the function in CGLDispatch, size the number of bytes
+ * of the whole command including copied data, always a multiple of 8.
+ * Data copied from pointers follows the arguments, the argument holding its offset from the command.
+ */
+typedef union CGLArg {
+    GLuint u;
+    GLint i;
+    GLfloat f;
+    GLdouble d;
+    int64_t l;
+    uint64_t q;
+} CGLArg;
+
+typedef struct CGLCommand {
+    unsigned short opcode;
+    unsigned short argc;
+    uint32_t size;
+    CGLArg arg[1];
+} CGLCommand;
+
+#define CGL_CMD_ALIGN(size) (((size) + 7) & ~(size_t) 7)
+#define CGL_CMD_SIZE(argc) (offsetof(CGLCommand, arg) + (argc) * sizeof(CGLArg))
+
+/* opcodes that are not functions of the dispatch table */
+#define CGL_CMD_CALLBACK    0xff00u     /* arg[0] the function, arg[1] its argument */
+#define CGL_CMD_WRAP        0xff01u     /* proxy ring: the rest of the ring is unused */
+#define CGL_CMD_INDIRECT    0xff02u     /* proxy ring: arg[0] points to the command, in a block of its own */
+#define CGL_CMD_STOP        0xff03u     /* proxy ring: return from cglRunProxy */
+#define CGL_CMD_FRAME       0xff04u     /* trace: end of a frame */
+
+/* the functions are called through an explicit table, as the current one holds the stubs of the proxy
+ * while it runs. With CGL_DIRECT_LINK, there are only the functions themselves.
+ */
+#ifdef CGL_DIRECT_LINK
+#define CGL_CMD_CALL(table, name) gl##name
+#else
+#define CGL_CMD_CALL(table, name) (table)->fn.name
+#endif
+
+struct CGLCommandBuffer {
+    unsigned char *data;
+    size_t used;
+    size_t capacity;
+    int failed;
+    struct CGLProxy *proxy;     /* set for the ring of a proxy, see cgl_proxy_reserve */
+    GLint unpack_alignment;     /* of the last glPixelStorei recorded, 0 for the default of 4, or unknown in a proxy */
+};
+
+
+CGLCommandBuffer *cglCreateCommandBuffer(size_t capacity) {
+    CGLCommandBuffer *buffer = (CGLCommandBuffer *) calloc(1, sizeof(CGLCommandBuffer));
+
+    if (buffer == nullptr)
+        return nullptr;
+    buffer->capacity = capacity > 0 ? CGL_CMD_ALIGN(capacity) : 4096;
+    buffer->data = (unsigned char *) malloc(buffer->capacity);
+    if (buffer->data == nullptr) {
+        free(buffer);
+        return nullptr;
+    }
+    return buffer;
+}
+
+void cglDestroyCommandBuffer(CGLCommandBuffer *buffer) {
+    if (buffer == nullptr)
+        return;
+    free(buffer->data);
+    free(buffer);
+}
+
+void cglResetCommandBuffer(CGLCommandBuffer *buffer) {
+    buffer->used = 0;
+    buffer->failed = 0;
+}
+
+size_t cglCommandBufferSize(const CGLCommandBuffer *buffer) {
+    return buffer->used;
+}
+
+int cglCommandBufferFailed(const CGLCommandBuffer *buffer) {
+    return buffer->failed;
+}
+
+
+static void cgl_cmd_init(CGLCommand *command, unsigned int opcode, unsigned int argc, size_t size) {
+    command->opcode = (unsigned short) opcode;
+    command->argc = (unsigned short) argc;
+    command->size = (uint32_t) size;
+}
+
+#ifndef CGL_DIRECT_LINK
+static CGLCommand *cgl_proxy_reserve(struct CGLProxy *proxy, unsigned int opcode, unsigned int argc, size_t size);
+static GLint cgl_proxy_unpack_alignment(struct CGLProxy *proxy);
+#endif
+
+/* reserves a command with argc arguments and payload bytes of copied data behind them,
+ * NULL if the buffer can't grow (or the command would be larger than the 32 bit size allows)
+ */
+static CGLCommand *cgl_cmd_begin(CGLCommandBuffer *buffer, unsigned int opcode, unsigned int argc, size_t payload) {
+    size_t size = CGL_CMD_SIZE(argc) + payload;
+    CGLCommand *command;
+
+    if (size > 0xffffffffUL) {
+        buffer->failed = 1;
+        return nullptr;
+    }
+#ifndef CGL_DIRECT_LINK
+    if (buffer->proxy != nullptr)
+        return cgl_proxy_reserve(buffer->proxy, opcode, argc, size);
+#endif
+    if (buffer->capacity - buffer->used < size) {
+        size_t capacity = buffer->capacity * 2;
+        unsigned char *data;
+
+        while (capacity - buffer->used < size)
+            capacity *= 2;
+        data = (unsigned char *) realloc(buffer->data, capacity);
+        if (data == nullptr) {
+            buffer->failed = 1;
+            return nullptr;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    command = (CGLCommand *) (buffer->data + buffer->used);
+    cgl_cmd_init(command, opcode, argc, size);
+    buffer->used += size;
+    return command;
+}
+
+/* copies size bytes of data behind the arguments, at *offset, returns that offset or 0 for NULL */
+static GLuint cgl_cmd_copy(CGLCommand *command, size_t *offset, const void *data, size_t size) {
+    size_t at = *offset;
+
+    if (data == nullptr)
+        return 0;
+    memcpy((unsigned char *) command + at, data, size);
+    *offset += CGL_CMD_ALIGN(size);
+    return (GLuint) at;
+}
+
+/* the bytes glTexImage2D and glTexSubImage2D read with rows aligned to alignment;
+ * the types other than GL_UNSIGNED_BYTE of GL ES 2.0 pack a pixel into 16 bits */
+static size_t cgl_cmd_image_bytes(size_t alignment, GLsizei width, GLsizei height, GLenum format, GLenum type) {
+    size_t pixel = format == GL_RGBA ? 4 : format == GL_RGB ? 3 : format == GL_LUMINANCE_ALPHA ? 2 : 1;
+    size_t row;
+
+    if (width <= 0 || height <= 0)
+        return 0;
+    if (type != GL_UNSIGNED_BYTE)
+        pixel = 2;
+    row = (size_t) width * pixel;
+    return (row + alignment - 1) / alignment * alignment * (size_t) (height - 1) + row;
+}
+
+/* the same, with the alignment the buffer last set with glPixelStorei */
+static size_t cgl_cmd_image_size(CGLCommandBuffer *buffer, GLsizei width, GLsizei height, GLenum format,
+                                 GLenum type) {
+    if (width <= 0 || height <= 0)
+        return 0;
+#ifndef CGL_DIRECT_LINK
+    /* the ring of a proxy asks the render thread for the alignment set before the proxy started */
+    if (buffer->unpack_alignment == 0 && buffer->proxy != nullptr)
+        buffer->unpack_alignment = cgl_proxy_unpack_alignment(buffer->proxy);
+#endif
+    return cgl_cmd_image_bytes(buffer->unpack_alignment > 0 ? (size_t) buffer->unpack_alignment : 4, width, height,
+                               format, type);
+}
+
+static const void *cgl_cmd_data(const CGLCommand *command, GLuint offset) {
+    return offset != 0 ? (const unsigned char *) command + offset : nullptr;
+}
+
+/* memory for the outputs of a replayed trace, where the recorded pointers are meaningless.
+ * It is sized by cgl_cmd_output_size before each command, and used = 0.
+ */
+typedef struct CGLScratch {
+    unsigned char *data;
+    size_t used;
+    size_t capacity;
+} CGLScratch;
+
+/* the output pointer of an argument, or size bytes of scratch memory when replaying a trace */
+static void *cgl_cmd_output(CGLScratch *scratch, const CGLArg *arg, size_t size) {
+    void *output;
+
+    if (scratch == nullptr)
+        return (void *) (size_t) arg->q;
+    output = scratch->data + scratch->used;
+    scratch->used += CGL_CMD_ALIGN(size);
+    return output;
+}
+
+
+void cglCmdCallback(CGLCommandBuffer *buffer, CGLCommandCallback callback, void *user) {
+    CGLCommand *command = cgl_cmd_begin(buffer, CGL_CMD_CALLBACK, 2, 0);
+
+    if (command == nullptr)
+        return;
+    command->arg[0].q = (uint64_t) (size_t) callback;
+    command->arg[1].q = (uint64_t) (size_t) user;
+}
+
+/* cglgen:begin encode */
+void cglCmdActiveTexture(CGLCommandBuffer *cmds, GLenum texture) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 0, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = texture;
+}
+
+void cglCmdAttachShader(CGLCommandBuffer *cmds, GLuint program, GLuint shader) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 1, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = program;
+    cmd->arg[1].u = shader;
+}
+
+void cglCmdBindAttribLocation(CGLCommandBuffer *cmds, GLuint program, GLuint index, const GLchar *name) {
+    size_t name_size = name != nullptr ? strlen(name) + 1 : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 2, 3, CGL_CMD_ALIGN(name_size));
+    size_t at = CGL_CMD_SIZE(3);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = program;
+    cmd->arg[1].u = index;
+    cmd->arg[2].u = cgl_cmd_copy(cmd, &at, name, name_size);
+}
+
+void cglCmdBindBuffer(CGLCommandBuffer *cmds, GLenum target, GLuint buffer) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 3, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = target;
+    cmd->arg[1].u = buffer;
+}
+
+void cglCmdBindTexture(CGLCommandBuffer *cmds, GLenum target, GLuint texture) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 4, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = target;
+    cmd->arg[1].u = texture;
+}
+
+void cglCmdBlendColor(CGLCommandBuffer *cmds, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 5, 4, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].f = red;
+    cmd->arg[1].f = green;
+    cmd->arg[2].f = blue;
+    cmd->arg[3].f = alpha;
+}
+
+void cglCmdBlendEquation(CGLCommandBuffer *cmds, GLenum mode) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 6, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = mode;
+}
+
+void cglCmdBlendEquationSeparate(CGLCommandBuffer *cmds, GLenum modeRGB, GLenum modeAlpha) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 7, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = modeRGB;
+    cmd->arg[1].u = modeAlpha;
+}
+
+void cglCmdBlendFunc(CGLCommandBuffer *cmds, GLenum sfactor, GLenum dfactor) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 8, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = sfactor;
+    cmd->arg[1].u = dfactor;
+}
+
+void cglCmdBlendFuncSeparate(CGLCommandBuffer *cmds, GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 9, 4, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = sfactorRGB;
+    cmd->arg[1].u = dfactorRGB;
+    cmd->arg[2].u = sfactorAlpha;
+    cmd->arg[3].u = dfactorAlpha;
+}
+
+void cglCmdBufferData(CGLCommandBuffer *cmds, GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    size_t data_size = data != nullptr ? (size_t) size : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 10, 4, CGL_CMD_ALIGN(data_size));
+    size_t at = CGL_CMD_SIZE(4);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = target;
+    cmd->arg[1].l = size;
+    cmd->arg[2].u = cgl_cmd_copy(cmd, &at, data, data_size);
+    cmd->arg[3].u = usage;
+}
+
+void cglCmdBufferSubData(CGLCommandBuffer *cmds, GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    size_t data_size = data != nullptr ? (size_t) size : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 11, 4, CGL_CMD_ALIGN(data_size));
+    size_t at = CGL_CMD_SIZE(4);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = target;
+    cmd->arg[1].l = offset;
+    cmd->arg[2].l = size;
+    cmd->arg[3].u = cgl_cmd_copy(cmd, &at, data, data_size);
+}
+
+void cglCmdClear(CGLCommandBuffer *cmds, GLbitfield mask) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 12, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = mask;
+}
+
+void cglCmdClearColor(CGLCommandBuffer *cmds, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 13, 4, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].f = red;
+    cmd->arg[1].f = green;
+    cmd->arg[2].f = blue;
+    cmd->arg[3].f = alpha;
+}
+
+void cglCmdClearDepth(CGLCommandBuffer *cmds, GLdouble depth) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 14, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].d = depth;
+}
+
+void cglCmdClearStencil(CGLCommandBuffer *cmds, GLint s) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 15, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = s;
+}
+
+void cglCmdColorMask(CGLCommandBuffer *cmds, GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 16, 4, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = red;
+    cmd->arg[1].u = green;
+    cmd->arg[2].u = blue;
+    cmd->arg[3].u = alpha;
+}
+
+void cglCmdCompileShader(CGLCommandBuffer *cmds, GLuint shader) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 17, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = shader;
+}
+
+void cglCmdCopyTexImage2D(CGLCommandBuffer *cmds, GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 18, 8, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = target;
+    cmd->arg[1].i = level;
+    cmd->arg[2].u = internalformat;
+    cmd->arg[3].i = x;
+    cmd->arg[4].i = y;
+    cmd->arg[5].i = width;
+    cmd->arg[6].i = height;
+    cmd->arg[7].i = border;
+}
+
+void cglCmdCopyTexSubImage2D(CGLCommandBuffer *cmds, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 19, 8, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = target;
+    cmd->arg[1].i = level;
+    cmd->arg[2].i = xoffset;
+    cmd->arg[3].i = yoffset;
+    cmd->arg[4].i = x;
+    cmd->arg[5].i = y;
+    cmd->arg[6].i = width;
+    cmd->arg[7].i = height;
+}
+
+void cglCmdCreateProgram(CGLCommandBuffer *cmds, GLuint *result) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 20, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].q = (uint64_t) (size_t) result;
+}
+
+void cglCmdCreateShader(CGLCommandBuffer *cmds, GLenum type, GLuint *result) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 21, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = type;
+    cmd->arg[1].q = (uint64_t) (size_t) result;
+}
+
+void cglCmdCullFace(CGLCommandBuffer *cmds, GLenum mode) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 22, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = mode;
+}
+
+void cglCmdDeleteBuffers(CGLCommandBuffer *cmds, GLsizei n, const GLuint *buffers) {
+    size_t buffers_size = n > 0 ? (size_t) n * sizeof(GLuint) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 23, 2, CGL_CMD_ALIGN(buffers_size));
+    size_t at = CGL_CMD_SIZE(2);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = n;
+    cmd->arg[1].u = cgl_cmd_copy(cmd, &at, buffers, buffers_size);
+}
+
+void cglCmdDeleteProgram(CGLCommandBuffer *cmds, GLuint program) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 24, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = program;
+}
+
+void cglCmdDeleteShader(CGLCommandBuffer *cmds, GLuint shader) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 25, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = shader;
+}
+
+void cglCmdDeleteTextures(CGLCommandBuffer *cmds, GLsizei n, const GLuint *textures) {
+    size_t textures_size = n > 0 ? (size_t) n * sizeof(GLuint) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 26, 2, CGL_CMD_ALIGN(textures_size));
+    size_t at = CGL_CMD_SIZE(2);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = n;
+    cmd->arg[1].u = cgl_cmd_copy(cmd, &at, textures, textures_size);
+}
+
+void cglCmdDepthFunc(CGLCommandBuffer *cmds, GLenum func) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 27, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = func;
+}
+
+void cglCmdDepthMask(CGLCommandBuffer *cmds, GLboolean flag) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 28, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = flag;
+}
+
+void cglCmdDepthRange(CGLCommandBuffer *cmds, GLdouble n, GLdouble f) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 29, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].d = n;
+    cmd->arg[1].d = f;
+}
+
+void cglCmdDetachShader(CGLCommandBuffer *cmds, GLuint program, GLuint shader) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 30, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = program;
+    cmd->arg[1].u = shader;
+}
+
+void cglCmdEnable(CGLCommandBuffer *cmds, GLenum cap) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 31, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = cap;
+}
+
+void cglCmdDisable(CGLCommandBuffer *cmds, GLenum cap) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 32, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = cap;
+}
+
+void cglCmdEnableVertexAttribArray(CGLCommandBuffer *cmds, GLuint index) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 33, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = index;
+}
+
+void cglCmdDisableVertexAttribArray(CGLCommandBuffer *cmds, GLuint index) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 34, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = index;
+}
+
+void cglCmdDrawArrays(CGLCommandBuffer *cmds, GLenum mode, GLint first, GLsizei count) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 35, 3, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = mode;
+    cmd->arg[1].i = first;
+    cmd->arg[2].i = count;
+}
+
+void cglCmdDrawElements(CGLCommandBuffer *cmds, GLenum mode, GLsizei count, GLenum type, const void *indices) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 36, 4, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = mode;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = type;
+    cmd->arg[3].q = (uint64_t) (size_t) indices;
+}
+
+void cglCmdFinish(CGLCommandBuffer *cmds) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 37, 0, 0);
+
+    if (cmd == nullptr)
+        return;
+}
+
+void cglCmdFlush(CGLCommandBuffer *cmds) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 38, 0, 0);
+
+    if (cmd == nullptr)
+        return;
+}
+
+void cglCmdFrontFace(CGLCommandBuffer *cmds, GLenum mode) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 39, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = mode;
+}
+
+void cglCmdGenBuffers(CGLCommandBuffer *cmds, GLsizei n, GLuint *buffers) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 40, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = n;
+    cmd->arg[1].q = (uint64_t) (size_t) buffers;
+}
+
+void cglCmdGenTextures(CGLCommandBuffer *cmds, GLsizei n, GLuint *textures) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 41, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = n;
+    cmd->arg[1].q = (uint64_t) (size_t) textures;
+}
+
+void cglCmdGetBooleanv(CGLCommandBuffer *cmds, GLenum pname, GLboolean *data) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 42, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = pname;
+    cmd->arg[1].q = (uint64_t) (size_t) data;
+}
+
+void cglCmdGetFloatv(CGLCommandBuffer *cmds, GLenum pname, GLfloat *data) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 43, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = pname;
+    cmd->arg[1].q = (uint64_t) (size_t) data;
+}
+
+void cglCmdGetIntegerv(CGLCommandBuffer *cmds, GLenum pname, GLint *data) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 44, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = pname;
+    cmd->arg[1].q = (uint64_t) (size_t) data;
+}
+
+void cglCmdGetActiveAttrib(CGLCommandBuffer *cmds, GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 45, 7, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = program;
+    cmd->arg[1].u = index;
+    cmd->arg[2].i = bufSize;
+    cmd->arg[3].q = (uint64_t) (size_t) length;
+    cmd->arg[4].q = (uint64_t) (size_t) size;
+    cmd->arg[5].q = (uint64_t) (size_t) type;
+    cmd->arg[6].q = (uint64_t) (size_t) name;
+}
+
+void cglCmdGetActiveUniform(CGLCommandBuffer *cmds, GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 46, 7, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = program;
+    cmd->arg[1].u = index;
+    cmd->arg[2].i = bufSize;
+    cmd->arg[3].q = (uint64_t) (size_t) length;
+    cmd->arg[4].q = (uint64_t) (size_t) size;
+    cmd->arg[5].q = (uint64_t) (size_t) type;
+    cmd->arg[6].q = (uint64_t) (size_t) name;
+}
+
+void cglCmdGetError(CGLCommandBuffer *cmds, GLenum *result) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 47, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].q = (uint64_t) (size_t) result;
+}
+
+void cglCmdGetProgramiv(CGLCommandBuffer *cmds, GLuint program, GLenum pname, GLint *params) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 48, 3, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = program;
+    cmd->arg[1].u = pname;
+    cmd->arg[2].q = (uint64_t) (size_t) params;
+}
+
+void cglCmdGetUniformLocation(CGLCommandBuffer *cmds, GLuint program, const GLchar *name, GLint *result) {
+    size_t name_size = name != nullptr ? strlen(name) + 1 : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 49, 3, CGL_CMD_ALIGN(name_size));
+    size_t at = CGL_CMD_SIZE(3);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = program;
+    cmd->arg[1].u = cgl_cmd_copy(cmd, &at, name, name_size);
+    cmd->arg[2].q = (uint64_t) (size_t) result;
+}
+
+void cglCmdLinkProgram(CGLCommandBuffer *cmds, GLuint program) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 50, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = program;
+}
+
+void cglCmdPixelStorei(CGLCommandBuffer *cmds, GLenum pname, GLint param) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 51, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = pname;
+    cmd->arg[1].i = param;
+    if (pname == GL_UNPACK_ALIGNMENT)
+        cmds->unpack_alignment = param;
+}
+
+void cglCmdPolygonOffset(CGLCommandBuffer *cmds, GLfloat factor, GLfloat units) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 52, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].f = factor;
+    cmd->arg[1].f = units;
+}
+
+void cglCmdStencilFunc(CGLCommandBuffer *cmds, GLenum func, GLint ref, GLuint mask) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 53, 3, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = func;
+    cmd->arg[1].i = ref;
+    cmd->arg[2].u = mask;
+}
+
+void cglCmdStencilFuncSeparate(CGLCommandBuffer *cmds, GLenum face, GLenum func, GLint ref, GLuint mask) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 54, 4, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = face;
+    cmd->arg[1].u = func;
+    cmd->arg[2].i = ref;
+    cmd->arg[3].u = mask;
+}
+
+void cglCmdStencilMask(CGLCommandBuffer *cmds, GLuint mask) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 55, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = mask;
+}
+
+void cglCmdStencilMaskSeparate(CGLCommandBuffer *cmds, GLenum face, GLuint mask) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 56, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = face;
+    cmd->arg[1].u = mask;
+}
+
+void cglCmdStencilOp(CGLCommandBuffer *cmds, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 57, 3, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = sfail;
+    cmd->arg[1].u = dpfail;
+    cmd->arg[2].u = dppass;
+}
+
+void cglCmdStencilOpSeparate(CGLCommandBuffer *cmds, GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 58, 4, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = face;
+    cmd->arg[1].u = sfail;
+    cmd->arg[2].u = dpfail;
+    cmd->arg[3].u = dppass;
+}
+
+void cglCmdTexImage2D(CGLCommandBuffer *cmds, GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *data) {
+    size_t data_size = data != nullptr ? cgl_cmd_image_size(cmds, width, height, format, type) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 59, 9, CGL_CMD_ALIGN(data_size));
+    size_t at = CGL_CMD_SIZE(9);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = target;
+    cmd->arg[1].i = level;
+    cmd->arg[2].i = internalformat;
+    cmd->arg[3].i = width;
+    cmd->arg[4].i = height;
+    cmd->arg[5].i = border;
+    cmd->arg[6].u = format;
+    cmd->arg[7].u = type;
+    cmd->arg[8].u = cgl_cmd_copy(cmd, &at, data, data_size);
+}
+
+void cglCmdTexParameteri(CGLCommandBuffer *cmds, GLenum target, GLenum pname, GLint param) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 60, 3, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = target;
+    cmd->arg[1].u = pname;
+    cmd->arg[2].i = param;
+}
+
+void cglCmdTexSubImage2D(CGLCommandBuffer *cmds, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *data) {
+    size_t data_size = data != nullptr ? cgl_cmd_image_size(cmds, width, height, format, type) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 61, 9, CGL_CMD_ALIGN(data_size));
+    size_t at = CGL_CMD_SIZE(9);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = target;
+    cmd->arg[1].i = level;
+    cmd->arg[2].i = xoffset;
+    cmd->arg[3].i = yoffset;
+    cmd->arg[4].i = width;
+    cmd->arg[5].i = height;
+    cmd->arg[6].u = format;
+    cmd->arg[7].u = type;
+    cmd->arg[8].u = cgl_cmd_copy(cmd, &at, data, data_size);
+}
+
+void cglCmdUniform1f(CGLCommandBuffer *cmds, GLint location, GLfloat v0) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 62, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].f = v0;
+}
+
+void cglCmdUniform2f(CGLCommandBuffer *cmds, GLint location, GLfloat v0, GLfloat v1) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 63, 3, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].f = v0;
+    cmd->arg[2].f = v1;
+}
+
+void cglCmdUniform3f(CGLCommandBuffer *cmds, GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 64, 4, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].f = v0;
+    cmd->arg[2].f = v1;
+    cmd->arg[3].f = v2;
+}
+
+void cglCmdUniform4f(CGLCommandBuffer *cmds, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 65, 5, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].f = v0;
+    cmd->arg[2].f = v1;
+    cmd->arg[3].f = v2;
+    cmd->arg[4].f = v3;
+}
+
+void cglCmdUniform1i(CGLCommandBuffer *cmds, GLint location, GLint v0) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 66, 2, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = v0;
+}
+
+void cglCmdUniform2i(CGLCommandBuffer *cmds, GLint location, GLint v0, GLint v1) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 67, 3, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = v0;
+    cmd->arg[2].i = v1;
+}
+
+void cglCmdUniform3i(CGLCommandBuffer *cmds, GLint location, GLint v0, GLint v1, GLint v2) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 68, 4, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = v0;
+    cmd->arg[2].i = v1;
+    cmd->arg[3].i = v2;
+}
+
+void cglCmdUniform4i(CGLCommandBuffer *cmds, GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 69, 5, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = v0;
+    cmd->arg[2].i = v1;
+    cmd->arg[3].i = v2;
+    cmd->arg[4].i = v3;
+}
+
+void cglCmdUniform1fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLfloat *value) {
+    size_t value_size = count > 0 ? (size_t) count * 1 * sizeof(GLfloat) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 70, 3, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(3);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUniform2fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLfloat *value) {
+    size_t value_size = count > 0 ? (size_t) count * 2 * sizeof(GLfloat) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 71, 3, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(3);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUniform3fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLfloat *value) {
+    size_t value_size = count > 0 ? (size_t) count * 3 * sizeof(GLfloat) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 72, 3, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(3);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUniform4fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLfloat *value) {
+    size_t value_size = count > 0 ? (size_t) count * 4 * sizeof(GLfloat) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 73, 3, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(3);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUniform1iv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLint *value) {
+    size_t value_size = count > 0 ? (size_t) count * 1 * sizeof(GLint) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 74, 3, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(3);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUniform2iv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLint *value) {
+    size_t value_size = count > 0 ? (size_t) count * 2 * sizeof(GLint) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 75, 3, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(3);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUniform3iv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLint *value) {
+    size_t value_size = count > 0 ? (size_t) count * 3 * sizeof(GLint) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 76, 3, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(3);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUniform4iv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLint *value) {
+    size_t value_size = count > 0 ? (size_t) count * 4 * sizeof(GLint) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 77, 3, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(3);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUniformMatrix2fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    size_t value_size = count > 0 ? (size_t) count * 4 * sizeof(GLfloat) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 78, 4, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(4);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = transpose;
+    cmd->arg[3].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUniformMatrix3fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    size_t value_size = count > 0 ? (size_t) count * 9 * sizeof(GLfloat) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 79, 4, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(4);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = transpose;
+    cmd->arg[3].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUniformMatrix4fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    size_t value_size = count > 0 ? (size_t) count * 16 * sizeof(GLfloat) : 0;
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 80, 4, CGL_CMD_ALIGN(value_size));
+    size_t at = CGL_CMD_SIZE(4);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].i = location;
+    cmd->arg[1].i = count;
+    cmd->arg[2].u = transpose;
+    cmd->arg[3].u = cgl_cmd_copy(cmd, &at, value, value_size);
+}
+
+void cglCmdUseProgram(CGLCommandBuffer *cmds, GLuint program) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 81, 1, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = program;
+}
+
+void cglCmdVertexAttribPointer(CGLCommandBuffer *cmds, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+    CGLCommand *cmd = cgl_cmd_begin(cmds, 82, 6, 0);
+
+    if (cmd == nullptr)
+        return;
+    cmd->arg[0].u = index;
+    cmd->arg[1].i = size;
+    cmd->arg[2].u = type;
+    cmd->arg[3].u = normalized;
+    cmd->arg[4].i = stride;
+    cmd->arg[5].q = (uint64_t) (size_t) pointer;
+}
+/* cglgen:end encode */
+
+
+/* cglgen:begin execute */
+static void cgl_cmd_execute(const CGLDispatch *gl, unsigned int opcode, const CGLCommand *command,
+                            CGLScratch *scratch) {
+    const CGLArg *arg = command->arg;
+
+    (void) gl;
+    switch (opcode) {
+        case 0: /* glActiveTexture */
+            CGL_CMD_CALL(gl, ActiveTexture)((GLenum) arg[0].u);
+            break;
+        case 1: /* glAttachShader */
+            CGL_CMD_CALL(gl, AttachShader)((GLuint) arg[0].u, (GLuint) arg[1].u);
+            break;
+        case 2: /* glBindAttribLocation */
+            CGL_CMD_CALL(gl, BindAttribLocation)((GLuint) arg[0].u, (GLuint) arg[1].u, (const GLchar *) cgl_cmd_data(command, arg[2].u));
+            break;
+        case 3: /* glBindBuffer */
+            CGL_CMD_CALL(gl, BindBuffer)((GLenum) arg[0].u, (GLuint) arg[1].u);
+            break;
+        case 4: /* glBindTexture */
+            CGL_CMD_CALL(gl, BindTexture)((GLenum) arg[0].u, (GLuint) arg[1].u);
+            break;
+        case 5: /* glBlendColor */
+            CGL_CMD_CALL(gl, BlendColor)((GLfloat) arg[0].f, (GLfloat) arg[1].f, (GLfloat) arg[2].f, (GLfloat) arg[3].f);
+            break;
+        case 6: /* glBlendEquation */
+            CGL_CMD_CALL(gl, BlendEquation)((GLenum) arg[0].u);
+            break;
+        case 7: /* glBlendEquationSeparate */
+            CGL_CMD_CALL(gl, BlendEquationSeparate)((GLenum) arg[0].u, (GLenum) arg[1].u);
+            break;
+        case 8: /* glBlendFunc */
+            CGL_CMD_CALL(gl, BlendFunc)((GLenum) arg[0].u, (GLenum) arg[1].u);
+            break;
+        case 9: /* glBlendFuncSeparate */
+            CGL_CMD_CALL(gl, BlendFuncSeparate)((GLenum) arg[0].u, (GLenum) arg[1].u, (GLenum) arg[2].u, (GLenum) arg[3].u);
+            break;
+        case 10: /* glBufferData */
+            CGL_CMD_CALL(gl, BufferData)((GLenum) arg[0].u, (GLsizeiptr) arg[1].l, (const void *) cgl_cmd_data(command, arg[2].u), (GLenum) arg[3].u);
+            break;
+        case 11: /* glBufferSubData */
+            CGL_CMD_CALL(gl, BufferSubData)((GLenum) arg[0].u, (GLintptr) arg[1].l, (GLsizeiptr) arg[2].l, (const void *) cgl_cmd_data(command, arg[3].u));
+            break;
+        case 12: /* glClear */
+            CGL_CMD_CALL(gl, Clear)((GLbitfield) arg[0].u);
+            break;
+        case 13: /* glClearColor */
+            CGL_CMD_CALL(gl, ClearColor)((GLfloat) arg[0].f, (GLfloat) arg[1].f, (GLfloat) arg[2].f, (GLfloat) arg[3].f);
+            break;
+        case 14: /* glClearDepth */
+            CGL_CMD_CALL(gl, ClearDepth)((GLdouble) arg[0].d);
+            break;
+        case 15: /* glClearStencil */
+            CGL_CMD_CALL(gl, ClearStencil)((GLint) arg[0].i);
+            break;
+        case 16: /* glColorMask */
+            CGL_CMD_CALL(gl, ColorMask)((GLboolean) arg[0].u, (GLboolean) arg[1].u, (GLboolean) arg[2].u, (GLboolean) arg[3].u);
+            break;
+        case 17: /* glCompileShader */
+            CGL_CMD_CALL(gl, CompileShader)((GLuint) arg[0].u);
+            break;
+        case 18: /* glCopyTexImage2D */
+            CGL_CMD_CALL(gl, CopyTexImage2D)((GLenum) arg[0].u, (GLint) arg[1].i, (GLenum) arg[2].u, (GLint) arg[3].i, (GLint) arg[4].i, (GLsizei) arg[5].i, (GLsizei) arg[6].i, (GLint) arg[7].i);
+            break;
+        case 19: /* glCopyTexSubImage2D */
+            CGL_CMD_CALL(gl, CopyTexSubImage2D)((GLenum) arg[0].u, (GLint) arg[1].i, (GLint) arg[2].i, (GLint) arg[3].i, (GLint) arg[4].i, (GLint) arg[5].i, (GLsizei) arg[6].i, (GLsizei) arg[7].i);
+            break;
+        case 20: /* glCreateProgram */
+            if (scratch == nullptr && arg[0].q != 0)
+                *(GLuint *) (size_t) arg[0].q = CGL_CMD_CALL(gl, CreateProgram)();
+            else
+                CGL_CMD_CALL(gl, CreateProgram)();
+            break;
+        case 21: /* glCreateShader */
+            if (scratch == nullptr && arg[1].q != 0)
+                *(GLuint *) (size_t) arg[1].q = CGL_CMD_CALL(gl, CreateShader)((GLenum) arg[0].u);
+            else
+                CGL_CMD_CALL(gl, CreateShader)((GLenum) arg[0].u);
+            break;
+        case 22: /* glCullFace */
+            CGL_CMD_CALL(gl, CullFace)((GLenum) arg[0].u);
+            break;
+        case 23: /* glDeleteBuffers */
+            CGL_CMD_CALL(gl, DeleteBuffers)((GLsizei) arg[0].i, (const GLuint *) cgl_cmd_data(command, arg[1].u));
+            break;
+        case 24: /* glDeleteProgram */
+            CGL_CMD_CALL(gl, DeleteProgram)((GLuint) arg[0].u);
+            break;
+        case 25: /* glDeleteShader */
+            CGL_CMD_CALL(gl, DeleteShader)((GLuint) arg[0].u);
+            break;
+        case 26: /* glDeleteTextures */
+            CGL_CMD_CALL(gl, DeleteTextures)((GLsizei) arg[0].i, (const GLuint *) cgl_cmd_data(command, arg[1].u));
+            break;
+        case 27: /* glDepthFunc */
+            CGL_CMD_CALL(gl, DepthFunc)((GLenum) arg[0].u);
+            break;
+        case 28: /* glDepthMask */
+            CGL_CMD_CALL(gl, DepthMask)((GLboolean) arg[0].u);
+            break;
+        case 29: /* glDepthRange */
+            CGL_CMD_CALL(gl, DepthRange)((GLdouble) arg[0].d, (GLdouble) arg[1].d);
+            break;
+        case 30: /* glDetachShader */
+            CGL_CMD_CALL(gl, DetachShader)((GLuint) arg[0].u, (GLuint) arg[1].u);
+            break;
+        case 31: /* glEnable */
+            CGL_CMD_CALL(gl, Enable)((GLenum) arg[0].u);
+            break;
+        case 32: /* glDisable */
+            CGL_CMD_CALL(gl, Disable)((GLenum) arg[0].u);
+            break;
+        case 33: /* glEnableVertexAttribArray */
+            CGL_CMD_CALL(gl, EnableVertexAttribArray)((GLuint) arg[0].u);
+            break;
+        case 34: /* glDisableVertexAttribArray */
+            CGL_CMD_CALL(gl, DisableVertexAttribArray)((GLuint) arg[0].u);
+            break;
+        case 35: /* glDrawArrays */
+            CGL_CMD_CALL(gl, DrawArrays)((GLenum) arg[0].u, (GLint) arg[1].i, (GLsizei) arg[2].i);
+            break;
+        case 36: /* glDrawElements */
+            CGL_CMD_CALL(gl, DrawElements)((GLenum) arg[0].u, (GLsizei) arg[1].i, (GLenum) arg[2].u, (const void *) (size_t) arg[3].q);
+            break;
+        case 37: /* glFinish */
+            CGL_CMD_CALL(gl, Finish)();
+            break;
+        case 38: /* glFlush */
+            CGL_CMD_CALL(gl, Flush)();
+            break;
+        case 39: /* glFrontFace */
+            CGL_CMD_CALL(gl, FrontFace)((GLenum) arg[0].u);
+            break;
+        case 40: /* glGenBuffers */
+            CGL_CMD_CALL(gl, GenBuffers)((GLsizei) arg[0].i, (GLuint *) cgl_cmd_output(scratch, &arg[1], ((GLsizei) arg[0].i) > 0 ? (size_t) ((GLsizei) arg[0].i) * sizeof(GLuint) : 0));
+            break;
+        case 41: /* glGenTextures */
+            CGL_CMD_CALL(gl, GenTextures)((GLsizei) arg[0].i, (GLuint *) cgl_cmd_output(scratch, &arg[1], ((GLsizei) arg[0].i) > 0 ? (size_t) ((GLsizei) arg[0].i) * sizeof(GLuint) : 0));
+            break;
+        case 42: /* glGetBooleanv */
+            CGL_CMD_CALL(gl, GetBooleanv)((GLenum) arg[0].u, (GLboolean *) cgl_cmd_output(scratch, &arg[1], 16 * sizeof(GLboolean)));
+            break;
+        case 43: /* glGetFloatv */
+            CGL_CMD_CALL(gl, GetFloatv)((GLenum) arg[0].u, (GLfloat *) cgl_cmd_output(scratch, &arg[1], 16 * sizeof(GLfloat)));
+            break;
+        case 44: /* glGetIntegerv */
+            CGL_CMD_CALL(gl, GetIntegerv)((GLenum) arg[0].u, (GLint *) cgl_cmd_output(scratch, &arg[1], 16 * sizeof(GLint)));
+            break;
+        case 45: /* glGetActiveAttrib */
+            CGL_CMD_CALL(gl, GetActiveAttrib)((GLuint) arg[0].u, (GLuint) arg[1].u, (GLsizei) arg[2].i, (GLsizei *) cgl_cmd_output(scratch, &arg[3], sizeof(GLsizei)), (GLint *) cgl_cmd_output(scratch, &arg[4], sizeof(GLint)), (GLenum *) cgl_cmd_output(scratch, &arg[5], sizeof(GLenum)), (GLchar *) cgl_cmd_output(scratch, &arg[6], ((GLsizei) arg[2].i) > 0 ? (size_t) ((GLsizei) arg[2].i) : 0));
+            break;
+        case 46: /* glGetActiveUniform */
+            CGL_CMD_CALL(gl, GetActiveUniform)((GLuint) arg[0].u, (GLuint) arg[1].u, (GLsizei) arg[2].i, (GLsizei *) cgl_cmd_output(scratch, &arg[3], sizeof(GLsizei)), (GLint *) cgl_cmd_output(scratch, &arg[4], sizeof(GLint)), (GLenum *) cgl_cmd_output(scratch, &arg[5], sizeof(GLenum)), (GLchar *) cgl_cmd_output(scratch, &arg[6], ((GLsizei) arg[2].i) > 0 ? (size_t) ((GLsizei) arg[2].i) : 0));
+            break;
+        case 47: /* glGetError */
+            if (scratch == nullptr && arg[0].q != 0)
+                *(GLenum *) (size_t) arg[0].q = CGL_CMD_CALL(gl, GetError)();
+            else
+                CGL_CMD_CALL(gl, GetError)();
+            break;
+        case 48: /* glGetProgramiv */
+            CGL_CMD_CALL(gl, GetProgramiv)((GLuint) arg[0].u, (GLenum) arg[1].u, (GLint *) cgl_cmd_output(scratch, &arg[2], sizeof(GLint)));
+            break;
+        case 49: /* glGetUniformLocation */
+            if (scratch == nullptr && arg[2].q != 0)
+                *(GLint *) (size_t) arg[2].q = CGL_CMD_CALL(gl, GetUniformLocation)((GLuint) arg[0].u, (const GLchar *) cgl_cmd_data(command, arg[1].u));
+            else
+                CGL_CMD_CALL(gl, GetUniformLocation)((GLuint) arg[0].u, (const GLchar *) cgl_cmd_data(command, arg[1].u));
+            break;
+        case 50: /* glLinkProgram */
+            CGL_CMD_CALL(gl, LinkProgram)((GLuint) arg[0].u);
+            break;
+        case 51: /* glPixelStorei */
+            CGL_CMD_CALL(gl, PixelStorei)((GLenum) arg[0].u, (GLint) arg[1].i);
+            break;
+        case 52: /* glPolygonOffset */
+            CGL_CMD_CALL(gl, PolygonOffset)((GLfloat) arg[0].f, (GLfloat) arg[1].f);
+            break;
+        case 53: /* glStencilFunc */
+            CGL_CMD_CALL(gl, StencilFunc)((GLenum) arg[0].u, (GLint) arg[1].i, (GLuint) arg[2].u);
+            break;
+        case 54: /* glStencilFuncSeparate */
+            CGL_CMD_CALL(gl, StencilFuncSeparate)((GLenum) arg[0].u, (GLenum) arg[1].u, (GLint) arg[2].i, (GLuint) arg[3].u);
+            break;
+        case 55: /* glStencilMask */
+            CGL_CMD_CALL(gl, StencilMask)((GLuint) arg[0].u);
+            break;
+        case 56: /* glStencilMaskSeparate */
+            CGL_CMD_CALL(gl, StencilMaskSeparate)((GLenum) arg[0].u, (GLuint) arg[1].u);
+            break;
+        case 57: /* glStencilOp */
+            CGL_CMD_CALL(gl, StencilOp)((GLenum) arg[0].u, (GLenum) arg[1].u, (GLenum) arg[2].u);
+            break;
+        case 58: /* glStencilOpSeparate */
+            CGL_CMD_CALL(gl, StencilOpSeparate)((GLenum) arg[0].u, (GLenum) arg[1].u, (GLenum) arg[2].u, (GLenum) arg[3].u);
+            break;
+        case 59: /* glTexImage2D */
+            CGL_CMD_CALL(gl, TexImage2D)((GLenum) arg[0].u, (GLint) arg[1].i, (GLint) arg[2].i, (GLsizei) arg[3].i, (GLsizei) arg[4].i, (GLint) arg[5].i, (GLenum) arg[6].u, (GLenum) arg[7].u, (const void *) cgl_cmd_data(command, arg[8].u));
+            break;
+        case 60: /* glTexParameteri */
+            CGL_CMD_CALL(gl, TexParameteri)((GLenum) arg[0].u, (GLenum) arg[1].u, (GLint) arg[2].i);
+            break;
+        case 61: /* glTexSubImage2D */
+            CGL_CMD_CALL(gl, TexSubImage2D)((GLenum) arg[0].u, (GLint) arg[1].i, (GLint) arg[2].i, (GLint) arg[3].i, (GLsizei) arg[4].i, (GLsizei) arg[5].i, (GLenum) arg[6].u, (GLenum) arg[7].u, (const void *) cgl_cmd_data(command, arg[8].u));
+            break;
+        case 62: /* glUniform1f */
+            CGL_CMD_CALL(gl, Uniform1f)((GLint) arg[0].i, (GLfloat) arg[1].f);
+            break;
+        case 63: /* glUniform2f */
+            CGL_CMD_CALL(gl, Uniform2f)((GLint) arg[0].i, (GLfloat) arg[1].f, (GLfloat) arg[2].f);
+            break;
+        case 64: /* glUniform3f */
+            CGL_CMD_CALL(gl, Uniform3f)((GLint) arg[0].i, (GLfloat) arg[1].f, (GLfloat) arg[2].f, (GLfloat) arg[3].f);
+            break;
+        case 65: /* glUniform4f */
+            CGL_CMD_CALL(gl, Uniform4f)((GLint) arg[0].i, (GLfloat) arg[1].f, (GLfloat) arg[2].f, (GLfloat) arg[3].f, (GLfloat) arg[4].f);
+            break;
+        case 66: /* glUniform1i */
+            CGL_CMD_CALL(gl, Uniform1i)((GLint) arg[0].i, (GLint) arg[1].i);
+            break;
+        case 67: /* glUniform2i */
+            CGL_CMD_CALL(gl, Uniform2i)((GLint) arg[0].i, (GLint) arg[1].i, (GLint) arg[2].i);
+            break;
+        case 68: /* glUniform3i */
+            CGL_CMD_CALL(gl, Uniform3i)((GLint) arg[0].i, (GLint) arg[1].i, (GLint) arg[2].i, (GLint) arg[3].i);
+            break;
+        case 69: /* glUniform4i */
+            CGL_CMD_CALL(gl, Uniform4i)((GLint) arg[0].i, (GLint) arg[1].i, (GLint) arg[2].i, (GLint) arg[3].i, (GLint) arg[4].i);
+            break;
+        case 70: /* glUniform1fv */
+            CGL_CMD_CALL(gl, Uniform1fv)((GLint) arg[0].i, (GLsizei) arg[1].i, (const GLfloat *) cgl_cmd_data(command, arg[2].u));
+            break;
+        case 71: /* glUniform2fv */
+            CGL_CMD_CALL(gl, Uniform2fv)((GLint) arg[0].i, (GLsizei) arg[1].i, (const GLfloat *) cgl_cmd_data(command, arg[2].u));
+            break;
+        case 72: /* glUniform3fv */
+            CGL_CMD_CALL(gl, Uniform3fv)((GLint) arg[0].i, (GLsizei) arg[1].i, (const GLfloat *) cgl_cmd_data(command, arg[2].u));
+            break;
+        case 73: /* glUniform4fv */
+            CGL_CMD_CALL(gl, Uniform4fv)((GLint) arg[0].i, (GLsizei) arg[1].i, (const GLfloat *) cgl_cmd_data(command, arg[2].u));
+            break;
+        case 74: /* glUniform1iv */
+            CGL_CMD_CALL(gl, Uniform1iv)((GLint) arg[0].i, (GLsizei) arg[1].i, (const GLint *) cgl_cmd_data(command, arg[2].u));
+            break;
+        case 75: /* glUniform2iv */
+            CGL_CMD_CALL(gl, Uniform2iv)((GLint) arg[0].i, (GLsizei) arg[1].i, (const GLint *) cgl_cmd_data(command, arg[2].u));
+            break;
+        case 76: /* glUniform3iv */
+            CGL_CMD_CALL(gl, Uniform3iv)((GLint) arg[0].i, (GLsizei) arg[1].i, (const GLint *) cgl_cmd_data(command, arg[2].u));
+            break;
+        case 77: /* glUniform4iv */
+            CGL_CMD_CALL(gl, Uniform4iv)((GLint) arg[0].i, (GLsizei) arg[1].i, (const GLint *) cgl_cmd_data(command, arg[2].u));
+            break;
+        case 78: /* glUniformMatrix2fv */
+            CGL_CMD_CALL(gl, UniformMatrix2fv)((GLint) arg[0].i, (GLsizei) arg[1].i, (GLboolean) arg[2].u, (const GLfloat *) cgl_cmd_data(command, arg[3].u));
+            break;
+        case 79: /* glUniformMatrix3fv */
+            CGL_CMD_CALL(gl, UniformMatrix3fv)((GLint) arg[0].i, (GLsizei) arg[1].i, (GLboolean) arg[2].u, (const GLfloat *) cgl_cmd_data(command, arg[3].u));
+            break;
+        case 80: /* glUniformMatrix4fv */
+            CGL_CMD_CALL(gl, UniformMatrix4fv)((GLint) arg[0].i, (GLsizei) arg[1].i, (GLboolean) arg[2].u, (const GLfloat *) cgl_cmd_data(command, arg[3].u));
+            break;
+        case 81: /* glUseProgram */
+            CGL_CMD_CALL(gl, UseProgram)((GLuint) arg[0].u);
+            break;
+        case 82: /* glVertexAttribPointer */
+            CGL_CMD_CALL(gl, VertexAttribPointer)((GLuint) arg[0].u, (GLint) arg[1].i, (GLenum) arg[2].u, (GLboolean) arg[3].u, (GLsizei) arg[4].i, (const void *) (size_t) arg[5].q);
+            break;
+        default:
+            break;
+    }
+}
+/* cglgen:end execute */
+
+static void cgl_cmd_run(const CGLDispatch *gl, const CGLCommand *command) {
+    if (command->opcode == CGL_CMD_CALLBACK)
+        ((CGLCommandCallback) (size_t) command->arg[0].q)((void *) (size_t) command->arg[1].q);
+    else
+        cgl_cmd_execute(gl, command->opcode, command, nullptr);
+}
+
+void cglSubmit(CGLCommandBuffer *const *buffers, size_t count) {
+#ifdef CGL_DIRECT_LINK
+    const CGLDispatch *gl = nullptr;
+#else
+    const CGLDispatch *gl = CGL_CURRENT_DISPATCH;
+#endif
+    size_t i;
+
+    for (i = 0; i < count; ++i) {
+        const unsigned char *at = buffers[i]->data;
+        const unsigned char *end = at + buffers[i]->used;
+
+        while (at < end) {
+            const CGLCommand *command = (const CGLCommand *) at;
+
+            cgl_cmd_run(gl, command);
+            at += command->size;
+        }
+    }
+}
+
+
+#ifndef CGL_DIRECT_LINK
+
+/* the proxy ring: head and tail count the bytes written and executed since the start, the ring offset is
+ * their value modulo the capacity, a power of two. Each is written by one thread only, and kept on a cache line
+ * of its own, so that the threads only share a line when one of them reads the other's counter.
+ * writer.used is the position after the last recorded command, head the same but only updated
+ * when the command is complete, which is when the render thread may execute it.
+ * Commands never wrap around the end of the ring, instead a CGL_CMD_WRAP command fills the rest.
+ */
+struct CGLProxy {
+    CGLCommandBuffer writer;
+    size_t tail_seen;           /* last value of tail read by the application thread */
+    char pad0[64];
+    size_t head;
+    char pad1[64];
+    size_t tail;
+    char pad2[64];
+    size_t stopped;
+    CGLDispatch *table;         /* the table holding the stubs */
+    CGLDispatch next;           /* the functions the stubs replaced, called by the render thread */
+};
+
+static CGLProxy *cgl_proxy = nullptr;
+
+static size_t cgl_load_acquire(const size_t *counter) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(counter, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+    size_t value = *(const volatile size_t *) counter;
+
+    MemoryBarrier();
+    return value;
+#else
+#error no atomic loads and stores known for this compiler
+#endif
+}
+
+static void cgl_store_release(size_t *counter, size_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(counter, value, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER)
+    MemoryBarrier();
+    *(volatile size_t *) counter = value;
+#endif
+}
+
+/* waiting for the other thread: spin shortly, then yield, then sleep */
+static void cgl_proxy_pause(unsigned int *spins) {
+    if (++*spins < 64)
+        return;
+#if defined(_WIN32)
+    if (*spins < 1024)
+        SwitchToThread();
+    else
+        Sleep(1);
+#else
+    if (*spins < 1024) {
+        sched_yield();
+    } else {
+        struct timespec pause;
+
+        pause.tv_sec = 0;
+        pause.tv_nsec = 50000;
+        nanosleep(&pause, nullptr);
+    }
+#endif
+}
+
+/* wait until size bytes behind writer.used are free */
+static void cgl_proxy_space(CGLProxy *proxy, size_t size) {
+    unsigned int spins = 0;
+
+    while (proxy->writer.capacity - (proxy->writer.used - proxy->tail_seen) < size) {
+        proxy->tail_seen = cgl_load_acquire(&proxy->tail);
+        if (proxy->writer.capacity - (proxy->writer.used - proxy->tail_seen) < size)
+            cgl_proxy_pause(&spins);
+    }
+}
+
+static CGLCommand *cgl_proxy_reserve(CGLProxy *proxy, unsigned int opcode, unsigned int argc, size_t size) {
+    size_t capacity = proxy->writer.capacity;
+    size_t at = proxy->writer.used & (capacity - 1);
+    CGLCommand *command;
+
+    if (size > capacity / 4) {
+        CGLCommand *block = (CGLCommand *) malloc(size);
+
+        if (block == nullptr) {
+            proxy->writer.failed = 1;
+            return nullptr;
+        }
+        command = cgl_proxy_reserve(proxy, CGL_CMD_INDIRECT, 1, CGL_CMD_SIZE(1));
+        command->arg[0].q = (uint64_t) (size_t) block;
+        cgl_cmd_init(block, opcode, argc, size);
+        return block;
+    }
+    if (capacity - at < size) {
+        cgl_proxy_space(proxy, capacity - at);
+        cgl_cmd_init((CGLCommand *) (proxy->writer.data + at), CGL_CMD_WRAP, 0, capacity - at);
+        proxy->writer.used += capacity - at;
+        at = 0;
+    }
+    cgl_proxy_space(proxy, size);
+    command = (CGLCommand *) (proxy->writer.data + at);
+    cgl_cmd_init(command, opcode, argc, size);
+    proxy->writer.used += size;
+    return command;
+}
+
+/* hand the recorded commands to the render thread */
+static void cgl_proxy_commit(CGLProxy *proxy) {
+    cgl_store_release(&proxy->head, proxy->writer.used);
+}
+
+/* the same, and wait until they are executed */
+static void cgl_proxy_wait(CGLProxy *proxy) {
+    unsigned int spins = 0;
+
+    cgl_proxy_commit(proxy);
+    while ((proxy->tail_seen = cgl_load_acquire(&proxy->tail)) != proxy->writer.used)
+        cgl_proxy_pause(&spins);
+}
+
+/* GL_UNPACK_ALIGNMENT on the render thread, for the first image recorded without a glPixelStorei before */
+static GLint cgl_proxy_unpack_alignment(CGLProxy *proxy) {
+    GLint alignment = 4;
+
+    cglCmdGetIntegerv(&proxy->writer, GL_UNPACK_ALIGNMENT, &alignment);
+    cgl_proxy_wait(proxy);
+    return alignment == 1 || alignment == 2 || alignment == 8 ? alignment : 4;
+}
+
+/* cglgen:begin proxy */
+static void APIENTRY cgl_proxy_glActiveTexture(GLenum texture) {
+    cglCmdActiveTexture(&cgl_proxy->writer, texture);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glAttachShader(GLuint program, GLuint shader) {
+    cglCmdAttachShader(&cgl_proxy->writer, program, shader);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glBindAttribLocation(GLuint program, GLuint index, const GLchar *name) {
+    cglCmdBindAttribLocation(&cgl_proxy->writer, program, index, name);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glBindBuffer(GLenum target, GLuint buffer) {
+    cglCmdBindBuffer(&cgl_proxy->writer, target, buffer);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glBindTexture(GLenum target, GLuint texture) {
+    cglCmdBindTexture(&cgl_proxy->writer, target, texture);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    cglCmdBlendColor(&cgl_proxy->writer, red, green, blue, alpha);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glBlendEquation(GLenum mode) {
+    cglCmdBlendEquation(&cgl_proxy->writer, mode);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+    cglCmdBlendEquationSeparate(&cgl_proxy->writer, modeRGB, modeAlpha);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glBlendFunc(GLenum sfactor, GLenum dfactor) {
+    cglCmdBlendFunc(&cgl_proxy->writer, sfactor, dfactor);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) {
+    cglCmdBlendFuncSeparate(&cgl_proxy->writer, sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    cglCmdBufferData(&cgl_proxy->writer, target, size, data, usage);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    cglCmdBufferSubData(&cgl_proxy->writer, target, offset, size, data);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glClear(GLbitfield mask) {
+    cglCmdClear(&cgl_proxy->writer, mask);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    cglCmdClearColor(&cgl_proxy->writer, red, green, blue, alpha);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glClearDepth(GLdouble depth) {
+    cglCmdClearDepth(&cgl_proxy->writer, depth);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glClearStencil(GLint s) {
+    cglCmdClearStencil(&cgl_proxy->writer, s);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    cglCmdColorMask(&cgl_proxy->writer, red, green, blue, alpha);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glCompileShader(GLuint shader) {
+    cglCmdCompileShader(&cgl_proxy->writer, shader);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glCopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border) {
+    cglCmdCopyTexImage2D(&cgl_proxy->writer, target, level, internalformat, x, y, width, height, border);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height) {
+    cglCmdCopyTexSubImage2D(&cgl_proxy->writer, target, level, xoffset, yoffset, x, y, width, height);
+    cgl_proxy_commit(cgl_proxy);
+}
+static GLuint APIENTRY cgl_proxy_glCreateProgram(void) {
+    GLuint result = 0;
+
+    cglCmdCreateProgram(&cgl_proxy->writer, &result);
+    cgl_proxy_wait(cgl_proxy);
+    return result;
+}
+static GLuint APIENTRY cgl_proxy_glCreateShader(GLenum type) {
+    GLuint result = 0;
+
+    cglCmdCreateShader(&cgl_proxy->writer, type, &result);
+    cgl_proxy_wait(cgl_proxy);
+    return result;
+}
+static void APIENTRY cgl_proxy_glCullFace(GLenum mode) {
+    cglCmdCullFace(&cgl_proxy->writer, mode);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
+    cglCmdDeleteBuffers(&cgl_proxy->writer, n, buffers);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDeleteProgram(GLuint program) {
+    cglCmdDeleteProgram(&cgl_proxy->writer, program);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDeleteShader(GLuint shader) {
+    cglCmdDeleteShader(&cgl_proxy->writer, shader);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDeleteTextures(GLsizei n, const GLuint *textures) {
+    cglCmdDeleteTextures(&cgl_proxy->writer, n, textures);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDepthFunc(GLenum func) {
+    cglCmdDepthFunc(&cgl_proxy->writer, func);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDepthMask(GLboolean flag) {
+    cglCmdDepthMask(&cgl_proxy->writer, flag);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDepthRange(GLdouble n, GLdouble f) {
+    cglCmdDepthRange(&cgl_proxy->writer, n, f);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDetachShader(GLuint program, GLuint shader) {
+    cglCmdDetachShader(&cgl_proxy->writer, program, shader);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glEnable(GLenum cap) {
+    cglCmdEnable(&cgl_proxy->writer, cap);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDisable(GLenum cap) {
+    cglCmdDisable(&cgl_proxy->writer, cap);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glEnableVertexAttribArray(GLuint index) {
+    cglCmdEnableVertexAttribArray(&cgl_proxy->writer, index);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDisableVertexAttribArray(GLuint index) {
+    cglCmdDisableVertexAttribArray(&cgl_proxy->writer, index);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    cglCmdDrawArrays(&cgl_proxy->writer, mode, first, count);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) {
+    cglCmdDrawElements(&cgl_proxy->writer, mode, count, type, indices);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glFinish(void) {
+    cglCmdFinish(&cgl_proxy->writer);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glFlush(void) {
+    cglCmdFlush(&cgl_proxy->writer);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glFrontFace(GLenum mode) {
+    cglCmdFrontFace(&cgl_proxy->writer, mode);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glGenBuffers(GLsizei n, GLuint *buffers) {
+    cglCmdGenBuffers(&cgl_proxy->writer, n, buffers);
+    cgl_proxy_wait(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glGenTextures(GLsizei n, GLuint *textures) {
+    cglCmdGenTextures(&cgl_proxy->writer, n, textures);
+    cgl_proxy_wait(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glGetBooleanv(GLenum pname, GLboolean *data) {
+    cglCmdGetBooleanv(&cgl_proxy->writer, pname, data);
+    cgl_proxy_wait(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glGetFloatv(GLenum pname, GLfloat *data) {
+    cglCmdGetFloatv(&cgl_proxy->writer, pname, data);
+    cgl_proxy_wait(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glGetIntegerv(GLenum pname, GLint *data) {
+    cglCmdGetIntegerv(&cgl_proxy->writer, pname, data);
+    cgl_proxy_wait(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    cglCmdGetActiveAttrib(&cgl_proxy->writer, program, index, bufSize, length, size, type, name);
+    cgl_proxy_wait(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    cglCmdGetActiveUniform(&cgl_proxy->writer, program, index, bufSize, length, size, type, name);
+    cgl_proxy_wait(cgl_proxy);
+}
+static GLenum APIENTRY cgl_proxy_glGetError(void) {
+    GLenum result = 0;
+
+    cglCmdGetError(&cgl_proxy->writer, &result);
+    cgl_proxy_wait(cgl_proxy);
+    return result;
+}
+static void APIENTRY cgl_proxy_glGetProgramiv(GLuint program, GLenum pname, GLint *params) {
+    cglCmdGetProgramiv(&cgl_proxy->writer, program, pname, params);
+    cgl_proxy_wait(cgl_proxy);
+}
+static GLint APIENTRY cgl_proxy_glGetUniformLocation(GLuint program, const GLchar *name) {
+    GLint result = 0;
+
+    cglCmdGetUniformLocation(&cgl_proxy->writer, program, name, &result);
+    cgl_proxy_wait(cgl_proxy);
+    return result;
+}
+static void APIENTRY cgl_proxy_glLinkProgram(GLuint program) {
+    cglCmdLinkProgram(&cgl_proxy->writer, program);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glPixelStorei(GLenum pname, GLint param) {
+    cglCmdPixelStorei(&cgl_proxy->writer, pname, param);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glPolygonOffset(GLfloat factor, GLfloat units) {
+    cglCmdPolygonOffset(&cgl_proxy->writer, factor, units);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glStencilFunc(GLenum func, GLint ref, GLuint mask) {
+    cglCmdStencilFunc(&cgl_proxy->writer, func, ref, mask);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+    cglCmdStencilFuncSeparate(&cgl_proxy->writer, face, func, ref, mask);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glStencilMask(GLuint mask) {
+    cglCmdStencilMask(&cgl_proxy->writer, mask);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glStencilMaskSeparate(GLenum face, GLuint mask) {
+    cglCmdStencilMaskSeparate(&cgl_proxy->writer, face, mask);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glStencilOp(GLenum sfail, GLenum dpfail, GLenum dppass) {
+    cglCmdStencilOp(&cgl_proxy->writer, sfail, dpfail, dppass);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    cglCmdStencilOpSeparate(&cgl_proxy->writer, face, sfail, dpfail, dppass);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *data) {
+    cglCmdTexImage2D(&cgl_proxy->writer, target, level, internalformat, width, height, border, format, type, data);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glTexParameteri(GLenum target, GLenum pname, GLint param) {
+    cglCmdTexParameteri(&cgl_proxy->writer, target, pname, param);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *data) {
+    cglCmdTexSubImage2D(&cgl_proxy->writer, target, level, xoffset, yoffset, width, height, format, type, data);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform1f(GLint location, GLfloat v0) {
+    cglCmdUniform1f(&cgl_proxy->writer, location, v0);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform2f(GLint location, GLfloat v0, GLfloat v1) {
+    cglCmdUniform2f(&cgl_proxy->writer, location, v0, v1);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    cglCmdUniform3f(&cgl_proxy->writer, location, v0, v1, v2);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    cglCmdUniform4f(&cgl_proxy->writer, location, v0, v1, v2, v3);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform1i(GLint location, GLint v0) {
+    cglCmdUniform1i(&cgl_proxy->writer, location, v0);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform2i(GLint location, GLint v0, GLint v1) {
+    cglCmdUniform2i(&cgl_proxy->writer, location, v0, v1);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform3i(GLint location, GLint v0, GLint v1, GLint v2) {
+    cglCmdUniform3i(&cgl_proxy->writer, location, v0, v1, v2);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+    cglCmdUniform4i(&cgl_proxy->writer, location, v0, v1, v2, v3);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform1fv(GLint location, GLsizei count, const GLfloat *value) {
+    cglCmdUniform1fv(&cgl_proxy->writer, location, count, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform2fv(GLint location, GLsizei count, const GLfloat *value) {
+    cglCmdUniform2fv(&cgl_proxy->writer, location, count, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+    cglCmdUniform3fv(&cgl_proxy->writer, location, count, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+    cglCmdUniform4fv(&cgl_proxy->writer, location, count, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform1iv(GLint location, GLsizei count, const GLint *value) {
+    cglCmdUniform1iv(&cgl_proxy->writer, location, count, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform2iv(GLint location, GLsizei count, const GLint *value) {
+    cglCmdUniform2iv(&cgl_proxy->writer, location, count, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform3iv(GLint location, GLsizei count, const GLint *value) {
+    cglCmdUniform3iv(&cgl_proxy->writer, location, count, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniform4iv(GLint location, GLsizei count, const GLint *value) {
+    cglCmdUniform4iv(&cgl_proxy->writer, location, count, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    cglCmdUniformMatrix2fv(&cgl_proxy->writer, location, count, transpose, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    cglCmdUniformMatrix3fv(&cgl_proxy->writer, location, count, transpose, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    cglCmdUniformMatrix4fv(&cgl_proxy->writer, location, count, transpose, value);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glUseProgram(GLuint program) {
+    cglCmdUseProgram(&cgl_proxy->writer, program);
+    cgl_proxy_commit(cgl_proxy);
+}
+static void APIENTRY cgl_proxy_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+    cglCmdVertexAttribPointer(&cgl_proxy->writer, index, size, type, normalized, stride, pointer);
+    cgl_proxy_commit(cgl_proxy);
+}
+
+static const CGLDispatch cgl_proxy_stubs = {{
+    cgl_proxy_glActiveTexture,
+    cgl_proxy_glAttachShader,
+    cgl_proxy_glBindAttribLocation,
+    cgl_proxy_glBindBuffer,
+    cgl_proxy_glBindTexture,
+    cgl_proxy_glBlendColor,
+    cgl_proxy_glBlendEquation,
+    cgl_proxy_glBlendEquationSeparate,
+    cgl_proxy_glBlendFunc,
+    cgl_proxy_glBlendFuncSeparate,
+    cgl_proxy_glBufferData,
+    cgl_proxy_glBufferSubData,
+    cgl_proxy_glClear,
+    cgl_proxy_glClearColor,
+    cgl_proxy_glClearDepth,
+    cgl_proxy_glClearStencil,
+    cgl_proxy_glColorMask,
+    cgl_proxy_glCompileShader,
+    cgl_proxy_glCopyTexImage2D,
+    cgl_proxy_glCopyTexSubImage2D,
+    cgl_proxy_glCreateProgram,
+    cgl_proxy_glCreateShader,
+    cgl_proxy_glCullFace,
+    cgl_proxy_glDeleteBuffers,
+    cgl_proxy_glDeleteProgram,
+    cgl_proxy_glDeleteShader,
+    cgl_proxy_glDeleteTextures,
+    cgl_proxy_glDepthFunc,
+    cgl_proxy_glDepthMask,
+    cgl_proxy_glDepthRange,
+    cgl_proxy_glDetachShader,
+    cgl_proxy_glEnable,
+    cgl_proxy_glDisable,
+    cgl_proxy_glEnableVertexAttribArray,
+    cgl_proxy_glDisableVertexAttribArray,
+    cgl_proxy_glDrawArrays,
+    cgl_proxy_glDrawElements,
+    cgl_proxy_glFinish,
+    cgl_proxy_glFlush,
+    cgl_proxy_glFrontFace,
+    cgl_proxy_glGenBuffers,
+    cgl_proxy_glGenTextures,
+    cgl_proxy_glGetBooleanv,
+    cgl_proxy_glGetFloatv,
+    cgl_proxy_glGetIntegerv,
+    cgl_proxy_glGetActiveAttrib,
+    cgl_proxy_glGetActiveUniform,
+    cgl_proxy_glGetError,
+    cgl_proxy_glGetProgramiv,
+    cgl_proxy_glGetUniformLocation,
+    cgl_proxy_glLinkProgram,
+    cgl_proxy_glPixelStorei,
+    cgl_proxy_glPolygonOffset,
+    cgl_proxy_glStencilFunc,
+    cgl_proxy_glStencilFuncSeparate,
+    cgl_proxy_glStencilMask,
+    cgl_proxy_glStencilMaskSeparate,
+    cgl_proxy_glStencilOp,
+    cgl_proxy_glStencilOpSeparate,
+    cgl_proxy_glTexImage2D,
+    cgl_proxy_glTexParameteri,
+    cgl_proxy_glTexSubImage2D,
+    cgl_proxy_glUniform1f,
+    cgl_proxy_glUniform2f,
+    cgl_proxy_glUniform3f,
+    cgl_proxy_glUniform4f,
+    cgl_proxy_glUniform1i,
+    cgl_proxy_glUniform2i,
+    cgl_proxy_glUniform3i,
+    cgl_proxy_glUniform4i,
+    cgl_proxy_glUniform1fv,
+    cgl_proxy_glUniform2fv,
+    cgl_proxy_glUniform3fv,
+    cgl_proxy_glUniform4fv,
+    cgl_proxy_glUniform1iv,
+    cgl_proxy_glUniform2iv,
+    cgl_proxy_glUniform3iv,
+    cgl_proxy_glUniform4iv,
+    cgl_proxy_glUniformMatrix2fv,
+    cgl_proxy_glUniformMatrix3fv,
+    cgl_proxy_glUniformMatrix4fv,
+    cgl_proxy_glUseProgram,
+    cgl_proxy_glVertexAttribPointer
+}};
+/* cglgen:end proxy */
+
+CGLProxy *cglStartProxy(size_t capacity) {
+    CGLProxy *proxy;
+    size_t size = 4096;
+
+    if (cgl_proxy != nullptr)
+        return nullptr;
+    while (size < capacity && size < (size_t) 1 << 30)
+        size *= 2;
+    proxy = (CGLProxy *) calloc(1, sizeof(CGLProxy));
+    if (proxy == nullptr)
+        return nullptr;
+    proxy->writer.data = (unsigned char *) malloc(size);
+    if (proxy->writer.data == nullptr) {
+        free(proxy);
+        return nullptr;
+    }
+    proxy->writer.capacity = size;
+    proxy->writer.proxy = proxy;
+    proxy->table = CGL_CURRENT_DISPATCH;
+    proxy->next = *proxy->table;
+    *proxy->table = cgl_proxy_stubs;
+    cgl_proxy = proxy;
+    return proxy;
+}
+
+void cglRunProxy(CGLProxy *proxy) {
+    const unsigned char *ring = proxy->writer.data;
+    size_t mask = proxy->writer.capacity - 1;
+    size_t tail = proxy->tail;
+    size_t head = tail;
+    unsigned int spins = 0;
+
+    cglResolveLazy(&proxy->next);
+    for (;;) {
+        const CGLCommand *command;
+
+        if (tail == head) {
+            head = cgl_load_acquire(&proxy->head);
+            if (tail == head) {
+                cgl_proxy_pause(&spins);
+                continue;
+            }
+            spins = 0;
+        }
+        command = (const CGLCommand *) (ring + (tail & mask));
+        if (command->opcode == CGL_CMD_STOP) {
+            cgl_store_release(&proxy->stopped, 1);
+            return;
+        }
+        if (command->opcode == CGL_CMD_INDIRECT) {
+            CGLCommand *block = (CGLCommand *) (size_t) command->arg[0].q;
+
+            cgl_cmd_run(&proxy->next, block);
+            free(block);
+        } else if (command->opcode != CGL_CMD_WRAP) {
+            cgl_cmd_run(&proxy->next, command);
+        }
+        tail += command->size;
+        cgl_store_release(&proxy->tail, tail);
+    }
+}
+
+void cglProxyCall(CGLProxy *proxy, CGLCommandCallback callback, void *user) {
+    cglCmdCallback(&proxy->writer, callback, user);
+    cgl_proxy_commit(proxy);
+}
+
+void cglProxyFinish(CGLProxy *proxy) {
+    cgl_proxy_wait(proxy);
+}
+
+void cglStopProxy(CGLProxy *proxy) {
+    unsigned int spins = 0;
+    unsigned int i;
+
+    cgl_cmd_begin(&proxy->writer, CGL_CMD_STOP, 0, 0);
+    cgl_proxy_commit(proxy);
+    while (!cgl_load_acquire(&proxy->stopped))
+        cgl_proxy_pause(&spins);
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i)
+        if (proxy->table->slot[i] == cgl_proxy_stubs.slot[i])
+            proxy->table->slot[i] = proxy->next.slot[i];
+    cgl_proxy = nullptr;
+    free(proxy->writer.data);
+    free(proxy);
+}
+
+
+
+/* traces: a CGLTraceHeader, the names of the functions in the order of their opcodes, each with its
+ * terminating zero and padded to a multiple of 8 bytes as a whole, then the commands, as they are recorded
+ * in command buffers. As opcodes are looked up by name, traces stay valid when functions are added.
+ * Everything is in the byte order of the machine that captured the trace.
+ */
+#define CGL_TRACE_VERSION 1
+#define CGL_TRACE_BYTE_ORDER 0x01020304u
+
+typedef struct CGLTraceHeader {
+    char magic[8];              /* "CGLTRACE" */
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t functions;
+    uint32_t names_size;
+} CGLTraceHeader;
+
+/* whether size bytes at offset lie within a command, behind its arguments; offset 0 is NULL */
+static int cgl_cmd_check_payload(const CGLCommand *command, GLuint offset, size_t size) {
+    return offset == 0 || (offset >= CGL_CMD_SIZE(command->argc) && offset <= command->size
+                           && size <= command->size - offset);
+}
+
+/* the same for a string, which has to end within the command */
+static int cgl_cmd_check_string(const CGLCommand *command, GLuint offset) {
+    return offset == 0 || (offset >= CGL_CMD_SIZE(command->argc) && offset < command->size
+                           && memchr((const unsigned char *) command + offset, 0, command->size - offset) != nullptr);
+}
+
+/* whether a command of a trace has the arguments of the function of its slot, with every payload within it,
+ * as far as the function reads; alignment follows the glPixelStorei calls checked before */
+/* cglgen:begin check */
+static int cgl_cmd_check(unsigned int opcode, const CGLCommand *command, size_t *alignment) {
+    const CGLArg *arg = command->arg;
+
+    switch (opcode) {
+        case 0: /* glActiveTexture */
+            return command->argc == 1;
+        case 1: /* glAttachShader */
+            return command->argc == 2;
+        case 2: /* glBindAttribLocation */
+            return command->argc == 3
+                   && cgl_cmd_check_string(command, arg[2].u);
+        case 3: /* glBindBuffer */
+            return command->argc == 2;
+        case 4: /* glBindTexture */
+            return command->argc == 2;
+        case 5: /* glBlendColor */
+            return command->argc == 4;
+        case 6: /* glBlendEquation */
+            return command->argc == 1;
+        case 7: /* glBlendEquationSeparate */
+            return command->argc == 2;
+        case 8: /* glBlendFunc */
+            return command->argc == 2;
+        case 9: /* glBlendFuncSeparate */
+            return command->argc == 4;
+        case 10: /* glBufferData */
+            return command->argc == 4
+                   && cgl_cmd_check_payload(command, arg[2].u, (size_t) ((GLsizeiptr) arg[1].l));
+        case 11: /* glBufferSubData */
+            return command->argc == 4
+                   && cgl_cmd_check_payload(command, arg[3].u, (size_t) ((GLsizeiptr) arg[2].l));
+        case 12: /* glClear */
+            return command->argc == 1;
+        case 13: /* glClearColor */
+            return command->argc == 4;
+        case 14: /* glClearDepth */
+            return command->argc == 1;
+        case 15: /* glClearStencil */
+            return command->argc == 1;
+        case 16: /* glColorMask */
+            return command->argc == 4;
+        case 17: /* glCompileShader */
+            return command->argc == 1;
+        case 18: /* glCopyTexImage2D */
+            return command->argc == 8;
+        case 19: /* glCopyTexSubImage2D */
+            return command->argc == 8;
+        case 20: /* glCreateProgram */
+            return command->argc == 1;
+        case 21: /* glCreateShader */
+            return command->argc == 2;
+        case 22: /* glCullFace */
+            return command->argc == 1;
+        case 23: /* glDeleteBuffers */
+            return command->argc == 2
+                   && cgl_cmd_check_payload(command, arg[1].u, ((GLsizei) arg[0].i) > 0 ? (size_t) ((GLsizei) arg[0].i) * sizeof(GLuint) : 0);
+        case 24: /* glDeleteProgram */
+            return command->argc == 1;
+        case 25: /* glDeleteShader */
+            return command->argc == 1;
+        case 26: /* glDeleteTextures */
+            return command->argc == 2
+                   && cgl_cmd_check_payload(command, arg[1].u, ((GLsizei) arg[0].i) > 0 ? (size_t) ((GLsizei) arg[0].i) * sizeof(GLuint) : 0);
+        case 27: /* glDepthFunc */
+            return command->argc == 1;
+        case 28: /* glDepthMask */
+            return command->argc == 1;
+        case 29: /* glDepthRange */
+            return command->argc == 2;
+        case 30: /* glDetachShader */
+            return command->argc == 2;
+        case 31: /* glEnable */
+            return command->argc == 1;
+        case 32: /* glDisable */
+            return command->argc == 1;
+        case 33: /* glEnableVertexAttribArray */
+            return command->argc == 1;
+        case 34: /* glDisableVertexAttribArray */
+            return command->argc == 1;
+        case 35: /* glDrawArrays */
+            return command->argc == 3;
+        case 36: /* glDrawElements */
+            return command->argc == 4;
+        case 37: /* glFinish */
+            return command->argc == 0;
+        case 38: /* glFlush */
+            return command->argc == 0;
+        case 39: /* glFrontFace */
+            return command->argc == 1;
+        case 40: /* glGenBuffers */
+            return command->argc == 2;
+        case 41: /* glGenTextures */
+            return command->argc == 2;
+        case 42: /* glGetBooleanv */
+            return command->argc == 2;
+        case 43: /* glGetFloatv */
+            return command->argc == 2;
+        case 44: /* glGetIntegerv */
+            return command->argc == 2;
+        case 45: /* glGetActiveAttrib */
+            return command->argc == 7;
+        case 46: /* glGetActiveUniform */
+            return command->argc == 7;
+        case 47: /* glGetError */
+            return command->argc == 1;
+        case 48: /* glGetProgramiv */
+            return command->argc == 3;
+        case 49: /* glGetUniformLocation */
+            return command->argc == 3
+                   && cgl_cmd_check_string(command, arg[1].u);
+        case 50: /* glLinkProgram */
+            return command->argc == 1;
+        case 51: /* glPixelStorei */
+            if (command->argc == 2 && arg[0].u == GL_UNPACK_ALIGNMENT
+                    && (arg[1].i == 1 || arg[1].i == 2 || arg[1].i == 4 || arg[1].i == 8))
+                *alignment = (size_t) arg[1].i;
+            return command->argc == 2;
+        case 52: /* glPolygonOffset */
+            return command->argc == 2;
+        case 53: /* glStencilFunc */
+            return command->argc == 3;
+        case 54: /* glStencilFuncSeparate */
+            return command->argc == 4;
+        case 55: /* glStencilMask */
+            return command->argc == 1;
+        case 56: /* glStencilMaskSeparate */
+            return command->argc == 2;
+        case 57: /* glStencilOp */
+            return command->argc == 3;
+        case 58: /* glStencilOpSeparate */
+            return command->argc == 4;
+        case 59: /* glTexImage2D */
+            return command->argc == 9
+                   && cgl_cmd_check_payload(command, arg[8].u, cgl_cmd_image_bytes(*alignment, ((GLsizei) arg[3].i), ((GLsizei) arg[4].i), ((GLenum) arg[6].u), ((GLenum) arg[7].u)));
+        case 60: /* glTexParameteri */
+            return command->argc == 3;
+        case 61: /* glTexSubImage2D */
+            return command->argc == 9
+                   && cgl_cmd_check_payload(command, arg[8].u, cgl_cmd_image_bytes(*alignment, ((GLsizei) arg[4].i), ((GLsizei) arg[5].i), ((GLenum) arg[6].u), ((GLenum) arg[7].u)));
+        case 62: /* glUniform1f */
+            return command->argc == 2;
+        case 63: /* glUniform2f */
+            return command->argc == 3;
+        case 64: /* glUniform3f */
+            return command->argc == 4;
+        case 65: /* glUniform4f */
+            return command->argc == 5;
+        case 66: /* glUniform1i */
+            return command->argc == 2;
+        case 67: /* glUniform2i */
+            return command->argc == 3;
+        case 68: /* glUniform3i */
+            return command->argc == 4;
+        case 69: /* glUniform4i */
+            return command->argc == 5;
+        case 70: /* glUniform1fv */
+            return command->argc == 3
+                   && cgl_cmd_check_payload(command, arg[2].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 1 * sizeof(GLfloat) : 0);
+        case 71: /* glUniform2fv */
+            return command->argc == 3
+                   && cgl_cmd_check_payload(command, arg[2].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 2 * sizeof(GLfloat) : 0);
+        case 72: /* glUniform3fv */
+            return command->argc == 3
+                   && cgl_cmd_check_payload(command, arg[2].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 3 * sizeof(GLfloat) : 0);
+        case 73: /* glUniform4fv */
+            return command->argc == 3
+                   && cgl_cmd_check_payload(command, arg[2].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 4 * sizeof(GLfloat) : 0);
+        case 74: /* glUniform1iv */
+            return command->argc == 3
+                   && cgl_cmd_check_payload(command, arg[2].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 1 * sizeof(GLint) : 0);
+        case 75: /* glUniform2iv */
+            return command->argc == 3
+                   && cgl_cmd_check_payload(command, arg[2].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 2 * sizeof(GLint) : 0);
+        case 76: /* glUniform3iv */
+            return command->argc == 3
+                   && cgl_cmd_check_payload(command, arg[2].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 3 * sizeof(GLint) : 0);
+        case 77: /* glUniform4iv */
+            return command->argc == 3
+                   && cgl_cmd_check_payload(command, arg[2].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 4 * sizeof(GLint) : 0);
+        case 78: /* glUniformMatrix2fv */
+            return command->argc == 4
+                   && cgl_cmd_check_payload(command, arg[3].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 4 * sizeof(GLfloat) : 0);
+        case 79: /* glUniformMatrix3fv */
+            return command->argc == 4
+                   && cgl_cmd_check_payload(command, arg[3].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 9 * sizeof(GLfloat) : 0);
+        case 80: /* glUniformMatrix4fv */
+            return command->argc == 4
+                   && cgl_cmd_check_payload(command, arg[3].u, ((GLsizei) arg[1].i) > 0 ? (size_t) ((GLsizei) arg[1].i) * 16 * sizeof(GLfloat) : 0);
+        case 81: /* glUseProgram */
+            return command->argc == 1;
+        case 82: /* glVertexAttribPointer */
+            return command->argc == 6;
+        default:
+            return 0;
+    }
+}
+/* cglgen:end check */
+
+/* cglgen:begin output_size */
+static size_t cgl_cmd_output_size(unsigned int opcode, const CGLArg *arg) {
+    switch (opcode) {
+        case 40: /* glGenBuffers */
+            return CGL_CMD_ALIGN(((GLsizei) arg[0].i) > 0 ? (size_t) ((GLsizei) arg[0].i) * sizeof(GLuint) : 0);
+        case 41: /* glGenTextures */
+            return CGL_CMD_ALIGN(((GLsizei) arg[0].i) > 0 ? (size_t) ((GLsizei) arg[0].i) * sizeof(GLuint) : 0);
+        case 42: /* glGetBooleanv */
+            return CGL_CMD_ALIGN(16 * sizeof(GLboolean));
+        case 43: /* glGetFloatv */
+            return CGL_CMD_ALIGN(16 * sizeof(GLfloat));
+        case 44: /* glGetIntegerv */
+            return CGL_CMD_ALIGN(16 * sizeof(GLint));
+        case 45: /* glGetActiveAttrib */
+            return CGL_CMD_ALIGN(sizeof(GLsizei)) + CGL_CMD_ALIGN(sizeof(GLint)) + CGL_CMD_ALIGN(sizeof(GLenum)) + CGL_CMD_ALIGN(((GLsizei) arg[2].i) > 0 ? (size_t) ((GLsizei) arg[2].i) : 0);
+        case 46: /* glGetActiveUniform */
+            return CGL_CMD_ALIGN(sizeof(GLsizei)) + CGL_CMD_ALIGN(sizeof(GLint)) + CGL_CMD_ALIGN(sizeof(GLenum)) + CGL_CMD_ALIGN(((GLsizei) arg[2].i) > 0 ? (size_t) ((GLsizei) arg[2].i) : 0);
+        case 48: /* glGetProgramiv */
+            return CGL_CMD_ALIGN(sizeof(GLint));
+        default:
+            return 0;
+    }
+}
+/* cglgen:end output_size */
+
+
+/* capture: the stubs record each call into buffer, which is written out whenever it holds at least
+ * CGL_CAPTURE_FLUSH bytes, and then call the function they replaced
+ */
+#define CGL_CAPTURE_FLUSH ((size_t) 1 << 20)
+
+typedef struct CGLCapture {
+    CGLCommandBuffer *buffer;
+    FILE *file;
+    int failed;
+    CGLDispatch *table;         /* the table holding the stubs */
+    CGLDispatch next;           /* the functions the stubs replaced */
+} CGLCapture;
+
+static CGLCapture cgl_capture;
+
+static void cgl_capture_write(void) {
+    CGLCommandBuffer *buffer = cgl_capture.buffer;
+
+    if (buffer->failed || fwrite(buffer->data, 1, buffer->used, cgl_capture.file) != buffer->used)
+        cgl_capture.failed = 1;
+    cglResetCommandBuffer(buffer);
+}
+
+static void cgl_capture_check(void) {
+    if (cgl_capture.buffer->used >= CGL_CAPTURE_FLUSH)
+        cgl_capture_write();
+}
+
+/* cglgen:begin capture */
+static void APIENTRY cgl_capture_glActiveTexture(GLenum texture) {
+    cglCmdActiveTexture(cgl_capture.buffer, texture);
+    cgl_capture_check();
+    cgl_capture.next.fn.ActiveTexture(texture);
+}
+static void APIENTRY cgl_capture_glAttachShader(GLuint program, GLuint shader) {
+    cglCmdAttachShader(cgl_capture.buffer, program, shader);
+    cgl_capture_check();
+    cgl_capture.next.fn.AttachShader(program, shader);
+}
+static void APIENTRY cgl_capture_glBindAttribLocation(GLuint program, GLuint index, const GLchar *name) {
+    cglCmdBindAttribLocation(cgl_capture.buffer, program, index, name);
+    cgl_capture_check();
+    cgl_capture.next.fn.BindAttribLocation(program, index, name);
+}
+static void APIENTRY cgl_capture_glBindBuffer(GLenum target, GLuint buffer) {
+    cglCmdBindBuffer(cgl_capture.buffer, target, buffer);
+    cgl_capture_check();
+    cgl_capture.next.fn.BindBuffer(target, buffer);
+}
+static void APIENTRY cgl_capture_glBindTexture(GLenum target, GLuint texture) {
+    cglCmdBindTexture(cgl_capture.buffer, target, texture);
+    cgl_capture_check();
+    cgl_capture.next.fn.BindTexture(target, texture);
+}
+static void APIENTRY cgl_capture_glBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    cglCmdBlendColor(cgl_capture.buffer, red, green, blue, alpha);
+    cgl_capture_check();
+    cgl_capture.next.fn.BlendColor(red, green, blue, alpha);
+}
+static void APIENTRY cgl_capture_glBlendEquation(GLenum mode) {
+    cglCmdBlendEquation(cgl_capture.buffer, mode);
+    cgl_capture_check();
+    cgl_capture.next.fn.BlendEquation(mode);
+}
+static void APIENTRY cgl_capture_glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+    cglCmdBlendEquationSeparate(cgl_capture.buffer, modeRGB, modeAlpha);
+    cgl_capture_check();
+    cgl_capture.next.fn.BlendEquationSeparate(modeRGB, modeAlpha);
+}
+static void APIENTRY cgl_capture_glBlendFunc(GLenum sfactor, GLenum dfactor) {
+    cglCmdBlendFunc(cgl_capture.buffer, sfactor, dfactor);
+    cgl_capture_check();
+    cgl_capture.next.fn.BlendFunc(sfactor, dfactor);
+}
+static void APIENTRY cgl_capture_glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) {
+    cglCmdBlendFuncSeparate(cgl_capture.buffer, sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+    cgl_capture_check();
+    cgl_capture.next.fn.BlendFuncSeparate(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
+}
+static void APIENTRY cgl_capture_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    cglCmdBufferData(cgl_capture.buffer, target, size, data, usage);
+    cgl_capture_check();
+    cgl_capture.next.fn.BufferData(target, size, data, usage);
+}
+static void APIENTRY cgl_capture_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    cglCmdBufferSubData(cgl_capture.buffer, target, offset, size, data);
+    cgl_capture_check();
+    cgl_capture.next.fn.BufferSubData(target, offset, size, data);
+}
+static void APIENTRY cgl_capture_glClear(GLbitfield mask) {
+    cglCmdClear(cgl_capture.buffer, mask);
+    cgl_capture_check();
+    cgl_capture.next.fn.Clear(mask);
+}
+static void APIENTRY cgl_capture_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    cglCmdClearColor(cgl_capture.buffer, red, green, blue, alpha);
+    cgl_capture_check();
+    cgl_capture.next.fn.ClearColor(red, green, blue, alpha);
+}
+static void APIENTRY cgl_capture_glClearDepth(GLdouble depth) {
+    cglCmdClearDepth(cgl_capture.buffer, depth);
+    cgl_capture_check();
+    cgl_capture.next.fn.ClearDepth(depth);
+}
+static void APIENTRY cgl_capture_glClearStencil(GLint s) {
+    cglCmdClearStencil(cgl_capture.buffer, s);
+    cgl_capture_check();
+    cgl_capture.next.fn.ClearStencil(s);
+}
+static void APIENTRY cgl_capture_glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    cglCmdColorMask(cgl_capture.buffer, red, green, blue, alpha);
+    cgl_capture_check();
+    cgl_capture.next.fn.ColorMask(red, green, blue, alpha);
+}
+static void APIENTRY cgl_capture_glCompileShader(GLuint shader) {
+    cglCmdCompileShader(cgl_capture.buffer, shader);
+    cgl_capture_check();
+    cgl_capture.next.fn.CompileShader(shader);
+}
+static void APIENTRY cgl_capture_glCopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border) {
+    cglCmdCopyTexImage2D(cgl_capture.buffer, target, level, internalformat, x, y, width, height, border);
+    cgl_capture_check();
+    cgl_capture.next.fn.CopyTexImage2D(target, level, internalformat, x, y, width, height, border);
+}
+static void APIENTRY cgl_capture_glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height) {
+    cglCmdCopyTexSubImage2D(cgl_capture.buffer, target, level, xoffset, yoffset, x, y, width, height);
+    cgl_capture_check();
+    cgl_capture.next.fn.CopyTexSubImage2D(target, level, xoffset, yoffset, x, y, width, height);
+}
+static GLuint APIENTRY cgl_capture_glCreateProgram(void) {
+    cglCmdCreateProgram(cgl_capture.buffer, nullptr);
+    cgl_capture_check();
+    return cgl_capture.next.fn.CreateProgram();
+}
+static GLuint APIENTRY cgl_capture_glCreateShader(GLenum type) {
+    cglCmdCreateShader(cgl_capture.buffer, type, nullptr);
+    cgl_capture_check();
+    return cgl_capture.next.fn.CreateShader(type);
+}
+static void APIENTRY cgl_capture_glCullFace(GLenum mode) {
+    cglCmdCullFace(cgl_capture.buffer, mode);
+    cgl_capture_check();
+    cgl_capture.next.fn.CullFace(mode);
+}
+static void APIENTRY cgl_capture_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
+    cglCmdDeleteBuffers(cgl_capture.buffer, n, buffers);
+    cgl_capture_check();
+    cgl_capture.next.fn.DeleteBuffers(n, buffers);
+}
+static void APIENTRY cgl_capture_glDeleteProgram(GLuint program) {
+    cglCmdDeleteProgram(cgl_capture.buffer, program);
+    cgl_capture_check();
+    cgl_capture.next.fn.DeleteProgram(program);
+}
+static void APIENTRY cgl_capture_glDeleteShader(GLuint shader) {
+    cglCmdDeleteShader(cgl_capture.buffer, shader);
+    cgl_capture_check();
+    cgl_capture.next.fn.DeleteShader(shader);
+}
+static void APIENTRY cgl_capture_glDeleteTextures(GLsizei n, const GLuint *textures) {
+    cglCmdDeleteTextures(cgl_capture.buffer, n, textures);
+    cgl_capture_check();
+    cgl_capture.next.fn.DeleteTextures(n, textures);
+}
+static void APIENTRY cgl_capture_glDepthFunc(GLenum func) {
+    cglCmdDepthFunc(cgl_capture.buffer, func);
+    cgl_capture_check();
+    cgl_capture.next.fn.DepthFunc(func);
+}
+static void APIENTRY cgl_capture_glDepthMask(GLboolean flag) {
+    cglCmdDepthMask(cgl_capture.buffer, flag);
+    cgl_capture_check();
+    cgl_capture.next.fn.DepthMask(flag);
+}
+static void APIENTRY cgl_capture_glDepthRange(GLdouble n, GLdouble f) {
+    cglCmdDepthRange(cgl_capture.buffer, n, f);
+    cgl_capture_check();
+    cgl_capture.next.fn.DepthRange(n, f);
+}
+static void APIENTRY cgl_capture_glDetachShader(GLuint program, GLuint shader) {
+    cglCmdDetachShader(cgl_capture.buffer, program, shader);
+    cgl_capture_check();
+    cgl_capture.next.fn.DetachShader(program, shader);
+}
+static void APIENTRY cgl_capture_glEnable(GLenum cap) {
+    cglCmdEnable(cgl_capture.buffer, cap);
+    cgl_capture_check();
+    cgl_capture.next.fn.Enable(cap);
+}
+static void APIENTRY cgl_capture_glDisable(GLenum cap) {
+    cglCmdDisable(cgl_capture.buffer, cap);
+    cgl_capture_check();
+    cgl_capture.next.fn.Disable(cap);
+}
+static void APIENTRY cgl_capture_glEnableVertexAttribArray(GLuint index) {
+    cglCmdEnableVertexAttribArray(cgl_capture.buffer, index);
+    cgl_capture_check();
+    cgl_capture.next.fn.EnableVertexAttribArray(index);
+}
+static void APIENTRY cgl_capture_glDisableVertexAttribArray(GLuint index) {
+    cglCmdDisableVertexAttribArray(cgl_capture.buffer, index);
+    cgl_capture_check();
+    cgl_capture.next.fn.DisableVertexAttribArray(index);
+}
+static void APIENTRY cgl_capture_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    cglCmdDrawArrays(cgl_capture.buffer, mode, first, count);
+    cgl_capture_check();
+    cgl_capture.next.fn.DrawArrays(mode, first, count);
+}
+static void APIENTRY cgl_capture_glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) {
+    cglCmdDrawElements(cgl_capture.buffer, mode, count, type, indices);
+    cgl_capture_check();
+    cgl_capture.next.fn.DrawElements(mode, count, type, indices);
+}
+static void APIENTRY cgl_capture_glFinish(void) {
+    cglCmdFinish(cgl_capture.buffer);
+    cgl_capture_check();
+    cgl_capture.next.fn.Finish();
+}
+static void APIENTRY cgl_capture_glFlush(void) {
+    cglCmdFlush(cgl_capture.buffer);
+    cgl_capture_check();
+    cgl_capture.next.fn.Flush();
+}
+static void APIENTRY cgl_capture_glFrontFace(GLenum mode) {
+    cglCmdFrontFace(cgl_capture.buffer, mode);
+    cgl_capture_check();
+    cgl_capture.next.fn.FrontFace(mode);
+}
+static void APIENTRY cgl_capture_glGenBuffers(GLsizei n, GLuint *buffers) {
+    cglCmdGenBuffers(cgl_capture.buffer, n, buffers);
+    cgl_capture_check();
+    cgl_capture.next.fn.GenBuffers(n, buffers);
+}
+static void APIENTRY cgl_capture_glGenTextures(GLsizei n, GLuint *textures) {
+    cglCmdGenTextures(cgl_capture.buffer, n, textures);
+    cgl_capture_check();
+    cgl_capture.next.fn.GenTextures(n, textures);
+}
+static void APIENTRY cgl_capture_glGetBooleanv(GLenum pname, GLboolean *data) {
+    cglCmdGetBooleanv(cgl_capture.buffer, pname, data);
+    cgl_capture_check();
+    cgl_capture.next.fn.GetBooleanv(pname, data);
+}
+static void APIENTRY cgl_capture_glGetFloatv(GLenum pname, GLfloat *data) {
+    cglCmdGetFloatv(cgl_capture.buffer, pname, data);
+    cgl_capture_check();
+    cgl_capture.next.fn.GetFloatv(pname, data);
+}
+static void APIENTRY cgl_capture_glGetIntegerv(GLenum pname, GLint *data) {
+    cglCmdGetIntegerv(cgl_capture.buffer, pname, data);
+    cgl_capture_check();
+    cgl_capture.next.fn.GetIntegerv(pname, data);
+}
+static void APIENTRY cgl_capture_glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    cglCmdGetActiveAttrib(cgl_capture.buffer, program, index, bufSize, length, size, type, name);
+    cgl_capture_check();
+    cgl_capture.next.fn.GetActiveAttrib(program, index, bufSize, length, size, type, name);
+}
+static void APIENTRY cgl_capture_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    cglCmdGetActiveUniform(cgl_capture.buffer, program, index, bufSize, length, size, type, name);
+    cgl_capture_check();
+    cgl_capture.next.fn.GetActiveUniform(program, index, bufSize, length, size, type, name);
+}
+static GLenum APIENTRY cgl_capture_glGetError(void) {
+    cglCmdGetError(cgl_capture.buffer, nullptr);
+    cgl_capture_check();
+    return cgl_capture.next.fn.GetError();
+}
+static void APIENTRY cgl_capture_glGetProgramiv(GLuint program, GLenum pname, GLint *params) {
+    cglCmdGetProgramiv(cgl_capture.buffer, program, pname, params);
+    cgl_capture_check();
+    cgl_capture.next.fn.GetProgramiv(program, pname, params);
+}
+static GLint APIENTRY cgl_capture_glGetUniformLocation(GLuint program, const GLchar *name) {
+    cglCmdGetUniformLocation(cgl_capture.buffer, program, name, nullptr);
+    cgl_capture_check();
+    return cgl_capture.next.fn.GetUniformLocation(program, name);
+}
+static void APIENTRY cgl_capture_glLinkProgram(GLuint program) {
+    cglCmdLinkProgram(cgl_capture.buffer, program);
+    cgl_capture_check();
+    cgl_capture.next.fn.LinkProgram(program);
+}
+static void APIENTRY cgl_capture_glPixelStorei(GLenum pname, GLint param) {
+    cglCmdPixelStorei(cgl_capture.buffer, pname, param);
+    cgl_capture_check();
+    cgl_capture.next.fn.PixelStorei(pname, param);
+}
+static void APIENTRY cgl_capture_glPolygonOffset(GLfloat factor, GLfloat units) {
+    cglCmdPolygonOffset(cgl_capture.buffer, factor, units);
+    cgl_capture_check();
+    cgl_capture.next.fn.PolygonOffset(factor, units);
+}
+static void APIENTRY cgl_capture_glStencilFunc(GLenum func, GLint ref, GLuint mask) {
+    cglCmdStencilFunc(cgl_capture.buffer, func, ref, mask);
+    cgl_capture_check();
+    cgl_capture.next.fn.StencilFunc(func, ref, mask);
+}
+static void APIENTRY cgl_capture_glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+    cglCmdStencilFuncSeparate(cgl_capture.buffer, face, func, ref, mask);
+    cgl_capture_check();
+    cgl_capture.next.fn.StencilFuncSeparate(face, func, ref, mask);
+}
+static void APIENTRY cgl_capture_glStencilMask(GLuint mask) {
+    cglCmdStencilMask(cgl_capture.buffer, mask);
+    cgl_capture_check();
+    cgl_capture.next.fn.StencilMask(mask);
+}
+static void APIENTRY cgl_capture_glStencilMaskSeparate(GLenum face, GLuint mask) {
+    cglCmdStencilMaskSeparate(cgl_capture.buffer, face, mask);
+    cgl_capture_check();
+    cgl_capture.next.fn.StencilMaskSeparate(face, mask);
+}
+static void APIENTRY cgl_capture_glStencilOp(GLenum sfail, GLenum dpfail, GLenum dppass) {
+    cglCmdStencilOp(cgl_capture.buffer, sfail, dpfail, dppass);
+    cgl_capture_check();
+    cgl_capture.next.fn.StencilOp(sfail, dpfail, dppass);
+}
+static void APIENTRY cgl_capture_glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    cglCmdStencilOpSeparate(cgl_capture.buffer, face, sfail, dpfail, dppass);
+    cgl_capture_check();
+    cgl_capture.next.fn.StencilOpSeparate(face, sfail, dpfail, dppass);
+}
+static void APIENTRY cgl_capture_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *data) {
+    cglCmdTexImage2D(cgl_capture.buffer, target, level, internalformat, width, height, border, format, type, data);
+    cgl_capture_check();
+    cgl_capture.next.fn.TexImage2D(target, level, internalformat, width, height, border, format, type, data);
+}
+static void APIENTRY cgl_capture_glTexParameteri(GLenum target, GLenum pname, GLint param) {
+    cglCmdTexParameteri(cgl_capture.buffer, target, pname, param);
+    cgl_capture_check();
+    cgl_capture.next.fn.TexParameteri(target, pname, param);
+}
+static void APIENTRY cgl_capture_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *data) {
+    cglCmdTexSubImage2D(cgl_capture.buffer, target, level, xoffset, yoffset, width, height, format, type, data);
+    cgl_capture_check();
+    cgl_capture.next.fn.TexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, data);
+}
+static void APIENTRY cgl_capture_glUniform1f(GLint location, GLfloat v0) {
+    cglCmdUniform1f(cgl_capture.buffer, location, v0);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform1f(location, v0);
+}
+static void APIENTRY cgl_capture_glUniform2f(GLint location, GLfloat v0, GLfloat v1) {
+    cglCmdUniform2f(cgl_capture.buffer, location, v0, v1);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform2f(location, v0, v1);
+}
+static void APIENTRY cgl_capture_glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    cglCmdUniform3f(cgl_capture.buffer, location, v0, v1, v2);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform3f(location, v0, v1, v2);
+}
+static void APIENTRY cgl_capture_glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    cglCmdUniform4f(cgl_capture.buffer, location, v0, v1, v2, v3);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform4f(location, v0, v1, v2, v3);
+}
+static void APIENTRY cgl_capture_glUniform1i(GLint location, GLint v0) {
+    cglCmdUniform1i(cgl_capture.buffer, location, v0);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform1i(location, v0);
+}
+static void APIENTRY cgl_capture_glUniform2i(GLint location, GLint v0, GLint v1) {
+    cglCmdUniform2i(cgl_capture.buffer, location, v0, v1);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform2i(location, v0, v1);
+}
+static void APIENTRY cgl_capture_glUniform3i(GLint location, GLint v0, GLint v1, GLint v2) {
+    cglCmdUniform3i(cgl_capture.buffer, location, v0, v1, v2);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform3i(location, v0, v1, v2);
+}
+static void APIENTRY cgl_capture_glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+    cglCmdUniform4i(cgl_capture.buffer, location, v0, v1, v2, v3);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform4i(location, v0, v1, v2, v3);
+}
+static void APIENTRY cgl_capture_glUniform1fv(GLint location, GLsizei count, const GLfloat *value) {
+    cglCmdUniform1fv(cgl_capture.buffer, location, count, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform1fv(location, count, value);
+}
+static void APIENTRY cgl_capture_glUniform2fv(GLint location, GLsizei count, const GLfloat *value) {
+    cglCmdUniform2fv(cgl_capture.buffer, location, count, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform2fv(location, count, value);
+}
+static void APIENTRY cgl_capture_glUniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+    cglCmdUniform3fv(cgl_capture.buffer, location, count, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform3fv(location, count, value);
+}
+static void APIENTRY cgl_capture_glUniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+    cglCmdUniform4fv(cgl_capture.buffer, location, count, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform4fv(location, count, value);
+}
+static void APIENTRY cgl_capture_glUniform1iv(GLint location, GLsizei count, const GLint *value) {
+    cglCmdUniform1iv(cgl_capture.buffer, location, count, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform1iv(location, count, value);
+}
+static void APIENTRY cgl_capture_glUniform2iv(GLint location, GLsizei count, const GLint *value) {
+    cglCmdUniform2iv(cgl_capture.buffer, location, count, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform2iv(location, count, value);
+}
+static void APIENTRY cgl_capture_glUniform3iv(GLint location, GLsizei count, const GLint *value) {
+    cglCmdUniform3iv(cgl_capture.buffer, location, count, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform3iv(location, count, value);
+}
+static void APIENTRY cgl_capture_glUniform4iv(GLint location, GLsizei count, const GLint *value) {
+    cglCmdUniform4iv(cgl_capture.buffer, location, count, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.Uniform4iv(location, count, value);
+}
+static void APIENTRY cgl_capture_glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    cglCmdUniformMatrix2fv(cgl_capture.buffer, location, count, transpose, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.UniformMatrix2fv(location, count, transpose, value);
+}
+static void APIENTRY cgl_capture_glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    cglCmdUniformMatrix3fv(cgl_capture.buffer, location, count, transpose, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.UniformMatrix3fv(location, count, transpose, value);
+}
+static void APIENTRY cgl_capture_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    cglCmdUniformMatrix4fv(cgl_capture.buffer, location, count, transpose, value);
+    cgl_capture_check();
+    cgl_capture.next.fn.UniformMatrix4fv(location, count, transpose, value);
+}
+static void APIENTRY cgl_capture_glUseProgram(GLuint program) {
+    cglCmdUseProgram(cgl_capture.buffer, program);
+    cgl_capture_check();
+    cgl_capture.next.fn.UseProgram(program);
+}
+static void APIENTRY cgl_capture_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+    cglCmdVertexAttribPointer(cgl_capture.buffer, index, size, type, normalized, stride, pointer);
+    cgl_capture_check();
+    cgl_capture.next.fn.VertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+
+static const CGLDispatch cgl_capture_stubs = {{
+    cgl_capture_glActiveTexture,
+    cgl_capture_glAttachShader,
+    cgl_capture_glBindAttribLocation,
+    cgl_capture_glBindBuffer,
+    cgl_capture_glBindTexture,
+    cgl_capture_glBlendColor,
+    cgl_capture_glBlendEquation,
+    cgl_capture_glBlendEquationSeparate,
+    cgl_capture_glBlendFunc,
+    cgl_capture_glBlendFuncSeparate,
+    cgl_capture_glBufferData,
+    cgl_capture_glBufferSubData,
+    cgl_capture_glClear,
+    cgl_capture_glClearColor,
+    cgl_capture_glClearDepth,
+    cgl_capture_glClearStencil,
+    cgl_capture_glColorMask,
+    cgl_capture_glCompileShader,
+    cgl_capture_glCopyTexImage2D,
+    cgl_capture_glCopyTexSubImage2D,
+    cgl_capture_glCreateProgram,
+    cgl_capture_glCreateShader,
+    cgl_capture_glCullFace,
+    cgl_capture_glDeleteBuffers,
+    cgl_capture_glDeleteProgram,
+    cgl_capture_glDeleteShader,
+    cgl_capture_glDeleteTextures,
+    cgl_capture_glDepthFunc,
+    cgl_capture_glDepthMask,
+    cgl_capture_glDepthRange,
+    cgl_capture_glDetachShader,
+    cgl_capture_glEnable,
+    cgl_capture_glDisable,
+    cgl_capture_glEnableVertexAttribArray,
+    cgl_capture_glDisableVertexAttribArray,
+    cgl_capture_glDrawArrays,
+    cgl_capture_glDrawElements,
+    cgl_capture_glFinish,
+    cgl_capture_glFlush,
+    cgl_capture_glFrontFace,
+    cgl_capture_glGenBuffers,
+    cgl_capture_glGenTextures,
+    cgl_capture_glGetBooleanv,
+    cgl_capture_glGetFloatv,
+    cgl_capture_glGetIntegerv,
+    cgl_capture_glGetActiveAttrib,
+    cgl_capture_glGetActiveUniform,
+    cgl_capture_glGetError,
+    cgl_capture_glGetProgramiv,
+    cgl_capture_glGetUniformLocation,
+    cgl_capture_glLinkProgram,
+    cgl_capture_glPixelStorei,
+    cgl_capture_glPolygonOffset,
+    cgl_capture_glStencilFunc,
+    cgl_capture_glStencilFuncSeparate,
+    cgl_capture_glStencilMask,
+    cgl_capture_glStencilMaskSeparate,
+    cgl_capture_glStencilOp,
+    cgl_capture_glStencilOpSeparate,
+    cgl_capture_glTexImage2D,
+    cgl_capture_glTexParameteri,
+    cgl_capture_glTexSubImage2D,
+    cgl_capture_glUniform1f,
+    cgl_capture_glUniform2f,
+    cgl_capture_glUniform3f,
+    cgl_capture_glUniform4f,
+    cgl_capture_glUniform1i,
+    cgl_capture_glUniform2i,
+    cgl_capture_glUniform3i,
+    cgl_capture_glUniform4i,
+    cgl_capture_glUniform1fv,
+    cgl_capture_glUniform2fv,
+    cgl_capture_glUniform3fv,
+    cgl_capture_glUniform4fv,
+    cgl_capture_glUniform1iv,
+    cgl_capture_glUniform2iv,
+    cgl_capture_glUniform3iv,
+    cgl_capture_glUniform4iv,
+    cgl_capture_glUniformMatrix2fv,
+    cgl_capture_glUniformMatrix3fv,
+    cgl_capture_glUniformMatrix4fv,
+    cgl_capture_glUseProgram,
+    cgl_capture_glVertexAttribPointer
+}};
+/* cglgen:end capture */
+
+int cglStartCapture(const char *path) {
+    static const char zeros[8] = {0};
+    CGLTraceHeader header;
+    size_t names = 0;
+    GLint alignment = 4;
+    unsigned int i;
+
+    if (cgl_capture.file != nullptr)
+        return 0;
+    cgl_capture.buffer = cglCreateCommandBuffer(CGL_CAPTURE_FLUSH + 4096);
+    if (cgl_capture.buffer == nullptr)
+        return 0;
+    cgl_capture.file = fopen(path, "wb");
+    if (cgl_capture.file == nullptr) {
+        cglDestroyCommandBuffer(cgl_capture.buffer);
+        return 0;
+    }
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i)
+        names += strlen(cglSymbolName(i)) + 1;
+    memcpy(header.magic, "CGLTRACE", 8);
+    header.version = CGL_TRACE_VERSION;
+    header.byte_order = CGL_TRACE_BYTE_ORDER;
+    header.functions = CGL_DISPATCH_COUNT;
+    header.names_size = (uint32_t) CGL_CMD_ALIGN(names);
+    cgl_capture.failed = fwrite(&header, sizeof(header), 1, cgl_capture.file) != 1;
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i)
+        if (fputs(cglSymbolName(i), cgl_capture.file) == EOF || fputc(0, cgl_capture.file) == EOF)
+            cgl_capture.failed = 1;
+    if (fwrite(zeros, 1, header.names_size - names, cgl_capture.file) != header.names_size - names)
+        cgl_capture.failed = 1;
+
+    cgl_capture.table = CGL_CURRENT_DISPATCH;
+    cgl_capture.next = *cgl_capture.table;
+    cglResolveLazy(&cgl_capture.next);
+    /* the trace starts with the alignment the program set before, for the images in it and for the replay */
+    cgl_capture.next.fn.GetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    if (alignment != 1 && alignment != 2 && alignment != 8)
+        alignment = 4;
+    cglCmdPixelStorei(cgl_capture.buffer, GL_UNPACK_ALIGNMENT, alignment);
+    *cgl_capture.table = cgl_capture_stubs;
+    return 1;
+}
+
+void cglCaptureFrame(void) {
+    if (cgl_capture.file != nullptr)
+        cgl_cmd_begin(cgl_capture.buffer, CGL_CMD_FRAME, 0, 0);
+}
+
+int cglStopCapture(void) {
+    unsigned int i;
+    int failed;
+
+    if (cgl_capture.file == nullptr)
+        return 0;
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i)
+        if (cgl_capture.table->slot[i] == cgl_capture_stubs.slot[i])
+            cgl_capture.table->slot[i] = cgl_capture.next.slot[i];
+    cgl_capture_write();
+    failed = cgl_capture.failed;
+    if (fclose(cgl_capture.file) != 0)
+        failed = 1;
+    cglDestroyCommandBuffer(cgl_capture.buffer);
+    cgl_capture.file = nullptr;
+    cgl_capture.buffer = nullptr;
+    return !failed;
+}
+
+
+/* replay: the trace is mapped into memory and the commands are executed right where they are,
+ * with the opcodes translated through slots, CGL_TRACE_UNKNOWN for functions this build doesn't have
+ */
+#define CGL_TRACE_UNKNOWN 0xffffu
+
+struct CGLTrace {
+    const unsigned char *data;
+    size_t size;
+    const unsigned char *commands;
+    unsigned long frames;
+    uint32_t functions;
+    unsigned short *slots;
+};
+
+static const unsigned char *cgl_map_file(const char *path, size_t *size) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    HANDLE mapping;
+    LARGE_INTEGER length;
+    const unsigned char *data = nullptr;
+
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+    if (GetFileSizeEx(file, &length) && length.QuadPart > 0 && (ULONGLONG) length.QuadPart <= (SIZE_T) -1) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            data = (const unsigned char *) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        *size = (size_t) length.QuadPart;
+    }
+    CloseHandle(file);
+    return data;
+#else
+    int file = open(path, O_RDONLY);
+    struct stat status;
+    void *data = MAP_FAILED;
+
+    if (file < 0)
+        return nullptr;
+    if (fstat(file, &status) == 0 && status.st_size > 0 && (unsigned long) status.st_size <= (size_t) -1) {
+        *size = (size_t) status.st_size;
+        data = mmap(nullptr, *size, PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    close(file);
+    return data != MAP_FAILED ? (const unsigned char *) data : nullptr;
+#endif
+}
+
+static void cgl_unmap_file(const unsigned char *data, size_t size) {
+#if defined(_WIN32)
+    (void) size;
+    UnmapViewOfFile(data);
+#else
+    munmap((void *) data, size);
+#endif
+}
+
+/* checks the header, the framing and the arguments of all commands, and maps the names to slots */
+static int cgl_trace_check(CGLTrace *trace) {
+    const CGLTraceHeader *header = (const CGLTraceHeader *) trace->data;
+    const char *name;
+    const char *names_end;
+    size_t at, alignment = 4;
+    uint32_t i;
+
+    /* each name takes at least its terminating zero, and opcodes have 16 bits */
+    if (trace->size < sizeof(CGLTraceHeader) || memcmp(header->magic, "CGLTRACE", 8) != 0
+            || header->version != CGL_TRACE_VERSION || header->byte_order != CGL_TRACE_BYTE_ORDER
+            || header->names_size % 8 != 0 || header->names_size > trace->size - sizeof(CGLTraceHeader)
+            || header->functions > header->names_size || header->functions >= CGL_TRACE_UNKNOWN)
+        return 0;
+    trace->functions = header->functions;
+    trace->slots = (unsigned short *) malloc(((size_t) header->functions + 1) * sizeof(unsigned short));
+    if (trace->slots == nullptr)
+        return 0;
+    name = (const char *) trace->data + sizeof(CGLTraceHeader);
+    names_end = name + header->names_size;
+    for (i = 0; i < header->functions; ++i) {
+        const char *end = (const char *) memchr(name, 0, (size_t) (names_end - name));
+        unsigned int slot;
+
+        if (end == nullptr)
+            return 0;
+        trace->slots[i] = CGL_TRACE_UNKNOWN;
+        for (slot = 0; slot < CGL_DISPATCH_COUNT; ++slot)
+            if (strcmp(cglSymbolName(slot), name) == 0)
+                trace->slots[i] = (unsigned short) slot;
+        name = end + 1;
+    }
+
+    at = sizeof(CGLTraceHeader) + header->names_size;
+    trace->commands = trace->data + at;
+    while (at < trace->size) {
+        const CGLCommand *command = (const CGLCommand *) (trace->data + at);
+
+        if (trace->size - at < CGL_CMD_SIZE(0) || command->size % 8 != 0 || command->size > trace->size - at
+                || command->size < CGL_CMD_SIZE(command->argc))
+            return 0;
+        if (command->opcode == CGL_CMD_FRAME && command->argc == 0)
+            ++trace->frames;
+        else if (command->opcode == CGL_CMD_FRAME || command->opcode >= trace->functions || trace->slots[command->opcode] == CGL_TRACE_UNKNOWN
+                 || !cgl_cmd_check(trace->slots[command->opcode], command, &alignment))
+            return 0;
+        at += command->size;
+    }
+    return 1;
+}
+
+CGLTrace *cglOpenTrace(const char *path) {
+    CGLTrace *trace = (CGLTrace *) calloc(1, sizeof(CGLTrace));
+
+    if (trace == nullptr)
+        return nullptr;
+    trace->data = cgl_map_file(path, &trace->size);
+    if (trace->data == nullptr || !cgl_trace_check(trace)) {
+        cglCloseTrace(trace);
+        return nullptr;
+    }
+    return trace;
+}
+
+void cglCloseTrace(CGLTrace *trace) {
+    if (trace == nullptr)
+        return;
+    if (trace->data != nullptr)
+        cgl_unmap_file(trace->data, trace->size);
+    free(trace->slots);
+    free(trace);
+}
+
+unsigned long cglTraceFrames(const CGLTrace *trace) {
+    return trace->frames;
+}
+
+unsigned long cglReplayTrace(const CGLTrace *trace, CGLCommandCallback frame, void *user) {
+    const CGLDispatch *gl = CGL_CURRENT_DISPATCH;
+    const unsigned char *at = trace->commands;
+    const unsigned char *end = trace->data + trace->size;
+    unsigned long count = 0;
+    CGLScratch scratch;
+
+    scratch.capacity = 4096;
+    scratch.data = (unsigned char *) malloc(scratch.capacity);
+    if (scratch.data == nullptr)
+        return 0;
+    while (at < end) {
+        const CGLCommand *command = (const CGLCommand *) at;
+
+        if (command->opcode == CGL_CMD_FRAME) {
+            if (frame != nullptr)
+                frame(user);
+        } else {
+            unsigned int opcode = trace->slots[command->opcode];
+            size_t size = cgl_cmd_output_size(opcode, command->arg);
+
+            if (size > scratch.capacity) {
+                free(scratch.data);
+                scratch.capacity = size;
+                scratch.data = (unsigned char *) malloc(size);
+                if (scratch.data == nullptr)
+                    return count;
+            }
+            scratch.used = 0;
+            cgl_cmd_execute(gl, opcode, command, &scratch);
+            ++count;
+        }
+        at += command->size;
+    }
+    free(scratch.data);
+    return count;
+}
+
+
+/* the null driver */
+
+/* cglgen:begin null */
+static void APIENTRY cgl_null_glActiveTexture(GLenum texture) {
+    (void) texture;
+}
+static void APIENTRY cgl_null_glAttachShader(GLuint program, GLuint shader) {
+    (void) program;
+    (void) shader;
+}
+static void APIENTRY cgl_null_glBindAttribLocation(GLuint program, GLuint index, const GLchar *name) {
+    (void) program;
+    (void) index;
+    (void) name;
+}
+static void APIENTRY cgl_null_glBindBuffer(GLenum target, GLuint buffer) {
+    (void) target;
+    (void) buffer;
+}
+static void APIENTRY cgl_null_glBindTexture(GLenum target, GLuint texture) {
+    (void) target;
+    (void) texture;
+}
+static void APIENTRY cgl_null_glBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    (void) red;
+    (void) green;
+    (void) blue;
+    (void) alpha;
+}
+static void APIENTRY cgl_null_glBlendEquation(GLenum mode) {
+    (void) mode;
+}
+static void APIENTRY cgl_null_glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+    (void) modeRGB;
+    (void) modeAlpha;
+}
+static void APIENTRY cgl_null_glBlendFunc(GLenum sfactor, GLenum dfactor) {
+    (void) sfactor;
+    (void) dfactor;
+}
+static void APIENTRY cgl_null_glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha) {
+    (void) sfactorRGB;
+    (void) dfactorRGB;
+    (void) sfactorAlpha;
+    (void) dfactorAlpha;
+}
+static void APIENTRY cgl_null_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    (void) target;
+    (void) size;
+    (void) data;
+    (void) usage;
+}
+static void APIENTRY cgl_null_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    (void) target;
+    (void) offset;
+    (void) size;
+    (void) data;
+}
+static void APIENTRY cgl_null_glClear(GLbitfield mask) {
+    (void) mask;
+}
+static void APIENTRY cgl_null_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    (void) red;
+    (void) green;
+    (void) blue;
+    (void) alpha;
+}
+static void APIENTRY cgl_null_glClearDepth(GLdouble depth) {
+    (void) depth;
+}
+static void APIENTRY cgl_null_glClearStencil(GLint s) {
+    (void) s;
+}
+static void APIENTRY cgl_null_glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    (void) red;
+    (void) green;
+    (void) blue;
+    (void) alpha;
+}
+static void APIENTRY cgl_null_glCompileShader(GLuint shader) {
+    (void) shader;
+}
+static void APIENTRY cgl_null_glCopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border) {
+    (void) target;
+    (void) level;
+    (void) internalformat;
+    (void) x;
+    (void) y;
+    (void) width;
+    (void) height;
+    (void) border;
+}
+static void APIENTRY cgl_null_glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height) {
+    (void) target;
+    (void) level;
+    (void) xoffset;
+    (void) yoffset;
+    (void) x;
+    (void) y;
+    (void) width;
+    (void) height;
+}
+static GLuint APIENTRY cgl_null_glCreateProgram(void) {
+    return 0;
+}
+static GLuint APIENTRY cgl_null_glCreateShader(GLenum type) {
+    (void) type;
+    return 0;
+}
+static void APIENTRY cgl_null_glCullFace(GLenum mode) {
+    (void) mode;
+}
+static void APIENTRY cgl_null_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
+    (void) n;
+    (void) buffers;
+}
+static void APIENTRY cgl_null_glDeleteProgram(GLuint program) {
+    (void) program;
+}
+static void APIENTRY cgl_null_glDeleteShader(GLuint shader) {
+    (void) shader;
+}
+static void APIENTRY cgl_null_glDeleteTextures(GLsizei n, const GLuint *textures) {
+    (void) n;
+    (void) textures;
+}
+static void APIENTRY cgl_null_glDepthFunc(GLenum func) {
+    (void) func;
+}
+static void APIENTRY cgl_null_glDepthMask(GLboolean flag) {
+    (void) flag;
+}
+static void APIENTRY cgl_null_glDepthRange(GLdouble n, GLdouble f) {
+    (void) n;
+    (void) f;
+}
+static void APIENTRY cgl_null_glDetachShader(GLuint program, GLuint shader) {
+    (void) program;
+    (void) shader;
+}
+static void APIENTRY cgl_null_glEnable(GLenum cap) {
+    (void) cap;
+}
+static void APIENTRY cgl_null_glDisable(GLenum cap) {
+    (void) cap;
+}
+static void APIENTRY cgl_null_glEnableVertexAttribArray(GLuint index) {
+    (void) index;
+}
+static void APIENTRY cgl_null_glDisableVertexAttribArray(GLuint index) {
+    (void) index;
+}
+static void APIENTRY cgl_null_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    (void) mode;
+    (void) first;
+    (void) count;
+}
+static void APIENTRY cgl_null_glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) {
+    (void) mode;
+    (void) count;
+    (void) type;
+    (void) indices;
+}
+static void APIENTRY cgl_null_glFinish(void) {
+}
+static void APIENTRY cgl_null_glFlush(void) {
+}
+static void APIENTRY cgl_null_glFrontFace(GLenum mode) {
+    (void) mode;
+}
+static void APIENTRY cgl_null_glGenBuffers(GLsizei n, GLuint *buffers) {
+    (void) n;
+    (void) buffers;
+}
+static void APIENTRY cgl_null_glGenTextures(GLsizei n, GLuint *textures) {
+    (void) n;
+    (void) textures;
+}
+static void APIENTRY cgl_null_glGetBooleanv(GLenum pname, GLboolean *data) {
+    (void) pname;
+    (void) data;
+}
+static void APIENTRY cgl_null_glGetFloatv(GLenum pname, GLfloat *data) {
+    (void) pname;
+    (void) data;
+}
+static void APIENTRY cgl_null_glGetIntegerv(GLenum pname, GLint *data) {
+    (void) pname;
+    (void) data;
+}
+static void APIENTRY cgl_null_glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    (void) program;
+    (void) index;
+    (void) bufSize;
+    (void) length;
+    (void) size;
+    (void) type;
+    (void) name;
+}
+static void APIENTRY cgl_null_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    (void) program;
+    (void) index;
+    (void) bufSize;
+    (void) length;
+    (void) size;
+    (void) type;
+    (void) name;
+}
+static GLenum APIENTRY cgl_null_glGetError(void) {
+    return 0;
+}
+static void APIENTRY cgl_null_glGetProgramiv(GLuint program, GLenum pname, GLint *params) {
+    (void) program;
+    (void) pname;
+    (void) params;
+}
+static GLint APIENTRY cgl_null_glGetUniformLocation(GLuint program, const GLchar *name) {
+    (void) program;
+    (void) name;
+    return 0;
+}
+static void APIENTRY cgl_null_glLinkProgram(GLuint program) {
+    (void) program;
+}
+static void APIENTRY cgl_null_glPixelStorei(GLenum pname, GLint param) {
+    (void) pname;
+    (void) param;
+}
+static void APIENTRY cgl_null_glPolygonOffset(GLfloat factor, GLfloat units) {
+    (void) factor;
+    (void) units;
+}
+static void APIENTRY cgl_null_glStencilFunc(GLenum func, GLint ref, GLuint mask) {
+    (void) func;
+    (void) ref;
+    (void) mask;
+}
+static void APIENTRY cgl_null_glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+    (void) face;
+    (void) func;
+    (void) ref;
+    (void) mask;
+}
+static void APIENTRY cgl_null_glStencilMask(GLuint mask) {
+    (void) mask;
+}
+static void APIENTRY cgl_null_glStencilMaskSeparate(GLenum face, GLuint mask) {
+    (void) face;
+    (void) mask;
+}
+static void APIENTRY cgl_null_glStencilOp(GLenum sfail, GLenum dpfail, GLenum dppass) {
+    (void) sfail;
+    (void) dpfail;
+    (void) dppass;
+}
+static void APIENTRY cgl_null_glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass) {
+    (void) face;
+    (void) sfail;
+    (void) dpfail;
+    (void) dppass;
+}
+static void APIENTRY cgl_null_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *data) {
+    (void) target;
+    (void) level;
+    (void) internalformat;
+    (void) width;
+    (void) height;
+    (void) border;
+    (void) format;
+    (void) type;
+    (void) data;
+}
+static void APIENTRY cgl_null_glTexParameteri(GLenum target, GLenum pname, GLint param) {
+    (void) target;
+    (void) pname;
+    (void) param;
+}
+static void APIENTRY cgl_null_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *data) {
+    (void) target;
+    (void) level;
+    (void) xoffset;
+    (void) yoffset;
+    (void) width;
+    (void) height;
+    (void) format;
+    (void) type;
+    (void) data;
+}
+static void APIENTRY cgl_null_glUniform1f(GLint location, GLfloat v0) {
+    (void) location;
+    (void) v0;
+}
+static void APIENTRY cgl_null_glUniform2f(GLint location, GLfloat v0, GLfloat v1) {
+    (void) location;
+    (void) v0;
+    (void) v1;
+}
+static void APIENTRY cgl_null_glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    (void) location;
+    (void) v0;
+    (void) v1;
+    (void) v2;
+}
+static void APIENTRY cgl_null_glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    (void) location;
+    (void) v0;
+    (void) v1;
+    (void) v2;
+    (void) v3;
+}
+static void APIENTRY cgl_null_glUniform1i(GLint location, GLint v0) {
+    (void) location;
+    (void) v0;
+}
+static void APIENTRY cgl_null_glUniform2i(GLint location, GLint v0, GLint v1) {
+    (void) location;
+    (void) v0;
+    (void) v1;
+}
+static void APIENTRY cgl_null_glUniform3i(GLint location, GLint v0, GLint v1, GLint v2) {
+    (void) location;
+    (void) v0;
+    (void) v1;
+    (void) v2;
+}
+static void APIENTRY cgl_null_glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+    (void) location;
+    (void) v0;
+    (void) v1;
+    (void) v2;
+    (void) v3;
+}
+static void APIENTRY cgl_null_glUniform1fv(GLint location, GLsizei count, const GLfloat *value) {
+    (void) location;
+    (void) count;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUniform2fv(GLint location, GLsizei count, const GLfloat *value) {
+    (void) location;
+    (void) count;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+    (void) location;
+    (void) count;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+    (void) location;
+    (void) count;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUniform1iv(GLint location, GLsizei count, const GLint *value) {
+    (void) location;
+    (void) count;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUniform2iv(GLint location, GLsizei count, const GLint *value) {
+    (void) location;
+    (void) count;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUniform3iv(GLint location, GLsizei count, const GLint *value) {
+    (void) location;
+    (void) count;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUniform4iv(GLint location, GLsizei count, const GLint *value) {
+    (void) location;
+    (void) count;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    (void) location;
+    (void) count;
+    (void) transpose;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    (void) location;
+    (void) count;
+    (void) transpose;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    (void) location;
+    (void) count;
+    (void) transpose;
+    (void) value;
+}
+static void APIENTRY cgl_null_glUseProgram(GLuint program) {
+    (void) program;
+}
+static void APIENTRY cgl_null_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+    (void) index;
+    (void) size;
+    (void) type;
+    (void) normalized;
+    (void) stride;
+    (void) pointer;
+}
+
+static const CGLDispatch cgl_null_functions = {{
+    cgl_null_glActiveTexture,
+    cgl_null_glAttachShader,
+    cgl_null_glBindAttribLocation,
+    cgl_null_glBindBuffer,
+    cgl_null_glBindTexture,
+    cgl_null_glBlendColor,
+    cgl_null_glBlendEquation,
+    cgl_null_glBlendEquationSeparate,
+    cgl_null_glBlendFunc,
+    cgl_null_glBlendFuncSeparate,
+    cgl_null_glBufferData,
+    cgl_null_glBufferSubData,
+    cgl_null_glClear,
+    cgl_null_glClearColor,
+    cgl_null_glClearDepth,
+    cgl_null_glClearStencil,
+    cgl_null_glColorMask,
+    cgl_null_glCompileShader,
+    cgl_null_glCopyTexImage2D,
+    cgl_null_glCopyTexSubImage2D,
+    cgl_null_glCreateProgram,
+    cgl_null_glCreateShader,
+    cgl_null_glCullFace,
+    cgl_null_glDeleteBuffers,
+    cgl_null_glDeleteProgram,
+    cgl_null_glDeleteShader,
+    cgl_null_glDeleteTextures,
+    cgl_null_glDepthFunc,
+    cgl_null_glDepthMask,
+    cgl_null_glDepthRange,
+    cgl_null_glDetachShader,
+    cgl_null_glEnable,
+    cgl_null_glDisable,
+    cgl_null_glEnableVertexAttribArray,
+    cgl_null_glDisableVertexAttribArray,
+    cgl_null_glDrawArrays,
+    cgl_null_glDrawElements,
+    cgl_null_glFinish,
+    cgl_null_glFlush,
+    cgl_null_glFrontFace,
+    cgl_null_glGenBuffers,
+    cgl_null_glGenTextures,
+    cgl_null_glGetBooleanv,
+    cgl_null_glGetFloatv,
+    cgl_null_glGetIntegerv,
+    cgl_null_glGetActiveAttrib,
+    cgl_null_glGetActiveUniform,
+    cgl_null_glGetError,
+    cgl_null_glGetProgramiv,
+    cgl_null_glGetUniformLocation,
+    cgl_null_glLinkProgram,
+    cgl_null_glPixelStorei,
+    cgl_null_glPolygonOffset,
+    cgl_null_glStencilFunc,
+    cgl_null_glStencilFuncSeparate,
+    cgl_null_glStencilMask,
+    cgl_null_glStencilMaskSeparate,
+    cgl_null_glStencilOp,
+    cgl_null_glStencilOpSeparate,
+    cgl_null_glTexImage2D,
+    cgl_null_glTexParameteri,
+    cgl_null_glTexSubImage2D,
+    cgl_null_glUniform1f,
+    cgl_null_glUniform2f,
+    cgl_null_glUniform3f,
+    cgl_null_glUniform4f,
+    cgl_null_glUniform1i,
+    cgl_null_glUniform2i,
+    cgl_null_glUniform3i,
+    cgl_null_glUniform4i,
+    cgl_null_glUniform1fv,
+    cgl_null_glUniform2fv,
+    cgl_null_glUniform3fv,
+    cgl_null_glUniform4fv,
+    cgl_null_glUniform1iv,
+    cgl_null_glUniform2iv,
+    cgl_null_glUniform3iv,
+    cgl_null_glUniform4iv,
+    cgl_null_glUniformMatrix2fv,
+    cgl_null_glUniformMatrix3fv,
+    cgl_null_glUniformMatrix4fv,
+    cgl_null_glUseProgram,
+    cgl_null_glVertexAttribPointer
+}};
+/* cglgen:end null */
+
+GLADproc cglNullProc(const char *name) {
+    unsigned int i;
+
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i)
+        if (strcmp(cglSymbolName(i), name) == 0)
+            return cgl_null_functions.slot[i];
+    return nullptr;
+}
+
+#endif /* CGL_DIRECT_LINK */
@@ -0,0 +1,311 @@
+/*
+ *  Command buffers for the common OpenGL subset: record GL calls on any thread, replay them on the GL thread
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLCMD_H
+#define CGLCMD_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief a recorded list of GL calls
+ *
+ * GL contexts can only be used by one thread at a time, but building the calls for a frame can be spread
+ * over many: every thread records into its own command buffer with the cglCmd* functions, one for each
+ * GL function of cgl.h, taking the same arguments after the buffer. Then the GL thread replays all of them
+ * in order with cglSubmit. Recording doesn't touch GL or any shared state, so it needs no locking,
+ * as long as each buffer is only used by one thread at a time.
+ *
+ * Each call is encoded in one block of 8 bytes plus 8 per argument. Everything a function reads through
+ * a pointer (the data of glBufferData and glBufferSubData, the names of glDeleteBuffers, ...) is copied
+ * into the buffer as well, so it can be freed or changed right after recording. Only the indices of
+ * glDrawElements and the pointer of glVertexAttribPointer are kept as pointers, since they usually are offsets
+ * into the bound buffers. Client-side vertex arrays (or indices) passed there are not copied: their memory has to
+ * stay valid and unchanged until the buffer is replayed.
+ * The size of the pixels of glTexImage2D and glTexSubImage2D depends on GL_UNPACK_ALIGNMENT, which a buffer
+ * can't query: each buffer assumes the default of 4 until it records a glPixelStorei of its own, so a buffer
+ * uploading images with another alignment has to record the glPixelStorei itself, even if the GL state
+ * or another buffer already sets it.
+ *
+ * Outputs can't be known before replay: pointers to outputs (of glGenBuffers, glGetIntegerv, ...) are kept
+ * and written to during cglSubmit, and functions returning a value take an extra pointer to store it in,
+ * which can be NULL. The memory behind them has to stay valid until then.
+ *
+ * The encoding has no pointers into the buffer itself, so it can be moved or copied freely.
+ */
+typedef struct CGLCommandBuffer CGLCommandBuffer;
+
+/*! \brief create an empty command buffer
+ *
+ * \param capacity bytes to reserve, the buffer grows as needed
+ *
+ * \return the buffer, or NULL if there is not enough memory
+ */
+GLAPI CGLCommandBuffer *cglCreateCommandBuffer(size_t capacity);
+
+/*! \brief free a command buffer, NULL is ignored */
+GLAPI void cglDestroyCommandBuffer(CGLCommandBuffer *buffer);
+
+/*! \brief remove all recorded calls, keeping the memory for the next recording */
+GLAPI void cglResetCommandBuffer(CGLCommandBuffer *buffer);
+
+/*! \brief bytes used by the recorded calls */
+GLAPI size_t cglCommandBufferSize(const CGLCommandBuffer *buffer);
+
+/*! \brief whether a call could not be recorded since the last reset, for lack of memory
+ *
+ * calls that don't fit are dropped, so such a buffer shouldn't be submitted.
+ */
+GLAPI int cglCommandBufferFailed(const CGLCommandBuffer *buffer);
+
+/*! \brief replay command buffers on the current GL context, in order
+ *
+ * must be called on the thread the GL context is current on, while no thread is recording into the buffers.
+ * The buffers are left as they are, so they can be submitted again.
+ *
+ * \param buffers the buffers to replay
+ * \param count   number of buffers
+ */
+GLAPI void cglSubmit(CGLCommandBuffer *const *buffers, size_t count);
+
+/*! \brief function run on the GL thread, see cglCmdCallback */
+typedef void (*CGLCommandCallback)(void *user);
+
+/*! \brief record a call of \ref callback with \ref user
+ *
+ * for everything that has to happen on the GL thread in between the GL calls, but isn't one of them,
+ * like swapping buffers or signalling that a resource has been uploaded.
+ */
+GLAPI void cglCmdCallback(CGLCommandBuffer *buffer, CGLCommandCallback callback, void *user);
+
+
+#ifndef CGL_DIRECT_LINK
+
+/*! \brief render thread proxy
+ *
+ * moves all GL calls of a program to a thread of their own, without changing any of them:
+ * cglStartProxy replaces every function of the current dispatch table by a stub, which records
+ * the call like the cglCmd* functions, but into a ring buffer, which the render thread reads from
+ * and executes in cglRunProxy. The ring has exactly one writer and one reader, so it needs no locks,
+ * only two counters, and the calling thread only waits when the ring is full.
+ *
+ * Functions that give something back (glCreateProgram, glGenBuffers, glGetIntegerv, glGetError, ...) wait
+ * until the render thread has executed them and all calls before, so they cost a round trip between
+ * the threads and are best kept out of the frame loop, as with any GL implementation.
+ * Calls larger than a quarter of the ring, like big glBufferData uploads, are copied into a separate
+ * block instead, so the ring only limits how far the render thread can fall behind.
+ *
+ * typical use, with the functions loaded and the GL context not current on the calling thread:
+ *      CGLProxy *proxy = cglStartProxy(1 << 20);
+ *      (on the render thread: make the GL context current, then cglRunProxy(proxy))
+ *      ... GL calls as usual, and once per frame:
+ *      cglProxyCall(proxy, swap_buffers, window);
+ *      ...
+ *      cglStopProxy(proxy);
+ *
+ * The first glTexImage2D or glTexSubImage2D with pixels, unless a glPixelStorei of GL_UNPACK_ALIGNMENT comes
+ * before it, makes a round trip too, to ask the render thread for the alignment set before the proxy started.
+ *
+ * The proxy works on the table that is current when it starts, and only one proxy can run at a time.
+ * All GL calls have to come from one thread, and the table must not be changed (by cglLoadGL or
+ * the caches of cgl.h) while the proxy runs; caches enabled before run on the render thread.
+ * With CGL_MULTI_CONTEXT, the render thread has to make the same CGLContext current as well.
+ */
+typedef struct CGLProxy CGLProxy;
+
+/*! \brief replace the current dispatch table by the proxy stubs
+ *
+ * \param capacity bytes of the ring, rounded up to a power of two of at least 4096
+ *
+ * \return the proxy, or NULL if there is not enough memory or a proxy is already running
+ */
+GLAPI CGLProxy *cglStartProxy(size_t capacity);
+
+/*! \brief execute the calls of the proxy until it is stopped
+ *
+ * to be called on the render thread, with the GL context current. When the ring is empty, the render thread
+ * spins shortly, then yields, then sleeps for 50 microseconds at a time until there is work again.
+ */
+GLAPI void cglRunProxy(CGLProxy *proxy);
+
+/*! \brief record a call of \ref callback on the render thread, e.g. for swapping buffers */
+GLAPI void cglProxyCall(CGLProxy *proxy, CGLCommandCallback callback, void *user);
+
+/*! \brief wait until the render thread has executed all calls made so far */
+GLAPI void cglProxyFinish(CGLProxy *proxy);
+
+/*! \brief let the render thread finish all calls, return from cglRunProxy, and restore the dispatch table
+ *
+ * \ref proxy is freed afterwards.
+ */
+GLAPI void cglStopProxy(CGLProxy *proxy);
+
+/*! \brief start writing all GL calls into a trace file
+ *
+ * replaces every function of the current dispatch table by a stub, which records the call like the cglCmd* functions,
+ * and then calls the function it replaced, so the program runs on as before. The file starts with a version
+ * and the names of the functions, followed by the recorded calls in the same encoding as command buffers,
+ * including everything read through pointers, like the data of glBufferData. It is written in blocks of 1 MiB.
+ *
+ * Like for command buffers, outputs and return values are not recorded, and the indices of glDrawElements
+ * and the pointer of glVertexAttribPointer are kept as they are, so client-side arrays don't survive in a trace:
+ * indices have to be in an element buffer and vertex attributes in an array buffer. As the names returned by glGenBuffers etc.
+ * are not recorded either, replaying relies on the driver handing out the same names, which is the case
+ * when replaying in a fresh context. GL_UNPACK_ALIGNMENT is queried when the capture starts and recorded as
+ * the first call, so that images are read and replayed with the alignment set before.
+ * The same restrictions on changing the table apply as for the proxy.
+ *
+ * \param path the trace file to write
+ *
+ * \return 1 on success, 0 if the file could not be opened, there is not enough memory or a capture is running
+ */
+GLAPI int cglStartCapture(const char *path);
+
+/*! \brief mark the end of a frame in the trace, to be called before swapping buffers */
+GLAPI void cglCaptureFrame(void);
+
+/*! \brief restore the dispatch table and write the rest of the trace
+ *
+ * \return 1 if the whole trace has been written, 0 otherwise
+ */
+GLAPI int cglStopCapture(void);
+
+/*! \brief a trace written by cglStartCapture, mapped into memory */
+typedef struct CGLTrace CGLTrace;
+
+/*! \brief open a trace for replaying
+ *
+ * the file is mapped into memory, not read, and the calls are replayed right from there, so their data isn't copied.
+ * Only the structure of the file is checked, the calls themselves are trusted.
+ *
+ * \return the trace, or NULL if it can't be opened, is damaged, was written by an incompatible version or on a machine
+ * of a different byte order, or uses functions this version doesn't have
+ */
+GLAPI CGLTrace *cglOpenTrace(const char *path);
+
+/*! \brief unmap a trace, NULL is ignored */
+GLAPI void cglCloseTrace(CGLTrace *trace);
+
+/*! \brief number of frames marked by cglCaptureFrame in the trace */
+GLAPI unsigned long cglTraceFrames(const CGLTrace *trace);
+
+/*! \brief replay a trace through the current dispatch table
+ *
+ * outputs are written to scratch memory, return values are ignored.
+ *
+ * \param trace the trace to replay
+ * \param frame called at the end of every frame, e.g. for swapping buffers or timing, can be NULL
+ * \param user  passed to \ref frame
+ *
+ * \return the number of calls replayed
+ */
+GLAPI unsigned long cglReplayTrace(const CGLTrace *trace, CGLCommandCallback frame, void *user);
+
+/*! \brief loader for a driver that does nothing
+ *
+ * for cglLoadGL, gives functions that do nothing and return 0, e.g. for replaying traces on machines without a GPU
+ * to measure just the cost of the calls, or for testing. Outputs are left unchanged.
+ */
+GLAPI GLADproc cglNullProc(const char *name);
+
+#endif /* CGL_DIRECT_LINK */
+
+/* the recording functions, generated by cglgen.py */
+/* cglgen:begin commands */
+GLAPI void cglCmdActiveTexture(CGLCommandBuffer *cmds, GLenum texture);
+GLAPI void cglCmdAttachShader(CGLCommandBuffer *cmds, GLuint program, GLuint shader);
+GLAPI void cglCmdBindAttribLocation(CGLCommandBuffer *cmds, GLuint program, GLuint index, const GLchar *name);
+GLAPI void cglCmdBindBuffer(CGLCommandBuffer *cmds, GLenum target, GLuint buffer);
+GLAPI void cglCmdBindTexture(CGLCommandBuffer *cmds, GLenum target, GLuint texture);
+GLAPI void cglCmdBlendColor(CGLCommandBuffer *cmds, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+GLAPI void cglCmdBlendEquation(CGLCommandBuffer *cmds, GLenum mode);
+GLAPI void cglCmdBlendEquationSeparate(CGLCommandBuffer *cmds, GLenum modeRGB, GLenum modeAlpha);
+GLAPI void cglCmdBlendFunc(CGLCommandBuffer *cmds, GLenum sfactor, GLenum dfactor);
+GLAPI void cglCmdBlendFuncSeparate(CGLCommandBuffer *cmds, GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
+GLAPI void cglCmdBufferData(CGLCommandBuffer *cmds, GLenum target, GLsizeiptr size, const void *data, GLenum usage);
+GLAPI void cglCmdBufferSubData(CGLCommandBuffer *cmds, GLenum target, GLintptr offset, GLsizeiptr size, const void *data);
+GLAPI void cglCmdClear(CGLCommandBuffer *cmds, GLbitfield mask);
+GLAPI void cglCmdClearColor(CGLCommandBuffer *cmds, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+GLAPI void cglCmdClearDepth(CGLCommandBuffer *cmds, GLdouble depth);
+GLAPI void cglCmdClearStencil(CGLCommandBuffer *cmds, GLint s);
+GLAPI void cglCmdColorMask(CGLCommandBuffer *cmds, GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+GLAPI void cglCmdCompileShader(CGLCommandBuffer *cmds, GLuint shader);
+GLAPI void cglCmdCopyTexImage2D(CGLCommandBuffer *cmds, GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border);
+GLAPI void cglCmdCopyTexSubImage2D(CGLCommandBuffer *cmds, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height);
+GLAPI void cglCmdCreateProgram(CGLCommandBuffer *cmds, GLuint *result);
+GLAPI void cglCmdCreateShader(CGLCommandBuffer *cmds, GLenum type, GLuint *result);
+GLAPI void cglCmdCullFace(CGLCommandBuffer *cmds, GLenum mode);
+GLAPI void cglCmdDeleteBuffers(CGLCommandBuffer *cmds, GLsizei n, const GLuint *buffers);
+GLAPI void cglCmdDeleteProgram(CGLCommandBuffer *cmds, GLuint program);
+GLAPI void cglCmdDeleteShader(CGLCommandBuffer *cmds, GLuint shader);
+GLAPI void cglCmdDeleteTextures(CGLCommandBuffer *cmds, GLsizei n, const GLuint *textures);
+GLAPI void cglCmdDepthFunc(CGLCommandBuffer *cmds, GLenum func);
+GLAPI void cglCmdDepthMask(CGLCommandBuffer *cmds, GLboolean flag);
+GLAPI void cglCmdDepthRange(CGLCommandBuffer *cmds, GLdouble n, GLdouble f);
+GLAPI void cglCmdDetachShader(CGLCommandBuffer *cmds, GLuint program, GLuint shader);
+GLAPI void cglCmdEnable(CGLCommandBuffer *cmds, GLenum cap);
+GLAPI void cglCmdDisable(CGLCommandBuffer *cmds, GLenum cap);
+GLAPI void cglCmdEnableVertexAttribArray(CGLCommandBuffer *cmds, GLuint index);
+GLAPI void cglCmdDisableVertexAttribArray(CGLCommandBuffer *cmds, GLuint index);
+GLAPI void cglCmdDrawArrays(CGLCommandBuffer *cmds, GLenum mode, GLint first, GLsizei count);
+GLAPI void cglCmdDrawElements(CGLCommandBuffer *cmds, GLenum mode, GLsizei count, GLenum type, const void *indices);
+GLAPI void cglCmdFinish(CGLCommandBuffer *cmds);
+GLAPI void cglCmdFlush(CGLCommandBuffer *cmds);
+GLAPI void cglCmdFrontFace(CGLCommandBuffer *cmds, GLenum mode);
+GLAPI void cglCmdGenBuffers(CGLCommandBuffer *cmds, GLsizei n, GLuint *buffers);
+GLAPI void cglCmdGenTextures(CGLCommandBuffer *cmds, GLsizei n, GLuint *textures);
+GLAPI void cglCmdGetBooleanv(CGLCommandBuffer *cmds, GLenum pname, GLboolean *data);
+GLAPI void cglCmdGetFloatv(CGLCommandBuffer *cmds, GLenum pname, GLfloat *data);
+GLAPI void cglCmdGetIntegerv(CGLCommandBuffer *cmds, GLenum pname, GLint *data);
+GLAPI void cglCmdGetActiveAttrib(CGLCommandBuffer *cmds, GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name);
+GLAPI void cglCmdGetActiveUniform(CGLCommandBuffer *cmds, GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name);
+GLAPI void cglCmdGetError(CGLCommandBuffer *cmds, GLenum *result);
+GLAPI void cglCmdGetProgramiv(CGLCommandBuffer *cmds, GLuint program, GLenum pname, GLint *params);
+GLAPI void cglCmdGetUniformLocation(CGLCommandBuffer *cmds, GLuint program, const GLchar *name, GLint *result);
+GLAPI void cglCmdLinkProgram(CGLCommandBuffer *cmds, GLuint program);
+GLAPI void cglCmdPixelStorei(CGLCommandBuffer *cmds, GLenum pname, GLint param);
+GLAPI void cglCmdPolygonOffset(CGLCommandBuffer *cmds, GLfloat factor, GLfloat units);
+GLAPI void cglCmdStencilFunc(CGLCommandBuffer *cmds, GLenum func, GLint ref, GLuint mask);
+GLAPI void cglCmdStencilFuncSeparate(CGLCommandBuffer *cmds, GLenum face, GLenum func, GLint ref, GLuint mask);
+GLAPI void cglCmdStencilMask(CGLCommandBuffer *cmds, GLuint mask);
+GLAPI void cglCmdStencilMaskSeparate(CGLCommandBuffer *cmds, GLenum face, GLuint mask);
+GLAPI void cglCmdStencilOp(CGLCommandBuffer *cmds, GLenum sfail, GLenum dpfail, GLenum dppass);
+GLAPI void cglCmdStencilOpSeparate(CGLCommandBuffer *cmds, GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass);
+GLAPI void cglCmdTexImage2D(CGLCommandBuffer *cmds, GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *data);
+GLAPI void cglCmdTexParameteri(CGLCommandBuffer *cmds, GLenum target, GLenum pname, GLint param);
+GLAPI void cglCmdTexSubImage2D(CGLCommandBuffer *cmds, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *data);
+GLAPI void cglCmdUniform1f(CGLCommandBuffer *cmds, GLint location, GLfloat v0);
+GLAPI void cglCmdUniform2f(CGLCommandBuffer *cmds, GLint location, GLfloat v0, GLfloat v1);
+GLAPI void cglCmdUniform3f(CGLCommandBuffer *cmds, GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+GLAPI void cglCmdUniform4f(CGLCommandBuffer *cmds, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+GLAPI void cglCmdUniform1i(CGLCommandBuffer *cmds, GLint location, GLint v0);
+GLAPI void cglCmdUniform2i(CGLCommandBuffer *cmds, GLint location, GLint v0, GLint v1);
+GLAPI void cglCmdUniform3i(CGLCommandBuffer *cmds, GLint location, GLint v0, GLint v1, GLint v2);
+GLAPI void cglCmdUniform4i(CGLCommandBuffer *cmds, GLint location, GLint v0, GLint v1, GLint v2, GLint v3);
+GLAPI void cglCmdUniform1fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLfloat *value);
+GLAPI void cglCmdUniform2fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLfloat *value);
+GLAPI void cglCmdUniform3fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLfloat *value);
+GLAPI void cglCmdUniform4fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLfloat *value);
+GLAPI void cglCmdUniform1iv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLint *value);
+GLAPI void cglCmdUniform2iv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLint *value);
+GLAPI void cglCmdUniform3iv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLint *value);
+GLAPI void cglCmdUniform4iv(CGLCommandBuffer *cmds, GLint location, GLsizei count, const GLint *value);
+GLAPI void cglCmdUniformMatrix2fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+GLAPI void cglCmdUniformMatrix3fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+GLAPI void cglCmdUniformMatrix4fv(CGLCommandBuffer *cmds, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value);
+GLAPI void cglCmdUseProgram(CGLCommandBuffer *cmds, GLuint program);
+GLAPI void cglCmdVertexAttribPointer(CGLCommandBuffer *cmds, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer);
+/* cglgen:end commands */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,648 @@
+#!/usr/bin/env python3
+#
+#  Common OpenGL loader generator
+#
+#  Reads the list of entry points documented in cgl-ref-pages, matches them against the
+#  function pointer typedefs in cgl.h, and regenerates the marked sections of cgl.h, cgl.c,
+#  cglcmd.h and cglcmd.c:
+#
+#      /* cglgen:begin <section> */ ... /* cglgen:end <section> */
+#
+#  Everything between those markers is overwritten, everything else is left alone.
+#  Run it from anywhere after adding a function to cgl.h:  python3 cglgen.py
+#
+#  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+#  SPDX-License-Identifier: MIT
+#
+
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+
+REF_PAGES = os.path.join(ROOT, "cgl-ref-pages")
+HEADER = os.path.join(ROOT, "cgl.h")
+SOURCE = os.path.join(ROOT, "cgl.c")
+CMD_HEADER = os.path.join(ROOT, "cglcmd.h")
+CMD_SOURCE = os.path.join(ROOT, "cglcmd.c")
+
+REF_PROTOTYPE = re.compile(r"^    (?:const\s+)?\w+\s*\*?\s*(gl[A-Z]\w*)\(")
+HEADER_TYPEDEF = re.compile(r"^typedef\s+(.+?)\s*\(APIENTRYP\s+(PFNGL\w+PROC)\)\((.*)\);\s*$")
+SECTION = re.compile(r"(/\* cglgen:begin (\w+) \*/\n)(.*?)(/\* cglgen:end \2 \*/)", re.S)
+
+
+class Param:
+    def __init__(self, decl):
+        decl = decl.strip()
+        m = re.match(r"^(.*?)(\w+)$", decl)
+        self.type = m.group(1).strip()
+        self.name = m.group(2)
+
+    def __str__(self):
+        sep = "" if self.type.endswith("*") else " "
+        return self.type + sep + self.name
+
+
+class Entry:
+    def __init__(self, name, ret, params):
+        self.name = name                        # glActiveTexture
+        self.member = name[2:]                  # ActiveTexture
+        self.pfn = "PFNGL" + name[2:].upper() + "PROC"
+        self.glad = "glad_" + name
+        self.ret = ret
+        self.params = params
+
+
+def ref_entry_points():
+    """every gl* function named in a prototype line of the ref pages, in order of appearance"""
+    names = []
+    with open(REF_PAGES, encoding="utf-8") as f:
+        for line in f:
+            m = REF_PROTOTYPE.match(line)
+            if m and m.group(1) not in names:
+                names.append(m.group(1))
+    return names
+
+
+def header_typedefs(text):
+    typedefs = {}
+    for line in text.splitlines():
+        m = HEADER_TYPEDEF.match(line)
+        if not m:
+            continue
+        args = m.group(3).strip()
+        params = [] if args == "void" else [Param(a) for a in args.split(",")]
+        typedefs[m.group(2)] = (m.group(1), params)
+    return typedefs
+
+
+def entries(header_text):
+    typedefs = header_typedefs(header_text)
+    exposed = set(re.findall(r"^#define (gl[A-Z]\w*) glad_\1\s*$", header_text, re.M))
+    result = []
+    for name in ref_entry_points():
+        pfn = "PFNGL" + name[2:].upper() + "PROC"
+        if name in exposed and pfn in typedefs:
+            result.append(Entry(name, *typedefs[pfn]))
+    documented = set(e.name for e in result)
+    for name in sorted(exposed - documented):
+        sys.stderr.write("cglgen: %s is in cgl.h but has no prototype in cgl-ref-pages, skipped\n" % name)
+    return result
+
+
+def enums(header_text):
+    """(name, value) of every #define GL_* constant, in order of definition, without repetitions"""
+    result = []
+    seen = set()
+    for name, value in re.findall(r"^#define (GL_\w+)\s+(0x[0-9A-Fa-f]+|\d+)\s*$", header_text, re.M):
+        if name not in seen:
+            seen.add(name)
+            result.append((name, int(value, 0)))
+    return result
+
+
+# ---------------------------------------------------------------------------------------------
+# perfect hashing (hash and displace): a key lands in bucket hash(key, 0) % len(displace),
+# and then in slot hash(key, displace[bucket]) % size, with displace chosen per bucket so
+# that no two keys share a slot. The C side in cgl.c must compute the same hashes.
+# ---------------------------------------------------------------------------------------------
+
+def hash_string(key, seed):
+    h = (2166136261 ^ seed) & 0xffffffff
+    for c in key.encode("ascii"):
+        h = ((h ^ c) * 16777619) & 0xffffffff
+    return h
+
+
+def hash_value(key, seed):
+    h = (key ^ (seed * 0x9e3779b9)) & 0xffffffff
+    h = ((h ^ (h >> 16)) * 0x7feb352d) & 0xffffffff
+    h = ((h ^ (h >> 15)) * 0x846ca68b) & 0xffffffff
+    return h ^ (h >> 16)
+
+
+def perfect_hash(keys, hash_fn):
+    """returns (displace, slots) with slots[i] the index into keys of the key in slot i, or None"""
+    size = len(keys)
+    nbuckets = max(1, (len(keys) + 1) // 2)
+    buckets = [[] for _ in range(nbuckets)]
+    for i, k in enumerate(keys):
+        buckets[hash_fn(k, 0) % nbuckets].append(i)
+    displace = [0] * nbuckets
+    slots = [None] * size
+    for b in sorted(range(nbuckets), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        for d in range(1, 0x10000):
+            positions = [hash_fn(keys[i], d) % size for i in buckets[b]]
+            if len(set(positions)) == len(positions) and all(slots[p] is None for p in positions):
+                break
+        else:
+            sys.exit("cglgen: no perfect hash found")
+        displace[b] = d
+        for i, p in zip(buckets[b], positions):
+            slots[p] = i
+    return displace, slots
+
+
+def c_array(ctype, name, size, items, per_line):
+    out = ["static const %s %s[%s] = {\n" % (ctype, name, size)]
+    for i in range(0, len(items), per_line):
+        chunk = items[i:i + per_line]
+        last = i + per_line >= len(items)
+        out.append("    " + ", ".join(chunk) + ("" if last else ",") + "\n")
+    out.append("};\n")
+    return "".join(out)
+
+
+# ---------------------------------------------------------------------------------------------
+# section emitters: each returns the new text between the begin/end markers of its section
+# ---------------------------------------------------------------------------------------------
+
+def prototype_args(e):
+    return ", ".join(str(p) for p in e.params) if e.params else "void"
+
+
+def call_args(e):
+    return ", ".join(p.name for p in e.params)
+
+
+def emit_dispatch(model):
+    es = model.entries
+    width = max(len(e.pfn) for e in es)
+    out = []
+    out.append("#define CGL_DISPATCH_COUNT %d\n\n" % len(es))
+    out.append("typedef union CGL_CACHE_ALIGNED CGLDispatch {\n")
+    out.append("    struct {\n")
+    for e in es:
+        out.append("        %-*s %s;\n" % (width, e.pfn, e.member))
+    out.append("    } fn;\n")
+    out.append("    GLADproc slot[CGL_DISPATCH_COUNT];\n")
+    out.append("} CGLDispatch;\n\n")
+    out.append("GLAPI CGLDispatch cgl_dispatch;\n\n")
+    width = max(len(e.glad) for e in es)
+    out.append("#ifdef CGL_DIRECT_LINK\n\n")
+    for e in es:
+        out.append("#undef %s\n" % e.name)
+    out.append("\n")
+    for e in es:
+        out.append("#define %-*s %s\n" % (width, e.glad, e.name))
+    out.append("\n")
+    for e in es:
+        out.append("extern %s APIENTRY %s(%s);\n" % (e.ret, e.name, prototype_args(e)))
+    out.append("\n#else\n\n")
+    for e in es:
+        out.append("#define %-*s CGL_CURRENT_DISPATCH->fn.%s\n" % (width, e.glad, e.member))
+    out.append("\n#endif /* CGL_DIRECT_LINK */\n")
+    return "".join(out)
+
+
+def gnu_hash(name):
+    """the hash of the DT_GNU_HASH section of ELF shared objects"""
+    h = 5381
+    for c in name.encode("ascii"):
+        h = (h * 33 + c) & 0xffffffff
+    return h
+
+
+def emit_symbols(model):
+    es = model.entries
+    out = []
+    out.append("static const char cgl_symbol_pool[] =\n")
+    for e in es[:-1]:
+        out.append('    "%s\\0"\n' % e.name)
+    out.append('    "%s";\n' % es[-1].name)
+    offsets = []
+    pos = 0
+    for e in es:
+        offsets.append(pos)
+        pos += len(e.name) + 1
+    out.append("\nstatic const unsigned short cgl_symbol_offset[CGL_DISPATCH_COUNT] = {\n")
+    line = "   "
+    for i, off in enumerate(offsets):
+        item = " %d," % off if i < len(offsets) - 1 else " %d" % off
+        if len(line) + len(item) > 100:
+            out.append(line + "\n")
+            line = "   "
+        line += item
+    out.append(line + "\n};\n")
+    out.append("\n#ifdef CGL_ELF_LOOKUP\n")
+    out.append("static const unsigned long cgl_symbol_hash[CGL_DISPATCH_COUNT] = {\n")
+    line = "   "
+    for i, e in enumerate(es):
+        item = " 0x%08xUL%s" % (gnu_hash(e.name), "," if i < len(es) - 1 else "")
+        if len(line) + len(item) > 100:
+            out.append(line + "\n")
+            line = "   "
+        line += item
+    out.append(line + "\n};\n#endif\n")
+    return "".join(out)
+
+
+def emit_lazy(model):
+    es = model.entries
+    out = []
+    for i, e in enumerate(es):
+        out.append("static %s APIENTRY cgl_lazy_%s(%s) {\n" % (e.ret, e.name, prototype_args(e)))
+        call = "((%s) cgl_lazy_bind(%d, (GLADproc) cgl_lazy_%s))(%s);" % (e.pfn, i, e.name, call_args(e))
+        out.append("    %s%s\n" % ("" if e.ret == "void" else "return ", call))
+        out.append("}\n")
+    out.append("\nstatic const CGLDispatch cgl_lazy_stubs = {{\n")
+    for i, e in enumerate(es):
+        out.append("    cgl_lazy_%s%s\n" % (e.name, "," if i < len(es) - 1 else ""))
+    out.append("}};\n")
+    return "".join(out)
+
+
+def emit_enums(model):
+    names = [n for n, v in model.enums]
+    values = []
+    for n, v in model.enums:
+        if v not in values:
+            values.append(v)
+    name_displace, name_slots = perfect_hash(names, hash_string)
+    value_displace, value_slots = perfect_hash(values, hash_value)
+    # the entries are stored in name hash order, the value table refers to the first name of a value
+    order = name_slots
+    first_entry = {}
+    for pos, i in enumerate(order):
+        name, value = model.enums[i]
+        if value not in first_entry or i < order[first_entry[value]]:
+            first_entry[value] = pos
+    out = []
+    out.append("#define CGL_ENUM_COUNT %d\n" % len(names))
+    out.append("#define CGL_ENUM_VALUE_COUNT %d\n\n" % len(values))
+    out.append("static const char cgl_enum_pool[] =\n")
+    offsets = {}
+    pos = 0
+    for i, n in enumerate(names):
+        offsets[n] = pos
+        pos += len(n) + 1
+        out.append('    "%s%s"%s\n' % (n, "" if i == len(names) - 1 else "\\0", ";" if i == len(names) - 1 else ""))
+    out.append("\n")
+    out.append(c_array("CGLEnumEntry", "cgl_enum_entries", "CGL_ENUM_COUNT",
+                       ["{%d, 0x%04X}" % (offsets[model.enums[i][0]], model.enums[i][1]) for i in order], 6))
+    out.append("\n")
+    out.append(c_array("unsigned short", "cgl_enum_name_displace", len(name_displace),
+                       ["%d" % d for d in name_displace], 16))
+    out.append("\n")
+    out.append(c_array("unsigned short", "cgl_enum_value_slots", "CGL_ENUM_VALUE_COUNT",
+                       ["%d" % first_entry[values[i]] for i in value_slots], 16))
+    out.append("\n")
+    out.append(c_array("unsigned short", "cgl_enum_value_displace", len(value_displace),
+                       ["%d" % d for d in value_displace], 16))
+    return "".join(out)
+
+
+# ---------------------------------------------------------------------------------------------
+# command encoding (cglcmd.c): every argument takes one 8 byte CGLArg, arrays and strings read by
+# a function are copied behind the arguments, and referred to by their offset from the start of
+# the command. Every const pointer parameter needs an entry here with the size of what it points to,
+# or in RAW_POINTERS if the pointer itself is the argument (like the offset of glDrawElements).
+# Other pointers are outputs, which are kept as they are and written to at replay, as is the
+# result of functions returning a value, which is passed as an extra pointer argument.
+# ---------------------------------------------------------------------------------------------
+
+PAYLOADS = {
+    ("glBindAttribLocation", "name"): "name != nullptr ? strlen(name) + 1 : 0",
+    ("glBufferData", "data"): "data != nullptr ? (size_t) size : 0",
+    ("glBufferSubData", "data"): "data != nullptr ? (size_t) size : 0",
+    ("glDeleteBuffers", "buffers"): "n > 0 ? (size_t) n * sizeof(GLuint) : 0",
+    ("glDeleteTextures", "textures"): "n > 0 ? (size_t) n * sizeof(GLuint) : 0",
+    ("glGetUniformLocation", "name"): "name != nullptr ? strlen(name) + 1 : 0",
+    ("glTexImage2D", "data"): "data != nullptr ? cgl_cmd_image_size(cmds, width, height, format, type) : 0",
+    ("glTexSubImage2D", "data"): "data != nullptr ? cgl_cmd_image_size(cmds, width, height, format, type) : 0",
+}
+
+# glUniform*v and glUniformMatrix*fv: count elements of the components in the name
+for n in (1, 2, 3, 4):
+    for t, ty in (("f", "GLfloat"), ("i", "GLint")):
+        PAYLOADS[("glUniform%d%sv" % (n, t), "value")] = "count > 0 ? (size_t) count * %d * sizeof(%s) : 0" % (n, ty)
+    if n > 1:
+        PAYLOADS[("glUniformMatrix%dfv" % n, "value")] = "count > 0 ? (size_t) count * %d * sizeof(GLfloat) : 0" % (n * n)
+
+RAW_POINTERS = {
+    ("glDrawElements", "indices"),
+    ("glVertexAttribPointer", "pointer"),
+}
+
+# state the recording needs to size later payloads, kept in the command buffer when the call is encoded
+ENCODE_STATE = {
+    "glPixelStorei": "    if (pname == GL_UNPACK_ALIGNMENT)\n        cmds->unpack_alignment = param;\n",
+}
+
+# state the check of a trace needs to size later payloads, updated as the commands are checked in order
+CHECK_STATE = {
+    "glPixelStorei": "            if (command->argc == 2 && arg[0].u == GL_UNPACK_ALIGNMENT\n"
+                     "                    && (arg[1].i == 1 || arg[1].i == 2 || arg[1].i == 4 || arg[1].i == 8))\n"
+                     "                *alignment = (size_t) arg[1].i;\n",
+}
+
+# bytes written to each output, for the scratch memory that replaces them when replaying a trace
+OUTPUTS = {
+    ("glGetBooleanv", "data"): "16 * sizeof(GLboolean)",
+    ("glGetFloatv", "data"): "16 * sizeof(GLfloat)",
+    ("glGetIntegerv", "data"): "16 * sizeof(GLint)",
+    ("glGenBuffers", "buffers"): "n > 0 ? (size_t) n * sizeof(GLuint) : 0",
+    ("glGenTextures", "textures"): "n > 0 ? (size_t) n * sizeof(GLuint) : 0",
+    ("glGetActiveAttrib", "length"): "sizeof(GLsizei)",
+    ("glGetActiveAttrib", "size"): "sizeof(GLint)",
+    ("glGetActiveAttrib", "type"): "sizeof(GLenum)",
+    ("glGetActiveAttrib", "name"): "bufSize > 0 ? (size_t) bufSize : 0",
+    ("glGetProgramiv", "params"): "sizeof(GLint)",
+    ("glGetActiveUniform", "length"): "sizeof(GLsizei)",
+    ("glGetActiveUniform", "size"): "sizeof(GLint)",
+    ("glGetActiveUniform", "type"): "sizeof(GLenum)",
+    ("glGetActiveUniform", "name"): "bufSize > 0 ? (size_t) bufSize : 0",
+}
+
+ARG_MEMBERS = {
+    "GLenum": "u", "GLuint": "u", "GLbitfield": "u", "GLboolean": "u",
+    "GLint": "i", "GLsizei": "i",
+    "GLfloat": "f", "GLdouble": "d",
+    "GLsizeiptr": "l", "GLintptr": "l",
+}
+
+
+def arg_kind(e, p):
+    """'value', 'payload', 'raw' or 'output'"""
+    if "*" not in p.type:
+        if p.type not in ARG_MEMBERS:
+            sys.exit("cglgen: no command encoding for the type %s of %s in %s" % (p.type, p.name, e.name))
+        return "value"
+    if (e.name, p.name) in PAYLOADS:
+        return "payload"
+    if (e.name, p.name) in RAW_POINTERS:
+        return "raw"
+    if p.type.startswith("const"):
+        sys.exit("cglgen: the size of %s of %s is unknown, add it to PAYLOADS or RAW_POINTERS" % (p.name, e.name))
+    if (e.name, p.name) not in OUTPUTS:
+        sys.exit("cglgen: the size of the output %s of %s is unknown, add it to OUTPUTS" % (p.name, e.name))
+    return "output"
+
+
+def decoded(e, p, i):
+    """argument i of a command, as the value passed to the function"""
+    return "(%s) arg[%d].%s" % (p.type, i, ARG_MEMBERS[p.type])
+
+
+def output_size(e, p):
+    """the size of an output, with the parameters replaced by the decoded arguments"""
+    expr = OUTPUTS[(e.name, p.name)]
+    for i, q in enumerate(e.params):
+        if arg_kind(e, q) == "value":
+            expr = re.sub(r"\b%s\b" % q.name, "(%s)" % decoded(e, q, i), expr)
+    return expr
+
+
+def cmd_params(e):
+    params = [str(p) for p in e.params]
+    if e.ret != "void":
+        params.append("%s *result" % e.ret)
+    return ", ".join(["CGLCommandBuffer *cmds"] + params)
+
+
+def emit_commands(model):
+    out = []
+    for e in model.entries:
+        out.append("GLAPI void cglCmd%s(%s);\n" % (e.member, cmd_params(e)))
+    return "".join(out)
+
+
+def emit_encode(model):
+    out = []
+    for slot, e in enumerate(model.entries):
+        nargs = len(e.params) + (e.ret != "void")
+        payloads = [p for p in e.params if arg_kind(e, p) == "payload"]
+        out.append("void cglCmd%s(%s) {\n" % (e.member, cmd_params(e)))
+        for p in payloads:
+            out.append("    size_t %s_size = %s;\n" % (p.name, PAYLOADS[(e.name, p.name)]))
+        total = " + ".join("CGL_CMD_ALIGN(%s_size)" % p.name for p in payloads) or "0"
+        out.append("    CGLCommand *cmd = cgl_cmd_begin(cmds, %d, %d, %s);\n" % (slot, nargs, total))
+        if payloads:
+            out.append("    size_t at = CGL_CMD_SIZE(%d);\n" % nargs)
+        out.append("\n    if (cmd == nullptr)\n        return;\n")
+        for i, p in enumerate(e.params):
+            kind = arg_kind(e, p)
+            if kind == "value":
+                out.append("    cmd->arg[%d].%s = %s;\n" % (i, ARG_MEMBERS[p.type], p.name))
+            elif kind == "payload":
+                out.append("    cmd->arg[%d].u = cgl_cmd_copy(cmd, &at, %s, %s_size);\n" % (i, p.name, p.name))
+            else:
+                out.append("    cmd->arg[%d].q = (uint64_t) (size_t) %s;\n" % (i, p.name))
+        if e.ret != "void":
+            out.append("    cmd->arg[%d].q = (uint64_t) (size_t) result;\n" % len(e.params))
+        out.append(ENCODE_STATE.get(e.name, ""))
+        out.append("}\n\n")
+    return "".join(out).rstrip("\n") + "\n"
+
+
+def emit_execute(model):
+    out = []
+    out.append("static void cgl_cmd_execute(const CGLDispatch *gl, unsigned int opcode, const CGLCommand *command,\n")
+    out.append("                            CGLScratch *scratch) {\n")
+    out.append("    const CGLArg *arg = command->arg;\n\n")
+    out.append("    (void) gl;\n")
+    out.append("    switch (opcode) {\n")
+    for slot, e in enumerate(model.entries):
+        args = []
+        for i, p in enumerate(e.params):
+            kind = arg_kind(e, p)
+            if kind == "value":
+                args.append(decoded(e, p, i))
+            elif kind == "payload":
+                args.append("(%s) cgl_cmd_data(command, arg[%d].u)" % (p.type, i))
+            elif kind == "raw":
+                args.append("(%s) (size_t) arg[%d].q" % (p.type, i))
+            else:
+                args.append("(%s) cgl_cmd_output(scratch, &arg[%d], %s)" % (p.type, i, output_size(e, p)))
+        call = "CGL_CMD_CALL(gl, %s)(%s)" % (e.member, ", ".join(args))
+        out.append("        case %d: /* %s */\n" % (slot, e.name))
+        if e.ret == "void":
+            out.append("            %s;\n" % call)
+        else:
+            out.append("            if (scratch == nullptr && arg[%d].q != 0)\n" % len(e.params))
+            out.append("                *(%s *) (size_t) arg[%d].q = %s;\n" % (e.ret, len(e.params), call))
+            out.append("            else\n")
+            out.append("                %s;\n" % call)
+        out.append("            break;\n")
+    out.append("        default:\n")
+    out.append("            break;\n")
+    out.append("    }\n")
+    out.append("}\n")
+    return "".join(out)
+
+
+def emit_output_size(model):
+    out = []
+    out.append("static size_t cgl_cmd_output_size(unsigned int opcode, const CGLArg *arg) {\n")
+    out.append("    switch (opcode) {\n")
+    for slot, e in enumerate(model.entries):
+        outputs = [p for p in e.params if arg_kind(e, p) == "output"]
+        if not outputs:
+            continue
+        total = " + ".join("CGL_CMD_ALIGN(%s)" % output_size(e, p) for p in outputs)
+        out.append("        case %d: /* %s */\n" % (slot, e.name))
+        out.append("            return %s;\n" % total)
+    out.append("        default:\n")
+    out.append("            return 0;\n")
+    out.append("    }\n")
+    out.append("}\n")
+    return "".join(out)
+
+
+def payload_check(e, p, i):
+    """the condition that payload i of a command lies within it, with the size the function will read"""
+    expr = PAYLOADS[(e.name, p.name)]
+    if "strlen(" in expr:
+        return "cgl_cmd_check_string(command, arg[%d].u)" % i
+    expr = re.sub(r"^%s != nullptr \? (.*) : 0$" % p.name, r"\1", expr)
+    expr = expr.replace("cgl_cmd_image_size(cmds, ", "cgl_cmd_image_bytes(*alignment, ")
+    for j, q in enumerate(e.params):
+        if arg_kind(e, q) == "value":
+            expr = re.sub(r"\b%s\b" % q.name, "(%s)" % decoded(e, q, j), expr)
+    return "cgl_cmd_check_payload(command, arg[%d].u, %s)" % (i, expr)
+
+
+def emit_check(model):
+    out = []
+    out.append("static int cgl_cmd_check(unsigned int opcode, const CGLCommand *command, size_t *alignment) {\n")
+    out.append("    const CGLArg *arg = command->arg;\n\n")
+    out.append("    switch (opcode) {\n")
+    for slot, e in enumerate(model.entries):
+        nargs = len(e.params) + (e.ret != "void")
+        checks = ["command->argc == %d" % nargs]
+        checks += [payload_check(e, p, i) for i, p in enumerate(e.params) if arg_kind(e, p) == "payload"]
+        out.append("        case %d: /* %s */\n" % (slot, e.name))
+        out.append(CHECK_STATE.get(e.name, ""))
+        out.append("            return %s;\n" % "\n                   && ".join(checks))
+    out.append("        default:\n")
+    out.append("            return 0;\n")
+    out.append("    }\n")
+    out.append("}\n")
+    return "".join(out)
+
+
+def proxy_waits(e):
+    """whether the proxy stub has to wait for the render thread, for a result or an output"""
+    return e.ret != "void" or any(arg_kind(e, p) == "output" for p in e.params)
+
+
+def emit_proxy(model):
+    out = []
+    for e in model.entries:
+        names = [p.name for p in e.params]
+        params = ", ".join(str(p) for p in e.params) or "void"
+        out.append("static %s APIENTRY cgl_proxy_%s(%s) {\n" % (e.ret, e.name, params))
+        if e.ret != "void":
+            out.append("    %s result = 0;\n\n" % e.ret)
+            names.append("&result")
+        out.append("    cglCmd%s(%s);\n" % (e.member, ", ".join(["&cgl_proxy->writer"] + names)))
+        out.append("    cgl_proxy_%s(cgl_proxy);\n" % ("wait" if proxy_waits(e) else "commit"))
+        if e.ret != "void":
+            out.append("    return result;\n")
+        out.append("}\n")
+    out.append("\nstatic const CGLDispatch cgl_proxy_stubs = {{\n")
+    out.append(",\n".join("    cgl_proxy_%s" % e.name for e in model.entries))
+    out.append("\n}};\n")
+    return "".join(out)
+
+
+def emit_capture(model):
+    out = []
+    for e in model.entries:
+        names = [p.name for p in e.params]
+        params = ", ".join(str(p) for p in e.params) or "void"
+        out.append("static %s APIENTRY cgl_capture_%s(%s) {\n" % (e.ret, e.name, params))
+        args = ["cgl_capture.buffer"] + names + (["nullptr"] if e.ret != "void" else [])
+        out.append("    cglCmd%s(%s);\n" % (e.member, ", ".join(args)))
+        out.append("    cgl_capture_check();\n")
+        call = "cgl_capture.next.fn.%s(%s)" % (e.member, ", ".join(names))
+        out.append("    %s%s;\n" % ("return " if e.ret != "void" else "", call))
+        out.append("}\n")
+    out.append("\nstatic const CGLDispatch cgl_capture_stubs = {{\n")
+    out.append(",\n".join("    cgl_capture_%s" % e.name for e in model.entries))
+    out.append("\n}};\n")
+    return "".join(out)
+
+
+def emit_null(model):
+    out = []
+    for e in model.entries:
+        params = ", ".join(str(p) for p in e.params) or "void"
+        out.append("static %s APIENTRY cgl_null_%s(%s) {\n" % (e.ret, e.name, params))
+        for p in e.params:
+            out.append("    (void) %s;\n" % p.name)
+        if e.ret != "void":
+            out.append("    return 0;\n")
+        out.append("}\n")
+    out.append("\nstatic const CGLDispatch cgl_null_functions = {{\n")
+    out.append(",\n".join("    cgl_null_%s" % e.name for e in model.entries))
+    out.append("\n}};\n")
+    return "".join(out)
+
+
+HEADER_SECTIONS = {
+    "dispatch": emit_dispatch,
+}
+
+SOURCE_SECTIONS = {
+    "symbols": emit_symbols,
+    "lazy": emit_lazy,
+    "enums": emit_enums,
+}
+
+CMD_HEADER_SECTIONS = {
+    "commands": emit_commands,
+}
+
+CMD_SOURCE_SECTIONS = {
+    "encode": emit_encode,
+    "execute": emit_execute,
+    "output_size": emit_output_size,
+    "check": emit_check,
+    "proxy": emit_proxy,
+    "capture": emit_capture,
+    "null": emit_null,
+}
+
+
+def regenerate(path, sections, model):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    seen = set()
+
+    def replace(m):
+        name = m.group(2)
+        if name not in sections:
+            sys.exit("cglgen: unknown section '%s' in %s" % (name, path))
+        seen.add(name)
+        return m.group(1) + sections[name](model) + m.group(4)
+
+    text = SECTION.sub(replace, text)
+    missing = set(sections) - seen
+    if missing:
+        sys.exit("cglgen: %s lacks the section(s) %s" % (path, ", ".join(sorted(missing))))
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+
+
+class Model:
+    def __init__(self, header_text):
+        self.entries = entries(header_text)
+        self.enums = enums(header_text)
+
+
+def main():
+    with open(HEADER, encoding="utf-8") as f:
+        model = Model(f.read())
+    regenerate(HEADER, HEADER_SECTIONS, model)
+    regenerate(SOURCE, SOURCE_SECTIONS, model)
+    regenerate(CMD_HEADER, CMD_HEADER_SECTIONS, model)
+    regenerate(CMD_SOURCE, CMD_SOURCE_SECTIONS, model)
+    sys.stderr.write("cglgen: %d entry points, %d enums\n" % (len(model.entries), len(model.enums)))
+
+
+if __name__ == "__main__":
+    main()
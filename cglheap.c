@@ -0,0 +1,497 @@
+/*
+ *  Buffer heaps for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cglheap.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+
+/* sizes are counted in units of CGL_HEAP_ALIGNMENT bytes. The first level of the TLSF index is the
+ * highest bit of the size, the second level the next CGL_HEAP_SL_BITS bits below it; sizes below
+ * CGL_HEAP_SL_COUNT units all go into the first level 0, one list per size.
+ */
+#define CGL_HEAP_SL_BITS    4
+#define CGL_HEAP_SL_COUNT   (1u << CGL_HEAP_SL_BITS)
+#define CGL_HEAP_FL_COUNT   (32 - CGL_HEAP_SL_BITS + 1)
+#define CGL_HEAP_MAX_UNITS  0x7fffffffUL
+#define CGL_HEAP_NONE       0xffffffffu
+
+/* a range of a block, allocated or free. Ranges are kept in an array and refer to each other by index,
+ * unused entries of the array are chained by next */
+typedef struct CGLHeapRange {
+    size_t offset;          /* in bytes */
+    unsigned long units;
+    unsigned int block;
+    unsigned int prev;      /* the ranges before and after it in its block, CGL_HEAP_NONE at the ends */
+    unsigned int next;
+    unsigned int free_prev; /* the free list of its size class, if it is free */
+    unsigned int free_next;
+    CGLHeapHandle handle;   /* 0 if free */
+} CGLHeapRange;
+
+typedef struct CGLHeapBlock {
+    GLuint buffer;          /* 0 if the block was deleted and can be used again */
+    size_t size;
+    unsigned char *copy;    /* the contents of the buffer in client memory, for moving allocations */
+    unsigned int first;     /* the range at offset 0 */
+} CGLHeapBlock;
+
+struct CGLBufferHeap {
+    GLenum target;
+    size_t block_size;
+    CGLHeapBlock *blocks;
+    unsigned int block_count;
+    CGLHeapRange *ranges;
+    unsigned int range_count;
+    unsigned int range_capacity;
+    unsigned int unused_ranges;     /* chain of entries of ranges that can be used again */
+    unsigned int *handles;          /* the range of each handle, handle h at h - 1 */
+    unsigned int handle_count;
+    unsigned int handle_capacity;
+    unsigned int *free_handles;     /* stack of the handles that can be given out again */
+    unsigned int free_handle_count;
+    size_t moved;
+    /* the TLSF index: bit fl of fl_bitmap is set if any list of sl_bitmap[fl] is non-empty */
+    unsigned int fl_bitmap;
+    unsigned int sl_bitmap[CGL_HEAP_FL_COUNT];
+    unsigned int lists[CGL_HEAP_FL_COUNT][CGL_HEAP_SL_COUNT];
+};
+
+
+static unsigned int cgl_heap_lowest_bit(unsigned int bits) {
+#ifdef __GNUC__
+    return (unsigned int) __builtin_ctz(bits);
+#else
+    unsigned int i = 0;
+
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+static unsigned int cgl_heap_highest_bit(unsigned long bits) {
+#ifdef __GNUC__
+    return (unsigned int) (sizeof(unsigned long) * 8 - 1) - (unsigned int) __builtin_clzl(bits);
+#else
+    unsigned int i = 0;
+
+    while (bits >>= 1)
+        ++i;
+    return i;
+#endif
+}
+
+/* the size class a free range of units belongs to */
+static void cgl_heap_mapping(unsigned long units, unsigned int *fl, unsigned int *sl) {
+    unsigned int bit;
+
+    if (units < CGL_HEAP_SL_COUNT) {
+        *fl = 0;
+        *sl = (unsigned int) units;
+        return;
+    }
+    bit = cgl_heap_highest_bit(units);
+    *fl = bit - CGL_HEAP_SL_BITS + 1;
+    *sl = (unsigned int) (units >> (bit - CGL_HEAP_SL_BITS)) - CGL_HEAP_SL_COUNT;
+}
+
+static void cgl_heap_insert_free(CGLBufferHeap *heap, unsigned int index) {
+    CGLHeapRange *range = &heap->ranges[index];
+    unsigned int fl, sl, head;
+
+    cgl_heap_mapping(range->units, &fl, &sl);
+    head = heap->lists[fl][sl];
+    range->handle = 0;
+    range->free_prev = CGL_HEAP_NONE;
+    range->free_next = head;
+    if (head != CGL_HEAP_NONE)
+        heap->ranges[head].free_prev = index;
+    heap->lists[fl][sl] = index;
+    heap->sl_bitmap[fl] |= 1u << sl;
+    heap->fl_bitmap |= 1u << fl;
+}
+
+static void cgl_heap_remove_free(CGLBufferHeap *heap, unsigned int index) {
+    CGLHeapRange *range = &heap->ranges[index];
+    unsigned int fl, sl;
+
+    cgl_heap_mapping(range->units, &fl, &sl);
+    if (range->free_prev != CGL_HEAP_NONE)
+        heap->ranges[range->free_prev].free_next = range->free_next;
+    else
+        heap->lists[fl][sl] = range->free_next;
+    if (range->free_next != CGL_HEAP_NONE)
+        heap->ranges[range->free_next].free_prev = range->free_prev;
+    if (heap->lists[fl][sl] == CGL_HEAP_NONE) {
+        heap->sl_bitmap[fl] &= ~(1u << sl);
+        if (heap->sl_bitmap[fl] == 0)
+            heap->fl_bitmap &= ~(1u << fl);
+    }
+}
+
+/* units rounded up to the smallest size of the next class, unless it is the smallest size of its class already */
+static unsigned long cgl_heap_round_up(unsigned long units) {
+    unsigned long step;
+
+    if (units < CGL_HEAP_SL_COUNT)
+        return units;
+    step = 1UL << (cgl_heap_highest_bit(units) - CGL_HEAP_SL_BITS);
+    return (units + step - 1) & ~(step - 1);
+}
+
+/* a free range of at least units, or CGL_HEAP_NONE. The size is rounded up to the next class first,
+ * so that every range of the class found is large enough (good fit, without searching a list) */
+static unsigned int cgl_heap_find_free(CGLBufferHeap *heap, unsigned long units) {
+    unsigned int fl, sl, bits;
+
+    cgl_heap_mapping(cgl_heap_round_up(units), &fl, &sl);
+    if (fl >= CGL_HEAP_FL_COUNT)
+        return CGL_HEAP_NONE;
+    bits = heap->sl_bitmap[fl] & (~0u << sl);
+    if (bits == 0) {
+        bits = fl + 1 < 32 ? heap->fl_bitmap & (~0u << (fl + 1)) : 0;
+        if (bits == 0)
+            return CGL_HEAP_NONE;
+        fl = cgl_heap_lowest_bit(bits);
+        bits = heap->sl_bitmap[fl];
+    }
+    sl = cgl_heap_lowest_bit(bits);
+    return heap->lists[fl][sl];
+}
+
+/* a new entry in ranges, or CGL_HEAP_NONE if there is no memory. May move the array */
+static unsigned int cgl_heap_new_range(CGLBufferHeap *heap) {
+    unsigned int index;
+
+    if (heap->unused_ranges != CGL_HEAP_NONE) {
+        index = heap->unused_ranges;
+        heap->unused_ranges = heap->ranges[index].next;
+        return index;
+    }
+    if (heap->range_count == heap->range_capacity) {
+        unsigned int capacity = heap->range_capacity > 0 ? heap->range_capacity * 2 : 256;
+        CGLHeapRange *ranges = (CGLHeapRange *) realloc(heap->ranges, capacity * sizeof(CGLHeapRange));
+
+        if (ranges == nullptr)
+            return CGL_HEAP_NONE;
+        heap->ranges = ranges;
+        heap->range_capacity = capacity;
+    }
+    return heap->range_count++;
+}
+
+static void cgl_heap_release_range(CGLBufferHeap *heap, unsigned int index) {
+    heap->ranges[index].next = heap->unused_ranges;
+    heap->unused_ranges = index;
+}
+
+/* adds a block that cgl_heap_find_free finds for units, with one free range over all of it; 0 if there is no memory */
+static int cgl_heap_add_block(CGLBufferHeap *heap, unsigned long units) {
+    size_t size = (size_t) cgl_heap_round_up(units) * CGL_HEAP_ALIGNMENT;
+    unsigned int block, index;
+    CGLHeapBlock *blocks;
+    CGLHeapRange *range;
+
+    if (size < heap->block_size)
+        size = heap->block_size;
+    for (block = 0; block < heap->block_count; ++block)
+        if (heap->blocks[block].buffer == 0)
+            break;
+    if (block == heap->block_count) {
+        blocks = (CGLHeapBlock *) realloc(heap->blocks, (heap->block_count + 1) * sizeof(CGLHeapBlock));
+        if (blocks == nullptr)
+            return 0;
+        heap->blocks = blocks;
+        heap->blocks[block].buffer = 0;
+        ++heap->block_count;
+    }
+    index = cgl_heap_new_range(heap);
+    if (index == CGL_HEAP_NONE)
+        return 0;
+    heap->blocks[block].copy = (unsigned char *) malloc(size);
+    if (heap->blocks[block].copy == nullptr) {
+        cgl_heap_release_range(heap, index);
+        return 0;
+    }
+    heap->blocks[block].size = size;
+    heap->blocks[block].first = index;
+    glGenBuffers(1, &heap->blocks[block].buffer);
+    glBindBuffer(heap->target, heap->blocks[block].buffer);
+    glBufferData(heap->target, (GLsizeiptr) size, nullptr, GL_STATIC_DRAW);
+
+    range = &heap->ranges[index];
+    range->offset = 0;
+    range->units = (unsigned long) (size / CGL_HEAP_ALIGNMENT);
+    range->block = block;
+    range->prev = range->next = CGL_HEAP_NONE;
+    cgl_heap_insert_free(heap, index);
+    return 1;
+}
+
+static void cgl_heap_delete_block(CGLBufferHeap *heap, unsigned int block) {
+    glDeleteBuffers(1, &heap->blocks[block].buffer);
+    heap->blocks[block].buffer = 0;
+    free(heap->blocks[block].copy);
+    heap->blocks[block].copy = nullptr;
+}
+
+static CGLHeapHandle cgl_heap_new_handle(CGLBufferHeap *heap, unsigned int index) {
+    CGLHeapHandle handle;
+
+    if (heap->free_handle_count > 0) {
+        handle = heap->free_handles[--heap->free_handle_count];
+    } else {
+        if (heap->handle_count == heap->handle_capacity) {
+            unsigned int capacity = heap->handle_capacity > 0 ? heap->handle_capacity * 2 : 256;
+            unsigned int *handles = (unsigned int *) realloc(heap->handles, capacity * sizeof(unsigned int));
+            unsigned int *free_handles;
+
+            if (handles == nullptr)
+                return 0;
+            heap->handles = handles;
+            free_handles = (unsigned int *) realloc(heap->free_handles, capacity * sizeof(unsigned int));
+            if (free_handles == nullptr)
+                return 0;
+            heap->free_handles = free_handles;
+            heap->handle_capacity = capacity;
+        }
+        handle = ++heap->handle_count;
+    }
+    heap->handles[handle - 1] = index;
+    return handle;
+}
+
+
+CGLBufferHeap *cglCreateBufferHeap(GLenum target, size_t block_size) {
+    CGLBufferHeap *heap = (CGLBufferHeap *) calloc(1, sizeof(CGLBufferHeap));
+    unsigned int fl, sl;
+
+    if (heap == nullptr)
+        return nullptr;
+    heap->target = target;
+    heap->block_size = (block_size + CGL_HEAP_ALIGNMENT - 1) & ~(size_t) (CGL_HEAP_ALIGNMENT - 1);
+    heap->unused_ranges = CGL_HEAP_NONE;
+    for (fl = 0; fl < CGL_HEAP_FL_COUNT; ++fl)
+        for (sl = 0; sl < CGL_HEAP_SL_COUNT; ++sl)
+            heap->lists[fl][sl] = CGL_HEAP_NONE;
+    return heap;
+}
+
+void cglDestroyBufferHeap(CGLBufferHeap *heap) {
+    unsigned int block;
+
+    if (heap == nullptr)
+        return;
+    for (block = 0; block < heap->block_count; ++block)
+        if (heap->blocks[block].buffer != 0)
+            cgl_heap_delete_block(heap, block);
+    free(heap->blocks);
+    free(heap->ranges);
+    free(heap->handles);
+    free(heap->free_handles);
+    free(heap);
+}
+
+CGLHeapHandle cglHeapAlloc(CGLBufferHeap *heap, const void *data, size_t size) {
+    unsigned long units;
+    unsigned int index, rest;
+    CGLHeapRange *range;
+    CGLHeapHandle handle;
+    CGLHeapBlock *block;
+
+    if (size / CGL_HEAP_ALIGNMENT >= CGL_HEAP_MAX_UNITS)
+        return 0;
+    units = (unsigned long) ((size + CGL_HEAP_ALIGNMENT - 1) / CGL_HEAP_ALIGNMENT);
+    if (units == 0)
+        units = 1;
+    index = cgl_heap_find_free(heap, units);
+    if (index == CGL_HEAP_NONE) {
+        if (!cgl_heap_add_block(heap, units))
+            return 0;
+        index = cgl_heap_find_free(heap, units);
+        if (index == CGL_HEAP_NONE)
+            return 0;
+    }
+
+    /* split off the rest first, since new entries may move the array */
+    rest = CGL_HEAP_NONE;
+    if (heap->ranges[index].units > units) {
+        rest = cgl_heap_new_range(heap);
+        if (rest == CGL_HEAP_NONE)
+            return 0;
+    }
+    handle = cgl_heap_new_handle(heap, index);
+    if (handle == 0) {
+        if (rest != CGL_HEAP_NONE)
+            cgl_heap_release_range(heap, rest);
+        return 0;
+    }
+    cgl_heap_remove_free(heap, index);
+    range = &heap->ranges[index];
+    if (rest != CGL_HEAP_NONE) {
+        CGLHeapRange *after = &heap->ranges[rest];
+
+        after->offset = range->offset + (size_t) units * CGL_HEAP_ALIGNMENT;
+        after->units = range->units - units;
+        after->block = range->block;
+        after->prev = index;
+        after->next = range->next;
+        if (range->next != CGL_HEAP_NONE)
+            heap->ranges[range->next].prev = rest;
+        range->next = rest;
+        range->units = units;
+        cgl_heap_insert_free(heap, rest);
+    }
+    range->handle = handle;
+
+    block = &heap->blocks[range->block];
+    if (data != nullptr && size > 0) {
+        memcpy(block->copy + range->offset, data, size);
+        glBindBuffer(heap->target, block->buffer);
+        glBufferSubData(heap->target, (GLintptr) range->offset, (GLsizeiptr) size, data);
+    }
+    return handle;
+}
+
+void cglHeapFree(CGLBufferHeap *heap, CGLHeapHandle handle) {
+    unsigned int index, neighbour;
+    CGLHeapRange *range;
+
+    if (handle == 0)
+        return;
+    index = heap->handles[handle - 1];
+    heap->free_handles[heap->free_handle_count++] = handle;
+    range = &heap->ranges[index];
+
+    /* merge with the free ranges around it */
+    neighbour = range->next;
+    if (neighbour != CGL_HEAP_NONE && heap->ranges[neighbour].handle == 0) {
+        cgl_heap_remove_free(heap, neighbour);
+        range->units += heap->ranges[neighbour].units;
+        range->next = heap->ranges[neighbour].next;
+        if (range->next != CGL_HEAP_NONE)
+            heap->ranges[range->next].prev = index;
+        cgl_heap_release_range(heap, neighbour);
+    }
+    neighbour = range->prev;
+    if (neighbour != CGL_HEAP_NONE && heap->ranges[neighbour].handle == 0) {
+        CGLHeapRange *before = &heap->ranges[neighbour];
+
+        cgl_heap_remove_free(heap, neighbour);
+        before->units += range->units;
+        before->next = range->next;
+        if (range->next != CGL_HEAP_NONE)
+            heap->ranges[range->next].prev = neighbour;
+        cgl_heap_release_range(heap, index);
+        index = neighbour;
+    }
+    cgl_heap_insert_free(heap, index);
+}
+
+void cglHeapLocation(const CGLBufferHeap *heap, CGLHeapHandle handle, GLuint *buffer, GLintptr *offset) {
+    const CGLHeapRange *range = &heap->ranges[heap->handles[handle - 1]];
+
+    *buffer = heap->blocks[range->block].buffer;
+    *offset = (GLintptr) range->offset;
+}
+
+size_t cglDefragmentBufferHeap(CGLBufferHeap *heap) {
+    size_t moved = 0;
+    unsigned int b;
+
+    for (b = 0; b < heap->block_count; ++b) {
+        CGLHeapBlock *block = &heap->blocks[b];
+        unsigned int index = block->first, last = CGL_HEAP_NONE, next, tail;
+        size_t end = 0, first_moved = block->size;
+
+        if (block->buffer == 0)
+            continue;
+        /* slide the allocations down in the copy, dropping the free ranges; there is at least one range */
+        block->first = CGL_HEAP_NONE;
+        for (; index != CGL_HEAP_NONE; index = next) {
+            CGLHeapRange *range = &heap->ranges[index];
+            size_t size = (size_t) range->units * CGL_HEAP_ALIGNMENT;
+
+            next = range->next;
+            if (range->handle == 0) {
+                cgl_heap_remove_free(heap, index);
+                cgl_heap_release_range(heap, index);
+                continue;
+            }
+            if (range->offset != end) {
+                memmove(block->copy + end, block->copy + range->offset, size);
+                if (end < first_moved)
+                    first_moved = end;
+                moved += size;
+                range->offset = end;
+            }
+            range->prev = last;
+            range->next = CGL_HEAP_NONE;
+            if (last != CGL_HEAP_NONE)
+                heap->ranges[last].next = index;
+            else
+                block->first = index;
+            last = index;
+            end += size;
+        }
+
+        if (end == 0) {
+            cgl_heap_delete_block(heap, b);
+            continue;
+        }
+        if (end < block->size) {
+            /* a range was released just before, so this doesn't allocate */
+            tail = cgl_heap_new_range(heap);
+            heap->ranges[tail].offset = end;
+            heap->ranges[tail].units = (unsigned long) ((block->size - end) / CGL_HEAP_ALIGNMENT);
+            heap->ranges[tail].block = b;
+            heap->ranges[tail].prev = last;
+            heap->ranges[tail].next = CGL_HEAP_NONE;
+            heap->ranges[last].next = tail;
+            cgl_heap_insert_free(heap, tail);
+        }
+        if (first_moved < end) {
+            glBindBuffer(heap->target, block->buffer);
+            glBufferSubData(heap->target, (GLintptr) first_moved, (GLsizeiptr) (end - first_moved), block->copy + first_moved);
+        }
+    }
+    heap->moved += moved;
+    return moved;
+}
+
+void cglGetBufferHeapStats(const CGLBufferHeap *heap, CGLBufferHeapStats *stats) {
+    unsigned int b, index;
+
+    memset(stats, 0, sizeof(*stats));
+    for (b = 0; b < heap->block_count; ++b) {
+        if (heap->blocks[b].buffer == 0)
+            continue;
+        ++stats->blocks;
+        stats->capacity += heap->blocks[b].size;
+        for (index = heap->blocks[b].first; index != CGL_HEAP_NONE; index = heap->ranges[index].next) {
+            const CGLHeapRange *range = &heap->ranges[index];
+            size_t size = (size_t) range->units * CGL_HEAP_ALIGNMENT;
+
+            if (range->handle != 0) {
+                stats->used += size;
+                ++stats->allocations;
+            } else {
+                ++stats->free_ranges;
+                if (size > stats->largest_free)
+                    stats->largest_free = size;
+            }
+        }
+    }
+    stats->moved = heap->moved;
+}
@@ -0,0 +1,95 @@
+/*
+ *  Buffer heaps for the common OpenGL subset: many static meshes sub-allocated from a few buffer objects
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLHEAP_H
+#define CGLHEAP_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief alignment of all offsets in a heap, and granularity of the sizes, enough for any vertex or index type */
+#define CGL_HEAP_ALIGNMENT 16
+
+/*! \brief an allocation in a heap, 0 is never a valid handle */
+typedef unsigned int CGLHeapHandle;
+
+/*! \brief a set of GL_STATIC_DRAW buffers, with data of many meshes packed into each
+ *
+ * giving every small mesh its own buffer object costs a glBindBuffer and new attribute pointers for every draw.
+ * A heap places the meshes into a few large buffers ("blocks") instead, so that draws sorted by buffer,
+ * as the render queue does, can skip most binds, and differ only in their offsets.
+ *
+ * The ranges are managed by a two level segregated fit (TLSF) allocator: free ranges are kept in lists by size class,
+ * with bitmaps to find a large enough one in constant time, and are merged with their free neighbours when freed.
+ * Blocks are added as needed, an allocation larger than the block size gets a block of its own.
+ *
+ * The common subset has no glCopyBufferSubData, so the heap keeps a copy of each block in client memory,
+ * which cglDefragmentBufferHeap uses to move allocations together and upload the result with glBufferSubData.
+ * Since that changes offsets, allocations are referred to by handles, to be looked up with cglHeapLocation.
+ */
+typedef struct CGLBufferHeap CGLBufferHeap;
+
+/*! \brief size and fragmentation of a heap */
+typedef struct CGLBufferHeapStats {
+    unsigned int blocks;        /*!< buffer objects */
+    size_t capacity;            /*!< bytes in all blocks */
+    size_t used;                /*!< bytes allocated, each size rounded up to CGL_HEAP_ALIGNMENT */
+    unsigned int allocations;   /*!< live handles */
+    unsigned int free_ranges;   /*!< free ranges in all blocks, more than one per block means fragmentation */
+    size_t largest_free;        /*!< bytes of the largest free range */
+    size_t moved;               /*!< bytes moved by all calls of cglDefragmentBufferHeap */
+} CGLBufferHeapStats;
+
+/*! \brief create an empty heap, no buffer object is made before the first allocation
+ *
+ * \param target     GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER, the target blocks are bound to for uploading
+ * \param block_size size of each buffer object in bytes, e.g. a few MB
+ *
+ * \return the heap, or NULL if there is not enough memory
+ */
+GLAPI CGLBufferHeap *cglCreateBufferHeap(GLenum target, size_t block_size);
+
+/*! \brief delete all buffer objects of the heap and free it, NULL is ignored */
+GLAPI void cglDestroyBufferHeap(CGLBufferHeap *heap);
+
+/*! \brief allocate \ref size bytes and upload \ref data to them
+ *
+ * binds the block of the allocation to the target of the heap.
+ *
+ * \param data the contents, or NULL to leave them undefined
+ *
+ * \return the handle, or 0 if there is not enough memory
+ */
+GLAPI CGLHeapHandle cglHeapAlloc(CGLBufferHeap *heap, const void *data, size_t size);
+
+/*! \brief free an allocation, the handle may be given out again; 0 is ignored */
+GLAPI void cglHeapFree(CGLBufferHeap *heap, CGLHeapHandle handle);
+
+/*! \brief the buffer object and byte offset of an allocation, valid until the next cglDefragmentBufferHeap */
+GLAPI void cglHeapLocation(const CGLBufferHeap *heap, CGLHeapHandle handle, GLuint *buffer, GLintptr *offset);
+
+/*! \brief move the allocations of each block to its start, closing the gaps between them
+ *
+ * each block with gaps is uploaded again with one glBufferSubData from its first moved allocation,
+ * blocks without any allocation left are deleted. Afterwards the offsets of cglHeapLocation must be queried again.
+ *
+ * \return the number of bytes moved
+ */
+GLAPI size_t cglDefragmentBufferHeap(CGLBufferHeap *heap);
+
+/*! \brief fill \ref stats with the current size and fragmentation of \ref heap */
+GLAPI void cglGetBufferHeapStats(const CGLBufferHeap *heap, CGLBufferHeapStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,289 @@
+/*
+ *  Mesh optimization for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cglmesh.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+
+#define CGL_MESH_NONE ((unsigned int) -1)
+
+static int cgl_check_indices(const unsigned int *indices, size_t index_count, size_t vertex_count) {
+    size_t i;
+
+    /* triangles are numbered with unsigned int */
+    if (index_count / 3 >= CGL_MESH_NONE)
+        return 0;
+    for (i = 0; i < index_count; ++i)
+        if (indices[i] >= vertex_count)
+            return 0;
+    return 1;
+}
+
+
+int cglOptimizeVertexCache(unsigned int *indices, size_t index_count, size_t vertex_count, unsigned int cache_size) {
+    size_t *offsets, *cache_time, i, out = 0, top = 0, cursor = 0, time;
+    unsigned int *triangles, *live, *stack, *result, f;
+    unsigned char *emitted;
+    int ok;
+
+    if (index_count % 3 != 0 || !cgl_check_indices(indices, index_count, vertex_count))
+        return 0;
+    if (index_count == 0)
+        return 1;
+    if (cache_size == 0)
+        cache_size = CGL_MESH_DEFAULT_CACHE;
+
+    offsets = (size_t *) malloc((vertex_count + 1) * sizeof(size_t));
+    cache_time = (size_t *) calloc(vertex_count, sizeof(size_t));
+    live = (unsigned int *) calloc(vertex_count, sizeof(unsigned int));
+    triangles = (unsigned int *) malloc(index_count * sizeof(unsigned int));
+    stack = (unsigned int *) malloc(index_count * sizeof(unsigned int));
+    result = (unsigned int *) malloc(index_count * sizeof(unsigned int));
+    emitted = (unsigned char *) calloc(index_count / 3, 1);
+    ok = offsets != nullptr && cache_time != nullptr && live != nullptr && triangles != nullptr && stack != nullptr
+         && result != nullptr && emitted != nullptr;
+
+    if (ok) {
+        /* the triangles around each vertex, as one array with the ranges in offsets;
+         * cache_time serves as the fill position meanwhile */
+        for (i = 0; i < index_count; ++i)
+            ++live[indices[i]];
+        offsets[0] = 0;
+        for (i = 0; i < vertex_count; ++i) {
+            offsets[i + 1] = offsets[i] + live[i];
+            cache_time[i] = offsets[i];
+        }
+        for (i = 0; i < index_count; ++i)
+            triangles[cache_time[indices[i]]++] = (unsigned int) (i / 3);
+        memset(cache_time, 0, vertex_count * sizeof(size_t));
+
+        /* a vertex is in the cache if time - cache_time[v] <= cache_size, time starts above so that none is */
+        time = cache_size + 1;
+        f = indices[0];
+        while (f != CGL_MESH_NONE) {
+            size_t start = top, priority, best_priority = 0, k;
+            unsigned int best = CGL_MESH_NONE;
+
+            for (k = offsets[f]; k < offsets[f + 1]; ++k) {
+                unsigned int t = triangles[k], j;
+
+                if (emitted[t])
+                    continue;
+                emitted[t] = 1;
+                for (j = 0; j < 3; ++j) {
+                    unsigned int v = indices[3 * t + j];
+
+                    result[out++] = v;
+                    stack[top++] = v;
+                    --live[v];
+                    if (time - cache_time[v] > cache_size)
+                        cache_time[v] = time++;
+                }
+            }
+
+            /* the candidates are the vertices just emitted, which are the top of the dead-end stack:
+             * prefer the one longest in the cache that stays in it while its remaining triangles are emitted */
+            for (k = start; k < top; ++k) {
+                unsigned int v = stack[k];
+
+                if (live[v] == 0)
+                    continue;
+                priority = time - cache_time[v] + 2 * live[v] <= cache_size ? time - cache_time[v] : 0;
+                if (best == CGL_MESH_NONE || priority > best_priority) {
+                    best = v;
+                    best_priority = priority;
+                }
+            }
+            while (best == CGL_MESH_NONE && top > 0) {
+                unsigned int v = stack[--top];
+
+                if (live[v] > 0)
+                    best = v;
+            }
+            if (best == CGL_MESH_NONE) {
+                while (cursor < vertex_count && live[cursor] == 0)
+                    ++cursor;
+                if (cursor < vertex_count)
+                    best = (unsigned int) cursor;
+            }
+            f = best;
+        }
+        memcpy(indices, result, index_count * sizeof(unsigned int));
+    }
+
+    free(emitted);
+    free(result);
+    free(stack);
+    free(triangles);
+    free(live);
+    free(cache_time);
+    free(offsets);
+    return ok;
+}
+
+size_t cglOptimizeVertexFetch(void *vertices, size_t vertex_count, size_t vertex_size,
+                              unsigned int *indices, size_t index_count) {
+    unsigned char *bytes = (unsigned char *) vertices, *copy;
+    unsigned int *remap;
+    size_t i, count = 0;
+
+    if (!cgl_check_indices(indices, index_count, vertex_count) || index_count == 0)
+        return 0;
+    remap = (unsigned int *) malloc(vertex_count * sizeof(unsigned int));
+    copy = (unsigned char *) malloc(vertex_count * vertex_size + 1);
+    if (remap == nullptr || copy == nullptr) {
+        free(copy);
+        free(remap);
+        return 0;
+    }
+    memset(remap, 0xff, vertex_count * sizeof(unsigned int));
+    memcpy(copy, vertices, vertex_count * vertex_size);
+
+    for (i = 0; i < index_count; ++i) {
+        unsigned int v = indices[i];
+
+        if (remap[v] == CGL_MESH_NONE) {
+            remap[v] = (unsigned int) count;
+            memcpy(bytes + count * vertex_size, copy + v * vertex_size, vertex_size);
+            ++count;
+        }
+        indices[i] = remap[v];
+    }
+
+    free(copy);
+    free(remap);
+    return count;
+}
+
+float cglAverageCacheMissRatio(const unsigned int *indices, size_t index_count, size_t vertex_count,
+                               unsigned int cache_size) {
+    size_t *cache_time, time, misses = 0, i;
+
+    if (index_count < 3 || !cgl_check_indices(indices, index_count, vertex_count))
+        return 0.0f;
+    if (cache_size == 0)
+        cache_size = CGL_MESH_DEFAULT_CACHE;
+    cache_time = (size_t *) calloc(vertex_count, sizeof(size_t));
+    if (cache_time == nullptr)
+        return 0.0f;
+
+    /* a FIFO: a vertex stays for cache_size misses after its own */
+    time = cache_size + 1;
+    for (i = 0; i < index_count; ++i) {
+        if (time - cache_time[indices[i]] > cache_size) {
+            cache_time[indices[i]] = time++;
+            ++misses;
+        }
+    }
+
+    free(cache_time);
+    return (float) misses / (float) (index_count / 3);
+}
+
+
+/* assigns the triangles to chunks, returns 0 if there is not enough memory */
+static int cgl_split_triangles(CGLMeshSplit *split, const unsigned int *indices, size_t index_count,
+                               unsigned int max_vertices, unsigned int *local, unsigned int *chunk_of) {
+    CGLMeshChunk *chunk = nullptr;
+    unsigned int capacity = 0;
+    size_t i;
+
+    for (i = 0; i < index_count; i += 3) {
+        unsigned int a = indices[i], b = indices[i + 1], c = indices[i + 2], j;
+        unsigned int current = split->chunk_count;
+        size_t added = (chunk_of[a] != current) + (b != a && chunk_of[b] != current)
+                       + (c != a && c != b && chunk_of[c] != current);
+
+        if (chunk == nullptr || chunk->vertex_count + added > max_vertices) {
+            if (split->chunk_count == capacity) {
+                unsigned int grown = capacity > 0 ? capacity * 2 : 4;
+                CGLMeshChunk *chunks = (CGLMeshChunk *) realloc(split->chunks, grown * sizeof(CGLMeshChunk));
+
+                if (chunks == nullptr)
+                    return 0;
+                split->chunks = chunks;
+                capacity = grown;
+            }
+            chunk = &split->chunks[split->chunk_count++];
+            chunk->first_index = i;
+            chunk->index_count = 0;
+            chunk->first_vertex = split->vertex_count;
+            chunk->vertex_count = 0;
+            current = split->chunk_count;
+        }
+        for (j = 0; j < 3; ++j) {
+            unsigned int v = indices[i + j];
+
+            if (chunk_of[v] != current) {
+                chunk_of[v] = current;
+                local[v] = (unsigned int) chunk->vertex_count++;
+                split->vertices[split->vertex_count++] = v;
+            }
+            split->indices[i + j] = (unsigned short) local[v];
+        }
+        chunk->index_count += 3;
+    }
+    return 1;
+}
+
+CGLMeshSplit *cglSplitMesh(const unsigned int *indices, size_t index_count, size_t vertex_count,
+                           unsigned int max_vertices) {
+    CGLMeshSplit *split;
+    unsigned int *local, *chunk_of;
+    int ok;
+
+    if (max_vertices < 3 || max_vertices > CGL_MESH_MAX_VERTICES || index_count % 3 != 0
+        || !cgl_check_indices(indices, index_count, vertex_count))
+        return nullptr;
+    split = (CGLMeshSplit *) calloc(1, sizeof(CGLMeshSplit));
+    if (split == nullptr)
+        return nullptr;
+    split->indices = (unsigned short *) malloc(index_count * sizeof(unsigned short) + 1);
+    split->vertices = (unsigned int *) malloc(index_count * sizeof(unsigned int) + 1);
+    /* the index of each vertex in the chunk it was last added to, and that chunk, numbered from 1 */
+    local = (unsigned int *) malloc(vertex_count * sizeof(unsigned int) + 1);
+    chunk_of = (unsigned int *) calloc(vertex_count + 1, sizeof(unsigned int));
+    ok = split->indices != nullptr && split->vertices != nullptr && local != nullptr && chunk_of != nullptr
+         && cgl_split_triangles(split, indices, index_count, max_vertices, local, chunk_of);
+    free(chunk_of);
+    free(local);
+    if (!ok) {
+        cglDestroyMeshSplit(split);
+        return nullptr;
+    }
+
+    if (split->vertex_count > 0) {
+        unsigned int *vertices = (unsigned int *) realloc(split->vertices, split->vertex_count * sizeof(unsigned int));
+
+        if (vertices != nullptr)
+            split->vertices = vertices;
+    }
+    return split;
+}
+
+void cglDestroyMeshSplit(CGLMeshSplit *split) {
+    if (split == nullptr)
+        return;
+    free(split->chunks);
+    free(split->vertices);
+    free(split->indices);
+    free(split);
+}
+
+void cglGatherVertices(const CGLMeshSplit *split, const void *vertices, size_t vertex_size, void *out) {
+    const unsigned char *in = (const unsigned char *) vertices;
+    unsigned char *bytes = (unsigned char *) out;
+    size_t i;
+
+    for (i = 0; i < split->vertex_count; ++i)
+        memcpy(bytes + i * vertex_size, in + split->vertices[i] * vertex_size, vertex_size);
+}
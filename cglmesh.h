@@ -0,0 +1,117 @@
+/*
+ *  Mesh optimization for the common OpenGL subset: triangle and vertex order, and 16-bit index chunks
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLMESH_H
+#define CGLMESH_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief vertices a chunk of cglSplitMesh can have at most, all GL_UNSIGNED_SHORT indices */
+#define CGL_MESH_MAX_VERTICES 65536
+
+/*! \brief default cache size for cglOptimizeVertexCache, a little below what most GPUs reuse from */
+#define CGL_MESH_DEFAULT_CACHE 16
+
+/*! \brief reorder the triangles of an indexed triangle list for the post-transform vertex cache
+ *
+ * uses the Tipsify algorithm (Sander, Nehab and Barczak, 2007): it emits all triangles around one vertex at a time,
+ * and continues with the neighbouring vertex that is still in the simulated cache and will stay there
+ * while its remaining triangles are emitted, or else with a recently used vertex that has triangles left.
+ * It runs in time linear in the number of triangles, about a third of a second per million triangles.
+ * The vertices are not changed, run cglOptimizeVertexFetch afterwards to make their order follow.
+ *
+ * \param indices      \ref index_count indices, 3 per triangle, reordered in place
+ * \param vertex_count larger than every index
+ * \param cache_size   vertices of the simulated cache, 0 for CGL_MESH_DEFAULT_CACHE
+ *
+ * \return 1, or 0 if \ref index_count is not a multiple of 3, an index is out of range, or there is not enough memory
+ */
+GLAPI int cglOptimizeVertexCache(unsigned int *indices, size_t index_count, size_t vertex_count,
+                                 unsigned int cache_size);
+
+/*! \brief reorder the vertices in the order the indices first use them, and remap the indices
+ *
+ * so that the vertex fetch reads the buffer mostly sequentially. Vertices no index refers to are dropped.
+ *
+ * \param vertices     \ref vertex_count vertices of \ref vertex_size bytes each, reordered in place
+ * \param indices      remapped in place
+ *
+ * \return the number of vertices left, or 0 if an index is out of range or there is not enough memory
+ */
+GLAPI size_t cglOptimizeVertexFetch(void *vertices, size_t vertex_count, size_t vertex_size,
+                                    unsigned int *indices, size_t index_count);
+
+/*! \brief the average cache miss ratio, vertex shader invocations per triangle with a FIFO cache of \ref cache_size
+ *
+ * between 0.5 for the best possible order of large meshes and 3, for comparing orders and cache sizes.
+ *
+ * \return the ratio, or 0 if there are no triangles or there is not enough memory
+ */
+GLAPI float cglAverageCacheMissRatio(const unsigned int *indices, size_t index_count, size_t vertex_count,
+                                     unsigned int cache_size);
+
+/*! \brief part of a split mesh, drawable with one glDrawElements of GL_UNSIGNED_SHORT indices */
+typedef struct CGLMeshChunk {
+    size_t first_index;     /*!< into \ref CGLMeshSplit::indices */
+    size_t index_count;
+    size_t first_vertex;    /*!< into \ref CGLMeshSplit::vertices, where the chunk's vertex 0 is */
+    size_t vertex_count;    /*!< at most the max_vertices given to cglSplitMesh */
+} CGLMeshChunk;
+
+/*! \brief a mesh split into chunks with 16-bit indices
+ *
+ * GL ES 2.0 only guarantees GL_UNSIGNED_BYTE and GL_UNSIGNED_SHORT indices, and has no base vertex for draws,
+ * so each chunk has its own vertices, which \ref vertices maps to the vertices of the original mesh, and
+ * indices relative to its first vertex. cglGatherVertices builds the vertex data from it. To draw chunk c,
+ * point the attributes at c.first_vertex * stride, e.g. by adding it to the offsets of the layout
+ * given to cglCreateVertexFormat, then glDrawElements(GL_TRIANGLES, c.index_count, GL_UNSIGNED_SHORT,
+ * (const void *) (c.first_index * 2)).
+ */
+typedef struct CGLMeshSplit {
+    unsigned short *indices;    /*!< as many as given to cglSplitMesh, in the same triangle order */
+    unsigned int *vertices;     /*!< the original vertex of each vertex of the chunks */
+    size_t vertex_count;        /*!< elements of \ref vertices */
+    CGLMeshChunk *chunks;
+    unsigned int chunk_count;
+} CGLMeshSplit;
+
+/*! \brief split an indexed triangle list into chunks of at most \ref max_vertices vertices
+ *
+ * the triangles are taken in order, and a new chunk is started when the next one would have too many vertices,
+ * so a mesh already optimized by cglOptimizeVertexCache keeps its locality. The vertices of each chunk
+ * are numbered in the order of first use, which is the order of cglOptimizeVertexFetch. A mesh with few enough
+ * vertices becomes a single chunk, with indices only converted to 16 bit.
+ *
+ * \param max_vertices at most CGL_MESH_MAX_VERTICES, at least 3, e.g. 256 to draw with GL_UNSIGNED_BYTE indices
+ *                     after narrowing them
+ *
+ * \return the split mesh, to be freed by cglDestroyMeshSplit, or NULL if \ref index_count is not a multiple of 3,
+ *         an index is out of range, \ref max_vertices is invalid, or there is not enough memory
+ */
+GLAPI CGLMeshSplit *cglSplitMesh(const unsigned int *indices, size_t index_count, size_t vertex_count,
+                                 unsigned int max_vertices);
+
+/*! \brief free a split mesh, NULL is ignored */
+GLAPI void cglDestroyMeshSplit(CGLMeshSplit *split);
+
+/*! \brief copy the vertices of the original mesh into the order of \ref split
+ *
+ * \param vertices    the original vertices, \ref vertex_size bytes each
+ * \param out         split->vertex_count * vertex_size bytes
+ */
+GLAPI void cglGatherVertices(const CGLMeshSplit *split, const void *vertices, size_t vertex_size, void *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ *  Buffer mirrors for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cglmirror.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+
+typedef struct CGLDirtyRange {
+    size_t begin;
+    size_t end;
+} CGLDirtyRange;
+
+/* the changed ranges are appended as they come, and only sorted and merged when the array is full
+ * or flushed; a write right after the last one extends it, which covers sequential writes */
+struct CGLBufferMirror {
+    GLenum target;
+    GLuint buffer;
+    size_t size;
+    size_t gap;
+    unsigned char *copy;
+    CGLDirtyRange *ranges;
+    unsigned int count;
+    unsigned int capacity;
+    CGLBufferMirrorStats stats;
+};
+
+
+static int cgl_compare_ranges(const void *a, const void *b) {
+    const CGLDirtyRange *x = (const CGLDirtyRange *) a;
+    const CGLDirtyRange *y = (const CGLDirtyRange *) b;
+
+    return x->begin < y->begin ? -1 : x->begin > y->begin;
+}
+
+/* sorts the ranges and merges all that are at most the gap apart */
+static void cgl_mirror_coalesce(CGLBufferMirror *mirror) {
+    CGLDirtyRange *ranges = mirror->ranges;
+    unsigned int i, count = 0;
+
+    if (mirror->count < 2)
+        return;
+    qsort(ranges, mirror->count, sizeof(CGLDirtyRange), cgl_compare_ranges);
+    for (i = 1; i < mirror->count; ++i) {
+        if (ranges[i].begin <= ranges[count].end || ranges[i].begin - ranges[count].end <= mirror->gap) {
+            if (ranges[i].end > ranges[count].end)
+                ranges[count].end = ranges[i].end;
+        } else {
+            ranges[++count] = ranges[i];
+        }
+    }
+    mirror->count = count + 1;
+}
+
+static int cgl_mirror_mark(CGLBufferMirror *mirror, size_t offset, size_t size) {
+    CGLDirtyRange *last = mirror->count > 0 ? &mirror->ranges[mirror->count - 1] : nullptr;
+
+    ++mirror->stats.writes;
+    if (size == 0)
+        return 1;
+    if (last != nullptr && offset >= last->begin && offset <= last->end) {
+        if (offset + size > last->end)
+            last->end = offset + size;
+        return 1;
+    }
+    if (mirror->count == mirror->capacity) {
+        cgl_mirror_coalesce(mirror);
+        /* grow if merging didn't free at least a quarter */
+        if (mirror->count >= mirror->capacity / 4 * 3) {
+            unsigned int capacity = mirror->capacity > 0 ? mirror->capacity * 2 : 64;
+            CGLDirtyRange *ranges = (CGLDirtyRange *) realloc(mirror->ranges, capacity * sizeof(CGLDirtyRange));
+
+            if (ranges == nullptr && mirror->count == mirror->capacity)
+                return 0;
+            if (ranges != nullptr) {
+                mirror->ranges = ranges;
+                mirror->capacity = capacity;
+            }
+        }
+    }
+    mirror->ranges[mirror->count].begin = offset;
+    mirror->ranges[mirror->count].end = offset + size;
+    ++mirror->count;
+    return 1;
+}
+
+
+CGLBufferMirror *cglCreateBufferMirror(GLenum target, size_t size, const void *data, GLenum usage) {
+    CGLBufferMirror *mirror = (CGLBufferMirror *) calloc(1, sizeof(CGLBufferMirror));
+
+    if (mirror == nullptr)
+        return nullptr;
+    mirror->copy = (unsigned char *) calloc(size + 1, 1);
+    if (mirror->copy == nullptr) {
+        free(mirror);
+        return nullptr;
+    }
+    if (data != nullptr && size > 0)
+        memcpy(mirror->copy, data, size);
+    mirror->target = target;
+    mirror->size = size;
+    mirror->gap = CGL_MIRROR_DEFAULT_GAP;
+    glGenBuffers(1, &mirror->buffer);
+    glBindBuffer(target, mirror->buffer);
+    glBufferData(target, (GLsizeiptr) size, mirror->copy, usage);
+    return mirror;
+}
+
+void cglDestroyBufferMirror(CGLBufferMirror *mirror) {
+    if (mirror == nullptr)
+        return;
+    glDeleteBuffers(1, &mirror->buffer);
+    free(mirror->ranges);
+    free(mirror->copy);
+    free(mirror);
+}
+
+GLuint cglBufferMirrorName(const CGLBufferMirror *mirror) {
+    return mirror->buffer;
+}
+
+const void *cglBufferMirrorData(const CGLBufferMirror *mirror) {
+    return mirror->copy;
+}
+
+void cglSetBufferMirrorGap(CGLBufferMirror *mirror, size_t gap) {
+    mirror->gap = gap;
+}
+
+void *cglMapBufferMirror(CGLBufferMirror *mirror, size_t offset, size_t size) {
+    if (offset > mirror->size || size > mirror->size - offset || !cgl_mirror_mark(mirror, offset, size))
+        return nullptr;
+    return mirror->copy + offset;
+}
+
+int cglWriteBufferMirror(CGLBufferMirror *mirror, size_t offset, const void *data, size_t size) {
+    void *memory = cglMapBufferMirror(mirror, offset, size);
+
+    if (memory == nullptr)
+        return 0;
+    if (size > 0)
+        memcpy(memory, data, size);
+    return 1;
+}
+
+unsigned int cglFlushBufferMirror(CGLBufferMirror *mirror) {
+    unsigned int i, uploads;
+
+    if (mirror->count == 0)
+        return 0;
+    cgl_mirror_coalesce(mirror);
+    glBindBuffer(mirror->target, mirror->buffer);
+    for (i = 0; i < mirror->count; ++i) {
+        const CGLDirtyRange *range = &mirror->ranges[i];
+
+        glBufferSubData(mirror->target, (GLintptr) range->begin, (GLsizeiptr) (range->end - range->begin),
+                        mirror->copy + range->begin);
+        mirror->stats.bytes += range->end - range->begin;
+    }
+    uploads = mirror->count;
+    mirror->stats.uploads += uploads;
+    ++mirror->stats.flushes;
+    mirror->count = 0;
+    return uploads;
+}
+
+const CGLBufferMirrorStats *cglGetBufferMirrorStats(const CGLBufferMirror *mirror) {
+    return &mirror->stats;
+}
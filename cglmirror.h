@@ -0,0 +1,92 @@
+/*
+ *  Buffer mirrors for the common OpenGL subset: sparse updates of dynamic buffers, uploaded together
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLMIRROR_H
+#define CGLMIRROR_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief default of cglSetBufferMirrorGap, in bytes */
+#define CGL_MIRROR_DEFAULT_GAP 512
+
+/*! \brief counters of a buffer mirror since it was created */
+typedef struct CGLBufferMirrorStats {
+    unsigned long writes;   /*!< calls of cglWriteBufferMirror and cglMapBufferMirror */
+    unsigned long flushes;  /*!< calls of cglFlushBufferMirror that had something to upload */
+    unsigned long uploads;  /*!< glBufferSubData calls */
+    size_t bytes;           /*!< bytes uploaded, including the unchanged gaps uploaded with the ranges around them */
+} CGLBufferMirrorStats;
+
+/*! \brief a buffer object with a copy in client memory, and the ranges changed since the last upload
+ *
+ * for data that is changed in many small places by different writers, e.g. per instance data:
+ * the writes only go to the copy, and are remembered as byte ranges. cglFlushBufferMirror then sorts them,
+ * merges the ones that overlap, touch, or are at most the gap apart, and uploads each merged range
+ * with one glBufferSubData, so hundreds of small writes become a few calls. Uploading the unchanged bytes
+ * between two ranges is usually cheaper than the overhead of another call, cglSetBufferMirrorGap tunes this.
+ */
+typedef struct CGLBufferMirror CGLBufferMirror;
+
+/*! \brief create a buffer object of \ref size bytes and its copy
+ *
+ * the buffer is specified by glBufferData with \ref data, the copy made from it.
+ *
+ * \param target GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER, the buffer is bound to it when it is created and flushed
+ * \param size   in bytes
+ * \param data   the initial contents, or NULL for zeroes
+ * \param usage  usage hint for glBufferData, usually GL_DYNAMIC_DRAW
+ *
+ * \return the mirror, or NULL if there is not enough memory
+ */
+GLAPI CGLBufferMirror *cglCreateBufferMirror(GLenum target, size_t size, const void *data, GLenum usage);
+
+/*! \brief delete the buffer object and free the mirror, NULL is ignored */
+GLAPI void cglDestroyBufferMirror(CGLBufferMirror *mirror);
+
+/*! \brief the name of the buffer object, to bind it for drawing */
+GLAPI GLuint cglBufferMirrorName(const CGLBufferMirror *mirror);
+
+/*! \brief the copy of the contents, including the changes not uploaded yet */
+GLAPI const void *cglBufferMirrorData(const CGLBufferMirror *mirror);
+
+/*! \brief set the largest gap in bytes between two changed ranges for them to be uploaded in one call, 0 to merge only
+ * ranges that overlap or touch */
+GLAPI void cglSetBufferMirrorGap(CGLBufferMirror *mirror, size_t gap);
+
+/*! \brief copy \ref size bytes of \ref data to \ref offset in the copy and remember the range for upload
+ *
+ * \return 1, or 0 if the range doesn't fit into the buffer, or there is not enough memory to remember it
+ */
+GLAPI int cglWriteBufferMirror(CGLBufferMirror *mirror, size_t offset, const void *data, size_t size);
+
+/*! \brief like cglWriteBufferMirror, but returns the memory of the range in the copy to write to directly
+ *
+ * \return the memory, valid until the next flush, or NULL if cglWriteBufferMirror would have returned 0
+ */
+GLAPI void *cglMapBufferMirror(CGLBufferMirror *mirror, size_t offset, size_t size);
+
+/*! \brief upload the changed ranges, with as few glBufferSubData calls as the gap allows
+ *
+ * to be called before the draws using the buffer. Binds the buffer to its target if there is anything to upload.
+ *
+ * \return the number of glBufferSubData calls made
+ */
+GLAPI unsigned int cglFlushBufferMirror(CGLBufferMirror *mirror);
+
+/*! \brief the counters of the mirror */
+GLAPI const CGLBufferMirrorStats *cglGetBufferMirrorStats(const CGLBufferMirror *mirror);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
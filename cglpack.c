@@ -0,0 +1,382 @@
+/*
+ *  Vertex packing for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cglpack.h>
+#include <string.h>
+
+#ifndef CGL_NO_SIMD
+#if defined(__AVX2__)
+#define CGL_PACK_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CGL_PACK_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CGL_PACK_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+/* a multiply and add contracted into a fused one rounds once instead of twice, and would make the portable
+ * code and the kernels, or the kernels and the elements after their loops, round differently */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract (off)
+#endif
+
+
+/* vertices converted at a time, so that the temporary arrays stay in L1 */
+#define CGL_PACK_CHUNK 256
+
+/* how the normalized encodings quantize: c = round(clamp(x * a + b, low, 1) * scale), rounding half away from 0
+ * in all kernels, so that they give the same result as the portable code */
+typedef struct CGLQuantizer {
+    float a;
+    float b;
+    float low;
+    float scale;
+    unsigned int encoding;
+} CGLQuantizer;
+
+
+static unsigned int cgl_pack_out_components(const CGLPackAttrib *attrib) {
+    return attrib->encoding == CGL_PACK_OCTAHEDRAL16 || attrib->encoding == CGL_PACK_OCTAHEDRAL8 ? 2 : attrib->components;
+}
+
+/* bytes of one component, 0 for invalid attributes */
+static size_t cgl_pack_component_size(const CGLPackAttrib *attrib) {
+    if (attrib->components < 1 || attrib->components > 4)
+        return 0;
+    switch (attrib->encoding) {
+    case CGL_PACK_FLOAT:
+        return 4;
+    case CGL_PACK_SNORM16: case CGL_PACK_UNORM16:
+        return 2;
+    case CGL_PACK_SNORM8: case CGL_PACK_UNORM8:
+        return 1;
+    case CGL_PACK_OCTAHEDRAL16:
+        return attrib->components == 3 ? 2 : 0;
+    case CGL_PACK_OCTAHEDRAL8:
+        return attrib->components == 3 ? 1 : 0;
+    }
+    return 0;
+}
+
+static GLenum cgl_pack_type(unsigned int encoding) {
+    switch (encoding) {
+    case CGL_PACK_SNORM16: case CGL_PACK_OCTAHEDRAL16:
+        return GL_SHORT;
+    case CGL_PACK_UNORM16:
+        return GL_UNSIGNED_SHORT;
+    case CGL_PACK_SNORM8: case CGL_PACK_OCTAHEDRAL8:
+        return GL_BYTE;
+    case CGL_PACK_UNORM8:
+        return GL_UNSIGNED_BYTE;
+    }
+    return GL_FLOAT;
+}
+
+static void cgl_pack_quantizer(const CGLPackAttrib *attrib, CGLQuantizer *q) {
+    int is_signed = attrib->encoding != CGL_PACK_UNORM16 && attrib->encoding != CGL_PACK_UNORM8;
+    float range = attrib->max - attrib->min;
+
+    q->encoding = attrib->encoding;
+    if (attrib->encoding == CGL_PACK_OCTAHEDRAL16)
+        q->encoding = CGL_PACK_SNORM16;
+    if (attrib->encoding == CGL_PACK_OCTAHEDRAL8)
+        q->encoding = CGL_PACK_SNORM8;
+    q->low = is_signed ? -1.0f : 0.0f;
+    switch (q->encoding) {
+    case CGL_PACK_SNORM16: q->scale = 32767.0f; break;
+    case CGL_PACK_UNORM16: q->scale = 65535.0f; break;
+    case CGL_PACK_SNORM8:  q->scale = 127.0f; break;
+    default:               q->scale = 255.0f; break;
+    }
+    if ((attrib->min == 0.0f && attrib->max == 0.0f) || q->encoding != attrib->encoding) {
+        q->a = 1.0f;
+        q->b = 0.0f;
+    } else if (range == 0.0f) {
+        q->a = q->b = 0.0f;
+    } else if (is_signed) {
+        q->a = 2.0f / range;
+        q->b = -(attrib->max + attrib->min) / range;
+    } else {
+        q->a = 1.0f / range;
+        q->b = -attrib->min / range;
+    }
+}
+
+
+/* the portable kernel, also used for the elements left after the SIMD loops */
+static void cgl_quantize_scalar(const CGLQuantizer *q, const float *in, size_t begin, size_t n, void *out) {
+    size_t i;
+
+    for (i = begin; i < n; ++i) {
+        float x = in[i] * q->a + q->b;
+        long c;
+
+        /* written so that NaN gives low, as the max instructions of the kernels do */
+        if (!(x >= q->low))
+            x = q->low;
+        if (x > 1.0f)
+            x = 1.0f;
+        x *= q->scale;
+        c = (long) (x < 0.0f ? x - 0.5f : x + 0.5f);
+        switch (q->encoding) {
+        case CGL_PACK_SNORM16: ((short *) out)[i] = (short) c; break;
+        case CGL_PACK_UNORM16: ((unsigned short *) out)[i] = (unsigned short) c; break;
+        case CGL_PACK_SNORM8:  ((signed char *) out)[i] = (signed char) c; break;
+        default:               ((unsigned char *) out)[i] = (unsigned char) c; break;
+        }
+    }
+}
+
+#if defined(CGL_PACK_AVX2)
+
+static __m256i cgl_quantize8_avx2(const CGLQuantizer *q, const float *in) {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 x = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(in), _mm256_set1_ps(q->a)), _mm256_set1_ps(q->b));
+
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(q->low)), _mm256_set1_ps(1.0f));
+    x = _mm256_mul_ps(x, _mm256_set1_ps(q->scale));
+    x = _mm256_add_ps(x, _mm256_or_ps(_mm256_and_ps(x, sign), _mm256_set1_ps(0.5f)));
+    return _mm256_cvttps_epi32(x);
+}
+
+static void cgl_quantize(const CGLQuantizer *q, const float *in, size_t n, void *out) {
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m256i lo = cgl_quantize8_avx2(q, in + i), hi = cgl_quantize8_avx2(q, in + i + 8), v;
+
+        /* the packs work within 128-bit lanes, the permute puts the 64-bit quarters back in order */
+        if (q->encoding == CGL_PACK_UNORM16 || q->encoding == CGL_PACK_UNORM8)
+            v = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xd8);
+        else
+            v = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xd8);
+        switch (q->encoding) {
+        case CGL_PACK_SNORM16: case CGL_PACK_UNORM16:
+            _mm256_storeu_si256((__m256i *) ((short *) out + i), v);
+            break;
+        case CGL_PACK_SNORM8:
+            _mm_storeu_si128((__m128i *) ((signed char *) out + i),
+                             _mm_packs_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+            break;
+        default:
+            _mm_storeu_si128((__m128i *) ((unsigned char *) out + i),
+                             _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+            break;
+        }
+    }
+    cgl_quantize_scalar(q, in, i, n, out);
+}
+
+#elif defined(CGL_PACK_SSE2)
+
+static __m128i cgl_quantize4_sse2(const CGLQuantizer *q, const float *in) {
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in), _mm_set1_ps(q->a)), _mm_set1_ps(q->b));
+
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(q->low)), _mm_set1_ps(1.0f));
+    x = _mm_mul_ps(x, _mm_set1_ps(q->scale));
+    x = _mm_add_ps(x, _mm_or_ps(_mm_and_ps(x, sign), _mm_set1_ps(0.5f)));
+    return _mm_cvttps_epi32(x);
+}
+
+static void cgl_quantize(const CGLQuantizer *q, const float *in, size_t n, void *out) {
+    const __m128i bias = _mm_set1_epi32(32768);
+    const __m128i flip = _mm_set1_epi16((short) 0x8000);
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        __m128i lo = cgl_quantize4_sse2(q, in + i), hi = cgl_quantize4_sse2(q, in + i + 4), v;
+
+        switch (q->encoding) {
+        case CGL_PACK_SNORM16:
+            _mm_storeu_si128((__m128i *) ((short *) out + i), _mm_packs_epi32(lo, hi));
+            break;
+        case CGL_PACK_UNORM16:
+            /* SSE2 has no unsigned saturating pack from 32 bits: shift to signed and back */
+            v = _mm_packs_epi32(_mm_sub_epi32(lo, bias), _mm_sub_epi32(hi, bias));
+            _mm_storeu_si128((__m128i *) ((unsigned short *) out + i), _mm_xor_si128(v, flip));
+            break;
+        case CGL_PACK_SNORM8:
+            v = _mm_packs_epi32(lo, hi);
+            _mm_storel_epi64((__m128i *) ((signed char *) out + i), _mm_packs_epi16(v, v));
+            break;
+        default:
+            v = _mm_packs_epi32(lo, hi);
+            _mm_storel_epi64((__m128i *) ((unsigned char *) out + i), _mm_packus_epi16(v, v));
+            break;
+        }
+    }
+    cgl_quantize_scalar(q, in, i, n, out);
+}
+
+#elif defined(CGL_PACK_NEON)
+
+static int32x4_t cgl_quantize4_neon(const CGLQuantizer *q, const float *in) {
+    float32x4_t x = vmlaq_n_f32(vdupq_n_f32(q->b), vld1q_f32(in), q->a), low = vdupq_n_f32(q->low);
+    uint32x4_t negative;
+
+    /* unlike the x86 max, vmaxq_f32 keeps NaN: replace it by low first */
+    x = vbslq_f32(vceqq_f32(x, x), x, low);
+    x = vminq_f32(vmaxq_f32(x, low), vdupq_n_f32(1.0f));
+    x = vmulq_n_f32(x, q->scale);
+    negative = vcltq_f32(x, vdupq_n_f32(0.0f));
+    x = vaddq_f32(x, vbslq_f32(negative, vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f)));
+    return vcvtq_s32_f32(x);
+}
+
+static void cgl_quantize(const CGLQuantizer *q, const float *in, size_t n, void *out) {
+    size_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        int32x4_t lo = cgl_quantize4_neon(q, in + i), hi = cgl_quantize4_neon(q, in + i + 4);
+
+        switch (q->encoding) {
+        case CGL_PACK_SNORM16:
+            vst1q_s16((int16_t *) out + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+            break;
+        case CGL_PACK_UNORM16:
+            vst1q_u16((uint16_t *) out + i, vcombine_u16(vqmovun_s32(lo), vqmovun_s32(hi)));
+            break;
+        case CGL_PACK_SNORM8:
+            vst1_s8((int8_t *) out + i, vqmovn_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi))));
+            break;
+        default:
+            vst1_u8((uint8_t *) out + i, vqmovun_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi))));
+            break;
+        }
+    }
+    cgl_quantize_scalar(q, in, i, n, out);
+}
+
+#else
+
+static void cgl_quantize(const CGLQuantizer *q, const float *in, size_t n, void *out) {
+    cgl_quantize_scalar(q, in, 0, n, out);
+}
+
+#endif
+
+
+/* octahedral encoding of n vectors: projected onto the octahedron |x| + |y| + |z| = 1,
+ * with the lower half folded over the diagonals onto the outer triangles of the square */
+static void cgl_octahedral(const float *in, size_t stride, size_t n, float *out) {
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        const float *v = (const float *) ((const unsigned char *) in + i * stride);
+        float ax = v[0] < 0.0f ? -v[0] : v[0], ay = v[1] < 0.0f ? -v[1] : v[1], az = v[2] < 0.0f ? -v[2] : v[2];
+        float l1 = ax + ay + az, x, y;
+
+        if (l1 == 0.0f) {
+            out[2 * i] = out[2 * i + 1] = 0.0f;
+            continue;
+        }
+        x = v[0] / l1;
+        y = v[1] / l1;
+        if (v[2] < 0.0f) {
+            float fx = (1.0f - ay / l1) * (x >= 0.0f ? 1.0f : -1.0f);
+            float fy = (1.0f - ax / l1) * (y >= 0.0f ? 1.0f : -1.0f);
+
+            x = fx;
+            y = fy;
+        }
+        out[2 * i] = x;
+        out[2 * i + 1] = y;
+    }
+}
+
+
+size_t cglPackedVertexSize(const CGLPackAttrib *attribs, unsigned int count) {
+    size_t stride = 0;
+    unsigned int i;
+
+    for (i = 0; i < count; ++i) {
+        size_t size = cgl_pack_component_size(&attribs[i]);
+
+        if (size == 0)
+            return 0;
+        stride += (size * cgl_pack_out_components(&attribs[i]) + 3) & ~(size_t) 3;
+    }
+    return stride;
+}
+
+size_t cglPackVertices(const CGLPackAttrib *attribs, unsigned int count, size_t vertices, void *out,
+                       CGLVertexAttrib *layout) {
+    float floats[CGL_PACK_CHUNK * 4];
+    unsigned char packed[CGL_PACK_CHUNK * 4 * 2];
+    unsigned char *bytes = (unsigned char *) out;
+    size_t stride = cglPackedVertexSize(attribs, count), offset = 0;
+    unsigned int i;
+
+    if (stride == 0)
+        return 0;
+    for (i = 0; i < count; ++i)
+        if ((cgl_pack_component_size(&attribs[i]) * cgl_pack_out_components(&attribs[i])) % 4 != 0)
+            break;
+    if (i < count)
+        memset(out, 0, stride * vertices);
+
+    for (i = 0; i < count; ++i) {
+        const CGLPackAttrib *attrib = &attribs[i];
+        unsigned int components = cgl_pack_out_components(attrib);
+        size_t element = cgl_pack_component_size(attrib) * components;
+        size_t source_stride = attrib->source_stride != 0 ? attrib->source_stride : attrib->components * sizeof(float);
+        int octahedral = attrib->encoding == CGL_PACK_OCTAHEDRAL16 || attrib->encoding == CGL_PACK_OCTAHEDRAL8;
+        CGLQuantizer q;
+        size_t start;
+
+        cgl_pack_quantizer(attrib, &q);
+        for (start = 0; start < vertices; start += CGL_PACK_CHUNK) {
+            size_t n = vertices - start < CGL_PACK_CHUNK ? vertices - start : CGL_PACK_CHUNK;
+            const unsigned char *source = (const unsigned char *) attrib->source + start * source_stride;
+            const float *in = (const float *) source;
+            size_t v;
+
+            /* the kernels take contiguous floats: encode or gather into floats first if needed */
+            if (octahedral) {
+                cgl_octahedral(in, source_stride, n, floats);
+                in = floats;
+            } else if (source_stride != components * sizeof(float)) {
+                for (v = 0; v < n; ++v)
+                    memcpy(floats + v * components, source + v * source_stride, components * sizeof(float));
+                in = floats;
+            }
+
+            if (attrib->encoding == CGL_PACK_FLOAT) {
+                for (v = 0; v < n; ++v)
+                    memcpy(bytes + (start + v) * stride + offset, in + v * components, element);
+                continue;
+            }
+            cgl_quantize(&q, in, n * components, packed);
+            for (v = 0; v < n; ++v)
+                memcpy(bytes + (start + v) * stride + offset, packed + v * element, element);
+        }
+
+        if (layout != nullptr) {
+            layout[i].index = attrib->index;
+            layout[i].size = (GLint) components;
+            layout[i].type = cgl_pack_type(attrib->encoding);
+            layout[i].normalized = attrib->encoding != CGL_PACK_FLOAT ? GL_TRUE : GL_FALSE;
+            layout[i].stride = (GLsizei) stride;
+            layout[i].offset = (GLintptr) offset;
+            layout[i].buffer = 0;
+        }
+        offset += (element + 3) & ~(size_t) 3;
+    }
+    return stride;
+}
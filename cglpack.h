@@ -0,0 +1,82 @@
+/*
+ *  Vertex packing for the common OpenGL subset: float arrays quantized and interleaved for upload
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLPACK_H
+#define CGLPACK_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \name encodings of a packed attribute
+ *
+ * the normalized encodings map [min, max] of CGLPackAttrib to [-1, 1] (SNORM) or [0, 1] (UNORM), clamp,
+ * and round to the nearest integer, so c = round(x * 32767) for CGL_PACK_SNORM16. That is the conversion of GL 4.2
+ * and later; GL 2.1 and GL ES 2.0 decode with (2c + 1) / 65535, which differs by at most half a step.
+ * NaN gives the lower end, -1 or 0, with the SIMD kernels and the portable code alike.
+ */
+/*!@{*/
+#define CGL_PACK_FLOAT          0   /*!< GL_FLOAT, copied */
+#define CGL_PACK_SNORM16        1   /*!< GL_SHORT, normalized */
+#define CGL_PACK_UNORM16        2   /*!< GL_UNSIGNED_SHORT, normalized, e.g. texture coordinates in [0, 1] */
+#define CGL_PACK_SNORM8         3   /*!< GL_BYTE, normalized */
+#define CGL_PACK_UNORM8         4   /*!< GL_UNSIGNED_BYTE, normalized, e.g. colors */
+/*! 3 components of a unit vector, e.g. a normal, octahedral encoded into 2 GL_SHORT, normalized.
+ * Decoded in GLSL by
+ *      vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+ *      if (n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+ *      n = normalize(n);
+ */
+#define CGL_PACK_OCTAHEDRAL16   5
+#define CGL_PACK_OCTAHEDRAL8    6   /*!< like CGL_PACK_OCTAHEDRAL16, into 2 GL_BYTE */
+/*!@}*/
+
+/*! \brief one attribute to pack, from an array of floats */
+typedef struct CGLPackAttrib {
+    GLuint index;               /*!< generic attribute index, copied into the layout */
+    const float *source;        /*!< the first component of the first vertex */
+    unsigned int components;    /*!< per vertex in \ref source, 1 to 4, 3 for the octahedral encodings */
+    size_t source_stride;       /*!< bytes from one vertex to the next in \ref source, 0 for tightly packed */
+    unsigned int encoding;      /*!< CGL_PACK_* */
+    float min;                  /*!< the range mapped to the normalized range, e.g. the bounds of the positions */
+    float max;                  /*!< if both are 0, the normalized range itself is used */
+} CGLPackAttrib;
+
+/*! \brief the size in bytes of one packed vertex
+ *
+ * every attribute starts at a multiple of 4 bytes, as GL implementations expect for fast fetching,
+ * so e.g. 3 components of CGL_PACK_SNORM16 take 8 bytes.
+ *
+ * \return the stride, or 0 if an attribute has an invalid encoding or number of components
+ */
+GLAPI size_t cglPackedVertexSize(const CGLPackAttrib *attribs, unsigned int count);
+
+/*! \brief quantize and interleave \ref vertices vertices
+ *
+ * the conversion runs in chunks, with the SIMD kernels of the target (AVX2, SSE2 or NEON on AArch64,
+ * as enabled by the compiler flags) or portable C, which is also used if CGL_NO_SIMD is defined when compiling cglpack.c.
+ *
+ * \param attribs  the attributes, in the order they are placed in the vertex
+ * \param count    number of elements of \ref attribs
+ * \param vertices number of vertices
+ * \param out      cglPackedVertexSize(attribs, count) * vertices bytes, padding between the attributes is zeroed
+ * \param layout   if not NULL, returns \ref count attributes for cglCreateVertexFormat, with offsets into
+ *                 the packed vertices and buffer 0, to be set by the caller
+ *
+ * \return the stride of the packed vertices, or 0 if cglPackedVertexSize fails
+ */
+GLAPI size_t cglPackVertices(const CGLPackAttrib *attribs, unsigned int count, size_t vertices, void *out,
+                             CGLVertexAttrib *layout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,201 @@
+/*
+ *  Render queue for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cglqueue.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+
+typedef struct CGLSortItem {
+    uint64_t key;
+    size_t index;   /* into CGLRenderQueue::packets */
+} CGLSortItem;
+
+struct CGLRenderQueue {
+    CGLDrawPacket *packets;
+    CGLSortItem *items;
+    CGLSortItem *scratch;   /* second buffer for the radix sort */
+    size_t count;
+    size_t capacity;
+};
+
+
+uint64_t cglDrawSortKey(const CGLDrawPacket *packet) {
+    /* 4 | 16 | 16 | 12 | 16 bits, the pipeline address hashed by a Fibonacci multiply */
+    uint64_t pipeline = (uint64_t) (size_t) packet->pipeline;
+
+    pipeline = ((pipeline >> 4) * UINT64_C(0x9e3779b97f4a7c15)) >> 48;
+    return ((uint64_t) (packet->layer & 0xf) << 60)
+         | ((uint64_t) (packet->program & 0xffff) << 44)
+         | ((uint64_t) (packet->textures[0] & 0xffff) << 28)
+         | ((uint64_t) (packet->vertex_buffer & 0xfff) << 16)
+         | pipeline;
+}
+
+
+static int cgl_queue_reserve(CGLRenderQueue *queue, size_t capacity) {
+    CGLDrawPacket *packets;
+    CGLSortItem *items, *scratch;
+
+    if (capacity <= queue->capacity)
+        return 1;
+    packets = (CGLDrawPacket *) realloc(queue->packets, capacity * sizeof(CGLDrawPacket));
+    if (packets == nullptr)
+        return 0;
+    queue->packets = packets;
+    items = (CGLSortItem *) realloc(queue->items, capacity * sizeof(CGLSortItem));
+    if (items == nullptr)
+        return 0;
+    queue->items = items;
+    scratch = (CGLSortItem *) realloc(queue->scratch, capacity * sizeof(CGLSortItem));
+    if (scratch == nullptr)
+        return 0;
+    queue->scratch = scratch;
+    queue->capacity = capacity;
+    return 1;
+}
+
+CGLRenderQueue *cglCreateRenderQueue(size_t capacity) {
+    CGLRenderQueue *queue = (CGLRenderQueue *) calloc(1, sizeof(CGLRenderQueue));
+
+    if (queue == nullptr)
+        return nullptr;
+    if (!cgl_queue_reserve(queue, capacity > 0 ? capacity : 64)) {
+        cglDestroyRenderQueue(queue);
+        return nullptr;
+    }
+    return queue;
+}
+
+void cglDestroyRenderQueue(CGLRenderQueue *queue) {
+    if (queue == nullptr)
+        return;
+    free(queue->packets);
+    free(queue->items);
+    free(queue->scratch);
+    free(queue);
+}
+
+int cglPushDraw(CGLRenderQueue *queue, const CGLDrawPacket *packet) {
+    if (queue->count == queue->capacity && !cgl_queue_reserve(queue, queue->capacity * 2))
+        return 0;
+    queue->packets[queue->count] = *packet;
+    queue->items[queue->count].key = cglDrawSortKey(packet);
+    queue->items[queue->count].index = queue->count;
+    ++queue->count;
+    return 1;
+}
+
+void cglClearRenderQueue(CGLRenderQueue *queue) {
+    queue->count = 0;
+}
+
+
+/* LSD radix sort on bytes, stable. All 8 histograms are made in one pass,
+ * and bytes that are the same in all keys (most of them, usually) are skipped.
+ * Returns the buffer the sorted items end up in.
+ */
+static CGLSortItem *cgl_radix_sort(CGLSortItem *items, CGLSortItem *scratch, size_t count) {
+    size_t histogram[8][256];
+    size_t i;
+    unsigned int pass;
+
+    memset(histogram, 0, sizeof(histogram));
+    for (i = 0; i < count; ++i)
+        for (pass = 0; pass < 8; ++pass)
+            ++histogram[pass][(items[i].key >> (pass * 8)) & 0xff];
+
+    for (pass = 0; pass < 8; ++pass) {
+        size_t *offsets = histogram[pass];
+        size_t sum = 0;
+        unsigned int shift = pass * 8;
+        CGLSortItem *swap;
+
+        if (offsets[(items[0].key >> shift) & 0xff] == count)
+            continue;
+        for (i = 0; i < 256; ++i) {
+            size_t n = offsets[i];
+
+            offsets[i] = sum;
+            sum += n;
+        }
+        for (i = 0; i < count; ++i)
+            scratch[offsets[(items[i].key >> shift) & 0xff]++] = items[i];
+        swap = items;
+        items = scratch;
+        scratch = swap;
+    }
+    return items;
+}
+
+void cglFlushRenderQueue(CGLRenderQueue *queue) {
+    const CGLDrawPacket *last = nullptr;
+    const CGLSortItem *sorted;
+    GLenum bound_targets[CGL_QUEUE_TEXTURES];   /* 0 if not bound by the queue yet */
+    GLuint bound_textures[CGL_QUEUE_TEXTURES];
+    GLenum active_texture = 0;                  /* 0 if not known */
+    GLuint vertex_buffer = 0, index_buffer = 0;
+    int vertex_bound = 0, index_bound = 0;      /* whether the buffers above are known to be bound */
+    size_t i;
+
+    if (queue->count == 0)
+        return;
+    sorted = cgl_radix_sort(queue->items, queue->scratch, queue->count);
+    memset(bound_targets, 0, sizeof(bound_targets));
+    memset(bound_textures, 0, sizeof(bound_textures));
+
+    for (i = 0; i < queue->count; ++i) {
+        const CGLDrawPacket *packet = &queue->packets[sorted[i].index];
+        unsigned int unit;
+
+        if (packet->pipeline != nullptr && (last == nullptr || packet->pipeline != last->pipeline))
+            cglApplyPipeline(packet->pipeline);
+        if (last == nullptr || packet->program != last->program)
+            glUseProgram(packet->program);
+        for (unit = 0; unit < CGL_QUEUE_TEXTURES; ++unit) {
+            if (packet->texture_targets[unit] == 0
+                    || (packet->texture_targets[unit] == bound_targets[unit] && packet->textures[unit] == bound_textures[unit]))
+                continue;
+            if (active_texture != GL_TEXTURE0 + unit) {
+                active_texture = GL_TEXTURE0 + unit;
+                glActiveTexture(active_texture);
+            }
+            glBindTexture(packet->texture_targets[unit], packet->textures[unit]);
+            bound_targets[unit] = packet->texture_targets[unit];
+            bound_textures[unit] = packet->textures[unit];
+        }
+        if (!vertex_bound || packet->vertex_buffer != vertex_buffer) {
+            glBindBuffer(GL_ARRAY_BUFFER, packet->vertex_buffer);
+            vertex_buffer = packet->vertex_buffer;
+            vertex_bound = 1;
+        }
+        if (packet->index_type != 0 && (!index_bound || packet->index_buffer != index_buffer)) {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, packet->index_buffer);
+            index_buffer = packet->index_buffer;
+            index_bound = 1;
+        }
+        if (packet->prepare != nullptr) {
+            packet->prepare(packet, packet->user);
+            /* it may have bound other buffers (cglApplyVertexFormat does) or textures, so forget them */
+            vertex_bound = 0;
+            index_bound = 0;
+            active_texture = 0;
+            memset(bound_targets, 0, sizeof(bound_targets));
+        }
+
+        if (packet->index_type != 0)
+            glDrawElements(packet->mode, packet->count, packet->index_type, (const void *) packet->index_offset);
+        else
+            glDrawArrays(packet->mode, packet->first, packet->count);
+        last = packet;
+    }
+    queue->count = 0;
+}
@@ -0,0 +1,96 @@
+/*
+ *  Render queue for the common OpenGL subset: draws sorted by state before submission
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLQUEUE_H
+#define CGLQUEUE_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief number of texture units a draw packet can bind */
+#define CGL_QUEUE_TEXTURES 4
+
+/*! \brief everything needed for one draw call
+ *
+ * the state is set in this order: pipeline, program, textures, vertex and index buffer, then \ref prepare
+ * is called, then the draw is made, with glDrawElements if \ref index_type is set, else with glDrawArrays.
+ * Only state that differs from the packet submitted before is set.
+ *
+ * \ref prepare may bind buffers (e.g. with cglApplyVertexFormat), textures and the active texture unit,
+ * the queue binds them again for the next packet. It must leave the program and the pipeline state alone.
+ */
+typedef struct CGLDrawPacket {
+    unsigned int layer;                 /*!< 0..15, sorted before everything else, e.g. opaque before transparent */
+    GLuint program;                     /*!< for glUseProgram */
+    const CGLPipelineState *pipeline;   /*!< for cglApplyPipeline, or NULL to leave that state alone */
+    GLenum texture_targets[CGL_QUEUE_TEXTURES]; /*!< target on GL_TEXTUREi, or 0 to leave unit i alone */
+    GLuint textures[CGL_QUEUE_TEXTURES];        /*!< texture bound to it */
+    GLuint vertex_buffer;               /*!< bound to GL_ARRAY_BUFFER */
+    GLuint index_buffer;                /*!< bound to GL_ELEMENT_ARRAY_BUFFER if \ref index_type is set */
+    GLenum mode;                        /*!< the primitive type, e.g. GL_TRIANGLES */
+    GLenum index_type;                  /*!< GL_UNSIGNED_BYTE or GL_UNSIGNED_SHORT for glDrawElements, 0 for glDrawArrays */
+    GLint first;                        /*!< first vertex for glDrawArrays */
+    size_t index_offset;                /*!< offset in bytes into \ref index_buffer for glDrawElements */
+    GLsizei count;                      /*!< number of vertices or indices */
+    /*! per draw setup after the state is bound, e.g. vertex attribute pointers and uniforms, can be NULL */
+    void (*prepare)(const struct CGLDrawPacket *packet, void *user);
+    void *user;                         /*!< passed to \ref prepare */
+} CGLDrawPacket;
+
+/*! \brief a list of draws to be sorted by state and submitted together
+ *
+ * each pushed packet gets a 64-bit sort key, made of (from the most significant bits)
+ *      4 bits layer, 16 bits program, 16 bits first texture, 12 bits vertex buffer, 16 bits pipeline
+ * where the names are cut to their lowest bits, and the pipeline is a hash of its address.
+ * cglFlushRenderQueue sorts the keys with a radix sort, so that draws with the same program,
+ * then the same texture, then the same buffer end up next to each other, and then submits them,
+ * skipping every bind that doesn't change anything. Names that collide in the key only make the
+ * grouping worse, never the result wrong; packets with the same key stay in the order they were pushed.
+ *
+ * The common subset has no instancing, so with many draws in random material order,
+ * this is the main way to reduce the state changes between them.
+ */
+typedef struct CGLRenderQueue CGLRenderQueue;
+
+/*! \brief create an empty queue
+ *
+ * \param capacity number of packets to reserve memory for, the queue grows as needed
+ *
+ * \return the queue, or NULL if there is not enough memory
+ */
+GLAPI CGLRenderQueue *cglCreateRenderQueue(size_t capacity);
+
+/*! \brief free a queue created by cglCreateRenderQueue, NULL is ignored */
+GLAPI void cglDestroyRenderQueue(CGLRenderQueue *queue);
+
+/*! \brief add a draw to the queue
+ *
+ * the packet is copied, the pipeline (and anything \ref user points to) must stay valid until the flush.
+ *
+ * \return 1, or 0 if there was not enough memory to grow the queue
+ */
+GLAPI int cglPushDraw(CGLRenderQueue *queue, const CGLDrawPacket *packet);
+
+/*! \brief sort all draws in the queue, submit them to GL and empty the queue */
+GLAPI void cglFlushRenderQueue(CGLRenderQueue *queue);
+
+/*! \brief empty the queue without drawing anything */
+GLAPI void cglClearRenderQueue(CGLRenderQueue *queue);
+
+/*! \brief the sort key of a packet, as used by the queue */
+GLAPI uint64_t cglDrawSortKey(const CGLDrawPacket *packet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ *  Stream buffers for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cglstream.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+
+/* the ring is [0, size) of the buffer, with the data allocated but not flushed yet in [flushed, head) */
+struct CGLStreamBuffer {
+    GLenum target;
+    GLuint buffer;
+    size_t size;
+    size_t head;
+    size_t flushed;
+    unsigned char *staging;     /* the client copy of the buffer, only [flushed, head) is used */
+    int orphan;                 /* the ring started over, the next flush orphans the buffer before the upload */
+    CGLStreamStats stats;
+};
+
+
+static void cgl_stream_orphan(CGLStreamBuffer *stream) {
+    glBindBuffer(stream->target, stream->buffer);
+    glBufferData(stream->target, (GLsizeiptr) stream->size, nullptr, GL_STREAM_DRAW);
+}
+
+static void cgl_stream_count(CGLStreamBuffer *stream, unsigned long allocations, unsigned long uploads,
+                             unsigned long orphans, size_t bytes) {
+    CGLStreamCounters *counters[2];
+    unsigned int i;
+
+    counters[0] = &stream->stats.frame;
+    counters[1] = &stream->stats.total;
+    for (i = 0; i < 2; ++i) {
+        counters[i]->allocations += allocations;
+        counters[i]->uploads += uploads;
+        counters[i]->orphans += orphans;
+        counters[i]->bytes += bytes;
+    }
+}
+
+
+CGLStreamBuffer *cglCreateStreamBuffer(GLenum target, size_t size) {
+    CGLStreamBuffer *stream = (CGLStreamBuffer *) calloc(1, sizeof(CGLStreamBuffer));
+
+    if (stream == nullptr)
+        return nullptr;
+    stream->staging = (unsigned char *) malloc(size + 1);
+    if (stream->staging == nullptr) {
+        free(stream);
+        return nullptr;
+    }
+    stream->target = target;
+    stream->size = size;
+    glGenBuffers(1, &stream->buffer);
+    cgl_stream_orphan(stream);
+    return stream;
+}
+
+void cglDestroyStreamBuffer(CGLStreamBuffer *stream) {
+    if (stream == nullptr)
+        return;
+    glDeleteBuffers(1, &stream->buffer);
+    free(stream->staging);
+    free(stream);
+}
+
+GLuint cglStreamBufferName(const CGLStreamBuffer *stream) {
+    return stream->buffer;
+}
+
+void *cglStreamAlloc(CGLStreamBuffer *stream, size_t size, size_t alignment, GLintptr *offset) {
+    size_t start;
+
+    if (alignment == 0)
+        alignment = 1;
+    start = (stream->head + alignment - 1) & ~(alignment - 1);
+    if (start > stream->size || size > stream->size - start) {
+        /* everything before was drawn already, so the old storage can go to the driver; this is left to the
+         * flush, which binds the buffer anyway */
+        if (stream->flushed != stream->head || size > stream->size)
+            return nullptr;
+        stream->orphan = 1;
+        stream->head = stream->flushed = start = 0;
+    }
+    if (stream->flushed == stream->head)
+        stream->flushed = start;
+    stream->head = start + size;
+    cgl_stream_count(stream, 1, 0, 0, 0);
+    *offset = (GLintptr) start;
+    return stream->staging + start;
+}
+
+int cglStreamWrite(CGLStreamBuffer *stream, const void *data, size_t size, size_t alignment, GLintptr *offset) {
+    void *memory = cglStreamAlloc(stream, size, alignment, offset);
+
+    if (memory == nullptr)
+        return 0;
+    if (size > 0)
+        memcpy(memory, data, size);
+    return 1;
+}
+
+void cglFlushStreamBuffer(CGLStreamBuffer *stream) {
+    size_t bytes = stream->head - stream->flushed;
+
+    if (stream->orphan) {
+        cgl_stream_orphan(stream);
+        cgl_stream_count(stream, 0, 0, 1, 0);
+        stream->orphan = 0;
+    } else {
+        glBindBuffer(stream->target, stream->buffer);
+    }
+    if (bytes == 0)
+        return;
+    glBufferSubData(stream->target, (GLintptr) stream->flushed, (GLsizeiptr) bytes, stream->staging + stream->flushed);
+    cgl_stream_count(stream, 0, 1, 0, bytes);
+    stream->flushed = stream->head;
+}
+
+void cglEndStreamFrame(CGLStreamBuffer *stream) {
+    stream->stats.last = stream->stats.frame;
+    memset(&stream->stats.frame, 0, sizeof(stream->stats.frame));
+    ++stream->stats.frames;
+}
+
+const CGLStreamStats *cglGetStreamStats(const CGLStreamBuffer *stream) {
+    return &stream->stats;
+}
@@ -0,0 +1,103 @@
+/*
+ *  Stream buffers for the common OpenGL subset: per frame vertex and index data sub-allocated from one ring
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLSTREAM_H
+#define CGLSTREAM_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief counters of a stream buffer, over one frame or in total */
+typedef struct CGLStreamCounters {
+    unsigned long allocations;  /*!< calls of cglStreamAlloc that returned memory */
+    unsigned long uploads;      /*!< glBufferSubData calls */
+    unsigned long orphans;      /*!< glBufferData(NULL) calls when the ring wrapped */
+    size_t bytes;               /*!< bytes uploaded, including the padding for alignment */
+} CGLStreamCounters;
+
+/*! \brief statistics of a stream buffer, see cglEndStreamFrame */
+typedef struct CGLStreamStats {
+    unsigned long frames;       /*!< calls of cglEndStreamFrame */
+    CGLStreamCounters frame;    /*!< the current frame, since the last cglEndStreamFrame */
+    CGLStreamCounters last;     /*!< the frame ended by the last cglEndStreamFrame */
+    CGLStreamCounters total;    /*!< everything since creation */
+} CGLStreamStats;
+
+/*! \brief a GL_STREAM_DRAW buffer used as a ring for data that changes every frame
+ *
+ * calling glBufferData for every draw of dynamic data makes the driver allocate and free memory all the time,
+ * or wait for the GPU to finish with the old contents. A stream buffer specifies one large buffer once,
+ * and hands out aligned ranges of it one after another: the data is written into a copy in client memory,
+ * and cglFlushStreamBuffer uploads everything written since the last flush with a single glBufferSubData,
+ * into a part of the buffer no draw of this frame has used yet.
+ *
+ * When the ring is full, it starts over at offset 0, and the next flush orphans the buffer by glBufferData(NULL),
+ * which gives it new storage without waiting for the draws still using the old one.
+ *
+ * Use: allocate and fill the data of some draws, flush, draw them using the offsets, repeat;
+ * call cglEndStreamFrame once per frame for the statistics.
+ */
+typedef struct CGLStreamBuffer CGLStreamBuffer;
+
+/*! \brief create a stream buffer
+ *
+ * makes a new buffer object with glGenBuffers and specifies it with glBufferData(NULL, GL_STREAM_DRAW).
+ * It should be large enough for a few frames of data, so that it's orphaned at most once a frame.
+ *
+ * \param target GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER, the buffer is bound to it when it is created and flushed
+ * \param size   size of the buffer in bytes
+ *
+ * \return the stream buffer, or NULL if there is not enough memory
+ */
+GLAPI CGLStreamBuffer *cglCreateStreamBuffer(GLenum target, size_t size);
+
+/*! \brief delete the buffer object and free the stream buffer, NULL is ignored */
+GLAPI void cglDestroyStreamBuffer(CGLStreamBuffer *stream);
+
+/*! \brief the name of the buffer object, to bind it for drawing */
+GLAPI GLuint cglStreamBufferName(const CGLStreamBuffer *stream);
+
+/*! \brief reserve \ref size bytes for data to be uploaded by the next flush
+ *
+ * \param size      bytes to reserve
+ * \param alignment of the offset in the buffer, a power of 2, e.g. the size of the vertex or index type; 0 for 1
+ * \param offset    returns the byte offset of the range in the buffer, for glVertexAttribPointer or glDrawElements
+ *
+ * \return memory to write the data to, valid until the next flush; or NULL if the range doesn't fit in the rest
+ *         of the buffer, and data allocated before wasn't flushed yet: then flush, draw with it, and try again.
+ *         NULL is also returned if \ref size is larger than the buffer.
+ */
+GLAPI void *cglStreamAlloc(CGLStreamBuffer *stream, size_t size, size_t alignment, GLintptr *offset);
+
+/*! \brief like cglStreamAlloc, but copies \ref data into the range
+ *
+ * \return 1, or 0 if cglStreamAlloc would have returned NULL
+ */
+GLAPI int cglStreamWrite(CGLStreamBuffer *stream, const void *data, size_t size, size_t alignment, GLintptr *offset);
+
+/*! \brief upload everything allocated since the last flush, in one glBufferSubData
+ *
+ * binds the buffer to its target, and orphans it first if the ring started over; no other call but
+ * cglCreateStreamBuffer binds it. Draws must only use the offsets of allocations that were flushed.
+ */
+GLAPI void cglFlushStreamBuffer(CGLStreamBuffer *stream);
+
+/*! \brief end a frame for the statistics: the counters of the frame become the ones of the last frame */
+GLAPI void cglEndStreamFrame(CGLStreamBuffer *stream);
+
+/*! \brief the statistics of the stream buffer */
+GLAPI const CGLStreamStats *cglGetStreamStats(const CGLStreamBuffer *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,465 @@
+/*
+ *  Texture streaming for the common OpenGL subset
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L     /* clock_gettime, nanosleep, sched_yield */
+#endif
+
+#include <cgl/cgltex.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sched.h>
+#include <time.h>
+#endif
+
+#ifndef __cplusplus
+#define nullptr NULL
+#endif
+
+
+#define CGL_STREAM_NONE ((unsigned int) -1)
+
+/* the upload rate assumed before the first band is measured, in bytes per microsecond */
+#define CGL_STREAM_INITIAL_RATE 1000.0
+
+/* an entry is owned by the workers while it is CGL_STREAM_QUEUED or CGL_STREAM_DECODING, and by the GL thread
+ * otherwise; the state itself, and the array when it grows, only change under the lock */
+typedef struct CGLStreamEntry {
+    int state;                  /* CGL_STREAM_*, or CGL_STREAM_FREE */
+    int cancelled;              /* cancelled while a worker decodes it, the worker frees the entry */
+    int priority;
+    unsigned int flags;
+    void *source;
+    unsigned char *pixels;      /* converted, in the row order of the texture */
+    size_t stride;
+    GLsizei width;
+    GLsizei height;
+    GLsizei rows;               /* uploaded so far */
+    GLenum format;
+    GLuint texture;             /* 0 until the upload starts */
+} CGLStreamEntry;
+
+struct CGLTextureStreamer {
+    CGLTextureDecoder decoder;
+    void *user;
+    long lock;
+    long stopped;
+    CGLStreamEntry *entries;
+    unsigned int entry_count;
+    unsigned int entry_capacity;
+    unsigned int *free_entries;
+    unsigned int free_count;
+    double rate;                /* measured bytes per microsecond of glTexSubImage2D */
+    CGLTextureStreamStats stats;
+};
+
+
+static long cgl_tex_exchange(long *value, long desired) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_exchange_n(value, desired, __ATOMIC_ACQ_REL);
+#elif defined(_MSC_VER)
+    return InterlockedExchange((volatile LONG *) value, desired);
+#else
+#error no atomic exchange known for this compiler
+#endif
+}
+
+static long cgl_tex_load(const long *value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+    long loaded = *(const volatile long *) value;
+
+    MemoryBarrier();
+    return loaded;
+#endif
+}
+
+/* waiting for the lock or for work: spin shortly, then yield, then sleep */
+static void cgl_tex_pause(unsigned int *spins) {
+    if (++*spins < 64)
+        return;
+#if defined(_WIN32)
+    if (*spins < 1024)
+        SwitchToThread();
+    else
+        Sleep(1);
+#else
+    if (*spins < 1024) {
+        sched_yield();
+    } else {
+        struct timespec pause;
+
+        pause.tv_sec = 0;
+        pause.tv_nsec = 1000000;
+        nanosleep(&pause, nullptr);
+    }
+#endif
+}
+
+static void cgl_tex_lock(CGLTextureStreamer *streamer) {
+    unsigned int spins = 0;
+
+    while (cgl_tex_exchange(&streamer->lock, 1) != 0)
+        cgl_tex_pause(&spins);
+}
+
+static void cgl_tex_unlock(CGLTextureStreamer *streamer) {
+    cgl_tex_exchange(&streamer->lock, 0);
+}
+
+/* a monotonic clock in microseconds, wrapping around, so only differences are meaningful */
+static unsigned long cgl_tex_now(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER count, frequency;
+
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (unsigned long) (count.QuadPart / frequency.QuadPart * 1000000
+                            + count.QuadPart % frequency.QuadPart * 1000000 / frequency.QuadPart);
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long) now.tv_sec * 1000000UL + (unsigned long) (now.tv_nsec / 1000);
+#endif
+}
+
+static void cgl_tex_free_entry(CGLTextureStreamer *streamer, unsigned int index) {
+    streamer->entries[index].state = CGL_STREAM_FREE;
+    streamer->free_entries[streamer->free_count++] = index;
+}
+
+/* converts to GL_RGB or GL_RGBA with rows aligned to 4 bytes, NULL if there is not enough memory */
+static unsigned char *cgl_tex_convert(const CGLDecodedImage *image, unsigned int flags, size_t *stride,
+                                      GLenum *format) {
+    int channels = image->channels, alpha = channels == 2 || channels == 4;
+    int premultiply = alpha && (flags & CGL_STREAM_PREMULTIPLY) != 0;
+    size_t pixel = alpha ? 4 : 3, row = (size_t) image->width * pixel;
+    unsigned char *out;
+    int x, y;
+
+    *format = alpha ? GL_RGBA : GL_RGB;
+    *stride = (row + 3) & ~(size_t) 3;
+    out = (unsigned char *) malloc(*stride * (size_t) image->height);
+    if (out == nullptr)
+        return nullptr;
+    for (y = 0; y < image->height; ++y) {
+        const unsigned char *in = image->pixels + (size_t) y * (size_t) image->width * (size_t) channels;
+        unsigned char *to = out + (size_t) ((flags & CGL_STREAM_FLIP_Y) != 0 ? image->height - 1 - y : y) * *stride;
+
+        if ((size_t) channels == pixel && !premultiply) {
+            memcpy(to, in, row);
+        } else {
+            for (x = 0; x < image->width; ++x, in += channels, to += pixel) {
+                unsigned int r = in[0], g = in[0], b = in[0], a = channels == 2 ? in[1] : 255;
+
+                if (channels >= 3) {
+                    g = in[1];
+                    b = in[2];
+                    a = channels == 4 ? in[3] : 255;
+                }
+                if (premultiply) {
+                    r = (r * a + 127) / 255;
+                    g = (g * a + 127) / 255;
+                    b = (b * a + 127) / 255;
+                }
+                to[0] = (unsigned char) r;
+                to[1] = (unsigned char) g;
+                to[2] = (unsigned char) b;
+                if (alpha)
+                    to[3] = (unsigned char) a;
+            }
+            to -= row;
+        }
+        memset(to + row, 0, *stride - row);
+    }
+    return out;
+}
+
+/* the decoded entry to upload next: the highest priority, and of those the one already started */
+static unsigned int cgl_tex_next_upload(CGLTextureStreamer *streamer) {
+    unsigned int i, best = CGL_STREAM_NONE;
+
+    cgl_tex_lock(streamer);
+    for (i = 0; i < streamer->entry_count; ++i) {
+        const CGLStreamEntry *entry = &streamer->entries[i];
+
+        if (entry->state != CGL_STREAM_UPLOADING)
+            continue;
+        if (best == CGL_STREAM_NONE || entry->priority > streamer->entries[best].priority
+                || (entry->priority == streamer->entries[best].priority && entry->texture != 0
+                    && streamer->entries[best].texture == 0))
+            best = i;
+    }
+    cgl_tex_unlock(streamer);
+    return best;
+}
+
+
+CGLTextureStreamer *cglCreateTextureStreamer(CGLTextureDecoder decoder, void *user) {
+    CGLTextureStreamer *streamer = (CGLTextureStreamer *) calloc(1, sizeof(CGLTextureStreamer));
+
+    if (streamer == nullptr)
+        return nullptr;
+    streamer->decoder = decoder;
+    streamer->user = user;
+    streamer->rate = CGL_STREAM_INITIAL_RATE;
+    return streamer;
+}
+
+void cglDestroyTextureStreamer(CGLTextureStreamer *streamer) {
+    unsigned int i;
+
+    if (streamer == nullptr)
+        return;
+    for (i = 0; i < streamer->entry_count; ++i) {
+        CGLStreamEntry *entry = &streamer->entries[i];
+
+        if (entry->state == CGL_STREAM_UPLOADING) {
+            if (entry->texture != 0)
+                glDeleteTextures(1, &entry->texture);
+            free(entry->pixels);
+        }
+    }
+    free(streamer->entries);
+    free(streamer->free_entries);
+    free(streamer);
+}
+
+CGLStreamHandle cglStreamTexture(CGLTextureStreamer *streamer, void *source, int priority, unsigned int flags) {
+    CGLStreamEntry *entry;
+    unsigned int index;
+
+    cgl_tex_lock(streamer);
+    if (streamer->free_count == 0 && streamer->entry_count == streamer->entry_capacity) {
+        unsigned int capacity = streamer->entry_capacity > 0 ? streamer->entry_capacity * 2 : 64;
+        CGLStreamEntry *entries = (CGLStreamEntry *) realloc(streamer->entries, capacity * sizeof(CGLStreamEntry));
+        unsigned int *free_entries;
+
+        if (entries != nullptr)
+            streamer->entries = entries;
+        free_entries = (unsigned int *) realloc(streamer->free_entries, capacity * sizeof(unsigned int));
+        if (free_entries != nullptr)
+            streamer->free_entries = free_entries;
+        if (entries == nullptr || free_entries == nullptr) {
+            cgl_tex_unlock(streamer);
+            return 0;
+        }
+        streamer->entry_capacity = capacity;
+    }
+    index = streamer->free_count > 0 ? streamer->free_entries[--streamer->free_count] : streamer->entry_count++;
+    entry = &streamer->entries[index];
+    memset(entry, 0, sizeof(CGLStreamEntry));
+    entry->state = CGL_STREAM_QUEUED;
+    entry->priority = priority;
+    entry->flags = flags;
+    entry->source = source;
+    cgl_tex_unlock(streamer);
+    return index + 1;
+}
+
+void cglSetStreamPriority(CGLTextureStreamer *streamer, CGLStreamHandle handle, int priority) {
+    if (handle == 0)
+        return;
+    cgl_tex_lock(streamer);
+    streamer->entries[handle - 1].priority = priority;
+    cgl_tex_unlock(streamer);
+}
+
+int cglStreamTextureState(CGLTextureStreamer *streamer, CGLStreamHandle handle, GLuint *texture) {
+    int state;
+
+    if (handle == 0) {
+        *texture = 0;
+        return CGL_STREAM_FREE;
+    }
+    cgl_tex_lock(streamer);
+    state = streamer->entries[handle - 1].state;
+    *texture = state == CGL_STREAM_DONE ? streamer->entries[handle - 1].texture : 0;
+    cgl_tex_unlock(streamer);
+    return state;
+}
+
+void cglCancelStreamTexture(CGLTextureStreamer *streamer, CGLStreamHandle handle) {
+    CGLStreamEntry *entry;
+    GLuint texture = 0;
+
+    if (handle == 0)
+        return;
+    cgl_tex_lock(streamer);
+    entry = &streamer->entries[handle - 1];
+    if (entry->state == CGL_STREAM_DECODING) {
+        entry->cancelled = 1;
+    } else {
+        if (entry->state == CGL_STREAM_UPLOADING) {
+            texture = entry->texture;
+            free(entry->pixels);
+        }
+        cgl_tex_free_entry(streamer, handle - 1);
+    }
+    cgl_tex_unlock(streamer);
+    if (texture != 0)
+        glDeleteTextures(1, &texture);
+}
+
+unsigned int cglUpdateTextureStreamer(CGLTextureStreamer *streamer, unsigned long budget) {
+    unsigned long start = cgl_tex_now(), elapsed, spent = 0;
+    unsigned int completed = 0, index;
+    size_t measured = 0;
+
+    streamer->stats.bands = 0;
+    streamer->stats.bytes = 0;
+    while ((index = cgl_tex_next_upload(streamer)) != CGL_STREAM_NONE) {
+        CGLStreamEntry *entry = &streamer->entries[index];
+        unsigned long before;
+        GLsizei rows;
+
+        elapsed = cgl_tex_now() - start;
+        if (streamer->stats.bands > 0 && elapsed >= budget)
+            break;
+
+        if (entry->texture == 0) {
+            GLint wrap = (entry->flags & CGL_STREAM_REPEAT) != 0 ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+
+            glGenTextures(1, &entry->texture);
+            glBindTexture(GL_TEXTURE_2D, entry->texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+            glTexImage2D(GL_TEXTURE_2D, 0, (GLint) entry->format, entry->width, entry->height, 0, entry->format,
+                         GL_UNSIGNED_BYTE, nullptr);
+            ++streamer->stats.bands;
+            continue;
+        }
+
+        /* as many rows as the rate says fit into the rest of the budget, but at least one per update */
+        rows = entry->height - entry->rows;
+        if (budget > elapsed && (double) (budget - elapsed) * streamer->rate < (double) rows * (double) entry->stride)
+            rows = (GLsizei) ((double) (budget - elapsed) * streamer->rate / (double) entry->stride);
+        else if (budget <= elapsed)
+            rows = 0;
+        if (rows < 1) {
+            if (streamer->stats.bands > 0)
+                break;
+            rows = 1;
+        }
+
+        before = cgl_tex_now();
+        glBindTexture(GL_TEXTURE_2D, entry->texture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, entry->rows, entry->width, rows, entry->format, GL_UNSIGNED_BYTE,
+                        entry->pixels + (size_t) entry->rows * entry->stride);
+        spent += cgl_tex_now() - before;
+        measured += (size_t) rows * entry->stride;
+        entry->rows += rows;
+        ++streamer->stats.bands;
+        streamer->stats.bytes += (size_t) rows * entry->stride;
+
+        if (entry->rows == entry->height) {
+            free(entry->pixels);
+            entry->pixels = nullptr;
+            cgl_tex_lock(streamer);
+            entry->state = CGL_STREAM_DONE;
+            cgl_tex_unlock(streamer);
+            ++completed;
+            ++streamer->stats.completed;
+        }
+    }
+    /* measured over the whole update, single bands can be too short for the resolution of the clock */
+    if (spent > 0)
+        streamer->rate = 0.75 * streamer->rate + 0.25 * (double) measured / (double) spent;
+    streamer->stats.microseconds = cgl_tex_now() - start;
+    return completed;
+}
+
+int cglDecodeStreamTexture(CGLTextureStreamer *streamer) {
+    CGLDecodedImage image;
+    CGLStreamEntry *entry;
+    unsigned char *pixels = nullptr;
+    unsigned int i, best = CGL_STREAM_NONE, flags = 0;
+    void *source = nullptr;
+    size_t stride = 0;
+    GLenum format = GL_RGBA;
+
+    cgl_tex_lock(streamer);
+    for (i = 0; i < streamer->entry_count; ++i) {
+        const CGLStreamEntry *queued = &streamer->entries[i];
+
+        if (queued->state == CGL_STREAM_QUEUED
+                && (best == CGL_STREAM_NONE || queued->priority > streamer->entries[best].priority))
+            best = i;
+    }
+    if (best != CGL_STREAM_NONE) {
+        streamer->entries[best].state = CGL_STREAM_DECODING;
+        source = streamer->entries[best].source;
+        flags = streamer->entries[best].flags;
+    }
+    cgl_tex_unlock(streamer);
+    if (best == CGL_STREAM_NONE)
+        return 0;
+
+    memset(&image, 0, sizeof(image));
+    if (streamer->decoder(streamer->user, source, &image) && image.pixels != nullptr && image.width > 0
+            && image.height > 0 && image.channels >= 1 && image.channels <= 4)
+        pixels = cgl_tex_convert(&image, flags, &stride, &format);
+    free(image.pixels);
+
+    cgl_tex_lock(streamer);
+    entry = &streamer->entries[best];
+    if (entry->cancelled) {
+        free(pixels);
+        cgl_tex_free_entry(streamer, best);
+    } else if (pixels == nullptr) {
+        entry->state = CGL_STREAM_FAILED;
+    } else {
+        entry->pixels = pixels;
+        entry->stride = stride;
+        entry->width = (GLsizei) image.width;
+        entry->height = (GLsizei) image.height;
+        entry->format = format;
+        entry->state = CGL_STREAM_UPLOADING;
+    }
+    cgl_tex_unlock(streamer);
+    return 1;
+}
+
+void cglRunTextureWorker(CGLTextureStreamer *streamer) {
+    unsigned int spins = 0;
+
+    while (!cgl_tex_load(&streamer->stopped)) {
+        if (cglDecodeStreamTexture(streamer))
+            spins = 0;
+        else
+            cgl_tex_pause(&spins);
+    }
+}
+
+void cglStopTextureWorkers(CGLTextureStreamer *streamer) {
+    cgl_tex_exchange(&streamer->stopped, 1);
+}
+
+void cglGetTextureStreamStats(CGLTextureStreamer *streamer, CGLTextureStreamStats *stats) {
+    unsigned int i;
+
+    *stats = streamer->stats;
+    stats->queued = stats->uploading = 0;
+    cgl_tex_lock(streamer);
+    for (i = 0; i < streamer->entry_count; ++i) {
+        int state = streamer->entries[i].state;
+
+        if (state == CGL_STREAM_QUEUED || state == CGL_STREAM_DECODING)
+            ++stats->queued;
+        else if (state == CGL_STREAM_UPLOADING)
+            ++stats->uploading;
+    }
+    cgl_tex_unlock(streamer);
+}
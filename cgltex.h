@@ -0,0 +1,147 @@
+/*
+ *  Texture streaming for the common OpenGL subset: decoding on worker threads, uploading in bands under a time budget
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#ifndef CGLTEX_H
+#define CGLTEX_H
+
+#include <cgl/cgl.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \name flags of cglStreamTexture */
+/*!@{*/
+#define CGL_STREAM_FLIP_Y       1   /*!< the decoder gives the top row first, make it the bottom row (t = 0) of the texture */
+#define CGL_STREAM_PREMULTIPLY  2   /*!< multiply the color by alpha, for images with an alpha channel */
+#define CGL_STREAM_REPEAT       4   /*!< GL_REPEAT instead of GL_CLAMP_TO_EDGE, needs a power of two size in GL ES 2.0 */
+/*!@}*/
+
+/*! \name states of a streamed texture */
+/*!@{*/
+#define CGL_STREAM_QUEUED       0   /*!< waiting for a worker */
+#define CGL_STREAM_DECODING     1   /*!< a worker decodes it */
+#define CGL_STREAM_UPLOADING    2   /*!< decoded, waiting for or in the middle of the upload */
+#define CGL_STREAM_DONE         3   /*!< the texture is complete */
+#define CGL_STREAM_FAILED       4   /*!< the decoder returned 0 or there was not enough memory */
+#define CGL_STREAM_FREE       (-1)  /*!< no texture: handle 0, or one cancelled and not given out again */
+/*!@}*/
+
+/*! \brief an image as given by the decoder */
+typedef struct CGLDecodedImage {
+    int width;
+    int height;
+    int channels;           /*!< 1 (gray), 2 (gray, alpha), 3 (RGB) or 4 (RGBA), 8 bits each */
+    unsigned char *pixels;  /*!< tightly packed rows, allocated with malloc, freed by the streamer */
+} CGLDecodedImage;
+
+/*! \brief decode \ref source into \ref image, on a worker thread, e.g. with stbi_load_from_memory
+ *
+ * \return 1, or 0 if it failed
+ */
+typedef int (*CGLTextureDecoder)(void *user, void *source, CGLDecodedImage *image);
+
+/*! \brief a streamed texture, 0 is never a valid handle */
+typedef unsigned int CGLStreamHandle;
+
+/*! \brief what the last cglUpdateTextureStreamer did, and what is in flight */
+typedef struct CGLTextureStreamStats {
+    unsigned int queued;        /*!< textures waiting for or being decoded */
+    unsigned int uploading;     /*!< textures decoded and not completely uploaded */
+    unsigned int bands;         /*!< glTexImage2D and glTexSubImage2D calls of the last update */
+    size_t bytes;               /*!< uploaded by the last update */
+    unsigned long microseconds; /*!< spent by the last update */
+    unsigned long completed;    /*!< textures completed since the streamer was created */
+} CGLTextureStreamStats;
+
+/*! \brief textures loaded in the background, instead of a glTexImage2D of each one when a level loads
+ *
+ * cglStreamTexture queues a source (e.g. the file contents) with a priority. Worker threads of the caller
+ * run cglRunTextureWorker, which takes the queued textures with the highest priority first, decodes them with
+ * the decoder of the streamer and converts them to GL_RGB or GL_RGBA with rows aligned to 4 bytes.
+ *
+ * On the GL thread, cglUpdateTextureStreamer is called once per frame with a budget in microseconds: it allocates
+ * the decoded textures with glTexImage2D and fills them in bands of rows with glTexSubImage2D, as many as fit into
+ * the budget. The band size follows the measured upload rate, so a large texture is spread over several frames
+ * instead of one long stall; a texture with a higher priority is started between two bands of another one.
+ *
+ * The textures have a single level, with GL_LINEAR filters and GL_CLAMP_TO_EDGE (or GL_REPEAT) wrapping,
+ * and the pixel data expects the default GL_UNPACK_ALIGNMENT of 4.
+ * All functions but cglRunTextureWorker, cglDecodeStreamTexture and cglStopTextureWorkers are for the GL thread;
+ * the workers only share the queue with it, under a spin lock.
+ */
+typedef struct CGLTextureStreamer CGLTextureStreamer;
+
+/*! \brief create a streamer
+ *
+ * \return the streamer, or NULL if there is not enough memory
+ */
+GLAPI CGLTextureStreamer *cglCreateTextureStreamer(CGLTextureDecoder decoder, void *user);
+
+/*! \brief delete the textures not completed, and free the streamer, NULL is ignored
+ *
+ * the workers have to have returned from cglRunTextureWorker. Completed textures belong to the caller.
+ */
+GLAPI void cglDestroyTextureStreamer(CGLTextureStreamer *streamer);
+
+/*! \brief queue a texture
+ *
+ * \param source   passed to the decoder, has to stay valid until the texture is decoded or cancelled
+ * \param priority higher values are decoded and uploaded first
+ * \param flags    CGL_STREAM_FLIP_Y, CGL_STREAM_PREMULTIPLY, CGL_STREAM_REPEAT or 0
+ *
+ * \return the handle, or 0 if there is not enough memory
+ */
+GLAPI CGLStreamHandle cglStreamTexture(CGLTextureStreamer *streamer, void *source, int priority, unsigned int flags);
+
+/*! \brief change the priority of a texture not completed yet, e.g. as the camera moves; 0 is ignored */
+GLAPI void cglSetStreamPriority(CGLTextureStreamer *streamer, CGLStreamHandle handle, int priority);
+
+/*! \brief the state of a texture, CGL_STREAM_*, and the texture if it is CGL_STREAM_DONE, else 0;
+ *         CGL_STREAM_FREE for handle 0, as cglStreamTexture returns when out of memory */
+GLAPI int cglStreamTextureState(CGLTextureStreamer *streamer, CGLStreamHandle handle, GLuint *texture);
+
+/*! \brief stop streaming a texture and free the handle, 0 is ignored
+ *
+ * a texture in the middle of the upload is deleted, one a worker decodes is dropped when the worker is done.
+ * Once the texture is completed, this only frees the handle, and the texture belongs to the caller.
+ */
+GLAPI void cglCancelStreamTexture(CGLTextureStreamer *streamer, CGLStreamHandle handle);
+
+/*! \brief upload decoded textures for up to \ref budget microseconds
+ *
+ * binds the textures to GL_TEXTURE_2D of the active unit while uploading. At least one band is uploaded
+ * if anything is decoded, so that streaming progresses even if a band takes longer than the budget.
+ *
+ * \return the number of textures completed by this call
+ */
+GLAPI unsigned int cglUpdateTextureStreamer(CGLTextureStreamer *streamer, unsigned long budget);
+
+/*! \brief decode one queued texture on the calling thread, for callers with a job system of their own
+ *
+ * \return 1, or 0 if nothing was queued
+ */
+GLAPI int cglDecodeStreamTexture(CGLTextureStreamer *streamer);
+
+/*! \brief decode queued textures until cglStopTextureWorkers is called, on any number of worker threads
+ *
+ * when the queue is empty, the worker spins shortly, then yields, then sleeps for 1 millisecond at a time.
+ */
+GLAPI void cglRunTextureWorker(CGLTextureStreamer *streamer);
+
+/*! \brief make all workers return from cglRunTextureWorker once they finished the texture at hand */
+GLAPI void cglStopTextureWorkers(CGLTextureStreamer *streamer);
+
+/*! \brief the counters of the streamer */
+GLAPI void cglGetTextureStreamStats(CGLTextureStreamer *streamer, CGLTextureStreamStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ *  Benchmark: time to the first draw with cglLoadGL and with cglLoadGLLazy
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <cgl/cgl.h>
+#include <cgl/cglcmd.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+#define ROUNDS 20000
+
+static double now(void) {
+    struct timespec spec;
+
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (double) spec.tv_sec + (double) spec.tv_nsec * 1e-9;
+}
+
+/* the calls of a minimal first frame, as a headless tool makes them */
+static void first_draw(void) {
+    GLuint buffer;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, 0, NULL, GL_STATIC_DRAW);
+    glUseProgram(0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, NULL);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+}
+
+/* microseconds per load and first draw */
+static double measure(void (*load)(GLADloadproc)) {
+    double start = now();
+    int round;
+
+    for (round = 0; round < ROUNDS; ++round) {
+        load(cglNullProc);
+        first_draw();
+    }
+    return (now() - start) * 1e6 / ROUNDS;
+}
+
+/* microseconds per frame of the same calls, once everything is resolved */
+static double measure_steady(void) {
+    double start = now();
+    int round;
+
+    for (round = 0; round < ROUNDS; ++round)
+        first_draw();
+    return (now() - start) * 1e6 / ROUNDS;
+}
+
+int main(void) {
+    double eager, lazy, steady_eager, steady_lazy;
+
+    /* warm up the caches, cglNullProc compares names, about as costly as a loader with a string table */
+    measure(cglLoadGL);
+    measure(cglLoadGLLazy);
+
+    eager = measure(cglLoadGL);
+    steady_eager = measure_steady();
+    lazy = measure(cglLoadGLLazy);
+    steady_lazy = measure_steady();
+
+    printf("loader: cglNullProc, %u entry points, 9 of them used by the first draw\n", (unsigned int) CGL_DISPATCH_COUNT);
+    printf("eager  cglLoadGL:     %8.3f us to first draw, %6.3f us per frame afterwards\n", eager, steady_eager);
+    printf("lazy   cglLoadGLLazy: %8.3f us to first draw, %6.3f us per frame afterwards\n", lazy, steady_lazy);
+    printf("lazy startup is %.1fx faster\n", eager / lazy);
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ *  Benchmark: throughput and round trip latency of the render thread proxy, against cglNullProc
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <cgl/cgl.h>
+#include <cgl/cglcmd.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define CALLS 4000000
+#define ROUND_TRIPS 20000
+
+static double now(void) {
+    struct timespec spec;
+
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+    return (double) spec.tv_sec + (double) spec.tv_nsec * 1e-9;
+}
+
+static void *render_thread(void *proxy) {
+    cglRunProxy((CGLProxy *) proxy);
+    return NULL;
+}
+
+/* a mix of small calls, as a frame loop makes them; 4 calls */
+static void calls(unsigned int count) {
+    unsigned int i;
+
+    for (i = 0; i < count; i += 4) {
+        glUseProgram(i & 7);
+        glUniform4f((GLint) (i & 15), 1.0f, 0.5f, 0.25f, 1.0f);
+        glBindBuffer(GL_ARRAY_BUFFER, i & 3);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+}
+
+static int compare(const void *a, const void *b) {
+    double first = *(const double *) a, second = *(const double *) b;
+
+    return first < second ? -1 : first > second;
+}
+
+int main(void) {
+    double *latencies = (double *) malloc(ROUND_TRIPS * sizeof(double));
+    double start, direct, queued, drained, total = 0.0;
+    CGLProxy *proxy;
+    pthread_t thread;
+    int i;
+
+    if (latencies == NULL)
+        return 1;
+    cglLoadGL(cglNullProc);
+
+    start = now();
+    calls(CALLS);
+    direct = now() - start;
+
+    proxy = cglStartProxy(1 << 20);
+    if (proxy == NULL || pthread_create(&thread, NULL, render_thread, proxy) != 0) {
+        printf("could not start the proxy\n");
+        return 1;
+    }
+    start = now();
+    calls(CALLS);
+    queued = now() - start;
+    cglProxyFinish(proxy);
+    drained = now() - start;
+
+    /* glGetError waits for the render thread to execute it and everything before */
+    for (i = 0; i < ROUND_TRIPS; ++i) {
+        start = now();
+        glGetError();
+        latencies[i] = (now() - start) * 1e6;
+        total += latencies[i];
+    }
+    cglStopProxy(proxy);
+    pthread_join(thread, NULL);
+    qsort(latencies, ROUND_TRIPS, sizeof(double), compare);
+
+    printf("driver: cglNullProc, %d calls\n", CALLS);
+    printf("direct:          %7.1f M calls/s\n", CALLS / direct * 1e-6);
+    printf("proxy, issuing:  %7.1f M calls/s on the calling thread\n", CALLS / queued * 1e-6);
+    printf("proxy, executed: %7.1f M calls/s including the render thread\n", CALLS / drained * 1e-6);
+    printf("glGetError round trip: mean %.2f us, median %.2f us, 99%% %.2f us, max %.2f us\n",
+           total / ROUND_TRIPS, latencies[ROUND_TRIPS / 2], latencies[ROUND_TRIPS * 99 / 100],
+           latencies[ROUND_TRIPS - 1]);
+    free(latencies);
+    return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ *  Test fixture: a fake GL library with a few entry points, for cglLoadGLFromLibrary
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+/* built with the plain names, not the glad_gl* macros of cgl.h, like a driver */
+
+unsigned int fakegl_calls = 0;
+
+void glClear(unsigned int mask) {
+    (void) mask;
+    ++fakegl_calls;
+}
+
+void glClearColor(float red, float green, float blue, float alpha) {
+    (void) red;
+    (void) green;
+    (void) blue;
+    (void) alpha;
+    ++fakegl_calls;
+}
+
+void glDrawArrays(unsigned int mode, int first, int count) {
+    (void) mode;
+    (void) first;
+    (void) count;
+    ++fakegl_calls;
+}
+
+void glBindBuffer(unsigned int target, unsigned int buffer) {
+    (void) target;
+    (void) buffer;
+    ++fakegl_calls;
+}
+
+void glGenBuffers(int n, unsigned int *buffers) {
+    int i;
+
+    for (i = 0; i < n; ++i)
+        buffers[i] = 100 + (unsigned int) i;
+    ++fakegl_calls;
+}
+
+unsigned int glGetError(void) {
+    ++fakegl_calls;
+    return 0x0505;  /* GL_OUT_OF_MEMORY, to tell it from a function returning 0 */
+}
+
+/* not part of the common subset, must not end up anywhere */
+void glBegin(unsigned int mode) {
+    (void) mode;
+}
+
+/* hidden, so only found if the lookup ignores visibility */
+__attribute__((visibility("hidden"))) void glFlush(void) {
+}
@@ -0,0 +1,290 @@
+/*
+ *  Test: adding, removing, evicting and repacking atlas images, checked against the texels of fake textures
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cgl.h>
+#include <cgl/cglatlas.h>
+#include <cgl/cglcmd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(condition) \
+    ((condition) ? (void) 0 : (void) (printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition), ++failures))
+
+static int failures = 0;
+
+#define PAGE_SIZE 256
+#define MAX_PAGES 6
+#define PIXEL 2             /* GL_LUMINANCE_ALPHA */
+#define IMAGES 3000
+#define MAX_TEXTURES 64
+
+/* the fake driver: the texels of each texture, garbage after glTexImage2D(NULL) as the driver may leave it */
+typedef struct Texture {
+    int width, height;
+    unsigned char *texels;
+} Texture;
+
+static Texture textures[MAX_TEXTURES];
+static GLuint next_texture = 1, bound_texture;
+
+static void APIENTRY fake_gen_textures(GLsizei n, GLuint *names) {
+    GLsizei i;
+
+    for (i = 0; i < n; ++i)
+        names[i] = next_texture++;
+}
+
+static void APIENTRY fake_delete_textures(GLsizei n, const GLuint *names) {
+    GLsizei i;
+
+    for (i = 0; i < n; ++i) {
+        free(textures[names[i]].texels);
+        textures[names[i]].texels = NULL;
+    }
+}
+
+static void APIENTRY fake_bind_texture(GLenum target, GLuint texture) {
+    (void) target;
+    bound_texture = texture;
+}
+
+/* rows aligned to 4 bytes, the default GL_UNPACK_ALIGNMENT */
+static void upload(int x, int y, int width, int height, const void *data) {
+    Texture *texture = &textures[bound_texture];
+    size_t row = (size_t) width * PIXEL, stride = (row + 3) & ~(size_t) 3;
+    int i;
+
+    CHECK(x >= 0 && y >= 0 && width > 0 && height > 0 && x + width <= texture->width && y + height <= texture->height);
+    if (x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > texture->width || y + height > texture->height)
+        return;
+    for (i = 0; i < height; ++i)
+        memcpy(texture->texels + ((size_t) (y + i) * (size_t) texture->width + (size_t) x) * PIXEL,
+               (const unsigned char *) data + (size_t) i * stride, row);
+}
+
+static void APIENTRY fake_tex_image(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                                    GLint border, GLenum format, GLenum type, const void *data) {
+    Texture *texture = &textures[bound_texture];
+
+    (void) target;
+    (void) level;
+    (void) internalformat;
+    (void) border;
+    (void) format;
+    (void) type;
+    free(texture->texels);
+    texture->width = width;
+    texture->height = height;
+    texture->texels = (unsigned char *) malloc((size_t) width * (size_t) height * PIXEL);
+    if (texture->texels == NULL)
+        return;
+    memset(texture->texels, 0xcd, (size_t) width * (size_t) height * PIXEL);
+    if (data != NULL)
+        upload(0, 0, width, height, data);
+}
+
+static void APIENTRY fake_tex_sub_image(GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height,
+                                        GLenum format, GLenum type, const void *data) {
+    (void) target;
+    (void) level;
+    (void) format;
+    (void) type;
+    upload(x, y, width, height, data);
+}
+
+static CGLAtlas *atlas;
+static CGLAtlasHandle handles[IMAGES];
+static int widths[IMAGES], heights[IMAGES];
+
+static unsigned char texel(int image, int x, int y, int c) {
+    return (unsigned char) (1 + (image * 7 + x * 3 + y * 5 + c * 11) % 250);
+}
+
+static void add(int image) {
+    unsigned char *pixels = (unsigned char *) malloc((size_t) widths[image] * (size_t) heights[image] * PIXEL);
+    int x, y, c;
+
+    if (pixels == NULL)
+        return;
+    for (y = 0; y < heights[image]; ++y)
+        for (x = 0; x < widths[image]; ++x)
+            for (c = 0; c < PIXEL; ++c)
+                pixels[((size_t) y * (size_t) widths[image] + (size_t) x) * PIXEL + c] = texel(image, x, y, c);
+    handles[image] = cglAddAtlasImage(atlas, widths[image], heights[image], pixels);
+    free(pixels);
+}
+
+/* uploads, then checks the texels of every image and its padding, that images do not overlap, and that all other
+ * texels of the pages are cleared, except the holes of removed images when holes_kept */
+static void check(const char *stage, int holes_kept) {
+    static unsigned char occupied[MAX_PAGES][PAGE_SIZE * PAGE_SIZE];
+    GLuint page_textures[MAX_PAGES];
+    unsigned long stale = 0;
+    unsigned int live = 0, evicted = 0, page;
+    CGLAtlasStats stats;
+    int i, x, y, c, bad = 0;
+
+    cglUploadAtlas(atlas);
+    memset(occupied, 0, sizeof(occupied));
+    memset(page_textures, 0, sizeof(page_textures));
+    for (i = 0; i < IMAGES; ++i) {
+        const Texture *texture;
+        CGLAtlasRect rect;
+
+        if (handles[i] == 0)
+            continue;
+        if (!cglGetAtlasImage(atlas, handles[i], &rect)) {
+            ++evicted;
+            continue;
+        }
+        ++live;
+        CHECK(rect.page < MAX_PAGES && rect.texture < MAX_TEXTURES);
+        if (rect.page >= MAX_PAGES || rect.texture >= MAX_TEXTURES)
+            return;
+        CHECK(rect.width == widths[i] && rect.height == heights[i]);
+        CHECK(rect.u0 == (float) rect.x / PAGE_SIZE && rect.v0 == (float) rect.y / PAGE_SIZE);
+        texture = &textures[rect.texture];
+        page_textures[rect.page] = rect.texture;
+        for (y = 0; y <= heights[i] && rect.y + y < PAGE_SIZE; ++y) {
+            for (x = 0; x <= widths[i] && rect.x + x < PAGE_SIZE; ++x) {
+                size_t at = (size_t) (rect.y + y) * PAGE_SIZE + (size_t) (rect.x + x);
+
+                if (occupied[rect.page][at]++)
+                    bad = 1;
+                for (c = 0; c < PIXEL; ++c)
+                    if (texture->texels[at * PIXEL + c] != (x < widths[i] && y < heights[i] ? texel(i, x, y, c) : 0))
+                        bad = 1;
+            }
+        }
+    }
+    for (page = 0; page < MAX_PAGES; ++page) {
+        size_t at;
+
+        if (page_textures[page] == 0)
+            continue;
+        for (at = 0; at < PAGE_SIZE * PAGE_SIZE; ++at)
+            if (!occupied[page][at] && (textures[page_textures[page]].texels[at * PIXEL] != 0
+                                        || textures[page_textures[page]].texels[at * PIXEL + 1] != 0))
+                ++stale;
+    }
+    cglGetAtlasStats(atlas, &stats);
+    printf("%s: %u images, %u evicted, %u pages, %lu texels used, %lu in holes, %lu stale\n", stage, live, evicted,
+           stats.pages, (unsigned long) stats.used, (unsigned long) stats.holes, stale);
+    CHECK(!bad);
+    CHECK(holes_kept || stale == 0);
+    CHECK(stats.images == live);
+}
+
+int main(void) {
+    CGLAtlasStats before, after;
+    CGLAtlasRect rect, other;
+    CGLAtlasHandle removed;
+    int i, k, failed;
+
+    cglLoadGL(cglNullProc);
+    cgl_dispatch.fn.GenTextures = fake_gen_textures;
+    cgl_dispatch.fn.DeleteTextures = fake_delete_textures;
+    cgl_dispatch.fn.BindTexture = fake_bind_texture;
+    cgl_dispatch.fn.TexImage2D = fake_tex_image;
+    cgl_dispatch.fn.TexSubImage2D = fake_tex_sub_image;
+    srand(25);
+
+    atlas = cglCreateAtlas(PAGE_SIZE, GL_LUMINANCE_ALPHA, MAX_PAGES, 1);
+    CHECK(atlas != NULL);
+    if (atlas == NULL)
+        return 1;
+    for (i = 0; i < IMAGES; ++i) {
+        widths[i] = 1 + rand() % (i % 10 == 0 ? 60 : 20);
+        heights[i] = 1 + rand() % (i % 7 == 0 ? 50 : 16);
+    }
+
+    for (i = 0; i < 300; ++i)
+        add(i);
+    check("added", 0);
+    for (i = 0; i < 300; i += 2) {
+        cglRemoveAtlasImage(atlas, handles[i]);
+        handles[i] = 0;
+    }
+    check("removed", 1);
+    cglRepackAtlas(atlas);
+    check("repacked", 0);
+
+    /* more than the pages hold, so that pages are evicted and cleared for new images; each batch in a new frame,
+     * as the pages used in this one, and so by the check, are not evicted */
+    for (k = 0; k < 6; ++k) {
+        cglUploadAtlas(atlas);
+        for (i = 300 + k * 400; i < 300 + (k + 1) * 400; ++i)
+            add(i);
+        check("filled", 0);
+    }
+    cglUploadAtlas(atlas);
+    for (i = 2700, failed = 0; i < IMAGES; ++i) {
+        add(i);
+        failed += handles[i] == 0;
+    }
+    CHECK(failed == 0);
+    check("evicting", 0);
+
+    /* evicted images are forgotten and added again */
+    for (i = 0; i < IMAGES; ++i) {
+        if (handles[i] != 0 && !cglGetAtlasImage(atlas, handles[i], &rect)) {
+            cglRemoveAtlasImage(atlas, handles[i]);
+            add(i);
+        }
+    }
+    check("added again", 0);
+    for (i = 0; i < IMAGES; i += 3) {
+        cglRemoveAtlasImage(atlas, handles[i]);
+        handles[i] = 0;
+    }
+    for (i = 0; i < IMAGES; i += 3) {
+        widths[i] = 1 + rand() % 30;
+        heights[i] = 1 + rand() % 30;
+        add(i);
+    }
+    cglRepackAtlas(atlas);
+    check("repacked", 0);
+
+    /* a handle removed twice, or never given out, changes nothing */
+    for (i = 0; i < IMAGES && handles[i] == 0; ++i)
+        ;
+    CHECK(i < IMAGES);
+    removed = handles[i];
+    cglRemoveAtlasImage(atlas, removed);
+    handles[i] = 0;
+    cglGetAtlasStats(atlas, &before);
+    cglRemoveAtlasImage(atlas, removed);
+    cglRemoveAtlasImage(atlas, 0);
+    cglRemoveAtlasImage(atlas, (CGLAtlasHandle) -1);
+    cglGetAtlasStats(atlas, &after);
+    CHECK(after.images == before.images && after.used == before.used && after.holes == before.holes);
+    CHECK(!cglGetAtlasImage(atlas, removed, &rect) && rect.texture == 0);
+    CHECK(!cglGetAtlasImage(atlas, (CGLAtlasHandle) -1, &rect));
+
+    /* so the handle is given out once, not to two images */
+    add(i);
+    CHECK(handles[i] == removed);
+    for (k = i + 1; k < IMAGES && handles[k] != 0; ++k)
+        ;
+    CHECK(k < IMAGES);
+    if (k < IMAGES) {
+        add(k);
+        CHECK(handles[k] != 0 && handles[k] != removed);
+        CHECK(cglGetAtlasImage(atlas, handles[i], &rect) && cglGetAtlasImage(atlas, handles[k], &other));
+        CHECK(rect.page != other.page || rect.x != other.x || rect.y != other.y);
+    }
+    check("removed twice", 1);
+
+    cglDestroyAtlas(atlas);
+    for (i = 0; i < MAX_TEXTURES; ++i) {
+        CHECK(textures[i].texels == NULL);
+        free(textures[i].texels);
+    }
+    printf(failures == 0 ? "ok\n" : "%d checks failed\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,236 @@
+/*
+ *  Test: static batches after removing objects twice, using stale handles and building with 0 workers
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cgl.h>
+#include <cgl/cglbatch.h>
+#include <cgl/cglcmd.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(condition) \
+    ((condition) ? (void) 0 : (void) (printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition), ++failures))
+
+static int failures = 0;
+
+#define MESHES 3
+#define MATERIALS 4
+#define OBJECTS 2000
+#define MAX_BUFFERS 1024
+
+/* the fake driver: the contents of each buffer object */
+static unsigned char *buffers[MAX_BUFFERS];
+static size_t buffer_sizes[MAX_BUFFERS];
+static GLuint next_buffer = 1, bound_array, bound_elements;
+
+static GLuint *bound(GLenum target) {
+    return target == GL_ELEMENT_ARRAY_BUFFER ? &bound_elements : &bound_array;
+}
+
+static void APIENTRY fake_gen_buffers(GLsizei n, GLuint *names) {
+    GLsizei i;
+
+    for (i = 0; i < n; ++i)
+        names[i] = next_buffer++;
+}
+
+static void APIENTRY fake_delete_buffers(GLsizei n, const GLuint *names) {
+    GLsizei i;
+
+    for (i = 0; i < n; ++i) {
+        free(buffers[names[i]]);
+        buffers[names[i]] = NULL;
+        buffer_sizes[names[i]] = 0;
+    }
+}
+
+static void APIENTRY fake_bind_buffer(GLenum target, GLuint buffer) {
+    *bound(target) = buffer;
+}
+
+static void APIENTRY fake_buffer_data(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    GLuint buffer = *bound(target);
+
+    (void) usage;
+    free(buffers[buffer]);
+    buffers[buffer] = (unsigned char *) calloc(1, (size_t) size > 0 ? (size_t) size : 1);
+    buffer_sizes[buffer] = (size_t) size;
+    if (data != NULL && buffers[buffer] != NULL)
+        memcpy(buffers[buffer], data, (size_t) size);
+}
+
+static void APIENTRY fake_buffer_sub_data(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    GLuint buffer = *bound(target);
+
+    CHECK(offset >= 0 && (size_t) offset + (size_t) size <= buffer_sizes[buffer]);
+    if (offset >= 0 && (size_t) offset + (size_t) size <= buffer_sizes[buffer])
+        memcpy(buffers[buffer] + offset, data, (size_t) size);
+}
+
+typedef struct Vertex {
+    float position[3];
+    float normal[3];
+    float uv[2];
+} Vertex;
+
+static const unsigned int vertex_counts[MESHES] = {40, 60, 24}, index_counts[MESHES] = {120, 180, 60};
+static Vertex mesh_vertices[MESHES][64];
+static unsigned short mesh_indices[MESHES][192];
+
+static CGLStaticBatcher *batcher;
+static unsigned int meshes[MESHES];
+static CGLBatchHandle handles[OBJECTS];
+static float matrices[OBJECTS][16];
+
+/* a rotation about y, a scale and a translation */
+static void random_matrix(float *m) {
+    float angle = (float) rand() / (float) RAND_MAX * 6.28f, scale = 0.5f + (float) rand() / (float) RAND_MAX;
+
+    memset(m, 0, 16 * sizeof(float));
+    m[0] = cosf(angle) * scale;
+    m[2] = -sinf(angle) * scale;
+    m[5] = scale;
+    m[8] = sinf(angle) * scale;
+    m[10] = cosf(angle) * scale;
+    m[12] = (float) (rand() % 1000);
+    m[13] = (float) (rand() % 10);
+    m[14] = (float) (rand() % 1000);
+    m[15] = 1.0f;
+}
+
+static void add(unsigned int i) {
+    random_matrix(matrices[i]);
+    handles[i] = cglAddBatchObject(batcher, meshes[i % MESHES], (unsigned int) rand() % MATERIALS, matrices[i]);
+    CHECK(handles[i] != 0);
+}
+
+/* builds on this thread with 0 workers, then compares a sum over the vertices of all batches with the one of the
+ * objects transformed here, and the objects in the batches with those added */
+static void check(const char *stage) {
+    double sum = 0.0, expected = 0.0;
+    unsigned int i, k, objects = 0, live = 0;
+    GLsizei j;
+
+    CHECK(cglPrepareStaticBatches(batcher) >= 0);
+    cglBuildStaticBatches(batcher, 0, 0);
+    cglUploadStaticBatches(batcher);
+    for (i = 0; i < cglStaticBatchCount(batcher); ++i) {
+        CGLStaticBatch batch;
+
+        cglGetStaticBatch(batcher, i, &batch);
+        objects += batch.objects;
+        for (j = 0; j < batch.index_count; ++j) {
+            const unsigned short *indices = (const unsigned short *) buffers[batch.index_buffer];
+            const Vertex *vertex = (const Vertex *) buffers[batch.vertex_buffer] + indices[j];
+
+            sum += vertex->position[0] + 2.0 * vertex->position[1] + 3.0 * vertex->position[2] + vertex->uv[1];
+        }
+    }
+    for (i = 0; i < OBJECTS; ++i) {
+        const float *m = matrices[i];
+        unsigned int mesh = i % MESHES;
+
+        if (handles[i] == 0)
+            continue;
+        ++live;
+        for (k = 0; k < index_counts[mesh]; ++k) {
+            const Vertex *vertex = &mesh_vertices[mesh][mesh_indices[mesh][k]];
+            const float *p = vertex->position;
+
+            expected += (m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12])
+                        + 2.0 * (m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13])
+                        + 3.0 * (m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14]) + vertex->uv[1];
+        }
+    }
+    printf("%s: %u objects in %u batches, relative difference %g\n", stage, objects, cglStaticBatchCount(batcher),
+           fabs(sum - expected) / expected);
+    CHECK(objects == live);
+    CHECK(fabs(sum - expected) <= 1e-6 * expected);
+}
+
+int main(void) {
+    unsigned int i, k, removed;
+
+    cglLoadGL(cglNullProc);
+    cgl_dispatch.fn.GenBuffers = fake_gen_buffers;
+    cgl_dispatch.fn.DeleteBuffers = fake_delete_buffers;
+    cgl_dispatch.fn.BindBuffer = fake_bind_buffer;
+    cgl_dispatch.fn.BufferData = fake_buffer_data;
+    cgl_dispatch.fn.BufferSubData = fake_buffer_sub_data;
+    srand(23);
+
+    batcher = cglCreateStaticBatcher(sizeof(Vertex), 0, 12, 0);
+    CHECK(batcher != NULL);
+    if (batcher == NULL)
+        return 1;
+    for (k = 0; k < MESHES; ++k) {
+        for (i = 0; i < vertex_counts[k]; ++i) {
+            Vertex *vertex = &mesh_vertices[k][i];
+
+            vertex->position[0] = (float) (rand() % 7);
+            vertex->position[1] = (float) (rand() % 7);
+            vertex->position[2] = (float) (rand() % 7);
+            vertex->normal[0] = (float) (rand() % 3 + 1);
+            vertex->normal[1] = 1.0f;
+            vertex->uv[1] = (float) i;
+        }
+        for (i = 0; i < index_counts[k]; ++i)
+            mesh_indices[k][i] = (unsigned short) (rand() % vertex_counts[k]);
+        meshes[k] = cglAddBatchMesh(batcher, mesh_vertices[k], vertex_counts[k], mesh_indices[k], index_counts[k]);
+        CHECK(meshes[k] != 0);
+    }
+    for (i = 0; i < OBJECTS; ++i)
+        add(i);
+    check("added");
+
+    /* each removed twice, then moved, with handles never given out ignored as well */
+    for (i = 0, removed = 0; i < OBJECTS / 3; ++i) {
+        k = (unsigned int) rand() % OBJECTS;
+        if (handles[k] == 0)
+            continue;
+        cglRemoveBatchObject(batcher, handles[k]);
+        cglRemoveBatchObject(batcher, handles[k]);
+        cglMoveBatchObject(batcher, handles[k], matrices[(k + 1) % OBJECTS]);
+        handles[k] = 0;
+        ++removed;
+    }
+    cglRemoveBatchObject(batcher, 0);
+    cglRemoveBatchObject(batcher, OBJECTS + 1);
+    cglMoveBatchObject(batcher, 0, matrices[0]);
+    cglMoveBatchObject(batcher, OBJECTS + 1, matrices[0]);
+    printf("removed %u objects\n", removed);
+    check("removed");
+
+    /* so each handle is given out once again, and each object keeps its own */
+    for (i = 0; i < OBJECTS; ++i)
+        if (handles[i] == 0)
+            add(i);
+    for (i = 0; i < OBJECTS; ++i)
+        for (k = i + 1; k < OBJECTS; ++k)
+            if (handles[i] == handles[k]) {
+                CHECK(!"a handle was given out twice");
+                i = k = OBJECTS;
+            }
+    check("added again");
+
+    /* and moved after all that */
+    for (i = 0; i < 100; ++i) {
+        k = (unsigned int) rand() % OBJECTS;
+        random_matrix(matrices[k]);
+        cglMoveBatchObject(batcher, handles[k], matrices[k]);
+    }
+    check("moved");
+
+    cglDestroyStaticBatcher(batcher);
+    for (i = 0; i < MAX_BUFFERS; ++i) {
+        CHECK(buffers[i] == NULL);
+        free(buffers[i]);
+    }
+    printf(failures == 0 ? "ok\n" : "%d checks failed\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,371 @@
+/*
+ *  Test: which calls the state caches filter and which they pass on, through fake entry points
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cgl.h>
+#include <cgl/cglcmd.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CHECK(condition) \
+    ((condition) ? (void) 0 : (void) (printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition), ++failures))
+
+static int failures = 0;
+
+/* the fake driver only counts the calls that reach it */
+static unsigned long passed, before;
+
+#define PASSED(call) (before = passed, (call), passed == before + 1)
+#define FILTERED(call) (before = passed, (call), passed == before)
+
+static void APIENTRY fake_enable(GLenum cap) {
+    (void) cap;
+    ++passed;
+}
+
+static void APIENTRY fake_blend_func(GLenum sfactor, GLenum dfactor) {
+    (void) sfactor;
+    (void) dfactor;
+    ++passed;
+}
+
+static void APIENTRY fake_blend_func_separate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    (void) srcRGB;
+    (void) dstRGB;
+    (void) srcAlpha;
+    (void) dstAlpha;
+    ++passed;
+}
+
+static void APIENTRY fake_blend_color(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+    (void) red;
+    (void) green;
+    (void) blue;
+    (void) alpha;
+    ++passed;
+}
+
+static void APIENTRY fake_color_mask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    (void) red;
+    (void) green;
+    (void) blue;
+    (void) alpha;
+    ++passed;
+}
+
+static void APIENTRY fake_depth_mask(GLboolean flag) {
+    (void) flag;
+    ++passed;
+}
+
+static void APIENTRY fake_depth_range(GLdouble n, GLdouble f) {
+    (void) n;
+    (void) f;
+    ++passed;
+}
+
+static void APIENTRY fake_bind(GLenum target, GLuint name) {
+    (void) target;
+    (void) name;
+    ++passed;
+}
+
+static void APIENTRY fake_use_program(GLuint program) {
+    (void) program;
+    ++passed;
+}
+
+static void APIENTRY fake_delete(GLsizei n, const GLuint *names) {
+    (void) n;
+    (void) names;
+    ++passed;
+}
+
+/* locations 10 and up, in the order the names are asked for, as a linker could give them */
+static GLint next_location = 10;
+
+static GLint APIENTRY fake_get_uniform_location(GLuint program, const GLchar *name) {
+    (void) program;
+    ++passed;
+    return strcmp(name, "missing") == 0 ? -1 : next_location++;
+}
+
+static void APIENTRY fake_link_program(GLuint program) {
+    (void) program;
+    ++passed;
+}
+
+static void APIENTRY fake_uniform1f(GLint location, GLfloat v0) {
+    (void) location;
+    (void) v0;
+    ++passed;
+}
+
+static void APIENTRY fake_uniform1i(GLint location, GLint v0) {
+    (void) location;
+    (void) v0;
+    ++passed;
+}
+
+static void APIENTRY fake_uniform_fv(GLint location, GLsizei count, const GLfloat *value) {
+    (void) location;
+    (void) count;
+    (void) value;
+    ++passed;
+}
+
+static void APIENTRY fake_uniform_matrix_fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    (void) location;
+    (void) count;
+    (void) transpose;
+    (void) value;
+    ++passed;
+}
+
+/* the slot of a function, for the counters of cglGetCacheStats */
+static unsigned int slot_of(const char *name) {
+    unsigned int slot;
+
+    for (slot = 0; slot < CGL_DISPATCH_COUNT && strcmp(cglSymbolName(slot), name) != 0; ++slot)
+        ;
+    return slot;
+}
+
+static void check_state_cache(void) {
+    const CGLCacheStats *stats = cglGetCacheStats();
+    unsigned int enable = slot_of("glEnable");
+
+    cgl_dispatch.fn.Enable = fake_enable;
+    cgl_dispatch.fn.Disable = fake_enable;
+    cgl_dispatch.fn.DepthFunc = fake_enable;
+    cgl_dispatch.fn.CullFace = fake_enable;
+    cgl_dispatch.fn.FrontFace = fake_enable;
+    cgl_dispatch.fn.BlendEquation = fake_enable;
+    cgl_dispatch.fn.BlendFunc = fake_blend_func;
+    cgl_dispatch.fn.BlendFuncSeparate = fake_blend_func_separate;
+    cgl_dispatch.fn.BlendColor = fake_blend_color;
+    cgl_dispatch.fn.ColorMask = fake_color_mask;
+    cgl_dispatch.fn.DepthMask = fake_depth_mask;
+    cgl_dispatch.fn.DepthRange = fake_depth_range;
+    cglEnableStateCache();
+    cglResetCacheStats();
+
+    /* the initial values of a new context are known */
+    CHECK(FILTERED(glDisable(GL_BLEND)));
+    CHECK(FILTERED(glEnable(GL_DITHER)));
+    CHECK(FILTERED(glDepthFunc(GL_LESS)));
+    CHECK(FILTERED(glCullFace(GL_BACK)));
+    CHECK(FILTERED(glFrontFace(GL_CCW)));
+    CHECK(FILTERED(glBlendFunc(GL_ONE, GL_ZERO)));
+    CHECK(FILTERED(glBlendEquation(GL_FUNC_ADD)));
+    CHECK(FILTERED(glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE)));
+    CHECK(FILTERED(glDepthMask(GL_TRUE)));
+    CHECK(FILTERED(glDepthRange(0.0, 1.0)));
+
+    /* a change is passed on once */
+    CHECK(PASSED(glEnable(GL_BLEND)));
+    CHECK(FILTERED(glEnable(GL_BLEND)));
+    CHECK(PASSED(glDisable(GL_BLEND)));
+    CHECK(PASSED(glDepthFunc(GL_LEQUAL)));
+    CHECK(FILTERED(glDepthFunc(GL_LEQUAL)));
+    CHECK(PASSED(glDepthMask(GL_FALSE)));
+    CHECK(FILTERED(glDepthMask(GL_FALSE)));
+
+    /* glBlendFunc and glBlendFuncSeparate set the same state */
+    CHECK(PASSED(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)));
+    CHECK(FILTERED(glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)));
+    CHECK(PASSED(glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO)));
+    CHECK(PASSED(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)));
+
+    /* values are compared as GL stores them, clamped to [0, 1] and with any true GLboolean as GL_TRUE */
+    CHECK(PASSED(glBlendColor(2.0f, 0.0f, 0.0f, 0.0f)));
+    CHECK(FILTERED(glBlendColor(1.0f, 0.0f, 0.0f, 0.0f)));
+    CHECK(FILTERED(glDepthRange(-1.0, 2.0)));
+    CHECK(FILTERED(glColorMask(2, 3, 4, 5)));
+
+    /* capabilities outside of the common subset are always passed on */
+    CHECK(PASSED(glEnable(0x0b10)));
+    CHECK(PASSED(glEnable(0x0b10)));
+
+    CHECK(stats->calls[enable] == 5 && stats->filtered[enable] == 2);
+
+    /* after an invalidation nothing is known, until it was set once */
+    cglInvalidateStateCache();
+    CHECK(PASSED(glDisable(GL_BLEND)));
+    CHECK(FILTERED(glDisable(GL_BLEND)));
+    CHECK(PASSED(glEnable(GL_DITHER)));
+    CHECK(PASSED(glDepthFunc(GL_LEQUAL)));
+    CHECK(FILTERED(glDepthFunc(GL_LEQUAL)));
+    CHECK(PASSED(glBlendColor(1.0f, 0.0f, 0.0f, 0.0f)));
+    CHECK(FILTERED(glBlendColor(1.0f, 0.0f, 0.0f, 0.0f)));
+    CHECK(PASSED(glDepthRange(0.0, 1.0)));
+    CHECK(PASSED(glDepthMask(GL_FALSE)));
+    CHECK(FILTERED(glDepthMask(GL_FALSE)));
+
+    /* and without the cache, every call is passed on */
+    cglDisableStateCache();
+    CHECK(cgl_dispatch.fn.Enable == fake_enable && cgl_dispatch.fn.BlendColor == fake_blend_color);
+    CHECK(PASSED(glDisable(GL_BLEND)));
+    CHECK(PASSED(glDisable(GL_BLEND)));
+}
+
+static void check_binding_cache(void) {
+    GLuint names[2];
+
+    cgl_dispatch.fn.BindBuffer = fake_bind;
+    cgl_dispatch.fn.BindTexture = fake_bind;
+    cgl_dispatch.fn.ActiveTexture = fake_enable;
+    cgl_dispatch.fn.UseProgram = fake_use_program;
+    cgl_dispatch.fn.DeleteBuffers = fake_delete;
+    cgl_dispatch.fn.DeleteTextures = fake_delete;
+    cglEnableBindingCache();
+
+    /* nothing is bound in a new context */
+    CHECK(FILTERED(glBindBuffer(GL_ARRAY_BUFFER, 0)));
+    CHECK(FILTERED(glBindTexture(GL_TEXTURE_2D, 0)));
+    CHECK(FILTERED(glActiveTexture(GL_TEXTURE0)));
+    CHECK(FILTERED(glUseProgram(0)));
+
+    CHECK(PASSED(glBindBuffer(GL_ARRAY_BUFFER, 5)));
+    CHECK(FILTERED(glBindBuffer(GL_ARRAY_BUFFER, 5)));
+    CHECK(PASSED(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 5)));
+    CHECK(FILTERED(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 5)));
+    CHECK(PASSED(glUseProgram(3)));
+    CHECK(FILTERED(glUseProgram(3)));
+
+    /* each unit has its own textures, with those of units past the cached ones passed on */
+    CHECK(PASSED(glBindTexture(GL_TEXTURE_2D, 7)));
+    CHECK(FILTERED(glBindTexture(GL_TEXTURE_2D, 7)));
+    CHECK(PASSED(glBindTexture(GL_TEXTURE_CUBE_MAP, 7)));
+    CHECK(PASSED(glActiveTexture(GL_TEXTURE1)));
+    CHECK(FILTERED(glActiveTexture(GL_TEXTURE1)));
+    CHECK(PASSED(glBindTexture(GL_TEXTURE_2D, 7)));
+    CHECK(FILTERED(glBindTexture(GL_TEXTURE_2D, 7)));
+    CHECK(PASSED(glActiveTexture(GL_TEXTURE0 + 40)));
+    CHECK(PASSED(glBindTexture(GL_TEXTURE_2D, 7)));
+    CHECK(PASSED(glBindTexture(GL_TEXTURE_2D, 7)));
+    CHECK(PASSED(glActiveTexture(GL_TEXTURE0)));
+
+    /* deleting unbinds from every target and unit, 0 and names not bound change nothing */
+    names[0] = 0;
+    names[1] = 7;
+    CHECK(PASSED(glDeleteTextures(2, names)));
+    CHECK(FILTERED(glBindTexture(GL_TEXTURE_2D, 0)));
+    CHECK(PASSED(glBindTexture(GL_TEXTURE_2D, 7)));
+    CHECK(FILTERED(glBindTexture(GL_TEXTURE_CUBE_MAP, 0)));
+    CHECK(PASSED(glActiveTexture(GL_TEXTURE1)));
+    CHECK(FILTERED(glBindTexture(GL_TEXTURE_2D, 0)));
+    names[1] = 6;
+    CHECK(PASSED(glDeleteBuffers(2, names)));
+    CHECK(FILTERED(glBindBuffer(GL_ARRAY_BUFFER, 5)));
+    names[1] = 5;
+    CHECK(PASSED(glDeleteBuffers(2, names)));
+    CHECK(FILTERED(glBindBuffer(GL_ARRAY_BUFFER, 0)));
+    CHECK(FILTERED(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0)));
+    CHECK(PASSED(glBindBuffer(GL_ARRAY_BUFFER, 5)));
+
+    /* after an invalidation no binding is known */
+    cglInvalidateStateCache();
+    CHECK(PASSED(glBindBuffer(GL_ARRAY_BUFFER, 5)));
+    CHECK(FILTERED(glBindBuffer(GL_ARRAY_BUFFER, 5)));
+    CHECK(PASSED(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0)));
+    CHECK(PASSED(glActiveTexture(GL_TEXTURE1)));
+    CHECK(PASSED(glBindTexture(GL_TEXTURE_2D, 0)));
+    CHECK(FILTERED(glBindTexture(GL_TEXTURE_2D, 0)));
+    CHECK(PASSED(glUseProgram(3)));
+    CHECK(FILTERED(glUseProgram(3)));
+
+    cglDisableBindingCache();
+    CHECK(cgl_dispatch.fn.BindBuffer == fake_bind && cgl_dispatch.fn.UseProgram == fake_use_program);
+    CHECK(PASSED(glUseProgram(3)));
+}
+
+static void check_uniform_cache(void) {
+    static const GLfloat values[4] = {1.0f, 2.0f, 3.0f, 4.0f}, others[4] = {1.0f, 2.0f, 3.0f, 5.0f};
+    static const GLfloat identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    GLint color, scale;
+
+    cgl_dispatch.fn.UseProgram = fake_use_program;
+    cgl_dispatch.fn.LinkProgram = fake_link_program;
+    cgl_dispatch.fn.DeleteProgram = fake_use_program;
+    cgl_dispatch.fn.GetUniformLocation = fake_get_uniform_location;
+    cgl_dispatch.fn.Uniform1f = fake_uniform1f;
+    cgl_dispatch.fn.Uniform1i = fake_uniform1i;
+    cgl_dispatch.fn.Uniform1fv = fake_uniform_fv;
+    cgl_dispatch.fn.Uniform4fv = fake_uniform_fv;
+    cgl_dispatch.fn.UniformMatrix4fv = fake_uniform_matrix_fv;
+    cglEnableUniformCache();
+    cglEnableBindingCache();
+
+    /* locations are asked for once per program and name */
+    CHECK(PASSED(color = glGetUniformLocation(3, "color")));
+    CHECK(FILTERED(glGetUniformLocation(3, "color") == color));
+    CHECK(PASSED(scale = glGetUniformLocation(3, "scale")));
+    CHECK(PASSED(glGetUniformLocation(4, "color") != color));
+    CHECK(PASSED(glGetUniformLocation(3, "missing")));
+    CHECK(FILTERED(glGetUniformLocation(3, "missing") == -1));
+
+    /* values are kept per program, with location -1 always dropped */
+    CHECK(PASSED(glUseProgram(3)));
+    CHECK(PASSED(glUniform4fv(color, 1, values)));
+    CHECK(FILTERED(glUniform4fv(color, 1, values)));
+    CHECK(PASSED(glUniform4fv(color, 1, others)));
+    CHECK(PASSED(glUniform1f(scale, 2.0f)));
+    CHECK(FILTERED(glUniform1f(scale, 2.0f)));
+    CHECK(PASSED(glUniform1i(scale, 2)));
+    CHECK(FILTERED(glUniform1f(-1, 2.0f)));
+    CHECK(PASSED(glUniformMatrix4fv(color + 4, 1, GL_FALSE, identity)));
+    CHECK(FILTERED(glUniformMatrix4fv(color + 4, 1, GL_FALSE, identity)));
+    CHECK(PASSED(glUniformMatrix4fv(color + 4, 1, GL_TRUE, identity)));
+    CHECK(PASSED(glUseProgram(4)));
+    CHECK(PASSED(glUniform1i(scale, 2)));
+    CHECK(PASSED(glUseProgram(3)));
+    CHECK(FILTERED(glUniform1i(scale, 2)));
+
+    /* arrays are passed on, and make the values of all locations they set unknown */
+    CHECK(PASSED(glUniform1f(scale + 1, 1.0f)));
+    CHECK(PASSED(glUniform1f(scale + 2, 1.0f)));
+    CHECK(PASSED(glUniform1fv(scale + 1, 2, values)));
+    CHECK(PASSED(glUniform1fv(scale + 1, 2, values)));
+    CHECK(PASSED(glUniform1f(scale + 1, 1.0f)));
+    CHECK(PASSED(glUniform1f(scale + 2, 1.0f)));
+    CHECK(FILTERED(glUniform1f(scale + 2, 1.0f)));
+    CHECK(PASSED(glUniform4fv(color, 0, values)));
+    CHECK(FILTERED(glUniform4fv(color, 1, others)));
+
+    /* linking gives new locations and resets the values */
+    CHECK(PASSED(glLinkProgram(3)));
+    CHECK(PASSED(color = glGetUniformLocation(3, "color")));
+    CHECK(FILTERED(glGetUniformLocation(3, "color") == color));
+    CHECK(PASSED(glUniform4fv(color, 1, values)));
+    CHECK(FILTERED(glUniform4fv(color, 1, values)));
+    CHECK(PASSED(glDeleteProgram(4)));
+    CHECK(PASSED(glGetUniformLocation(4, "color")));
+
+    /* and after an invalidation, the program in use is not known either */
+    cglInvalidateStateCache();
+    CHECK(PASSED(glGetUniformLocation(3, "color")));
+    CHECK(PASSED(glUniform4fv(color, 1, values)));
+    CHECK(PASSED(glUseProgram(3)));
+    CHECK(PASSED(glUniform4fv(color, 1, values)));
+    CHECK(FILTERED(glUniform4fv(color, 1, values)));
+
+    cglDisableUniformCache();
+    cglDisableBindingCache();
+    CHECK(cgl_dispatch.fn.UseProgram == fake_use_program && cgl_dispatch.fn.Uniform1f == fake_uniform1f);
+    CHECK(PASSED(glUniform1f(scale, 2.0f)));
+    CHECK(PASSED(glUniform1f(scale, 2.0f)));
+}
+
+int main(void) {
+    cglLoadGL(cglNullProc);
+    check_state_cache();
+    check_binding_cache();
+    check_uniform_cache();
+
+    printf(failures == 0 ? "ok\n" : "%d checks failed\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,201 @@
+/*
+ *  Test: random allocations and frees in a CGLBufferHeap, checked against a fake driver keeping the buffers
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cgl.h>
+#include <cgl/cglcmd.h>
+#include <cgl/cglheap.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(condition) \
+    ((condition) ? (void) 0 : (void) (printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition), ++failures))
+
+static int failures = 0;
+
+#define BLOCK_SIZE 65536
+#define MAX_LIVE 2000
+#define STEPS 40000
+#define MAX_BUFFERS 256
+
+/* the fake driver: the contents of each buffer object */
+static unsigned char *buffers[MAX_BUFFERS];
+static size_t buffer_sizes[MAX_BUFFERS];
+static GLuint next_buffer = 1, bound_buffer;
+
+static void APIENTRY fake_gen_buffers(GLsizei n, GLuint *names) {
+    GLsizei i;
+
+    for (i = 0; i < n; ++i)
+        names[i] = next_buffer++;
+}
+
+static void APIENTRY fake_delete_buffers(GLsizei n, const GLuint *names) {
+    GLsizei i;
+
+    for (i = 0; i < n; ++i) {
+        free(buffers[names[i]]);
+        buffers[names[i]] = NULL;
+        buffer_sizes[names[i]] = 0;
+    }
+}
+
+static void APIENTRY fake_bind_buffer(GLenum target, GLuint buffer) {
+    (void) target;
+    bound_buffer = buffer;
+}
+
+static void APIENTRY fake_buffer_data(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    (void) target;
+    (void) usage;
+    free(buffers[bound_buffer]);
+    buffers[bound_buffer] = (unsigned char *) calloc(1, (size_t) size);
+    buffer_sizes[bound_buffer] = (size_t) size;
+    if (data != NULL)
+        memcpy(buffers[bound_buffer], data, (size_t) size);
+}
+
+static void APIENTRY fake_buffer_sub_data(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    (void) target;
+    CHECK(offset >= 0 && (size_t) offset + (size_t) size <= buffer_sizes[bound_buffer]);
+    if (offset >= 0 && (size_t) offset + (size_t) size <= buffer_sizes[bound_buffer])
+        memcpy(buffers[bound_buffer] + offset, data, (size_t) size);
+}
+
+typedef struct Allocation {
+    CGLHeapHandle handle;
+    unsigned int serial;
+    size_t size;
+    GLuint buffer;
+    GLintptr offset;
+} Allocation;
+
+static Allocation live[MAX_LIVE];
+static unsigned int live_count;
+
+static unsigned char pattern(unsigned int serial, size_t i) {
+    return (unsigned char) (serial * 31u + (unsigned int) i * 7u + (unsigned int) (i >> 8));
+}
+
+static int by_location(const void *a, const void *b) {
+    const Allocation *first = (const Allocation *) a, *second = (const Allocation *) b;
+
+    if (first->buffer != second->buffer)
+        return first->buffer < second->buffer ? -1 : 1;
+    return first->offset < second->offset ? -1 : first->offset > second->offset;
+}
+
+/* alignment, bounds, no overlap, and the contents of every live allocation */
+static void check_live(CGLBufferHeap *heap) {
+    unsigned int i;
+    size_t j;
+
+    for (i = 0; i < live_count; ++i)
+        cglHeapLocation(heap, live[i].handle, &live[i].buffer, &live[i].offset);
+    qsort(live, live_count, sizeof(Allocation), by_location);
+    for (i = 0; i < live_count; ++i) {
+        const Allocation *allocation = &live[i];
+
+        CHECK(allocation->buffer != 0 && allocation->buffer < next_buffer);
+        CHECK(allocation->offset % CGL_HEAP_ALIGNMENT == 0);
+        CHECK((size_t) allocation->offset + allocation->size <= buffer_sizes[allocation->buffer]);
+        if (i + 1 < live_count && live[i + 1].buffer == allocation->buffer)
+            CHECK((size_t) allocation->offset + allocation->size <= (size_t) live[i + 1].offset);
+        if ((size_t) allocation->offset + allocation->size > buffer_sizes[allocation->buffer])
+            continue;
+        for (j = 0; j < allocation->size; ++j) {
+            if (buffers[allocation->buffer][allocation->offset + j] != pattern(allocation->serial, j)) {
+                CHECK(!"contents differ");
+                break;
+            }
+        }
+    }
+}
+
+int main(void) {
+    static unsigned char data[4 * BLOCK_SIZE];
+    CGLBufferHeap *heap;
+    CGLBufferHeapStats stats;
+    unsigned int step, serial = 0, i;
+    size_t j, moved;
+
+    cglLoadGL(cglNullProc);
+    cgl_dispatch.fn.GenBuffers = fake_gen_buffers;
+    cgl_dispatch.fn.DeleteBuffers = fake_delete_buffers;
+    cgl_dispatch.fn.BindBuffer = fake_bind_buffer;
+    cgl_dispatch.fn.BufferData = fake_buffer_data;
+    cgl_dispatch.fn.BufferSubData = fake_buffer_sub_data;
+    srand(19);
+
+    heap = cglCreateBufferHeap(GL_ARRAY_BUFFER, BLOCK_SIZE);
+    CHECK(heap != NULL);
+    if (heap == NULL)
+        return 1;
+
+    for (step = 0; step < STEPS; ++step) {
+        /* grow to about MAX_LIVE / 2 allocations, then keep the number around there */
+        if (live_count < MAX_LIVE && (live_count < MAX_LIVE / 2 || rand() % 2 == 0)) {
+            Allocation *allocation = &live[live_count];
+
+            /* mostly small meshes, some larger than a block */
+            allocation->size = rand() % 100 == 0 ? BLOCK_SIZE + (size_t) (rand() % (2 * BLOCK_SIZE))
+                                                 : 1 + (size_t) (rand() % 3000);
+            allocation->serial = ++serial;
+            for (j = 0; j < allocation->size; ++j)
+                data[j] = pattern(serial, j);
+            allocation->handle = cglHeapAlloc(heap, data, allocation->size);
+            CHECK(allocation->handle != 0);
+            if (allocation->handle != 0)
+                ++live_count;
+        } else if (live_count > 0) {
+            i = (unsigned int) rand() % live_count;
+            cglHeapFree(heap, live[i].handle);
+            live[i] = live[--live_count];
+        }
+        if (step % 1000 == 999)
+            check_live(heap);
+        if (step % 10000 == 9999) {
+            cglGetBufferHeapStats(heap, &stats);
+            moved = cglDefragmentBufferHeap(heap);
+            printf("step %u: %u blocks, %u allocations, %lu bytes used, %u free ranges, %lu bytes moved\n",
+                   step + 1, stats.blocks, stats.allocations, (unsigned long) stats.used, stats.free_ranges,
+                   (unsigned long) moved);
+            check_live(heap);
+            cglGetBufferHeapStats(heap, &stats);
+            CHECK(stats.allocations == live_count);
+            CHECK(stats.free_ranges <= stats.blocks);
+        }
+    }
+
+    /* with everything freed, each block is a single free range again */
+    while (live_count > 0) {
+        i = (unsigned int) rand() % live_count;
+        cglHeapFree(heap, live[i].handle);
+        live[i] = live[--live_count];
+    }
+    cglGetBufferHeapStats(heap, &stats);
+    printf("all freed: %u blocks, %u free ranges, largest %lu of %lu bytes\n", stats.blocks, stats.free_ranges,
+           (unsigned long) stats.largest_free, (unsigned long) stats.capacity);
+    CHECK(stats.allocations == 0);
+    CHECK(stats.used == 0);
+    CHECK(stats.free_ranges == stats.blocks);
+    CHECK(stats.blocks > 1);
+
+    /* and a block takes a full block size allocation again */
+    CHECK(cglHeapAlloc(heap, NULL, BLOCK_SIZE) != 0);
+    cglGetBufferHeapStats(heap, &stats);
+    CHECK(stats.allocations == 1);
+
+    cglDestroyBufferHeap(heap);
+    for (i = 0; i < MAX_BUFFERS; ++i) {
+        CHECK(buffers[i] == NULL);
+        free(buffers[i]);
+    }
+
+    printf(failures == 0 ? "ok\n" : "%d checks failed\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,103 @@
+/*
+ *  Test: cglLoadGLFromLibrary against the fake libraries built from fakegl.c
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cgl.h>
+#include <dlfcn.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CHECK(condition) \
+    ((condition) ? (void) 0 : (void) (printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition), ++failures))
+
+static int failures = 0;
+
+/* the functions of the common subset that fakegl.c exports */
+static const char *const exported[] = {
+    "glBindBuffer", "glClear", "glClearColor", "glDrawArrays", "glGenBuffers", "glGetError"
+};
+#define EXPORTED_COUNT (sizeof(exported) / sizeof(exported[0]))
+
+static int is_exported(const char *name) {
+    unsigned int i;
+
+    for (i = 0; i < EXPORTED_COUNT; ++i)
+        if (strcmp(exported[i], name) == 0)
+            return 1;
+    return 0;
+}
+
+static void check_library(const char *path) {
+    CGLLoadReport report = cglLoadGLFromLibrary(path);
+    void *library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    unsigned int *calls, i;
+    GLuint buffer = 0;
+
+    printf("%s: %u loaded, %u missing\n", path, report.loaded, report.missing);
+    CHECK(library != NULL);
+    if (library == NULL)
+        return;
+    CHECK(report.loaded == EXPORTED_COUNT);
+    CHECK(report.missing == CGL_DISPATCH_COUNT - EXPORTED_COUNT);
+
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i) {
+        const char *name = cglSymbolName(i);
+        int missing = (report.missing_mask[i / 32] >> (i % 32) & 1) != 0;
+
+        if (is_exported(name)) {
+            GLADproc expected;
+
+            *(void **) &expected = dlsym(library, name);
+            CHECK(!missing);
+            CHECK(cgl_dispatch.slot[i] == expected);
+        } else {
+            CHECK(missing);
+            CHECK(cgl_dispatch.slot[i] == NULL);
+        }
+    }
+
+    /* the resolved functions are the ones of the library */
+    calls = (unsigned int *) dlsym(library, "fakegl_calls");
+    CHECK(calls != NULL);
+    if (calls != NULL) {
+        *calls = 0;
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glGenBuffers(1, &buffer);
+        CHECK(glGetError() == 0x0505);
+        CHECK(buffer == 100);
+        CHECK(*calls == 4);
+    }
+    dlclose(library);
+}
+
+int main(int argc, char **argv) {
+    char gnu_hash[4096], sysv_hash[4096];
+    const char *slash = strrchr(argv[0], '/');
+    int directory = slash != NULL ? (int) (slash - argv[0]) : 1;
+    CGLLoadReport report;
+    unsigned int i;
+
+    (void) argc;
+    /* the libraries are built next to the test */
+    sprintf(gnu_hash, "%.*s/libfakegl.so", directory, slash != NULL ? argv[0] : ".");
+    sprintf(sysv_hash, "%.*s/libfakegl-sysv.so", directory, slash != NULL ? argv[0] : ".");
+
+    /* DT_GNU_HASH is searched with the precomputed hashes, DT_HASH only has the dlsym fallback */
+    check_library(gnu_hash);
+    check_library(sysv_hash);
+
+    report = cglLoadGLFromLibrary("/nonexistent/libGL.so.1");
+    CHECK(report.loaded == 0);
+    CHECK(report.missing == CGL_DISPATCH_COUNT);
+    for (i = 0; i < CGL_DISPATCH_COUNT; ++i) {
+        CHECK((report.missing_mask[i / 32] >> (i % 32) & 1) != 0);
+        CHECK(cgl_dispatch.slot[i] == NULL);
+    }
+
+    printf(failures == 0 ? "ok\n" : "%d checks failed\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,199 @@
+/*
+ *  Test: cache and fetch optimization and splitting of a shuffled grid mesh, checked against the original triangles
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cgl.h>
+#include <cgl/cglmesh.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(condition) \
+    ((condition) ? (void) 0 : (void) (printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition), ++failures))
+
+static int failures = 0;
+
+/* 300 x 300 vertices, more than one chunk of 16-bit indices */
+#define GRID 300
+#define VERTEX_COUNT (GRID * GRID)
+#define INDEX_COUNT ((GRID - 1) * (GRID - 1) * 6)
+
+/* a triangle with its smallest index first, keeping the winding */
+typedef struct Triangle {
+    unsigned int v[3];
+} Triangle;
+
+static Triangle canonical(const unsigned int *t) {
+    Triangle triangle;
+    unsigned int first = t[0] < t[1] ? (t[0] < t[2] ? 0 : 2) : (t[1] < t[2] ? 1 : 2), i;
+
+    for (i = 0; i < 3; ++i)
+        triangle.v[i] = t[(first + i) % 3];
+    return triangle;
+}
+
+static int by_vertices(const void *a, const void *b) {
+    const Triangle *first = (const Triangle *) a, *second = (const Triangle *) b;
+    unsigned int i;
+
+    for (i = 0; i < 3; ++i)
+        if (first->v[i] != second->v[i])
+            return first->v[i] < second->v[i] ? -1 : 1;
+    return 0;
+}
+
+/* whether two index lists have the same triangles in any order, each with the same winding */
+static int same_triangles(const unsigned int *a, const unsigned int *b, size_t index_count) {
+    size_t count = index_count / 3, i;
+    Triangle *first = (Triangle *) malloc(count * sizeof(Triangle)), *second = (Triangle *) malloc(count * sizeof(Triangle));
+    int same = first != NULL && second != NULL;
+
+    for (i = 0; same && i < count; ++i) {
+        first[i] = canonical(a + 3 * i);
+        second[i] = canonical(b + 3 * i);
+    }
+    if (same) {
+        qsort(first, count, sizeof(Triangle), by_vertices);
+        qsort(second, count, sizeof(Triangle), by_vertices);
+        same = memcmp(first, second, count * sizeof(Triangle)) == 0;
+    }
+    free(first);
+    free(second);
+    return same;
+}
+
+/* splits \ref indices and checks the chunks, and that the gathered vertices give the same triangles */
+static void check_split(const unsigned int *indices, const unsigned int *vertices, unsigned int max_vertices) {
+    CGLMeshSplit *split = cglSplitMesh(indices, INDEX_COUNT, VERTEX_COUNT, max_vertices);
+    unsigned int *gathered, c;
+    size_t i, next_index = 0, next_vertex = 0, max_local = 0;
+
+    CHECK(split != NULL);
+    if (split == NULL)
+        return;
+    gathered = (unsigned int *) malloc(split->vertex_count * sizeof(unsigned int));
+    CHECK(gathered != NULL);
+    if (gathered == NULL) {
+        cglDestroyMeshSplit(split);
+        return;
+    }
+    cglGatherVertices(split, vertices, sizeof(unsigned int), gathered);
+
+    CHECK(split->chunk_count >= (VERTEX_COUNT + max_vertices - 1) / max_vertices);
+    for (c = 0; c < split->chunk_count; ++c) {
+        const CGLMeshChunk *chunk = &split->chunks[c];
+
+        /* the chunks follow each other, in the triangle order given */
+        CHECK(chunk->first_index == next_index && chunk->first_vertex == next_vertex);
+        CHECK(chunk->index_count % 3 == 0 && chunk->index_count > 0);
+        CHECK(chunk->vertex_count <= max_vertices);
+        next_index += chunk->index_count;
+        next_vertex += chunk->vertex_count;
+        for (i = chunk->first_index; i < chunk->first_index + chunk->index_count; ++i) {
+            size_t local = split->indices[i];
+
+            if (local > max_local)
+                max_local = local;
+            CHECK(local < chunk->vertex_count);
+            if (local >= chunk->vertex_count)
+                break;
+            /* the vertex of the chunk is the vertex of the original triangle */
+            if (gathered[chunk->first_vertex + local] != vertices[indices[i]]) {
+                CHECK(!"gathered vertices differ");
+                break;
+            }
+        }
+    }
+    CHECK(next_index == INDEX_COUNT && next_vertex == split->vertex_count);
+    CHECK(max_local < 65536);
+    printf("split into chunks of at most %u vertices: %u chunks, %lu vertices\n", max_vertices, split->chunk_count,
+           (unsigned long) split->vertex_count);
+    free(gathered);
+    cglDestroyMeshSplit(split);
+}
+
+int main(void) {
+    unsigned int *grid = (unsigned int *) malloc(INDEX_COUNT * sizeof(unsigned int));
+    unsigned int *indices = (unsigned int *) malloc(INDEX_COUNT * sizeof(unsigned int));
+    unsigned int *optimized = (unsigned int *) malloc(INDEX_COUNT * sizeof(unsigned int));
+    unsigned int *vertices = (unsigned int *) malloc(VERTEX_COUNT * sizeof(unsigned int));
+    unsigned int x, y, t;
+    size_t i, kept;
+    float shuffled_ratio, optimized_ratio;
+
+    if (grid == NULL || indices == NULL || optimized == NULL || vertices == NULL)
+        return 1;
+    for (y = 0, i = 0; y + 1 < GRID; ++y) {
+        for (x = 0; x + 1 < GRID; ++x, i += 6) {
+            unsigned int v = y * GRID + x;
+
+            grid[i] = v;
+            grid[i + 1] = v + 1;
+            grid[i + 2] = v + GRID;
+            grid[i + 3] = v + 1;
+            grid[i + 4] = v + GRID + 1;
+            grid[i + 5] = v + GRID;
+        }
+    }
+    /* in random triangle order, as a mesh exported without care */
+    srand(22);
+    memcpy(indices, grid, INDEX_COUNT * sizeof(unsigned int));
+    for (t = INDEX_COUNT / 3 - 1; t > 0; --t) {
+        unsigned int other = (unsigned int) (((unsigned long) rand() * ((unsigned long) RAND_MAX + 1) + (unsigned long) rand())
+                                             % (t + 1)), swap[3];
+
+        memcpy(swap, indices + 3 * t, sizeof(swap));
+        memcpy(indices + 3 * t, indices + 3 * other, sizeof(swap));
+        memcpy(indices + 3 * other, swap, sizeof(swap));
+    }
+    /* each vertex is its own index in the original mesh, so moved vertices can be traced back */
+    for (i = 0; i < VERTEX_COUNT; ++i)
+        vertices[i] = (unsigned int) i;
+
+    /* the cache order is a permutation of the triangles, with fewer misses */
+    memcpy(optimized, indices, INDEX_COUNT * sizeof(unsigned int));
+    CHECK(cglOptimizeVertexCache(optimized, INDEX_COUNT, VERTEX_COUNT, 0) == 1);
+    CHECK(same_triangles(optimized, grid, INDEX_COUNT));
+    shuffled_ratio = cglAverageCacheMissRatio(indices, INDEX_COUNT, VERTEX_COUNT, CGL_MESH_DEFAULT_CACHE);
+    optimized_ratio = cglAverageCacheMissRatio(optimized, INDEX_COUNT, VERTEX_COUNT, CGL_MESH_DEFAULT_CACHE);
+    printf("cache miss ratio: %.3f shuffled, %.3f optimized\n", shuffled_ratio, optimized_ratio);
+    CHECK(shuffled_ratio > 2.0f);
+    CHECK(optimized_ratio > 0.5f && optimized_ratio < 0.8f);
+
+    /* the split keeps the triangles, in both cache orders and with chunks for 8-bit indices */
+    check_split(indices, vertices, CGL_MESH_MAX_VERTICES);
+    check_split(optimized, vertices, CGL_MESH_MAX_VERTICES);
+    check_split(optimized, vertices, 256);
+
+    /* the fetch order keeps every vertex and triangle, with the vertices in the order of first use */
+    memcpy(indices, optimized, INDEX_COUNT * sizeof(unsigned int));
+    kept = cglOptimizeVertexFetch(vertices, VERTEX_COUNT, sizeof(unsigned int), optimized, INDEX_COUNT);
+    CHECK(kept == VERTEX_COUNT);
+    for (i = 0, x = 0; i < INDEX_COUNT; ++i) {
+        CHECK(optimized[i] <= x);
+        if (optimized[i] == x)
+            ++x;
+        if (vertices[optimized[i]] != indices[i]) {
+            CHECK(!"fetch order changed a triangle");
+            break;
+        }
+    }
+    CHECK(cglAverageCacheMissRatio(optimized, INDEX_COUNT, VERTEX_COUNT, CGL_MESH_DEFAULT_CACHE) == optimized_ratio);
+
+    /* and invalid meshes are refused */
+    CHECK(cglOptimizeVertexCache(optimized, INDEX_COUNT - 1, VERTEX_COUNT, 0) == 0);
+    CHECK(cglOptimizeVertexCache(optimized, INDEX_COUNT, VERTEX_COUNT - 1, 0) == 0);
+    CHECK(cglSplitMesh(optimized, INDEX_COUNT - 1, VERTEX_COUNT, CGL_MESH_MAX_VERTICES) == NULL);
+    CHECK(cglSplitMesh(optimized, INDEX_COUNT, VERTEX_COUNT, CGL_MESH_MAX_VERTICES + 1) == NULL);
+    CHECK(cglSplitMesh(optimized, INDEX_COUNT, VERTEX_COUNT, 2) == NULL);
+
+    free(grid);
+    free(indices);
+    free(optimized);
+    free(vertices);
+    printf(failures == 0 ? "ok\n" : "%d checks failed\n", failures);
+    return failures != 0;
+}
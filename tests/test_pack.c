@@ -0,0 +1,147 @@
+/*
+ *  Test: cglPackVertices with the SIMD kernels against the portable code, byte for byte
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#include <cgl/cgl.h>
+#include <cgl/cglpack.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(condition) \
+    ((condition) ? (void) 0 : (void) (printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition), ++failures))
+
+static int failures = 0;
+
+/* cglpack.c compiled once more with CGL_NO_SIMD, see the Makefile */
+size_t cglPackVerticesScalar(const CGLPackAttrib *attribs, unsigned int count, size_t vertices, void *out,
+                             CGLVertexAttrib *layout);
+
+#define VERTICES 1000
+#define FLOATS (VERTICES * 5)
+
+static float source[FLOATS];
+static unsigned char simd[VERTICES * 32], scalar[VERTICES * 32];
+
+/* random values in [-2, 2] and the cases where the kernels may round differently */
+static void fill(float scale) {
+    static const float special[] = {0.0f, -0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 1.5f, -1.5f, 1e30f, -1e30f, 1e-40f, -1e-40f};
+    unsigned int i;
+
+    for (i = 0; i < FLOATS; ++i) {
+        int k = rand() % 2001 - 1000;
+
+        switch (rand() % 8) {
+        case 0:
+            /* exactly half a step, up to the end of the range and past it */
+            source[i] = ((float) k + 0.5f) / scale;
+            break;
+        case 1:
+            source[i] = (float) k / scale;
+            break;
+        case 2:
+            source[i] = special[rand() % (sizeof(special) / sizeof(special[0]))] / (rand() % 2 ? scale : 1.0f);
+            break;
+        case 3:
+            source[i] = rand() % 3 == 0 ? NAN : rand() % 2 ? INFINITY : -INFINITY;
+            break;
+        case 4:
+            /* just below and above half a step */
+            source[i] = nextafterf(((float) k + 0.5f) / scale, rand() % 2 ? INFINITY : -INFINITY);
+            break;
+        default:
+            source[i] = (float) rand() / (float) RAND_MAX * 4.0f - 2.0f;
+            break;
+        }
+    }
+}
+
+/* packs the same attributes both ways, with every vertex count up to 40 to cover the tails of the SIMD loops */
+static void compare(const CGLPackAttrib *attribs, unsigned int count, const char *what) {
+    CGLVertexAttrib simd_layout[4], scalar_layout[4];
+    size_t stride = cglPackedVertexSize(attribs, count), vertices, simd_stride, scalar_stride;
+    unsigned int i;
+
+    for (vertices = 0; vertices <= VERTICES; vertices += vertices < 40 ? 1 : VERTICES - 40) {
+        memset(simd, 0xcd, sizeof(simd));
+        memset(scalar, 0xcd, sizeof(scalar));
+        simd_stride = cglPackVertices(attribs, count, vertices, simd, simd_layout);
+        scalar_stride = cglPackVerticesScalar(attribs, count, vertices, scalar, scalar_layout);
+        CHECK(simd_stride == stride && scalar_stride == stride);
+        for (i = 0; i < count; ++i)
+            CHECK(simd_layout[i].index == scalar_layout[i].index && simd_layout[i].size == scalar_layout[i].size
+                  && simd_layout[i].type == scalar_layout[i].type
+                  && simd_layout[i].normalized == scalar_layout[i].normalized
+                  && simd_layout[i].stride == scalar_layout[i].stride
+                  && simd_layout[i].offset == scalar_layout[i].offset);
+        if (memcmp(simd, scalar, sizeof(simd)) != 0) {
+            for (i = 0; simd[i] == scalar[i]; ++i)
+                ;
+            printf("%s, %lu vertices: byte %u differs, %02x instead of %02x, vertex %u from %g\n", what,
+                   (unsigned long) vertices, i, simd[i], scalar[i], (unsigned int) (i / stride),
+                   attribs[0].source[i / stride * (attribs[0].source_stride / sizeof(float))]);
+            CHECK(!"SIMD and portable results differ");
+            return;
+        }
+    }
+}
+
+int main(void) {
+    static const char *names[] = {"float", "snorm16", "unorm16", "snorm8", "unorm8", "octahedral16", "octahedral8"};
+    static const float scales[] = {1.0f, 32767.0f, 65535.0f, 127.0f, 255.0f, 32767.0f, 127.0f};
+    /* the normalized range itself, a range to map, an empty range, and a reversed one */
+    static const float ranges[][2] = {{0.0f, 0.0f}, {-3.0f, 5.0f}, {2.0f, 2.0f}, {1.0f, -1.0f}};
+    CGLPackAttrib attribs[4];
+    char what[128];
+    unsigned int encoding, components, range, padding, i;
+
+    srand(21);
+    for (encoding = CGL_PACK_FLOAT; encoding <= CGL_PACK_OCTAHEDRAL8; ++encoding) {
+        fill(scales[encoding]);
+        for (components = 1; components <= 4; ++components) {
+            if (encoding >= CGL_PACK_OCTAHEDRAL16 && components != 3)
+                continue;
+            for (range = 0; range < sizeof(ranges) / sizeof(ranges[0]); ++range) {
+                for (padding = 0; padding <= 1; ++padding) {
+                    memset(attribs, 0, sizeof(attribs));
+                    attribs[0].source = source;
+                    attribs[0].components = components;
+                    attribs[0].source_stride = (components + padding) * sizeof(float);
+                    attribs[0].encoding = encoding;
+                    attribs[0].min = ranges[range][0];
+                    attribs[0].max = ranges[range][1];
+                    sprintf(what, "%s, %u components, range %g to %g, stride %lu", names[encoding], components,
+                            attribs[0].min, attribs[0].max, (unsigned long) attribs[0].source_stride);
+                    compare(attribs, 1, what);
+                }
+            }
+        }
+    }
+
+    /* and interleaved, as a vertex of position, normal, texture coordinates and color */
+    fill(32767.0f);
+    for (i = 0; i < 4; ++i) {
+        attribs[i].index = i;
+        attribs[i].source = source + (i == 3 ? 1 : i);
+        attribs[i].source_stride = 5 * sizeof(float);
+        attribs[i].min = attribs[i].max = 0.0f;
+    }
+    attribs[0].components = 3;
+    attribs[0].encoding = CGL_PACK_SNORM16;
+    attribs[0].min = -2.0f;
+    attribs[0].max = 2.0f;
+    attribs[1].components = 3;
+    attribs[1].encoding = CGL_PACK_OCTAHEDRAL8;
+    attribs[2].components = 2;
+    attribs[2].encoding = CGL_PACK_UNORM16;
+    attribs[3].components = 4;
+    attribs[3].encoding = CGL_PACK_UNORM8;
+    compare(attribs, 4, "interleaved");
+
+    printf(failures == 0 ? "ok\n" : "%d checks failed\n", failures);
+    return failures != 0;
+}
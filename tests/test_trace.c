@@ -0,0 +1,298 @@
+/*
+ *  Test: capture a trace through cglNullProc, then open and replay it, without a GPU
+ *
+ *  Copyright (c) 2023, Hypatia of Sva <hypatia dot sva at posteo dot eu>
+ *  SPDX-License-Identifier: MIT
+*/
+
+#define _POSIX_C_SOURCE 200809L     /* mkstemp */
+
+#include <cgl/cgl.h>
+#include <cgl/cglcmd.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CHECK(condition) \
+    ((condition) ? (void) 0 : (void) (printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition), ++failures))
+
+static int failures = 0;
+
+#define FRAMES 3
+#define VERTEX_BYTES 1000
+#define TEXTURE_SIZE 13     /* rows of 39 bytes, not padded with an alignment of 1 */
+
+static unsigned char vertices[VERTEX_BYTES];
+static unsigned char texels[3 * TEXTURE_SIZE * TEXTURE_SIZE];
+
+/* the program set an alignment of 1 before the capture starts */
+static void APIENTRY get_integerv(GLenum pname, GLint *data) {
+    if (pname == GL_UNPACK_ALIGNMENT)
+        *data = 1;
+}
+
+/* what the replay hands to the driver */
+static unsigned int buffer_data_calls, tex_image_calls, frames_seen, calls_before_alignment;
+static int buffer_data_equal, tex_image_equal;
+static GLint alignment;
+
+static void APIENTRY check_pixel_store(GLenum pname, GLint param) {
+    if (pname == GL_UNPACK_ALIGNMENT && alignment == 0) {
+        calls_before_alignment = buffer_data_calls + tex_image_calls;
+        alignment = param;
+    }
+}
+
+static void APIENTRY check_buffer_data(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    ++buffer_data_calls;
+    buffer_data_equal = target == GL_ARRAY_BUFFER && size == VERTEX_BYTES && usage == GL_STATIC_DRAW
+                        && data != NULL && memcmp(data, vertices, VERTEX_BYTES) == 0;
+}
+
+static void APIENTRY check_tex_image(GLenum target, GLint level, GLint internalformat, GLsizei width,
+                                     GLsizei height, GLint border, GLenum format, GLenum type, const void *data) {
+    ++tex_image_calls;
+    tex_image_equal = target == GL_TEXTURE_2D && level == 0 && internalformat == GL_RGB && width == TEXTURE_SIZE
+                      && height == TEXTURE_SIZE && border == 0 && format == GL_RGB && type == GL_UNSIGNED_BYTE
+                      && data != NULL && memcmp(data, texels, sizeof(texels)) == 0;
+}
+
+static void count_frame(void *user) {
+    (void) user;
+    ++frames_seen;
+}
+
+/* the layout of a trace file: a header of 24 bytes with the size of the names at 20,
+ * then commands of an opcode of 16 bits, an argument count of 16 bits and a size of 32 bits, then 8 bytes per argument */
+#define NAMES_SIZE_AT 20
+#define ARG_AT(command, i) ((command) + 8 + 8 * (i))
+
+static unsigned char *load(const char *path, size_t *size) {
+    FILE *file = fopen(path, "rb");
+    unsigned char *data = NULL;
+    long length;
+
+    if (file == NULL)
+        return NULL;
+    if (fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0
+            && (data = (unsigned char *) malloc((size_t) length)) != NULL) {
+        *size = fread(data, 1, (size_t) length, file);
+        if (*size != (size_t) length) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(file);
+    return data;
+}
+
+/* whether cglOpenTrace takes the first size bytes of data */
+static int opens(const char *path, const unsigned char *data, size_t size) {
+    FILE *file = fopen(path, "wb");
+    CGLTrace *trace;
+
+    if (file == NULL || fwrite(data, 1, size, file) != size) {
+        CHECK(!"cannot write the trace");
+        if (file != NULL)
+            fclose(file);
+        return 0;
+    }
+    fclose(file);
+    trace = cglOpenTrace(path);
+    cglCloseTrace(trace);
+    return trace != NULL;
+}
+
+static uint32_t read32(const unsigned char *at) {
+    uint32_t value;
+
+    memcpy(&value, at, sizeof(value));
+    return value;
+}
+
+static void write32(unsigned char *at, uint32_t value) {
+    memcpy(at, &value, sizeof(value));
+}
+
+/* the offset of the first command of the function, or 0 */
+static size_t find(const unsigned char *data, size_t size, const char *function) {
+    size_t at = 24, start = 24 + read32(data + NAMES_SIZE_AT);
+    unsigned int opcode = 0;
+
+    while (at < start && strcmp((const char *) data + at, function) != 0) {
+        at += strlen((const char *) data + at) + 1;
+        ++opcode;
+    }
+    for (at = start; at < size; at += read32(data + at + 4)) {
+        uint16_t command_opcode;
+
+        memcpy(&command_opcode, data + at, sizeof(command_opcode));
+        if (command_opcode == opcode)
+            return at;
+    }
+    return 0;
+}
+
+/* a damaged copy of the trace: truncated anywhere but between commands, or with a wrong count, argument count,
+ * payload offset or payload size, cglOpenTrace returns NULL */
+static void check_damaged(const char *path) {
+    size_t size = 0, at, start, next, command;
+    unsigned char *data = load(path, &size), *copy;
+    uint16_t argc;
+
+    CHECK(data != NULL && size > 24);
+    if (data == NULL)
+        return;
+    copy = (unsigned char *) malloc(size);
+    CHECK(copy != NULL);
+    if (copy == NULL) {
+        free(data);
+        return;
+    }
+    CHECK(opens(path, data, size));
+
+    start = 24 + read32(data + NAMES_SIZE_AT);
+    for (at = 0, next = start; at < size; ++at) {
+        if (at > next)
+            next += read32(data + next + 4);
+        if (opens(path, data, at) != (at == next)) {
+            printf("truncated to %lu bytes\n", (unsigned long) at);
+            CHECK(!"a truncated trace opened, or one cut between commands did not");
+        }
+    }
+
+    memcpy(copy, data, size);
+    write32(copy + 16, 0xffffffffu);
+    CHECK(!opens(path, copy, size));
+    write32(copy + 16, read32(data + NAMES_SIZE_AT) + 1);
+    CHECK(!opens(path, copy, size));
+
+    for (command = start; command < size; command += read32(data + command + 4)) {
+        memcpy(&argc, data + command + 2, sizeof(argc));
+        memcpy(copy, data, size);
+        argc = (uint16_t) (argc + 1);
+        memcpy(copy + command + 2, &argc, sizeof(argc));
+        CHECK(!opens(path, copy, size));
+        if (argc > 1) {
+            argc = (uint16_t) (argc - 2);
+            memcpy(copy + command + 2, &argc, sizeof(argc));
+            CHECK(!opens(path, copy, size));
+        }
+    }
+
+    /* glBufferData(target, size, data, usage) reading past its command, or its data pointing into the arguments */
+    command = find(data, size, "glBufferData");
+    CHECK(command != 0);
+    if (command != 0) {
+        GLsizeiptr bytes = VERTEX_BYTES + 1;
+
+        memcpy(copy, data, size);
+        memcpy(ARG_AT(copy + command, 1), &bytes, sizeof(bytes));
+        CHECK(!opens(path, copy, size));
+        memcpy(copy, data, size);
+        write32(ARG_AT(copy + command, 2), read32(data + command + 4));
+        CHECK(!opens(path, copy, size));
+        write32(ARG_AT(copy + command, 2), 8);
+        CHECK(!opens(path, copy, size));
+    }
+
+    /* a wider glTexImage2D, or its rows aligned to 4 instead of 1 by the glPixelStorei before it */
+    command = find(data, size, "glTexImage2D");
+    CHECK(command != 0);
+    if (command != 0) {
+        memcpy(copy, data, size);
+        write32(ARG_AT(copy + command, 3), TEXTURE_SIZE + 1);
+        CHECK(!opens(path, copy, size));
+    }
+    command = find(data, size, "glPixelStorei");
+    CHECK(command != 0);
+    if (command != 0) {
+        memcpy(copy, data, size);
+        write32(ARG_AT(copy + command, 1), 4);
+        CHECK(!opens(path, copy, size));
+        write32(ARG_AT(copy + command, 1), 1);
+        CHECK(opens(path, copy, size));
+    }
+    free(copy);
+    free(data);
+}
+
+/* a small frame, returns the number of GL calls made */
+static unsigned long frame(unsigned int index) {
+    GLuint buffer = 1, texture = 1;
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    if (index != 0) {
+        glUseProgram(3);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        return 4;
+    }
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, VERTEX_BYTES, vertices, GL_STATIC_DRAW);
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, TEXTURE_SIZE, TEXTURE_SIZE, 0, GL_RGB, GL_UNSIGNED_BYTE, texels);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    return 9;
+}
+
+int main(void) {
+    char path[] = "/tmp/cgl-test-trace-XXXXXX";
+    unsigned long made = 0;
+    unsigned int i;
+    CGLTrace *trace;
+    int file = mkstemp(path);
+
+    CHECK(file >= 0);
+    if (file < 0)
+        return 1;
+    close(file);
+    for (i = 0; i < sizeof(vertices); ++i)
+        vertices[i] = (unsigned char) (i * 7 + 1);
+    for (i = 0; i < sizeof(texels); ++i)
+        texels[i] = (unsigned char) (i * 13 + 5);
+
+    cglLoadGL(cglNullProc);
+    cgl_dispatch.fn.GetIntegerv = get_integerv;
+    CHECK(cglStartCapture(path));
+    for (i = 0; i < FRAMES; ++i) {
+        made += frame(i);
+        cglCaptureFrame();
+    }
+    CHECK(cglStopCapture());
+    /* the capture restored the table, so nothing more goes into the trace */
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    trace = cglOpenTrace(path);
+    CHECK(trace != NULL);
+    if (trace != NULL) {
+        unsigned long replayed;
+
+        CHECK(cglTraceFrames(trace) == FRAMES);
+
+        /* on the null driver, as on a machine without a GPU, with the glPixelStorei the capture starts with */
+        replayed = cglReplayTrace(trace, count_frame, NULL);
+        printf("%lu calls made, %lu replayed, %u frames\n", made, replayed, frames_seen);
+        CHECK(replayed == made + 1);
+        CHECK(frames_seen == FRAMES);
+
+        /* and once more, with the payloads and the alignment checked by the driver */
+        cgl_dispatch.fn.BufferData = check_buffer_data;
+        cgl_dispatch.fn.TexImage2D = check_tex_image;
+        cgl_dispatch.fn.PixelStorei = check_pixel_store;
+        CHECK(cglReplayTrace(trace, NULL, NULL) == made + 1);
+        CHECK(buffer_data_calls == 1 && buffer_data_equal);
+        CHECK(tex_image_calls == 1 && tex_image_equal);
+        CHECK(alignment == 1 && calls_before_alignment == 0);
+        cglCloseTrace(trace);
+    }
+    check_damaged(path);
+    remove(path);
+
+    printf(failures == 0 ? "ok\n" : "%d checks failed\n", failures);
+    return failures != 0;
+}